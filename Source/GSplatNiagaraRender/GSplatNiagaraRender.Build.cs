@@ -22,7 +22,18 @@ public class GSplatNiagaraRender : ModuleRules
         });
 
         PrivateDependencyModuleNames.AddRange(new string[] {
-            "VectorVM"
+            "VectorVM",
+            "Json",
+            "ImageCore",
+            "GSplatNiagaraRenderShaders"
         });
+
+        if (Target.bBuildEditor)
+        {
+            PrivateDependencyModuleNames.AddRange(new string[] {
+                "DerivedDataCache",
+                "DirectoryWatcher"
+            });
+        }
     }
 }
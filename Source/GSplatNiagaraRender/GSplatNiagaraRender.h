@@ -6,4 +6,6 @@
 
 #include "GaussianSplatData.h"
 #include "GaussianSplatNiagaraDataInterface.h"
+#include "GaussianSplatStreamingManager.h"
+#include "GaussianSplatTiledFile.h"
 #include "PLYParser.h"
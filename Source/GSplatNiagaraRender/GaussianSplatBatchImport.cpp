@@ -0,0 +1,184 @@
+﻿#include "GaussianSplatBatchImport.h"
+#include "Async/ParallelFor.h"
+#include "GaussianSplatCompactFile.h"
+#include "GaussianSplatDerivedData.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "PLYParser.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatImport, Log, All);
+
+namespace GaussianSplatBatchImport
+{
+// Decoded splats per byte of a compact file is bounded by the .splat format (32 bytes per splat without SH); .spz is
+// smaller per splat but carries SH, which grows the splats with it
+constexpr int64 CompactExpansion = 8;
+} // namespace GaussianSplatBatchImport
+
+int64 FGaussianSplatBatchImport::EstimatePeakBytes(const FString &FilePath, int64 &OutFileBytes, FString &OutError)
+{
+    using namespace GaussianSplatBatchImport;
+    OutFileBytes = IFileManager::Get().FileSize(*FilePath);
+    if (OutFileBytes < 0)
+    {
+        OutFileBytes = 0;
+        OutError = FString::Printf(TEXT("File not found: %s"), *FilePath);
+        return 0;
+    }
+    if (FGaussianSplatCompactFile::IsCompactFile(FilePath))
+        return OutFileBytes * CompactExpansion;
+
+    FPLYParser Parser;
+    if (!Parser.ProbeFile(FilePath))
+    {
+        OutError = Parser.GetErrorMessage();
+        return 0;
+    }
+    // ParseFile holds the raw bytes, a text copy of them and that copy split into lines all at once, then the splats;
+    // an editor load also packs the splats into a Derived Data Cache blob of about the same size
+    const int64 SplatBytes = int64(Parser.GetVertexCount()) *
+                             (sizeof(FGaussianSplatData) + Parser.GetNumSHCoeffs() * sizeof(FVector3f));
+    return OutFileBytes * (1 + 2 * sizeof(TCHAR)) + 2 * SplatBytes;
+}
+
+void FGaussianSplatBatchImport::CollectFiles(const FString &Input, TArray<FString> &OutFiles)
+{
+    if (IFileManager::Get().DirectoryExists(*Input))
+    {
+        TArray<FString> Names;
+        for (const TCHAR *Extension : {TEXT("*.ply"), TEXT("*.spz"), TEXT("*.splat")})
+            IFileManager::Get().FindFiles(Names, *(Input / Extension), true, false);
+        Names.Sort();
+        for (const FString &Name : Names)
+            OutFiles.Add(Input / Name);
+        return;
+    }
+
+    if (FPaths::GetExtension(Input).Equals(TEXT("txt"), ESearchCase::IgnoreCase))
+    {
+        // One path per line, relative to the list; blank lines and # comments are skipped
+        TArray<FString> Lines;
+        FFileHelper::LoadFileToStringArray(Lines, *Input);
+        for (FString &Line : Lines)
+        {
+            Line.TrimStartAndEndInline();
+            if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+                continue;
+            OutFiles.Add(FPaths::IsRelative(Line) ? FPaths::GetPath(Input) / Line : Line);
+        }
+        return;
+    }
+
+    OutFiles.Add(Input);
+}
+
+TArray<FGaussianSplatImportResult> FGaussianSplatBatchImport::Run(TConstArrayView<FString> FilePaths,
+                                                                 const FGaussianSplatBatchImportSettings &Settings,
+                                                                 const FOnFileLoaded &OnFileLoaded)
+{
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    const int32 NumFiles = FilePaths.Num();
+    TArray<FGaussianSplatImportResult> Results;
+    Results.SetNum(NumFiles);
+
+    // Probes only read headers, so they all go at once
+    ParallelFor(TEXT("GaussianSplat.ImportProbe"), NumFiles, 1,
+                [&](int32 FileIndex)
+                {
+                    FGaussianSplatImportResult &Result = Results[FileIndex];
+                    Result.FilePath = FilePaths[FileIndex];
+                    Result.EstimatedBytes = EstimatePeakBytes(Result.FilePath, Result.FileBytes, Result.Error);
+                });
+
+    TArray<int32> Pending;
+    for (int32 FileIndex = 0; FileIndex < NumFiles; ++FileIndex)
+    {
+        if (Results[FileIndex].Error.IsEmpty())
+            Pending.Add(FileIndex);
+        else
+            UE_LOG(LogGaussianSplatImport, Warning, TEXT("%s: %s"), *FilePaths[FileIndex], *Results[FileIndex].Error);
+    }
+    // Big files first so they do not end up alone at the tail of the batch
+    Pending.StableSort([&Results](int32 A, int32 B) { return Results[A].EstimatedBytes > Results[B].EstimatedBytes; });
+
+    const int32 MaxInFlight = Settings.MaxFilesInFlight > 0
+                                  ? Settings.MaxFilesInFlight
+                                  : FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+    const int64 Budget = Settings.MemoryBudgetBytes > 0 ? Settings.MemoryBudgetBytes
+                                                        : int64(FPlatformMemory::GetStats().AvailablePhysical / 2);
+    UE_LOG(LogGaussianSplatImport, Log, TEXT("Importing %d files | %d in flight | %.0f MB budget"), Pending.Num(),
+           MaxInFlight, double(Budget) / (1024.0 * 1024.0));
+
+    FCriticalSection Lock;
+    int32 InFlight = 0;
+    int64 BytesInFlight = 0;
+    // Auto-reset, so a completion between the admission check and the wait is not lost
+    FEvent *FileDone = FPlatformProcess::GetSynchEventFromPool(false);
+    TArray<UE::Tasks::FTask> Tasks;
+    Tasks.Reserve(Pending.Num());
+    const double BatchStart = FPlatformTime::Seconds();
+    auto FitsBudget = [&](int32 FileIndex) { return BytesInFlight + Results[FileIndex].EstimatedBytes <= Budget; };
+
+    while (Pending.Num() > 0)
+    {
+        int32 Admitted = INDEX_NONE;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (InFlight == 0)
+            {
+                Admitted = 0;
+            }
+            else if (InFlight < MaxInFlight)
+            {
+                Admitted = Pending.IndexOfByPredicate(FitsBudget);
+            }
+            if (Admitted != INDEX_NONE)
+            {
+                ++InFlight;
+                BytesInFlight += Results[Pending[Admitted]].EstimatedBytes;
+            }
+        }
+        if (Admitted == INDEX_NONE)
+        {
+            FileDone->Wait();
+            continue;
+        }
+
+        const int32 FileIndex = Pending[Admitted];
+        Pending.RemoveAt(Admitted);
+        Results[FileIndex].QueuedSeconds = FPlatformTime::Seconds() - BatchStart;
+        Tasks.Add(UE::Tasks::Launch(
+            UE_SOURCE_LOCATION,
+            [&Results, &Lock, &InFlight, &BytesInFlight, FileDone, &OnFileLoaded, FileIndex]()
+            {
+                LLM_SCOPE_BYTAG(GaussianSplat);
+                FGaussianSplatImportResult &Result = Results[FileIndex];
+                const double Start = FPlatformTime::Seconds();
+                {
+                    TArray<FGaussianSplatData> Splats;
+                    Result.bSucceeded = FGaussianSplatDerivedData::LoadPLY(Result.FilePath, Splats, Result.Error);
+                    Result.NumSplats = Splats.Num();
+                    if (Result.bSucceeded && OnFileLoaded)
+                        OnFileLoaded(FileIndex, Splats);
+                }
+                Result.LoadSeconds = FPlatformTime::Seconds() - Start;
+                UE_LOG(LogGaussianSplatImport, Verbose, TEXT("%s | %d splats | %.2f s"), *Result.FilePath,
+                       Result.NumSplats, Result.LoadSeconds);
+
+                {
+                    FScopeLock ScopeLock(&Lock);
+                    --InFlight;
+                    BytesInFlight -= Result.EstimatedBytes;
+                }
+                FileDone->Trigger();
+            }));
+    }
+
+    UE::Tasks::Wait(Tasks);
+    FPlatformProcess::ReturnSynchEventToPool(FileDone);
+    return Results;
+}
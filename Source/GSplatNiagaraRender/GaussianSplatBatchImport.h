@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+struct FGaussianSplatBatchImportSettings
+{
+    // Files loading at once; 0 uses one per task graph worker
+    int32 MaxFilesInFlight = 0;
+    // Cap on the summed peak memory estimates of the files in flight; 0 uses half the physical memory available when
+    // the batch starts. A file estimated above the whole budget still loads, alone.
+    int64 MemoryBudgetBytes = 0;
+};
+
+struct FGaussianSplatImportResult
+{
+    FString FilePath;
+    bool bSucceeded = false;
+    FString Error;
+    int32 NumSplats = 0;
+    int64 FileBytes = 0;
+    // Peak memory the header probe predicted, which is what admission charged the file
+    int64 EstimatedBytes = 0;
+    // From the start of the batch until the file was admitted, then until it finished loading, OnFileLoaded included
+    double QueuedSeconds = 0.0;
+    double LoadSeconds = 0.0;
+
+    double GetMBPerSecond() const
+    {
+        return LoadSeconds > 0.0 ? double(FileBytes) / (1024.0 * 1024.0) / LoadSeconds : 0.0;
+    }
+
+    double GetSplatsPerSecond() const
+    {
+        return LoadSeconds > 0.0 ? double(NumSplats) / LoadSeconds : 0.0;
+    }
+};
+
+/**
+ * Loads many clouds at once through FGaussianSplatDerivedData::LoadPLY, so editor imports also fill the Derived Data
+ * Cache. Every header is probed first to estimate the file's peak memory; files are then admitted largest first
+ * whenever both the in-flight count and the memory budget leave room, falling back to the largest one that fits, and
+ * load on the task graph. The budget only covers loading: splats kept by OnFileLoaded are the caller's to account.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatBatchImport
+{
+public:
+    // Called on a worker thread as each file finishes loading, in completion order. May move the splats out.
+    using FOnFileLoaded = TFunction<void(int32 FileIndex, TArray<FGaussianSplatData> &Splats)>;
+
+    // Blocks until every file is done. Results are in FilePaths order.
+    static TArray<FGaussianSplatImportResult> Run(TConstArrayView<FString> FilePaths,
+                                                  const FGaussianSplatBatchImportSettings &Settings,
+                                                  const FOnFileLoaded &OnFileLoaded = nullptr);
+
+    // Peak bytes LoadPLY needs for a file: PLYs from their header, compact files from their size. 0 with OutError
+    // set when the file cannot be probed.
+    static int64 EstimatePeakBytes(const FString &FilePath, int64 &OutFileBytes, FString &OutError);
+
+    // Splat files in a directory, the lines of a .txt list, or the path itself
+    static void CollectFiles(const FString &Input, TArray<FString> &OutFiles);
+};
@@ -0,0 +1,586 @@
+﻿#include "GaussianSplatBenchmarkCommandlet.h"
+#include "Dom/JsonObject.h"
+#include "GaussianSplatCPUData.h"
+#include "GaussianSplatPacking.h"
+#include "GaussianSplatSequenceFile.h"
+#include "GaussianSplatSequencePlayer.h"
+#include "GaussianSplatSpatialGrid.h"
+#include "GaussianSplatSyntheticData.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "PLYParser.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatBenchmark, Log, All);
+
+namespace GaussianSplatBenchmark
+{
+struct FStageTiming
+{
+    double MinSeconds = 0.0;
+    double MeanSeconds = 0.0;
+};
+
+// "250000", "100k", "50M"
+int64 ParseCount(FString Text)
+{
+    Text.TrimStartAndEndInline();
+    int64 Multiplier = 1;
+    if (Text.EndsWith(TEXT("k")) || Text.EndsWith(TEXT("K")))
+        Multiplier = 1000;
+    else if (Text.EndsWith(TEXT("m")) || Text.EndsWith(TEXT("M")))
+        Multiplier = 1000000;
+    if (Multiplier != 1)
+        Text.LeftChopInline(1);
+    return FCString::Atoi64(*Text) * Multiplier;
+}
+
+TArray<FString> ParseList(const FString &Params, const TCHAR *Key, const TCHAR *Default)
+{
+    FString Value = Default;
+    FParse::Value(*Params, Key, Value, false);
+    TArray<FString> Items;
+    Value.ParseIntoArray(Items, TEXT(","));
+    return Items;
+}
+
+bool ParseFormat(const FString &Name, EPLYFormat &OutFormat)
+{
+    if (Name == TEXT("ascii"))
+        OutFormat = EPLYFormat::ASCII;
+    else if (Name == TEXT("le"))
+        OutFormat = EPLYFormat::BinaryLittleEndian;
+    else if (Name == TEXT("be"))
+        OutFormat = EPLYFormat::BinaryBigEndian;
+    else
+        return false;
+    return true;
+}
+
+FStageTiming TimeStage(int32 Iterations, TFunctionRef<void()> Body)
+{
+    FStageTiming Timing;
+    Timing.MinSeconds = TNumericLimits<double>::Max();
+    double Total = 0.0;
+    for (int32 i = 0; i < Iterations; ++i)
+    {
+        const double Start = FPlatformTime::Seconds();
+        Body();
+        const double Elapsed = FPlatformTime::Seconds() - Start;
+        Timing.MinSeconds = FMath::Min(Timing.MinSeconds, Elapsed);
+        Total += Elapsed;
+    }
+    Timing.MeanSeconds = Total / FMath::Max(Iterations, 1);
+    return Timing;
+}
+
+// Throughput is computed from the best iteration, which is the least disturbed by the rest of the machine
+TSharedRef<FJsonObject> MakeStage(const FString &Name, const FStageTiming &Timing, int64 Bytes, int64 Splats)
+{
+    const double Seconds = FMath::Max(Timing.MinSeconds, UE_DOUBLE_SMALL_NUMBER);
+    TSharedRef<FJsonObject> Stage = MakeShared<FJsonObject>();
+    Stage->SetStringField(TEXT("stage"), Name);
+    Stage->SetNumberField(TEXT("minSeconds"), Timing.MinSeconds);
+    Stage->SetNumberField(TEXT("meanSeconds"), Timing.MeanSeconds);
+    Stage->SetNumberField(TEXT("bytes"), double(Bytes));
+    Stage->SetNumberField(TEXT("mbPerSecond"), double(Bytes) / (1024.0 * 1024.0) / Seconds);
+    Stage->SetNumberField(TEXT("splatsPerSecond"), double(Splats) / Seconds);
+
+    UE_LOG(LogGaussianSplatBenchmark, Display, TEXT("  %-22s %9.4f s | %9.1f MB/s | %8.2f M splats/s"), *Name,
+           Timing.MinSeconds, double(Bytes) / (1024.0 * 1024.0) / Seconds, double(Splats) / Seconds / 1.0e6);
+    return Stage;
+}
+
+TSharedRef<FJsonObject> MakeError(const FString &Name, const FString &Error)
+{
+    TSharedRef<FJsonObject> Stage = MakeShared<FJsonObject>();
+    Stage->SetStringField(TEXT("stage"), Name);
+    Stage->SetStringField(TEXT("error"), Error);
+    UE_LOG(LogGaussianSplatBenchmark, Warning, TEXT("  %-22s FAILED: %s"), *Name, *Error);
+    return Stage;
+}
+
+void AddStage(TArray<TSharedPtr<FJsonValue>> &Stages, const TSharedRef<FJsonObject> &Stage)
+{
+    Stages.Add(MakeShared<FJsonValueObject>(Stage));
+}
+
+void AddMemory(FJsonObject &Object)
+{
+    const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+    Object.SetNumberField(TEXT("usedPhysicalMB"), double(Stats.UsedPhysical) / (1024.0 * 1024.0));
+    // Process lifetime peak, so it only grows across cases; run one count per process for per-size peaks
+    Object.SetNumberField(TEXT("peakUsedPhysicalMB"), double(Stats.PeakUsedPhysical) / (1024.0 * 1024.0));
+}
+
+// GetSplatPosition + GetSplatColor output for one VM lane: XYZ then RGBA
+constexpr int32 VMFloatsPerSplat = 7;
+
+/**
+ * The gathers GetSplatPosition and GetSplatColor did before the planar CPU data: a bounds check and an AoS read
+ * per index, with a scalar SH conversion. Writes plain arrays instead of VM registers.
+ */
+void ReadSplatsAoS(const TArray<FGaussianSplatData> &Splats, const TArray<int32> &Indices, TArray64<float> &Out)
+{
+    float *RESTRICT Dest = Out.GetData();
+    for (const int32 Index : Indices)
+    {
+        if (Splats.IsValidIndex(Index))
+        {
+            const FGaussianSplatData &S = Splats[Index];
+            const FLinearColor Color = FGaussianSplatData::SHToColor(S.ZeroOrderHarmonicsCoefficients);
+            Dest[0] = S.Position.X;
+            Dest[1] = S.Position.Y;
+            Dest[2] = S.Position.Z;
+            Dest[3] = Color.R;
+            Dest[4] = Color.G;
+            Dest[5] = Color.B;
+            Dest[6] = S.Opacity;
+        }
+        else
+        {
+            FMemory::Memzero(Dest, VMFloatsPerSplat * sizeof(float));
+        }
+        Dest += VMFloatsPerSplat;
+    }
+}
+
+/**
+ * The same outputs through the current VM path: 128-index chunks, plane copies for contiguous chunks and clamped
+ * gathers otherwise, SH0 converted 4 lanes at a time. Mirrors GaussianSplatVM in the data interface, which takes
+ * VM registers and so cannot be called from here.
+ */
+void ReadSplatsPlanar(const FGaussianSplatCPUData &Data, const TArray<int32> &Indices, TArray64<float> &Out)
+{
+    constexpr int32 ChunkSize = 128;
+    const int32 Num = Indices.Num();
+    float *RESTRICT Planes[VMFloatsPerSplat];
+    for (int32 Plane = 0; Plane < VMFloatsPerSplat; ++Plane)
+        Planes[Plane] = Out.GetData() + int64(Plane) * Num;
+
+    int32 Chunk[ChunkSize];
+    alignas(16) float SHR[4], SHG[4], SHB[4];
+    for (int32 Done = 0; Done < Num; Done += ChunkSize)
+    {
+        const int32 ChunkNum = FMath::Min(Num - Done, ChunkSize);
+        const int32 First = Indices[Done];
+        bool bContiguous = First >= 0 && First + ChunkNum <= Data.Num();
+        for (int32 i = 0; i < ChunkNum; ++i)
+        {
+            Chunk[i] = Data.ClampIndex(Indices[Done + i]);
+            bContiguous &= Indices[Done + i] == First + i;
+        }
+
+        const TArray<float> *Sources[] = {&Data.PositionX, &Data.PositionY, &Data.PositionZ};
+        for (int32 Plane = 0; Plane < 3; ++Plane)
+        {
+            const float *Src = Sources[Plane]->GetData();
+            if (bContiguous)
+            {
+                FMemory::Memcpy(Planes[Plane] + Done, Src + First, ChunkNum * sizeof(float));
+            }
+            else
+            {
+                for (int32 i = 0; i < ChunkNum; ++i)
+                    Planes[Plane][Done + i] = Src[Chunk[i]];
+            }
+        }
+
+        for (int32 Base = 0; Base < ChunkNum; Base += 4)
+        {
+            const int32 NumLanes = FMath::Min(4, ChunkNum - Base);
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                const int32 Index = Lane < NumLanes ? Chunk[Base + Lane] : Data.Num();
+                SHR[Lane] = Data.SHZeroR.GetData()[Index];
+                SHG[Lane] = Data.SHZeroG.GetData()[Index];
+                SHB[Lane] = Data.SHZeroB.GetData()[Index];
+            }
+            alignas(16) float R[4], G[4], B[4];
+            FGaussianSplatCPUData::SHToColor4(SHR, SHG, SHB, FLinearColor::White, R, G, B);
+            for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+            {
+                Planes[3][Done + Base + Lane] = R[Lane];
+                Planes[4][Done + Base + Lane] = G[Lane];
+                Planes[5][Done + Base + Lane] = B[Lane];
+                Planes[6][Done + Base + Lane] = Data.Opacity.GetData()[Chunk[Base + Lane]];
+            }
+        }
+    }
+}
+} // namespace GaussianSplatBenchmark
+
+UGaussianSplatBenchmarkCommandlet::UGaussianSplatBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UGaussianSplatBenchmarkCommandlet::Main(const FString &Params)
+{
+    using namespace GaussianSplatBenchmark;
+
+    TArray<int64> Counts;
+    for (const FString &Item : ParseList(Params, TEXT("Counts="), TEXT("100k,1M")))
+        Counts.Add(FMath::Max<int64>(ParseCount(Item), 1));
+    TArray<int32> SHDegrees;
+    for (const FString &Item : ParseList(Params, TEXT("SHDegrees="), TEXT("0,3")))
+        SHDegrees.Add(FMath::Clamp(FCString::Atoi(*Item), 0, 3));
+    TArray<FString> FormatNames = ParseList(Params, TEXT("Formats="), TEXT("ascii,le,be"));
+
+    int32 Iterations = 3;
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    Iterations = FMath::Max(Iterations, 1);
+    // ASCII files are ~3x the binary size and parse an order of magnitude slower; skip the sizes that take hours
+    FString MaxAsciiText = TEXT("2M");
+    FParse::Value(*Params, TEXT("MaxAsciiSplats="), MaxAsciiText);
+    const int64 MaxAsciiSplats = ParseCount(MaxAsciiText);
+    int32 SequenceFrames = 30;
+    FParse::Value(*Params, TEXT("SequenceFrames="), SequenceFrames);
+    FString MaxSequenceText = TEXT("1M");
+    FParse::Value(*Params, TEXT("MaxSequenceSplats="), MaxSequenceText);
+    const int64 MaxSequenceSplats = ParseCount(MaxSequenceText);
+    const bool bKeepFiles = FParse::Param(*Params, TEXT("KeepFiles"));
+
+    FString TempDir = FPaths::ProjectSavedDir() / TEXT("GaussianSplatBenchmark");
+    FParse::Value(*Params, TEXT("TempDir="), TempDir);
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("GaussianSplatBenchmark.json");
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    IFileManager::Get().MakeDirectory(*TempDir, true);
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("platform"), FPlatformProperties::PlatformName());
+    Root->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    Root->SetNumberField(TEXT("logicalCores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+    Root->SetNumberField(TEXT("iterations"), Iterations);
+    TArray<TSharedPtr<FJsonValue>> Cases;
+
+    int32 NumErrors = 0;
+    for (const int64 Count : Counts)
+    {
+        for (const int32 SHDegree : SHDegrees)
+        {
+            UE_LOG(LogGaussianSplatBenchmark, Display, TEXT("%lld splats, SH degree %d"), Count, SHDegree);
+            TSharedRef<FJsonObject> Case = MakeShared<FJsonObject>();
+            Case->SetNumberField(TEXT("splats"), double(Count));
+            Case->SetNumberField(TEXT("shDegree"), SHDegree);
+            TArray<TSharedPtr<FJsonValue>> Stages;
+
+            FGaussianSplatSyntheticSettings Settings;
+            Settings.NumSplats = Count;
+            Settings.SHDegree = SHDegree;
+
+            // Parse, per file encoding. The parser's offsets are 32-bit, so files past 2 GB show up as errors here.
+            for (const FString &FormatName : FormatNames)
+            {
+                const FString StageName = FString::Printf(TEXT("parse_%s"), *FormatName);
+                if (!ParseFormat(FormatName, Settings.Format))
+                {
+                    AddStage(Stages, MakeError(StageName, TEXT("unknown format")));
+                    ++NumErrors;
+                    continue;
+                }
+                if (Settings.Format == EPLYFormat::ASCII && Count > MaxAsciiSplats)
+                    continue;
+
+                const FString FilePath =
+                    TempDir / FString::Printf(TEXT("synthetic_%lld_sh%d_%s.ply"), Count, SHDegree, *FormatName);
+                FString Error;
+                const double WriteStart = FPlatformTime::Seconds();
+                if (!FGaussianSplatSyntheticData::WritePLY(FilePath, Settings, Error))
+                {
+                    AddStage(Stages, MakeError(StageName, Error));
+                    ++NumErrors;
+                    continue;
+                }
+                FStageTiming WriteTiming;
+                WriteTiming.MinSeconds = WriteTiming.MeanSeconds = FPlatformTime::Seconds() - WriteStart;
+                const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+                const FString GenerateName = FString::Printf(TEXT("generate_%s"), *FormatName);
+                AddStage(Stages, MakeStage(GenerateName, WriteTiming, FileSize, Count));
+
+                bool bParsed = true;
+                const FStageTiming Timing = TimeStage(Iterations,
+                                                      [&]()
+                                                      {
+                                                          if (!bParsed)
+                                                              return;
+                                                          FPLYParser Parser;
+                                                          TArray<FGaussianSplatData> Parsed;
+                                                          bParsed = Parser.ParseFile(FilePath, Parsed);
+                                                          if (!bParsed)
+                                                              Error = Parser.GetErrorMessage();
+                                                      });
+                if (bParsed)
+                {
+                    AddStage(Stages, MakeStage(StageName, Timing, FileSize, Count));
+                }
+                else
+                {
+                    AddStage(Stages, MakeError(StageName, Error));
+                    ++NumErrors;
+                }
+
+                if (!bKeepFiles)
+                    IFileManager::Get().Delete(*FilePath);
+            }
+
+            // The stages after the parser do not depend on the file encoding
+            TArray<FGaussianSplatData> Splats;
+            {
+                TArray64<float> RawValues;
+                FGaussianSplatSyntheticData::MakeRawProperties(Settings, RawValues);
+                const FStageTiming Timing = TimeStage(
+                    Iterations,
+                    [&]() { FGaussianSplatSyntheticData::ConvertRawProperties(RawValues, SHDegree, Splats); });
+                AddStage(Stages, MakeStage(TEXT("convert"), Timing, RawValues.Num() * sizeof(float), Count));
+            }
+
+            // CPU packing cost per buffer layout only. The GPU read side of each layout is not measured here: the
+            // commandlet runs without a renderer.
+            const int64 RecordBytes = int64(Splats.Num()) * sizeof(FGaussianSplatPackedRecord);
+            {
+                TArray<FGaussianSplatPackedRecord> Records;
+                const FStageTiming Timing =
+                    TimeStage(Iterations, [&]() { FGaussianSplatPacking::PackRecords(Splats, Records); });
+                AddStage(Stages, MakeStage(TEXT("cpu_pack_interleaved"), Timing, RecordBytes, Count));
+            }
+            {
+                // What an instance init does for the separate-streams layout, minus the RHI copies
+                TArray<FGaussianSplatPackedRecord> Records;
+                FGaussianSplatStreams Streams;
+                const FStageTiming Timing = TimeStage(Iterations,
+                                                      [&]()
+                                                      {
+                                                          FGaussianSplatPacking::PackRecords(Splats, Records);
+                                                          FGaussianSplatPacking::SplitRecords(Records, Streams);
+                                                      });
+                AddStage(Stages, MakeStage(TEXT("cpu_pack_separate"), Timing, RecordBytes, Count));
+            }
+            {
+                FGaussianSplatCPUData CPUData;
+                const FStageTiming Timing = TimeStage(Iterations, [&]() { CPUData.Build(Splats); });
+                const int64 PlanarBytes = int64(CPUData.PositionX.Num()) * 14 * sizeof(float);
+                AddStage(Stages, MakeStage(TEXT("cpu_planar_build"), Timing, PlanarBytes, Count));
+
+                // Position + colour reads for every splat, as a spawn script reading ExecIndex does, then the same
+                // indices shuffled, as a script sampling random splats does. Both paths read the same cloud.
+                TArray<int32> Indices;
+                Indices.SetNumUninitialized(Splats.Num());
+                for (int32 i = 0; i < Indices.Num(); ++i)
+                    Indices[i] = i;
+                TArray64<float> Out;
+                Out.SetNumUninitialized(int64(Indices.Num()) * VMFloatsPerSplat);
+                const int64 OutBytes = int64(Out.Num()) * sizeof(float);
+
+                for (const TCHAR *Order : {TEXT("seq"), TEXT("random")})
+                {
+                    if (FCString::Strcmp(Order, TEXT("random")) == 0)
+                    {
+                        FRandomStream Random(0x5EED);
+                        for (int32 i = Indices.Num() - 1; i > 0; --i)
+                            Indices.Swap(i, Random.RandHelper(i + 1));
+                    }
+                    const FStageTiming AoSTiming =
+                        TimeStage(Iterations, [&]() { ReadSplatsAoS(Splats, Indices, Out); });
+                    AddStage(Stages, MakeStage(FString::Printf(TEXT("vm_read_aos_%s"), Order), AoSTiming, OutBytes,
+                                               Count));
+                    const FStageTiming PlanarTiming =
+                        TimeStage(Iterations, [&]() { ReadSplatsPlanar(CPUData, Indices, Out); });
+                    AddStage(Stages, MakeStage(FString::Printf(TEXT("vm_read_planar_%s"), Order), PlanarTiming,
+                                               OutBytes, Count));
+                }
+            }
+            {
+                // Query stages report queries per second in splatsPerSecond. Queries are centred on random splats
+                // so they land where the cloud is dense, with a radius of about two cells.
+                FGaussianSplatSpatialGrid Grid;
+                const FStageTiming BuildTiming = TimeStage(Iterations, [&]() { Grid.Build(Splats); });
+                AddStage(Stages, MakeStage(TEXT("spatial_grid_build"), BuildTiming, Grid.GetAllocatedSize(), Count));
+
+                constexpr int32 NumQueries = 65536;
+                constexpr int32 MaxResults = 64;
+                FRandomStream Random(0x5EED);
+                TArray<FVector3f> Queries;
+                Queries.SetNumUninitialized(NumQueries);
+                for (FVector3f &Query : Queries)
+                    Query = Splats[Random.RandHelper(Splats.Num())].Position;
+                const float Radius = 2.0f * Grid.CellSize;
+
+                int64 Hits = 0;
+                auto RadiusQueries = [&]()
+                {
+                    Hits = 0;
+                    for (const FVector3f &Query : Queries)
+                        Hits += Grid.CountInRadius(Query, Radius, MaxResults);
+                };
+                const FStageTiming RadiusTiming = TimeStage(Iterations, RadiusQueries);
+                TSharedRef<FJsonObject> RadiusStage =
+                    MakeStage(TEXT("spatial_radius_query"), RadiusTiming, 0, NumQueries);
+                RadiusStage->SetNumberField(TEXT("meanHits"), double(Hits) / NumQueries);
+                AddStage(Stages, RadiusStage);
+
+                // Offset from the splats so the nearest one is not the query itself
+                for (FVector3f &Query : Queries)
+                    Query += FVector3f(Random.GetUnitVector()) * Grid.CellSize;
+                double DistanceSum = 0.0;
+                auto NearestQueries = [&]()
+                {
+                    DistanceSum = 0.0;
+                    for (const FVector3f &Query : Queries)
+                    {
+                        float Distance = 0.0f;
+                        Grid.FindNearest(Query, 0.0f, &Distance);
+                        DistanceSum += Distance;
+                    }
+                };
+                const FStageTiming NearestTiming = TimeStage(Iterations, NearestQueries);
+                TSharedRef<FJsonObject> NearestStage =
+                    MakeStage(TEXT("spatial_nearest_query"), NearestTiming, 0, NumQueries);
+                NearestStage->SetNumberField(TEXT("meanDistance"), DistanceSum / NumQueries);
+                AddStage(Stages, NearestStage);
+            }
+            Splats.Empty();
+
+            Case->SetArrayField(TEXT("stages"), Stages);
+            AddMemory(*Case);
+            Cases.Add(MakeShared<FJsonValueObject>(Case));
+        }
+    }
+    Root->SetArrayField(TEXT("cases"), Cases);
+
+    // Sequences store packed records only, so SH degree does not matter; one run per count
+    TArray<TSharedPtr<FJsonValue>> Sequences;
+    for (const int64 Count : Counts)
+    {
+        if (SequenceFrames <= 0 || Count > MaxSequenceSplats)
+            continue;
+
+        UE_LOG(LogGaussianSplatBenchmark, Display, TEXT("Sequence: %d frames of %lld splats"), SequenceFrames, Count);
+        TSharedRef<FJsonObject> Sequence = MakeShared<FJsonObject>();
+        Sequence->SetNumberField(TEXT("splats"), double(Count));
+        Sequence->SetNumberField(TEXT("frames"), SequenceFrames);
+        TArray<TSharedPtr<FJsonValue>> Stages;
+
+        // Independent random frames are the worst case for the XOR delta, so decode rates here are a lower bound
+        TArray<FString> FrameFiles;
+        FString Error;
+        for (int32 Frame = 0; Frame < SequenceFrames && Error.IsEmpty(); ++Frame)
+        {
+            FGaussianSplatSyntheticSettings Settings;
+            Settings.NumSplats = Count;
+            Settings.Seed += Frame;
+            const FString FramePath = TempDir / FString::Printf(TEXT("sequence_%lld_%04d.ply"), Count, Frame);
+            if (FGaussianSplatSyntheticData::WritePLY(FramePath, Settings, Error))
+                FrameFiles.Add(FramePath);
+        }
+
+        const FString SequencePath = TempDir / FString::Printf(TEXT("sequence_%lld.gsseq"), Count);
+        const int64 RawBytes = int64(SequenceFrames) * Count * sizeof(FGaussianSplatPackedRecord);
+        bool bEncoded = Error.IsEmpty();
+        if (bEncoded)
+        {
+            // Includes parsing every frame PLY, which is how BuildSequenceFromPLYs is used
+            const FStageTiming Timing = TimeStage(1,
+                                                  [&]()
+                                                  {
+                                                      bEncoded = FGaussianSplatSequenceFile::Write(
+                                                          SequencePath, FrameFiles, 30.0f,
+                                                          FGaussianSplatSequenceFile::DefaultKeyframeInterval, Error);
+                                                  });
+            if (bEncoded)
+            {
+                AddStage(Stages, MakeStage(TEXT("sequence_encode"), Timing, RawBytes, int64(SequenceFrames) * Count));
+                Sequence->SetNumberField(TEXT("storedBytes"), double(IFileManager::Get().FileSize(*SequencePath)));
+            }
+        }
+        if (!bEncoded)
+        {
+            AddStage(Stages, MakeError(TEXT("sequence_encode"), Error));
+            ++NumErrors;
+        }
+
+        for (int32 i = 0; i < Iterations && bEncoded; ++i)
+        {
+            FGaussianSplatSequencePlayer Player;
+            FGaussianSplatSequenceSettings PlayerSettings;
+            PlayerSettings.bLoop = false;
+            if (!Player.Open(SequencePath, PlayerSettings, Error))
+            {
+                AddStage(Stages, MakeError(TEXT("sequence_decode"), Error));
+                ++NumErrors;
+                break;
+            }
+
+            // Advance the playhead as soon as each frame is ready, i.e. play as fast as the decoder allows
+            bool bDecodeFailed = false;
+            const FStageTiming Timing = TimeStage(1,
+                                                  [&]()
+                                                  {
+                                                      for (int64 Frame = 0; Frame < Player.GetNumFrames(); ++Frame)
+                                                      {
+                                                          while (true)
+                                                          {
+                                                              const FGaussianSplatSequenceFrameRef Ready =
+                                                                  Player.Update(Frame);
+                                                              if (Ready && Ready->PlayFrame == Frame)
+                                                                  break;
+                                                              if (Player.GetStats().DecodeErrors > 0)
+                                                              {
+                                                                  bDecodeFailed = true;
+                                                                  return;
+                                                              }
+                                                              FPlatformProcess::SleepNoStats(0.0f);
+                                                          }
+                                                      }
+                                                  });
+            if (bDecodeFailed)
+            {
+                AddStage(Stages, MakeError(TEXT("sequence_decode"), TEXT("frame decode failed")));
+                ++NumErrors;
+                break;
+            }
+            // Only the last iteration is reported; earlier ones warm the file cache
+            if (i == Iterations - 1)
+            {
+                TSharedRef<FJsonObject> Stage =
+                    MakeStage(TEXT("sequence_decode"), Timing, RawBytes, int64(SequenceFrames) * Count);
+                Stage->SetNumberField(TEXT("framesPerSecond"),
+                                      SequenceFrames / FMath::Max(Timing.MinSeconds, UE_DOUBLE_SMALL_NUMBER));
+                Stage->SetNumberField(TEXT("storedBytesRead"), double(Player.GetStats().BytesRead));
+                AddStage(Stages, Stage);
+            }
+        }
+
+        if (!bKeepFiles)
+        {
+            for (const FString &FramePath : FrameFiles)
+                IFileManager::Get().Delete(*FramePath);
+            IFileManager::Get().Delete(*SequencePath);
+        }
+
+        Sequence->SetArrayField(TEXT("stages"), Stages);
+        AddMemory(*Sequence);
+        Sequences.Add(MakeShared<FJsonValueObject>(Sequence));
+    }
+    Root->SetArrayField(TEXT("sequences"), Sequences);
+    AddMemory(*Root);
+    Root->SetNumberField(TEXT("errors"), NumErrors);
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+    if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+    {
+        UE_LOG(LogGaussianSplatBenchmark, Error, TEXT("Failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogGaussianSplatBenchmark, Display, TEXT("Wrote %s (%d errors)"), *OutputPath, NumErrors);
+    return NumErrors > 0 ? 1 : 0;
+}
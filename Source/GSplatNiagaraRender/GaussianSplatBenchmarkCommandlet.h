@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "GaussianSplatBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless timing of the CPU side of the splat pipeline on synthetic clouds: PLY parse, attribute conversion,
+ * CPU record packing for both buffer layouts (GPU reads are not timed), the planar CPU VM build, CPU VM
+ * position/colour reads through the planar path against the old per-splat AoS path, the spatial grid build with its
+ * radius and nearest-splat query throughput, and sequence decode. Results go to a JSON file so runs can be diffed
+ * across changes.
+ *
+ * UnrealEditor-Cmd <Project> -run=GaussianSplatBenchmark [-Counts=100k,1M] [-SHDegrees=0,3] [-Formats=ascii,le,be]
+ *     [-Iterations=3] [-MaxAsciiSplats=2M] [-SequenceFrames=30] [-MaxSequenceSplats=1M] [-TempDir=<dir>]
+ *     [-Output=<file.json>] [-KeepFiles]
+ */
+UCLASS()
+class UGaussianSplatBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGaussianSplatBenchmarkCommandlet();
+
+    virtual int32 Main(const FString &Params) override;
+};
@@ -0,0 +1,219 @@
+﻿#include "GaussianSplatBudgetSubsystem.h"
+#include "Engine/Engine.h"
+#include "GaussianSplatNiagaraDataInterface.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatBudget, Log, All);
+
+static int32 GGaussianSplatBudgetCPUMB = 0;
+static FAutoConsoleVariableRef CVarGaussianSplatBudgetCPUMB(
+    TEXT("gsplat.Budget.CPUMB"), GGaussianSplatBudgetCPUMB,
+    TEXT("Game thread memory budget for all splat clouds, in MB (0 = unlimited)."), ECVF_Scalability);
+
+static int32 GGaussianSplatBudgetGPUMB = 0;
+static FAutoConsoleVariableRef CVarGaussianSplatBudgetGPUMB(
+    TEXT("gsplat.Budget.GPUMB"), GGaussianSplatBudgetGPUMB,
+    TEXT("GPU memory budget for all splat clouds, in MB (0 = unlimited)."), ECVF_Scalability);
+
+static int32 GGaussianSplatBudgetMaxLevel = 3;
+static FAutoConsoleVariableRef CVarGaussianSplatBudgetMaxLevel(
+    TEXT("gsplat.Budget.MaxLevel"), GGaussianSplatBudgetMaxLevel,
+    TEXT("Coarsest detail level the budget may select; level N keeps one splat in 2^N."), ECVF_Scalability);
+
+static float GGaussianSplatBudgetInterval = 0.5f;
+static FAutoConsoleVariableRef CVarGaussianSplatBudgetInterval(
+    TEXT("gsplat.Budget.Interval"), GGaussianSplatBudgetInterval,
+    TEXT("Seconds between budget evaluations."), ECVF_Default);
+
+static float GGaussianSplatBudgetHysteresis = 0.1f;
+static FAutoConsoleVariableRef CVarGaussianSplatBudgetHysteresis(
+    TEXT("gsplat.Budget.Hysteresis"), GGaussianSplatBudgetHysteresis,
+    TEXT("Fraction of the budget that must stay free before a cloud gets detail back."), ECVF_Default);
+
+static FAutoConsoleCommand GGaussianSplatBudgetReportCommand(
+    TEXT("gsplat.Budget.Report"), TEXT("Prints splat memory per cloud against the budgets."),
+    FConsoleCommandDelegate::CreateLambda(
+        []()
+        {
+            if (UGaussianSplatBudgetSubsystem *Budget = UGaussianSplatBudgetSubsystem::Get())
+            {
+                Budget->Evaluate();
+                Budget->DumpReport();
+            }
+        }));
+
+namespace GaussianSplatBudget
+{
+constexpr int64 BytesPerMB = 1024 * 1024;
+
+double ToMB(int64 Bytes)
+{
+    return double(Bytes) / BytesPerMB;
+}
+
+bool IsOver(int64 CPUBytes, int64 GPUBytes, int64 CPUBudget, int64 GPUBudget)
+{
+    return (CPUBudget > 0 && CPUBytes > CPUBudget) || (GPUBudget > 0 && GPUBytes > GPUBudget);
+}
+} // namespace GaussianSplatBudget
+
+UGaussianSplatBudgetSubsystem *UGaussianSplatBudgetSubsystem::Get()
+{
+    return GEngine ? GEngine->GetEngineSubsystem<UGaussianSplatBudgetSubsystem>() : nullptr;
+}
+
+void UGaussianSplatBudgetSubsystem::Initialize(FSubsystemCollectionBase &Collection)
+{
+    Super::Initialize(Collection);
+    TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UGaussianSplatBudgetSubsystem::Tick));
+}
+
+void UGaussianSplatBudgetSubsystem::Deinitialize()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+    Clouds.Reset();
+    LastEntries.Reset();
+    Super::Deinitialize();
+}
+
+void UGaussianSplatBudgetSubsystem::Register(UGaussianSplatNiagaraDataInterface *NDI)
+{
+    check(IsInGameThread());
+    Clouds.AddUnique(NDI);
+}
+
+void UGaussianSplatBudgetSubsystem::Unregister(UGaussianSplatNiagaraDataInterface *NDI)
+{
+    check(IsInGameThread());
+    Clouds.Remove(NDI);
+}
+
+bool UGaussianSplatBudgetSubsystem::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastEvaluateTime >= GGaussianSplatBudgetInterval)
+    {
+        LastEvaluateTime = Now;
+        Evaluate();
+    }
+    return true;
+}
+
+void UGaussianSplatBudgetSubsystem::Plan(TArray<FGaussianSplatBudgetEntry> &Entries, int64 CPUBudget,
+                                         int64 GPUBudget, int32 MaxLevel, TArray<int32> &OutLevels)
+{
+    using namespace GaussianSplatBudget;
+
+    // Memory at full detail, assuming it halves with each level like the splat count
+    TArray<int64> FullCPU, FullGPU;
+    int64 CPUBytes = 0;
+    int64 GPUBytes = 0;
+    TArray<int32> Order;
+    OutLevels.SetNumZeroed(Entries.Num());
+    for (int32 i = 0; i < Entries.Num(); ++i)
+    {
+        const FGaussianSplatBudgetEntry &Entry = Entries[i];
+        const int32 Shift = Entry.bDegradable ? Entry.Level : 0;
+        FullCPU.Add(Entry.CPUBytes << Shift);
+        FullGPU.Add(Entry.GPUBytes << Shift);
+        CPUBytes += FullCPU.Last();
+        GPUBytes += FullGPU.Last();
+        if (Entry.bDegradable)
+            Order.Add(i);
+    }
+
+    // Cheapest to lose first: low priority, then far away
+    Order.Sort(
+        [&Entries](int32 A, int32 B)
+        {
+            if (Entries[A].Priority != Entries[B].Priority)
+                return Entries[A].Priority < Entries[B].Priority;
+            return Entries[A].ViewDistance > Entries[B].ViewDistance;
+        });
+
+    // One level at a time across all clouds, so no cloud drops two levels while a cheaper one still has detail
+    for (int32 Level = 1; Level <= MaxLevel; ++Level)
+    {
+        for (const int32 i : Order)
+        {
+            if (!IsOver(CPUBytes, GPUBytes, CPUBudget, GPUBudget))
+                return;
+            CPUBytes -= (FullCPU[i] >> (Level - 1)) - (FullCPU[i] >> Level);
+            GPUBytes -= (FullGPU[i] >> (Level - 1)) - (FullGPU[i] >> Level);
+            OutLevels[i] = Level;
+        }
+    }
+}
+
+void UGaussianSplatBudgetSubsystem::Evaluate()
+{
+    using namespace GaussianSplatBudget;
+
+    Clouds.RemoveAll([](const TWeakObjectPtr<UGaussianSplatNiagaraDataInterface> &NDI) { return !NDI.IsValid(); });
+
+    TArray<FGaussianSplatBudgetEntry> Entries;
+    Entries.Reserve(Clouds.Num());
+    for (const TWeakObjectPtr<UGaussianSplatNiagaraDataInterface> &WeakNDI : Clouds)
+    {
+        const UGaussianSplatNiagaraDataInterface *NDI = WeakNDI.Get();
+        FGaussianSplatBudgetEntry &Entry = Entries.AddDefaulted_GetRef();
+        Entry.NDI = WeakNDI;
+        Entry.CPUBytes = NDI->GetCPUMemoryBytes();
+        Entry.GPUBytes = NDI->GetGPUMemoryBytes();
+        Entry.Priority = NDI->BudgetPriority;
+        Entry.ViewDistance = NDI->GetBudgetViewDistance();
+        Entry.Level = NDI->GetBudgetLevel();
+        Entry.bDegradable = NDI->CanChangeBudgetLevel();
+    }
+
+    const int64 CPUBudget = int64(FMath::Max(GGaussianSplatBudgetCPUMB, 0)) * BytesPerMB;
+    const int64 GPUBudget = int64(FMath::Max(GGaussianSplatBudgetGPUMB, 0)) * BytesPerMB;
+    const int32 MaxLevel = FMath::Clamp(GGaussianSplatBudgetMaxLevel, 0, 8);
+    const double Slack = 1.0 - FMath::Clamp(GGaussianSplatBudgetHysteresis, 0.0f, 0.9f);
+
+    // Degrading follows the budget; restoring detail has to fit the tighter one
+    TArray<int32> Levels, TightLevels;
+    Plan(Entries, CPUBudget, GPUBudget, MaxLevel, Levels);
+    Plan(Entries, int64(CPUBudget * Slack), int64(GPUBudget * Slack), MaxLevel, TightLevels);
+
+    for (int32 i = 0; i < Entries.Num(); ++i)
+    {
+        FGaussianSplatBudgetEntry &Entry = Entries[i];
+        Entry.PlannedLevel = Levels[i] >= Entry.Level ? Levels[i] : FMath::Min(Entry.Level, TightLevels[i]);
+        if (!Entry.bDegradable || Entry.PlannedLevel == Entry.Level)
+            continue;
+
+        UGaussianSplatNiagaraDataInterface *NDI = Entry.NDI.Get();
+        UE_LOG(LogGaussianSplatBudget, Log, TEXT("%s | level %d -> %d | priority %d | %.0f cm"), *NDI->GetPathName(),
+               Entry.Level, Entry.PlannedLevel, Entry.Priority, Entry.ViewDistance);
+        NDI->SetBudgetLevel(Entry.PlannedLevel);
+    }
+    LastEntries = MoveTemp(Entries);
+}
+
+void UGaussianSplatBudgetSubsystem::DumpReport() const
+{
+    using namespace GaussianSplatBudget;
+
+    int64 CPUBytes = 0;
+    int64 GPUBytes = 0;
+    for (const FGaussianSplatBudgetEntry &Entry : LastEntries)
+    {
+        CPUBytes += Entry.CPUBytes;
+        GPUBytes += Entry.GPUBytes;
+    }
+    UE_LOG(LogGaussianSplatBudget, Display, TEXT("Splat budget: %d clouds | CPU %.1f / %d MB | GPU %.1f / %d MB"),
+           LastEntries.Num(), ToMB(CPUBytes), GGaussianSplatBudgetCPUMB, ToMB(GPUBytes), GGaussianSplatBudgetGPUMB);
+
+    // Measured before the plan was applied, so a cloud that just changed level still shows its old memory
+    for (const FGaussianSplatBudgetEntry &Entry : LastEntries)
+    {
+        const UGaussianSplatNiagaraDataInterface *NDI = Entry.NDI.Get();
+        UE_LOG(LogGaussianSplatBudget, Display,
+               TEXT("  %-60s | CPU %8.1f MB | GPU %8.1f MB | priority %3d | %10.0f cm | level %d -> %d%s"),
+               NDI ? *NDI->GetPathName() : TEXT("<destroyed>"), ToMB(Entry.CPUBytes), ToMB(Entry.GPUBytes),
+               Entry.Priority, Entry.ViewDistance, Entry.Level, Entry.PlannedLevel,
+               Entry.bDegradable ? TEXT("") : TEXT(" (fixed)"));
+    }
+}
@@ -0,0 +1,63 @@
+﻿#pragma once
+
+#include "Containers/Ticker.h"
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "GaussianSplatBudgetSubsystem.generated.h"
+
+class UGaussianSplatNiagaraDataInterface;
+
+// One row of the budget report
+struct FGaussianSplatBudgetEntry
+{
+    TWeakObjectPtr<UGaussianSplatNiagaraDataInterface> NDI;
+    int64 CPUBytes = 0;
+    int64 GPUBytes = 0;
+    int32 Priority = 0;
+    float ViewDistance = 0.0f;
+    int32 Level = 0;
+    int32 PlannedLevel = 0;
+    // Streaming and sequence NDIs have budgets of their own and are only counted
+    bool bDegradable = false;
+};
+
+/**
+ * Keeps the splat clouds of every live NDI within the CPU and GPU budgets set by gsplat.Budget.CPUMB and
+ * gsplat.Budget.GPUMB (scalability cvars, so device profiles and scalability groups can set them). Over budget,
+ * clouds are moved to coarser detail levels, each of which keeps every other splat of the one before, starting with
+ * the lowest BudgetPriority and, within a priority, the furthest from the camera. Detail comes back once the plan
+ * fits with gsplat.Budget.Hysteresis to spare. Plans are made every gsplat.Budget.Interval seconds; the last one is
+ * printed by gsplat.Budget.Report.
+ */
+UCLASS()
+class GSPLATNIAGARARENDER_API UGaussianSplatBudgetSubsystem : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UGaussianSplatBudgetSubsystem *Get();
+
+    virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+    virtual void Deinitialize() override;
+
+    void Register(UGaussianSplatNiagaraDataInterface *NDI);
+    void Unregister(UGaussianSplatNiagaraDataInterface *NDI);
+
+    // Measures every cloud, plans detail levels against the budgets and applies them
+    void Evaluate();
+
+    void DumpReport() const;
+
+private:
+    bool Tick(float DeltaTime);
+
+    // Lowest detail levels that bring the totals under the given budgets (0 = unlimited)
+    static void Plan(TArray<FGaussianSplatBudgetEntry> &Entries, int64 CPUBudget, int64 GPUBudget, int32 MaxLevel,
+                     TArray<int32> &OutLevels);
+
+    TArray<TWeakObjectPtr<UGaussianSplatNiagaraDataInterface>> Clouds;
+    // As measured by the last Evaluate
+    TArray<FGaussianSplatBudgetEntry> LastEntries;
+    FTSTicker::FDelegateHandle TickHandle;
+    double LastEvaluateTime = 0.0;
+};
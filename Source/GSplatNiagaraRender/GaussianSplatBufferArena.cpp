@@ -0,0 +1,426 @@
+﻿#include "GaussianSplatBufferArena.h"
+#include "GaussianSplatStats.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatArena, Log, All);
+
+static int32 GGaussianSplatArenaMinElements = 64 * 1024;
+static FAutoConsoleVariableRef CVarGaussianSplatArenaMinElements(
+    TEXT("gsplat.Arena.MinElements"), GGaussianSplatArenaMinElements,
+    TEXT("Smallest capacity, in splats, a splat buffer arena is created with."), ECVF_Default);
+
+static float GGaussianSplatArenaDefragThreshold = 0.5f;
+static FAutoConsoleVariableRef CVarGaussianSplatArenaDefragThreshold(
+    TEXT("gsplat.Arena.DefragThreshold"), GGaussianSplatArenaDefragThreshold,
+    TEXT("Fragmentation ratio (1 - largest free range / total free) above which an arena compacts itself."),
+    ECVF_Default);
+
+static int32 GGaussianSplatArenaDefragIntervalFrames = 30;
+static FAutoConsoleVariableRef CVarGaussianSplatArenaDefragIntervalFrames(
+    TEXT("gsplat.Arena.DefragIntervalFrames"), GGaussianSplatArenaDefragIntervalFrames,
+    TEXT("Minimum frames between threshold-triggered compactions of one arena, so a burst of frees compacts once. "
+         "An allocation that only fits after compacting is never delayed."),
+    ECVF_Default);
+
+static int32 GGaussianSplatArenaReleaseWhenEmpty = 0;
+static FAutoConsoleVariableRef CVarGaussianSplatArenaReleaseWhenEmpty(
+    TEXT("gsplat.Arena.ReleaseWhenEmpty"), GGaussianSplatArenaReleaseWhenEmpty,
+    TEXT("1 frees an arena's buffers as soon as its last range is freed. 0 (default) keeps the capacity, so pooled "
+         "components that deactivate and reactivate do not recreate the buffers every cycle."),
+    ECVF_Default);
+
+namespace GaussianSplatArena
+{
+// Process-wide totals; gauges are maintained as deltas from each arena's own stats
+std::atomic<int64> GCapacityElements{0};
+std::atomic<int64> GAllocatedElements{0};
+std::atomic<int64> GLiveAllocations{0};
+std::atomic<int64> GFreeRanges{0};
+std::atomic<int64> GTotalAllocations{0};
+std::atomic<int64> GTotalFrees{0};
+std::atomic<int64> GTotalGrows{0};
+std::atomic<int64> GTotalDefrags{0};
+
+const TCHAR *StreamDebugNames[FGaussianSplatBufferArena::Stream_Count] = {
+    TEXT("GSplat_Arena_Positions"), TEXT("GSplat_Arena_Scales"), TEXT("GSplat_Arena_Orientations"),
+    TEXT("GSplat_Arena_SHOpacity")};
+const TCHAR *RecordsDebugName = TEXT("GSplat_Arena_Records");
+
+// Largest piece of a range moved through the bounce buffer at once, which bounds the buffer's size
+constexpr uint32 DefragChunkElements = 1024 * 1024;
+} // namespace GaussianSplatArena
+
+static FAutoConsoleCommand GGaussianSplatArenaStatsCommand(
+    TEXT("gsplat.Arena.Stats"), TEXT("Prints allocation and fragmentation counters for all splat buffer arenas."),
+    FConsoleCommandDelegate::CreateLambda(
+        []()
+        {
+            const FGaussianSplatArenaStats Stats = FGaussianSplatBufferArena::GetGlobalStats();
+            UE_LOG(LogGaussianSplatArena, Display,
+                   TEXT("Arenas: Capacity=%lld splats (%.1f MB) | Allocated=%lld | Live=%d | FreeRanges=%d"),
+                   Stats.CapacityElements,
+                   double(Stats.CapacityElements * FGaussianSplatBufferArena::BytesPerSplat) / (1024.0 * 1024.0),
+                   Stats.AllocatedElements, Stats.LiveAllocations, Stats.FreeRanges);
+            UE_LOG(LogGaussianSplatArena, Display, TEXT("Arenas: Allocs=%lld | Frees=%lld | Grows=%lld | Defrags=%lld"),
+                   Stats.TotalAllocations, Stats.TotalFrees, Stats.TotalGrows, Stats.TotalDefrags);
+        }));
+
+FGaussianSplatBufferArena::FGaussianSplatBufferArena(EGaussianSplatBufferLayout InLayout)
+    : Layout(InLayout), Capacity(0), LastDefragFrame(0)
+{
+}
+
+FGaussianSplatBufferArena::~FGaussianSplatBufferArena()
+{
+    Release();
+}
+
+FGaussianSplatArenaStats FGaussianSplatBufferArena::GetGlobalStats()
+{
+    using namespace GaussianSplatArena;
+    FGaussianSplatArenaStats Stats;
+    Stats.CapacityElements = GCapacityElements.load();
+    Stats.AllocatedElements = GAllocatedElements.load();
+    Stats.LiveAllocations = int32(GLiveAllocations.load());
+    Stats.FreeRanges = int32(GFreeRanges.load());
+    Stats.TotalAllocations = GTotalAllocations.load();
+    Stats.TotalFrees = GTotalFrees.load();
+    Stats.TotalGrows = GTotalGrows.load();
+    Stats.TotalDefrags = GTotalDefrags.load();
+    return Stats;
+}
+
+bool FGaussianSplatBufferArena::IsValid() const
+{
+    for (int32 i = 0; i < GetNumBuffers(); ++i)
+    {
+        if (!Buffers[i].IsValid() || !SRVs[i].IsValid())
+            return false;
+    }
+    return true;
+}
+
+FRHIShaderResourceView *FGaussianSplatBufferArena::GetSRV(EStream Stream) const
+{
+    check(Layout == EGaussianSplatBufferLayout::SeparateStreams);
+    return SRVs[Stream].GetReference();
+}
+
+FRHIShaderResourceView *FGaussianSplatBufferArena::GetRecordsSRV() const
+{
+    check(Layout == EGaussianSplatBufferLayout::Interleaved);
+    return SRVs[0].GetReference();
+}
+
+void FGaussianSplatBufferArena::Release()
+{
+    for (int32 i = 0; i < Stream_Count; ++i)
+    {
+        Buffers[i].SafeRelease();
+        SRVs[i].SafeRelease();
+    }
+    Capacity = 0;
+    Allocations.Empty();
+    FreeRanges.Empty();
+    UpdateStats();
+}
+
+void FGaussianSplatBufferArena::CreateStreams(FRHICommandListImmediate &RHICmdList, uint32 NumElements,
+                                              FBufferRHIRef *OutBuffers, FShaderResourceViewRHIRef *OutSRVs)
+{
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    check(NumElements <= GetMaxCapacity());
+    // Static, not dynamic: sub-range locks on a dynamic buffer may rename the whole resource
+    const EBufferUsageFlags Usage = BUF_ShaderResource | BUF_Static | BUF_SourceCopy;
+    if (Layout == EGaussianSplatBufferLayout::Interleaved)
+    {
+        // Raw buffer: the shader loads just the dwords each function needs out of the 64 byte record
+        FRHIResourceCreateInfo CreateInfo(GaussianSplatArena::RecordsDebugName);
+        OutBuffers[0] = RHICmdList.CreateStructuredBuffer(sizeof(uint32), uint32(uint64(NumElements) * BytesPerSplat),
+                                                          Usage | BUF_ByteAddressBuffer, CreateInfo);
+        OutSRVs[0] = RHICmdList.CreateShaderResourceView(OutBuffers[0]);
+        return;
+    }
+
+    for (int32 i = 0; i < Stream_Count; ++i)
+    {
+        FRHIResourceCreateInfo CreateInfo(GaussianSplatArena::StreamDebugNames[i]);
+        OutBuffers[i] =
+            RHICmdList.CreateVertexBuffer(uint32(uint64(NumElements) * sizeof(FVector4f)), Usage, CreateInfo);
+        OutSRVs[i] = RHICmdList.CreateShaderResourceView(OutBuffers[i], sizeof(FVector4f), PF_A32B32G32R32F);
+    }
+}
+
+FGaussianSplatBufferArena::FHandle FGaussianSplatBufferArena::Allocate(FRHICommandListImmediate &RHICmdList,
+                                                                        uint32 Count)
+{
+    check(IsInRenderingThread());
+    if (Count == 0)
+        return INDEX_NONE;
+
+    auto FindFit = [this, Count]()
+    { return FreeRanges.IndexOfByPredicate([Count](const FGaussianSplatArenaRange &R) { return R.Count >= Count; }); };
+
+    int32 FreeIdx = FindFit();
+    if (FreeIdx == INDEX_NONE && Stats.FreeRanges > 1 &&
+        uint32(Stats.CapacityElements - Stats.AllocatedElements) >= Count)
+    {
+        // Enough space in total, just not in one piece
+        Defragment(RHICmdList);
+        FreeIdx = FindFit();
+    }
+    if (FreeIdx == INDEX_NONE)
+    {
+        if (!Grow(RHICmdList, Count))
+        {
+            UE_LOG(LogGaussianSplatArena, Error,
+                   TEXT("Arena cannot fit %u more splats: %u of %u allowed by the %llu byte buffer limit in use"),
+                   Count, uint32(Stats.AllocatedElements), GetMaxCapacity(), MaxBufferBytes);
+            return INDEX_NONE;
+        }
+        FreeIdx = FindFit();
+    }
+    check(FreeIdx != INDEX_NONE);
+
+    FGaussianSplatArenaRange &Free = FreeRanges[FreeIdx];
+    FGaussianSplatArenaRange Range;
+    Range.Offset = Free.Offset;
+    Range.Count = Count;
+    Free.Offset += Count;
+    Free.Count -= Count;
+    if (Free.Count == 0)
+        FreeRanges.RemoveAt(FreeIdx);
+
+    const FHandle Handle = Allocations.Add(Range);
+    ++Stats.TotalAllocations;
+    ++GaussianSplatArena::GTotalAllocations;
+    UpdateStats();
+    return Handle;
+}
+
+void FGaussianSplatBufferArena::Free(FRHICommandListImmediate &RHICmdList, FHandle Handle)
+{
+    check(IsInRenderingThread());
+    if (!IsValidHandle(Handle))
+        return;
+
+    const FGaussianSplatArenaRange Range = Allocations[Handle];
+    Allocations.RemoveAt(Handle);
+    AddFreeRange(Range.Offset, Range.Count);
+
+    ++Stats.TotalFrees;
+    ++GaussianSplatArena::GTotalFrees;
+    UpdateStats();
+
+    if (Allocations.Num() == 0)
+    {
+        // An empty arena is a single free range, so there is nothing to compact either way
+        if (GGaussianSplatArenaReleaseWhenEmpty != 0)
+            Release();
+        return;
+    }
+    DefragmentIfNeeded(RHICmdList);
+}
+
+void FGaussianSplatBufferArena::AddFreeRange(uint32 Offset, uint32 Count)
+{
+    int32 InsertIdx = Algo::LowerBoundBy(FreeRanges, Offset, &FGaussianSplatArenaRange::Offset);
+    FreeRanges.Insert(FGaussianSplatArenaRange{Offset, Count}, InsertIdx);
+
+    // Coalesce with the following range, then with the preceding one
+    if (InsertIdx + 1 < FreeRanges.Num() && Offset + Count == FreeRanges[InsertIdx + 1].Offset)
+    {
+        FreeRanges[InsertIdx].Count += FreeRanges[InsertIdx + 1].Count;
+        FreeRanges.RemoveAt(InsertIdx + 1);
+    }
+    if (InsertIdx > 0 && FreeRanges[InsertIdx - 1].Offset + FreeRanges[InsertIdx - 1].Count == Offset)
+    {
+        FreeRanges[InsertIdx - 1].Count += FreeRanges[InsertIdx].Count;
+        FreeRanges.RemoveAt(InsertIdx);
+    }
+}
+
+bool FGaussianSplatBufferArena::Grow(FRHICommandListImmediate &RHICmdList, uint32 MinFreeElements)
+{
+    const uint32 OldCapacity = Capacity;
+    const uint64 MaxCapacity = GetMaxCapacity();
+    if (uint64(OldCapacity) + MinFreeElements > MaxCapacity)
+        return false;
+    const uint64 MinCapacity = uint64(FMath::Max(GGaussianSplatArenaMinElements, 1));
+    const uint32 NewCapacity = uint32(FMath::Min(
+        FMath::Max3(MinCapacity, uint64(OldCapacity) * 2, uint64(OldCapacity) + MinFreeElements), MaxCapacity));
+
+    FBufferRHIRef NewBuffers[Stream_Count];
+    FShaderResourceViewRHIRef NewSRVs[Stream_Count];
+    CreateStreams(RHICmdList, NewCapacity, NewBuffers, NewSRVs);
+
+    const uint32 Stride = GetBufferStride();
+    if (OldCapacity > 0 && IsValid())
+    {
+        for (int32 i = 0; i < GetNumBuffers(); ++i)
+        {
+            RHICmdList.Transition(FRHITransitionInfo(Buffers[i], ERHIAccess::Unknown, ERHIAccess::CopySrc));
+            RHICmdList.Transition(FRHITransitionInfo(NewBuffers[i], ERHIAccess::Unknown, ERHIAccess::CopyDest));
+            RHICmdList.CopyBufferRegion(NewBuffers[i], 0, Buffers[i], 0, uint64(OldCapacity) * Stride);
+            RHICmdList.Transition(FRHITransitionInfo(NewBuffers[i], ERHIAccess::CopyDest, ERHIAccess::SRVMask));
+        }
+    }
+
+    for (int32 i = 0; i < GetNumBuffers(); ++i)
+    {
+        Buffers[i] = NewBuffers[i];
+        SRVs[i] = NewSRVs[i];
+    }
+    Capacity = NewCapacity;
+    AddFreeRange(OldCapacity, NewCapacity - OldCapacity);
+
+    ++Stats.TotalGrows;
+    ++GaussianSplatArena::GTotalGrows;
+    UpdateStats();
+    UE_LOG(LogGaussianSplatArena, Log, TEXT("Arena grown %u -> %u splats"), OldCapacity, NewCapacity);
+    return true;
+}
+
+void FGaussianSplatBufferArena::DefragmentIfNeeded(FRHICommandListImmediate &RHICmdList)
+{
+    if (Stats.TotalDefrags > 0 &&
+        GFrameNumberRenderThread - LastDefragFrame < uint32(FMath::Max(GGaussianSplatArenaDefragIntervalFrames, 0)))
+        return;
+    if (Stats.FreeRanges > 1 && Stats.GetFragmentation() > GGaussianSplatArenaDefragThreshold)
+        Defragment(RHICmdList);
+}
+
+void FGaussianSplatBufferArena::Defragment(FRHICommandListImmediate &RHICmdList)
+{
+    check(IsInRenderingThread());
+    if (!IsValid())
+        return;
+
+    TArray<FHandle> Order;
+    for (auto It = Allocations.CreateConstIterator(); It; ++It)
+        Order.Add(It.GetIndex());
+    Order.Sort([this](FHandle A, FHandle B) { return Allocations[A].Offset < Allocations[B].Offset; });
+
+    // Ranges only ever move down, so they are compacted within the existing buffers. A buffer cannot be copy source
+    // and destination at once, so each piece goes through a small bounce buffer rather than a second full arena.
+    uint32 Cursor = 0;
+    uint32 LargestMove = 0;
+    for (FHandle Handle : Order)
+    {
+        const FGaussianSplatArenaRange &Range = Allocations[Handle];
+        if (Range.Offset != Cursor)
+            LargestMove = FMath::Max(LargestMove, Range.Count);
+        Cursor += Range.Count;
+    }
+
+    if (LargestMove > 0)
+    {
+        const uint32 ChunkElements = FMath::Min(LargestMove, GaussianSplatArena::DefragChunkElements);
+        FBufferRHIRef Bounce[Stream_Count];
+        FShaderResourceViewRHIRef BounceSRVs[Stream_Count];
+        CreateStreams(RHICmdList, ChunkElements, Bounce, BounceSRVs);
+
+        const uint64 Stride = GetBufferStride();
+        auto CopyPiece = [&](uint32 From, uint32 To, uint32 Count)
+        {
+            for (int32 i = 0; i < GetNumBuffers(); ++i)
+            {
+                RHICmdList.Transition(FRHITransitionInfo(Buffers[i], ERHIAccess::Unknown, ERHIAccess::CopySrc));
+                RHICmdList.Transition(FRHITransitionInfo(Bounce[i], ERHIAccess::Unknown, ERHIAccess::CopyDest));
+                RHICmdList.CopyBufferRegion(Bounce[i], 0, Buffers[i], From * Stride, Count * Stride);
+                RHICmdList.Transition(FRHITransitionInfo(Buffers[i], ERHIAccess::CopySrc, ERHIAccess::CopyDest));
+                RHICmdList.Transition(FRHITransitionInfo(Bounce[i], ERHIAccess::CopyDest, ERHIAccess::CopySrc));
+                RHICmdList.CopyBufferRegion(Buffers[i], To * Stride, Bounce[i], 0, Count * Stride);
+            }
+        };
+
+        Cursor = 0;
+        for (FHandle Handle : Order)
+        {
+            FGaussianSplatArenaRange &Range = Allocations[Handle];
+            // Front to back: a piece's destination only overlaps source pieces that were already moved
+            for (uint32 Done = 0; Range.Offset != Cursor && Done < Range.Count; Done += ChunkElements)
+                CopyPiece(Range.Offset + Done, Cursor + Done, FMath::Min(ChunkElements, Range.Count - Done));
+            Range.Offset = Cursor;
+            Cursor += Range.Count;
+        }
+
+        for (int32 i = 0; i < GetNumBuffers(); ++i)
+            RHICmdList.Transition(FRHITransitionInfo(Buffers[i], ERHIAccess::Unknown, ERHIAccess::SRVMask));
+    }
+
+    FreeRanges.Reset();
+    if (Cursor < Capacity)
+        FreeRanges.Add(FGaussianSplatArenaRange{Cursor, Capacity - Cursor});
+
+    LastDefragFrame = GFrameNumberRenderThread;
+    ++Stats.TotalDefrags;
+    ++GaussianSplatArena::GTotalDefrags;
+    UpdateStats();
+    UE_LOG(LogGaussianSplatArena, Log, TEXT("Arena defragmented | %d allocations | %u/%u splats in use"),
+           Allocations.Num(), Cursor, Capacity);
+}
+
+void FGaussianSplatBufferArena::Upload(FRHICommandListImmediate &RHICmdList, FHandle Handle, EStream Stream,
+                                       uint32 FirstElement, const FVector4f *Data, uint32 Count)
+{
+    check(Layout == EGaussianSplatBufferLayout::SeparateStreams);
+    WriteRange(RHICmdList, Handle, Stream, FirstElement, Data, Count);
+}
+
+void FGaussianSplatBufferArena::UploadRecords(FRHICommandListImmediate &RHICmdList, FHandle Handle,
+                                              uint32 FirstElement, const FGaussianSplatPackedRecord *Data,
+                                              uint32 Count)
+{
+    check(Layout == EGaussianSplatBufferLayout::Interleaved);
+    WriteRange(RHICmdList, Handle, 0, FirstElement, Data, Count);
+}
+
+void FGaussianSplatBufferArena::WriteRange(FRHICommandListImmediate &RHICmdList, FHandle Handle, int32 BufferIndex,
+                                           uint32 FirstElement, const void *Data, uint32 Count)
+{
+    check(IsInRenderingThread());
+    if (!IsValidHandle(Handle) || !Data || Count == 0)
+        return;
+
+    const FGaussianSplatArenaRange &Range = Allocations[Handle];
+    if (!ensure(uint64(FirstElement) + Count <= Range.Count))
+        return;
+
+    // Capacity is capped at GetMaxCapacity(), so both fit in 32 bits once computed in 64
+    const uint64 Stride = GetBufferStride();
+    const uint64 Offset = (uint64(Range.Offset) + FirstElement) * Stride;
+    const uint64 Size = uint64(Count) * Stride;
+    check(Offset + Size <= MaxBufferBytes);
+    void *Mapped = RHICmdList.LockBuffer(Buffers[BufferIndex], uint32(Offset), uint32(Size), RLM_WriteOnly);
+    if (Mapped)
+    {
+        FMemory::Memcpy(Mapped, Data, Size);
+        RHICmdList.UnlockBuffer(Buffers[BufferIndex]);
+    }
+}
+
+void FGaussianSplatBufferArena::UpdateStats()
+{
+    using namespace GaussianSplatArena;
+
+    const FGaussianSplatArenaStats Old = Stats;
+    Stats.CapacityElements = Capacity;
+    Stats.AllocatedElements = 0;
+    for (const FGaussianSplatArenaRange &Range : Allocations)
+        Stats.AllocatedElements += Range.Count;
+    Stats.LiveAllocations = Allocations.Num();
+    Stats.FreeRanges = FreeRanges.Num();
+    Stats.LargestFreeRange = 0;
+    for (const FGaussianSplatArenaRange &Range : FreeRanges)
+        Stats.LargestFreeRange = FMath::Max<int64>(Stats.LargestFreeRange, Range.Count);
+
+    GCapacityElements += Stats.CapacityElements - Old.CapacityElements;
+    GAllocatedElements += Stats.AllocatedElements - Old.AllocatedElements;
+    GLiveAllocations += Stats.LiveAllocations - Old.LiveAllocations;
+    GFreeRanges += Stats.FreeRanges - Old.FreeRanges;
+}
@@ -0,0 +1,153 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+#include "RHI.h"
+#include "RHIResources.h"
+
+struct FGaussianSplatArenaRange
+{
+    uint32 Offset = 0;
+    uint32 Count = 0;
+};
+
+struct FGaussianSplatArenaStats
+{
+    int64 CapacityElements = 0;
+    int64 AllocatedElements = 0;
+    int32 LiveAllocations = 0;
+    int32 FreeRanges = 0;
+    int64 LargestFreeRange = 0;
+
+    // Cumulative
+    int64 TotalAllocations = 0;
+    int64 TotalFrees = 0;
+    int64 TotalGrows = 0;
+    int64 TotalDefrags = 0;
+
+    // 0 when all free space is one contiguous range, approaching 1 as it splinters
+    float GetFragmentation() const
+    {
+        const int64 FreeElements = CapacityElements - AllocatedElements;
+        return FreeElements > 0 ? 1.0f - float(LargestFreeRange) / float(FreeElements) : 0.0f;
+    }
+};
+
+/**
+ * Large splat buffers shared by every system instance of one NDI: either four float4 streams (positions, scales,
+ * orientations, SH0+opacity) or, in the interleaved layout, one ByteAddressBuffer of FGaussianSplatPackedRecord.
+ * Instances get an element range instead of their own buffers; the shader adds the range offset to each splat
+ * index. Freed ranges are coalesced and reused, the arena grows by copying into larger buffers, and compacts itself
+ * in place when free space becomes too fragmented, at most once per gsplat.Arena.DefragIntervalFrames. Capacity is
+ * kept when the last range is freed unless gsplat.Arena.ReleaseWhenEmpty is set; Release() frees it explicitly.
+ * Render thread only.
+ */
+class FGaussianSplatBufferArena
+{
+public:
+    using FHandle = int32;
+
+    enum EStream
+    {
+        Stream_Positions,
+        Stream_Scales,
+        Stream_Orientations,
+        Stream_SHZeroCoeffsAndOpacity,
+        Stream_Count
+    };
+
+    // GPU bytes per splat; the same for both layouts
+    static constexpr uint32 BytesPerSplat = sizeof(FGaussianSplatPackedRecord);
+    // Largest single buffer every RHI accepts (also 2^27 float4 texels, the typed SRV limit)
+    static constexpr uint64 MaxBufferBytes = uint64(MAX_int32);
+
+    explicit FGaussianSplatBufferArena(
+        EGaussianSplatBufferLayout InLayout = EGaussianSplatBufferLayout::SeparateStreams);
+    ~FGaussianSplatBufferArena();
+
+    // Returns INDEX_NONE if Count is zero or would take the arena past MaxBufferBytes
+    FHandle Allocate(FRHICommandListImmediate &RHICmdList, uint32 Count);
+    void Free(FRHICommandListImmediate &RHICmdList, FHandle Handle);
+
+    bool IsValidHandle(FHandle Handle) const
+    {
+        return Allocations.IsValidIndex(Handle);
+    }
+
+    FGaussianSplatArenaRange GetRange(FHandle Handle) const
+    {
+        return IsValidHandle(Handle) ? Allocations[Handle] : FGaussianSplatArenaRange();
+    }
+
+    // Writes Count elements of one stream starting at FirstElement within the allocation. Separate streams only.
+    void Upload(FRHICommandListImmediate &RHICmdList, FHandle Handle, EStream Stream, uint32 FirstElement,
+                const FVector4f *Data, uint32 Count);
+
+    // Writes Count whole records starting at FirstElement within the allocation. Interleaved only.
+    void UploadRecords(FRHICommandListImmediate &RHICmdList, FHandle Handle, uint32 FirstElement,
+                       const FGaussianSplatPackedRecord *Data, uint32 Count);
+
+    // Compacts live ranges to the front of the arena if fragmentation exceeds gsplat.Arena.DefragThreshold and the
+    // last compaction is at least gsplat.Arena.DefragIntervalFrames old
+    void DefragmentIfNeeded(FRHICommandListImmediate &RHICmdList);
+
+    bool IsValid() const;
+    FRHIShaderResourceView *GetSRV(EStream Stream) const;
+    // The single record buffer of an interleaved arena
+    FRHIShaderResourceView *GetRecordsSRV() const;
+    void Release();
+
+    EGaussianSplatBufferLayout GetLayout() const
+    {
+        return Layout;
+    }
+
+    const FGaussianSplatArenaStats &GetStats() const
+    {
+        return Stats;
+    }
+
+    // Sum over every arena in the process, for gsplat.Arena.Stats
+    static FGaussianSplatArenaStats GetGlobalStats();
+
+private:
+    int32 GetNumBuffers() const
+    {
+        return Layout == EGaussianSplatBufferLayout::Interleaved ? 1 : int32(Stream_Count);
+    }
+
+    uint32 GetBufferStride() const
+    {
+        return Layout == EGaussianSplatBufferLayout::Interleaved ? BytesPerSplat : uint32(sizeof(FVector4f));
+    }
+
+    // Capacity at which one buffer reaches MaxBufferBytes
+    uint32 GetMaxCapacity() const
+    {
+        return uint32(MaxBufferBytes / GetBufferStride());
+    }
+
+    void CreateStreams(FRHICommandListImmediate &RHICmdList, uint32 NumElements, FBufferRHIRef *OutBuffers,
+                       FShaderResourceViewRHIRef *OutSRVs);
+    void WriteRange(FRHICommandListImmediate &RHICmdList, FHandle Handle, int32 BufferIndex, uint32 FirstElement,
+                    const void *Data, uint32 Count);
+    // False if the arena cannot hold MinFreeElements more without passing GetMaxCapacity()
+    bool Grow(FRHICommandListImmediate &RHICmdList, uint32 MinFreeElements);
+    void Defragment(FRHICommandListImmediate &RHICmdList);
+    void AddFreeRange(uint32 Offset, uint32 Count);
+    void UpdateStats();
+
+    EGaussianSplatBufferLayout Layout;
+    // Only the first GetNumBuffers() entries are used
+    FBufferRHIRef Buffers[Stream_Count];
+    FShaderResourceViewRHIRef SRVs[Stream_Count];
+    uint32 Capacity;
+    // GFrameNumberRenderThread of the last compaction
+    uint32 LastDefragFrame;
+
+    TSparseArray<FGaussianSplatArenaRange> Allocations;
+    // Sorted by offset, never adjacent (always coalesced)
+    TArray<FGaussianSplatArenaRange> FreeRanges;
+
+    FGaussianSplatArenaStats Stats;
+};
@@ -0,0 +1,135 @@
+﻿#include "GaussianSplatCPUData.h"
+#include "GaussianSplatStats.h"
+#include "Math/VectorRegister.h"
+
+void FGaussianSplatCPUData::Build(TConstArrayView<FGaussianSplatData> Splats)
+{
+    GSPLAT_SCOPE(BuildCPUData);
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    const int32 NumWithSentinel = Splats.Num() + 1;
+    for (TArray<float> *Plane : {&PositionX, &PositionY, &PositionZ, &ScaleX, &ScaleY, &ScaleZ, &OrientationX,
+                                 &OrientationY, &OrientationZ, &OrientationW, &SHZeroR, &SHZeroG, &SHZeroB, &Opacity,
+                                 &BoundingRadius})
+        Plane->SetNumUninitialized(NumWithSentinel);
+
+    for (int32 i = 0; i < Splats.Num(); ++i)
+        Write(i, Splats[i]);
+    WriteSentinel(Splats.Num());
+    ComputeBoundingRadii(ScaleX.GetData(), ScaleY.GetData(), ScaleZ.GetData(), BoundingRadius.GetData(),
+                         NumWithSentinel);
+}
+
+void FGaussianSplatCPUData::UpdateRange(TConstArrayView<FGaussianSplatData> Splats, int32 Start, int32 Count)
+{
+    if (!ensure(Splats.Num() == Num()))
+        return;
+
+    const int32 First = FMath::Max(Start, 0);
+    const int32 End = FMath::Min(Start + Count, Num());
+    for (int32 i = First; i < End; ++i)
+        Write(i, Splats[i]);
+    if (End > First)
+        ComputeBoundingRadii(ScaleX.GetData() + First, ScaleY.GetData() + First, ScaleZ.GetData() + First,
+                             BoundingRadius.GetData() + First, End - First);
+}
+
+SIZE_T FGaussianSplatCPUData::GetAllocatedSize() const
+{
+    SIZE_T Size = 0;
+    for (const TArray<float> *Plane : {&PositionX, &PositionY, &PositionZ, &ScaleX, &ScaleY, &ScaleZ, &OrientationX,
+                                       &OrientationY, &OrientationZ, &OrientationW, &SHZeroR, &SHZeroG, &SHZeroB,
+                                       &Opacity, &BoundingRadius})
+        Size += Plane->GetAllocatedSize();
+    return Size;
+}
+
+void FGaussianSplatCPUData::Reset()
+{
+    Build(TConstArrayView<FGaussianSplatData>());
+    for (TArray<float> *Plane : {&PositionX, &PositionY, &PositionZ, &ScaleX, &ScaleY, &ScaleZ, &OrientationX,
+                                 &OrientationY, &OrientationZ, &OrientationW, &SHZeroR, &SHZeroG, &SHZeroB, &Opacity,
+                                 &BoundingRadius})
+        Plane->Shrink();
+}
+
+void FGaussianSplatCPUData::Write(int32 Index, const FGaussianSplatData &S)
+{
+    PositionX[Index] = S.Position.X;
+    PositionY[Index] = S.Position.Y;
+    PositionZ[Index] = S.Position.Z;
+    ScaleX[Index] = S.Scale.X;
+    ScaleY[Index] = S.Scale.Y;
+    ScaleZ[Index] = S.Scale.Z;
+    OrientationX[Index] = S.Orientation.X;
+    OrientationY[Index] = S.Orientation.Y;
+    OrientationZ[Index] = S.Orientation.Z;
+    OrientationW[Index] = S.Orientation.W;
+    SHZeroR[Index] = S.ZeroOrderHarmonicsCoefficients.X;
+    SHZeroG[Index] = S.ZeroOrderHarmonicsCoefficients.Y;
+    SHZeroB[Index] = S.ZeroOrderHarmonicsCoefficients.Z;
+    Opacity[Index] = S.Opacity;
+}
+
+void FGaussianSplatCPUData::WriteSentinel(int32 Index)
+{
+    // Same values the old per-instance IsValidIndex checks returned: zero position, unit scale, identity rotation,
+    // black and fully transparent. The SH value clamps to 0 in SHToColor4.
+    FGaussianSplatData Default;
+    Default.Scale = FVector3f::OneVector;
+    Default.ZeroOrderHarmonicsCoefficients = FVector3f(-1.0e4f);
+    Default.Opacity = 0.0f;
+    Write(Index, Default);
+}
+
+void FGaussianSplatCPUData::SHToColor4(const float *SHR, const float *SHG, const float *SHB, const FLinearColor &Tint,
+                                       float *OutR, float *OutG, float *OutB)
+{
+    const VectorRegister4Float C0 = VectorSetFloat1(0.28209479177387814f);
+    const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+
+    auto Channel = [&](const float *SH, float TintChannel, float *Out)
+    {
+        VectorRegister4Float Color = VectorMultiplyAdd(VectorLoad(SH), C0, Half);
+        Color = VectorMin(VectorMax(Color, Zero), One);
+        VectorStore(VectorMultiply(Color, VectorSetFloat1(TintChannel)), Out);
+    };
+    Channel(SHR, Tint.R, OutR);
+    Channel(SHG, Tint.G, OutG);
+    Channel(SHB, Tint.B, OutB);
+}
+
+void FGaussianSplatCPUData::ComputeBoundingRadii(const float *X, const float *Y, const float *Z, float *OutRadius,
+                                                 int32 Num)
+{
+    const VectorRegister4Float Sigma = VectorSetFloat1(FGaussianSplatData::BoundingSigma);
+    int32 i = 0;
+    for (; i + 4 <= Num; i += 4)
+    {
+        const VectorRegister4Float AbsY = VectorAbs(VectorLoad(Y + i));
+        const VectorRegister4Float AbsZ = VectorAbs(VectorLoad(Z + i));
+        const VectorRegister4Float Max = VectorMax(VectorMax(VectorAbs(VectorLoad(X + i)), AbsY), AbsZ);
+        VectorStore(VectorMultiply(Max, Sigma), OutRadius + i);
+    }
+    for (; i < Num; ++i)
+    {
+        const float Max = FMath::Max(FMath::Max(FMath::Abs(X[i]), FMath::Abs(Y[i])), FMath::Abs(Z[i]));
+        OutRadius[i] = FGaussianSplatData::BoundingSigma * Max;
+    }
+}
+
+void FGaussianSplatCPUData::PixelRadius4(const float *PX, const float *PY, const float *PZ, const float *Radius,
+                                         const FVector4f &DepthPlane, float PixelScale, float *OutPixelRadius)
+{
+    VectorRegister4Float Depth = VectorSetFloat1(DepthPlane.W);
+    Depth = VectorMultiplyAdd(VectorLoad(PX), VectorSetFloat1(DepthPlane.X), Depth);
+    Depth = VectorMultiplyAdd(VectorLoad(PY), VectorSetFloat1(DepthPlane.Y), Depth);
+    Depth = VectorMultiplyAdd(VectorLoad(PZ), VectorSetFloat1(DepthPlane.Z), Depth);
+    // Lanes at or behind the camera divide by one and are then zeroed
+    const VectorRegister4Float InFront = VectorCompareGT(Depth, VectorZeroFloat());
+    const VectorRegister4Float SafeDepth = VectorSelect(InFront, Depth, VectorOneFloat());
+    const VectorRegister4Float Pixels =
+        VectorDivide(VectorMultiply(VectorLoad(Radius), VectorSetFloat1(PixelScale)), SafeDepth);
+    VectorStore(VectorSelect(InFront, Pixels, VectorZeroFloat()), OutPixelRadius);
+}
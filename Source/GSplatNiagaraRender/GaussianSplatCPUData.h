@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+/**
+ * Planar copy of the splats for the CPU VM: one float array per component, so gathers touch only the components
+ * a function outputs. Every array has one extra trailing element holding the out-of-range defaults, letting
+ * ClampIndex send invalid indices there without a branch.
+ */
+struct FGaussianSplatCPUData
+{
+    TArray<float> PositionX, PositionY, PositionZ;
+    TArray<float> ScaleX, ScaleY, ScaleZ;
+    TArray<float> OrientationX, OrientationY, OrientationZ, OrientationW;
+    TArray<float> SHZeroR, SHZeroG, SHZeroB;
+    TArray<float> Opacity;
+    // FGaussianSplatData::GetBoundingRadius, derived from the scale planes
+    TArray<float> BoundingRadius;
+
+    // Starts empty but with the sentinel in place, so reads are always safe
+    FGaussianSplatCPUData()
+    {
+        Reset();
+    }
+
+    void Build(TConstArrayView<FGaussianSplatData> Splats);
+    // Rewrites [Start, Start + Count) from Splats, which must be the array Build was given
+    void UpdateRange(TConstArrayView<FGaussianSplatData> Splats, int32 Start, int32 Count);
+    // Back to zero splats (sentinel only)
+    void Reset();
+
+    SIZE_T GetAllocatedSize() const;
+
+    // Number of real splats, excluding the sentinel
+    int32 Num() const
+    {
+        return FMath::Max(PositionX.Num() - 1, 0);
+    }
+
+    // Any index outside [0, Num) maps to the sentinel; negative indices wrap to large unsigned values
+    int32 ClampIndex(int32 Index) const
+    {
+        return int32(FMath::Min(uint32(Index), uint32(Num())));
+    }
+
+    // SH0 -> linear RGB for 4 splats at once, multiplied by Tint. Matches FGaussianSplatData::SHToColor.
+    static void SHToColor4(const float *SHR, const float *SHG, const float *SHB, const FLinearColor &Tint,
+                           float *OutR, float *OutG, float *OutB);
+
+    // OutRadius[i] = BoundingSigma * max(|X[i]|, |Y[i]|, |Z[i]|), 4 splats at a time. Bit-identical to
+    // FGaussianSplatData::GetBoundingRadius.
+    static void ComputeBoundingRadii(const float *X, const float *Y, const float *Z, float *OutRadius, int32 Num);
+
+    // Projected radius in pixels for 4 splats at once; FGaussianSplatCulling::GetPixelRadius per lane
+    static void PixelRadius4(const float *PX, const float *PY, const float *PZ, const float *Radius,
+                             const FVector4f &DepthPlane, float PixelScale, float *OutPixelRadius);
+
+private:
+    void Write(int32 Index, const FGaussianSplatData &S);
+    void WriteSentinel(int32 Index);
+};
@@ -0,0 +1,208 @@
+﻿#include "GaussianSplatCleanup.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "GaussianSplatStats.h"
+
+namespace GaussianSplatCleanup
+{
+enum class EReject : uint8
+{
+    None,
+    NonFinite,
+    ZeroArea,
+    Transparent
+};
+
+bool IsFinite(const FVector3f &V)
+{
+    return FMath::IsFinite(V.X) && FMath::IsFinite(V.Y) && FMath::IsFinite(V.Z);
+}
+
+EReject Classify(const FGaussianSplatData &S, const FGaussianSplatCleanupSettings &Settings)
+{
+    const FQuat4f &Q = S.Orientation;
+    if (!IsFinite(S.Position) || !IsFinite(S.Scale) || !IsFinite(S.ZeroOrderHarmonicsCoefficients) ||
+        !FMath::IsFinite(S.Opacity) || Q.ContainsNaN() || Q.SizeSquared() < UE_KINDA_SMALL_NUMBER)
+        return EReject::NonFinite;
+    if (S.Opacity < Settings.MinOpacity)
+        return EReject::Transparent;
+    // One thin axis is a disc, which is fine; two make a needle that covers no pixels
+    const FVector3f Scale = S.Scale.GetAbs();
+    const float MiddleAxis = Scale.X + Scale.Y + Scale.Z - Scale.GetMax() - Scale.GetMin();
+    if (MiddleAxis < Settings.MinScale)
+        return EReject::ZeroArea;
+    return EReject::None;
+}
+
+bool IsDuplicate(const FGaussianSplatData &A, const FGaussianSplatData &B,
+                 const FGaussianSplatCleanupSettings &Settings)
+{
+    if (FVector3f::DistSquared(A.Position, B.Position) > FMath::Square(Settings.PositionTolerance))
+        return false;
+    for (int32 c = 0; c < 3; ++c)
+    {
+        const float Larger = FMath::Max(FMath::Abs(A.Scale[c]), FMath::Abs(B.Scale[c]));
+        if (FMath::Abs(A.Scale[c] - B.Scale[c]) > Settings.ScaleTolerance * Larger)
+            return false;
+    }
+    // SH0 maps to color linearly, so the tolerance converts back to coefficient space
+    constexpr float SHC0 = 0.28209479177387814f;
+    const FVector3f ColorDelta = A.ZeroOrderHarmonicsCoefficients - B.ZeroOrderHarmonicsCoefficients;
+    if (ColorDelta.GetAbsMax() * SHC0 > Settings.ColorTolerance)
+        return false;
+    return A.Orientation.AngularDistance(B.Orientation) <= FMath::DegreesToRadians(Settings.OrientationTolerance);
+}
+
+// 21 bits per axis. Far cells can alias, which only costs extra comparisons since matches check real distances.
+int64 PackCell(const FIntVector &Cell)
+{
+    constexpr int64 Mask = (1 << 21) - 1;
+    return ((Cell.X & Mask) << 42) | ((Cell.Y & Mask) << 21) | (Cell.Z & Mask);
+}
+
+FIntVector GetCell(const FVector3f &Position, float InvCellSize)
+{
+    return FIntVector(FMath::FloorToInt32(Position.X * InvCellSize), FMath::FloorToInt32(Position.Y * InvCellSize),
+                      FMath::FloorToInt32(Position.Z * InvCellSize));
+}
+
+// Stable in-place removal
+void Compact(TArray<FGaussianSplatData> &Splats, TFunctionRef<bool(int32)> ShouldRemove)
+{
+    int32 Write = 0;
+    for (int32 i = 0; i < Splats.Num(); ++i)
+    {
+        if (ShouldRemove(i))
+            continue;
+        if (Write != i)
+            Splats[Write] = MoveTemp(Splats[i]);
+        ++Write;
+    }
+    Splats.SetNum(Write);
+}
+
+void RemoveDegenerate(const FGaussianSplatCleanupSettings &Settings, TArray<FGaussianSplatData> &Splats,
+                      FGaussianSplatCleanupStats &Stats)
+{
+    TArray<EReject> Rejects;
+    Rejects.SetNumUninitialized(Splats.Num());
+    ParallelFor(TEXT("GaussianSplat.Cleanup.Classify"), Splats.Num(), 4096,
+                [&](int32 i) { Rejects[i] = Classify(Splats[i], Settings); });
+
+    for (const EReject Reject : Rejects)
+    {
+        Stats.NonFinite += Reject == EReject::NonFinite;
+        Stats.ZeroArea += Reject == EReject::ZeroArea;
+        Stats.Transparent += Reject == EReject::Transparent;
+    }
+    if (Stats.NonFinite + Stats.ZeroArea + Stats.Transparent > 0)
+        Compact(Splats, [&Rejects](int32 i) { return Rejects[i] != EReject::None; });
+}
+
+// Buckets splats into cells of PositionTolerance, so every candidate is in one of the 27 cells around a splat. Each
+// splat then looks for the lowest-indexed earlier splat it matches, in parallel; chains resolve to their first
+// splat afterwards, which keeps the result independent of scheduling.
+void MergeDuplicates(const FGaussianSplatCleanupSettings &Settings, TArray<FGaussianSplatData> &Splats,
+                     FGaussianSplatCleanupStats &Stats)
+{
+    const int32 N = Splats.Num();
+    const float InvCellSize = 1.0f / FMath::Max(Settings.PositionTolerance, UE_KINDA_SMALL_NUMBER);
+
+    TArray<int64> Keys;
+    Keys.SetNumUninitialized(N);
+    ParallelFor(TEXT("GaussianSplat.Cleanup.Hash"), N, 4096,
+                [&](int32 i) { Keys[i] = PackCell(GetCell(Splats[i].Position, InvCellSize)); });
+
+    // Sorted by cell, then index, so a cell's splats are a contiguous run in index order
+    TArray<int32> Order;
+    Order.SetNumUninitialized(N);
+    for (int32 i = 0; i < N; ++i)
+        Order[i] = i;
+    Algo::Sort(Order, [&Keys](int32 A, int32 B) { return Keys[A] != Keys[B] ? Keys[A] < Keys[B] : A < B; });
+
+    struct FCellRange
+    {
+        int32 Start;
+        int32 Num;
+    };
+    TMap<int64, FCellRange> Cells;
+    for (int32 Start = 0; Start < N;)
+    {
+        const int64 Key = Keys[Order[Start]];
+        int32 End = Start + 1;
+        while (End < N && Keys[Order[End]] == Key)
+            ++End;
+        Cells.Add(Key, FCellRange{Start, End - Start});
+        Start = End;
+    }
+
+    TArray<int32> Target;
+    Target.SetNumUninitialized(N);
+    ParallelFor(TEXT("GaussianSplat.Cleanup.Match"), N, 1024,
+                [&](int32 i)
+                {
+                    int32 Match = INDEX_NONE;
+                    const FIntVector Cell = GetCell(Splats[i].Position, InvCellSize);
+                    for (int32 dx = -1; dx <= 1; ++dx)
+                        for (int32 dy = -1; dy <= 1; ++dy)
+                            for (int32 dz = -1; dz <= 1; ++dz)
+                            {
+                                const FCellRange *Range = Cells.Find(PackCell(Cell + FIntVector(dx, dy, dz)));
+                                if (!Range)
+                                    continue;
+                                for (int32 k = 0; k < Range->Num; ++k)
+                                {
+                                    const int32 j = Order[Range->Start + k];
+                                    if (j >= i || (Match != INDEX_NONE && j >= Match))
+                                        break;
+                                    if (IsDuplicate(Splats[i], Splats[j], Settings))
+                                    {
+                                        Match = j;
+                                        break;
+                                    }
+                                }
+                            }
+                    Target[i] = Match;
+                });
+
+    // Targets always point backwards, so one forward pass resolves chains to their surviving splat
+    for (int32 i = 0; i < N; ++i)
+    {
+        if (Target[i] == INDEX_NONE)
+            continue;
+        if (Target[Target[i]] != INDEX_NONE)
+            Target[i] = Target[Target[i]];
+        FGaussianSplatData &Survivor = Splats[Target[i]];
+        Survivor.Opacity = 1.0f - (1.0f - Survivor.Opacity) * (1.0f - Splats[i].Opacity);
+        ++Stats.Duplicates;
+    }
+    if (Stats.Duplicates > 0)
+        Compact(Splats, [&Target](int32 i) { return Target[i] != INDEX_NONE; });
+}
+} // namespace GaussianSplatCleanup
+
+void FGaussianSplatCleanup::Decimate(int32 Stride, TArray<FGaussianSplatData> &InOutSplats)
+{
+    if (Stride > 1)
+        GaussianSplatCleanup::Compact(InOutSplats, [Stride](int32 i) { return i % Stride != 0; });
+}
+
+FString FGaussianSplatCleanupStats::ToString() const
+{
+    return FString::Printf(TEXT("%d removed (%d non-finite, %d zero-area, %d transparent, %d duplicates)"),
+                           GetTotal(), NonFinite, ZeroArea, Transparent, Duplicates);
+}
+
+FGaussianSplatCleanupStats FGaussianSplatCleanup::Apply(const FGaussianSplatCleanupSettings &Settings,
+                                                        TArray<FGaussianSplatData> &InOutSplats)
+{
+    using namespace GaussianSplatCleanup;
+
+    GSPLAT_SCOPE(Cleanup);
+    FGaussianSplatCleanupStats Stats;
+    if (Settings.bRemoveDegenerate)
+        RemoveDegenerate(Settings, InOutSplats, Stats);
+    if (Settings.bMergeDuplicates && InOutSplats.Num() > 1)
+        MergeDuplicates(Settings, InOutSplats, Stats);
+    return Stats;
+}
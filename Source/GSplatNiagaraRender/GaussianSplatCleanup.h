@@ -0,0 +1,80 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+#include "GaussianSplatCleanup.generated.h"
+
+// Import-time filtering of a parsed cloud, applied per source file before any cloud transform
+USTRUCT(BlueprintType)
+struct FGaussianSplatCleanupSettings
+{
+    GENERATED_BODY()
+
+    // Drops splats with non-finite attributes, a line-like shape (two scale axes under MinScale, so no projected
+    // area from any direction) or opacity under MinOpacity
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup")
+    bool bRemoveDegenerate = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup", meta = (ClampMin = "0", Units = "cm"))
+    float MinScale = 0.001f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup", meta = (ClampMin = "0", ClampMax = "1"))
+    float MinOpacity = 1.0f / 255.0f;
+
+    // Merges splats that match an earlier splat within every tolerance below, as left by overlapping capture
+    // sessions. The survivor takes the combined opacity of the pair.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup")
+    bool bMergeDuplicates = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup",
+              meta = (ClampMin = "0.001", Units = "cm", EditCondition = "bMergeDuplicates"))
+    float PositionTolerance = 0.5f;
+
+    // Per axis, relative to the larger of the two scales
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup",
+              meta = (ClampMin = "0", EditCondition = "bMergeDuplicates"))
+    float ScaleTolerance = 0.1f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup",
+              meta = (ClampMin = "0", Units = "deg", EditCondition = "bMergeDuplicates"))
+    float OrientationTolerance = 5.0f;
+
+    // Per channel of the SH0 color, 0..1
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cleanup",
+              meta = (ClampMin = "0", ClampMax = "1", EditCondition = "bMergeDuplicates"))
+    float ColorTolerance = 0.02f;
+
+    bool IsEnabled() const
+    {
+        return bRemoveDegenerate || bMergeDuplicates;
+    }
+
+    bool operator==(const FGaussianSplatCleanupSettings &Other) const = default;
+};
+
+struct FGaussianSplatCleanupStats
+{
+    int32 NonFinite = 0;
+    int32 ZeroArea = 0;
+    int32 Transparent = 0;
+    int32 Duplicates = 0;
+
+    int32 GetTotal() const
+    {
+        return NonFinite + ZeroArea + Transparent + Duplicates;
+    }
+
+    FString ToString() const;
+};
+
+class GSPLATNIAGARARENDER_API FGaussianSplatCleanup
+{
+public:
+    // Removes the splats the settings reject, keeping the order of the rest. Both passes run in parallel; the
+    // result does not depend on the thread count.
+    static FGaussianSplatCleanupStats Apply(const FGaussianSplatCleanupSettings &Settings,
+                                            TArray<FGaussianSplatData> &InOutSplats);
+
+    // Keeps every Stride-th splat, in order. Stride 2^N of a cloud equals stride 2 applied N times.
+    static void Decimate(int32 Stride, TArray<FGaussianSplatData> &InOutSplats);
+};
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include "Algo/BinarySearch.h"
+#include "CoreMinimal.h"
+
+/**
+ * Maps the concatenated splat index space of a multi-cloud NDI back to its source clouds. A single PLY is one
+ * cloud covering every splat.
+ */
+struct FGaussianSplatCloudTable
+{
+    // Offsets[i] is the first splat of cloud i; one extra trailing entry holds the total
+    TArray<int32> Offsets;
+    TArray<FLinearColor> Tints;
+
+    int32 Num() const
+    {
+        return Tints.Num();
+    }
+
+    void Reset()
+    {
+        Offsets.Reset();
+        Tints.Reset();
+    }
+
+    void Add(int32 Count, const FLinearColor &Tint)
+    {
+        if (Offsets.Num() == 0)
+            Offsets.Add(0);
+        Offsets.Add(Offsets.Last() + Count);
+        Tints.Add(Tint);
+    }
+
+    // Cloud containing GlobalIndex, clamped to a valid cloud; 0 when the table is empty
+    int32 FindCloud(int32 GlobalIndex) const
+    {
+        if (Num() <= 1)
+            return 0;
+        const int32 Upper = Algo::UpperBound(MakeArrayView(Offsets.GetData(), Num()), GlobalIndex);
+        return FMath::Clamp(Upper - 1, 0, Num() - 1);
+    }
+
+    int32 GetFirst(int32 Cloud) const
+    {
+        return Cloud >= 0 && Cloud < Num() ? Offsets[Cloud] : 0;
+    }
+
+    int32 GetCount(int32 Cloud) const
+    {
+        return Cloud >= 0 && Cloud < Num() ? Offsets[Cloud + 1] - Offsets[Cloud] : 0;
+    }
+};
@@ -0,0 +1,433 @@
+﻿#include "GaussianSplatCompactFile.h"
+#include "GaussianSplatStats.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace GaussianSplatCompactFile
+{
+constexpr float SHC0 = 0.28209479177387814f;
+
+struct FSplatRecord
+{
+    float Position[3];
+    float Scale[3];
+    uint8 Color[4];
+    uint8 Rotation[4]; // wxyz, (q * 128 + 128)
+};
+static_assert(sizeof(FSplatRecord) == 32, ".splat records are 32 bytes");
+
+struct FSpzHeader
+{
+    static constexpr uint32 MagicValue = 0x5053474e; // 'NGSP'
+    static constexpr uint32 CurrentVersion = 2;
+
+    uint32 Magic = MagicValue;
+    uint32 Version = CurrentVersion;
+    uint32 NumPoints = 0;
+    uint8 SHDegree = 0;
+    uint8 FractionalBits = 0;
+    uint8 Flags = 0;
+    uint8 Reserved = 0;
+};
+static_assert(sizeof(FSpzHeader) == 16, ".spz header is 16 bytes");
+
+// .spz quantizes SH0 with this scale instead of storing the 0..1 color
+constexpr float SpzColorScale = 0.15f;
+
+// .spz is RUB while PLY is RDF: the conversion negates y and z, which flips these quaternion components and SH
+// coefficients. Both directions use the same signs.
+constexpr float SpzFlipQ[3] = {1.0f, -1.0f, -1.0f};
+constexpr float SpzFlipSH[15] = {-1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f,
+                                 -1.0f, 1.0f,  -1.0f, -1.0f, 1.0f, -1.0f, 1.0f};
+
+// Per-channel SH coefficients above SH0 for a degree
+int32 GetNumSHCoeffs(int32 Degree)
+{
+    return (Degree + 1) * (Degree + 1) - 1;
+}
+
+// Largest degree whose coefficients all fit in NumCoeffs
+int32 GetSHDegree(int32 NumCoeffs)
+{
+    int32 Degree = 0;
+    while (Degree < 3 && GetNumSHCoeffs(Degree + 1) <= NumCoeffs)
+        ++Degree;
+    return Degree;
+}
+
+uint8 ToUint8(float Value)
+{
+    return uint8(FMath::Clamp(FMath::RoundToInt32(Value), 0, 255));
+}
+
+// Inverses of the FGaussianSplatData conversions, back to raw PLY values
+FVector3f ToPlyPosition(const FVector3f &P)
+{
+    return FVector3f(P.X, -P.Z, -P.Y) / 100.0f;
+}
+
+// Scale is a sigmoid of the PLY value, so the inverse is a logit; clamped so saturated scales stay finite
+float ToPlyLogScale(float S)
+{
+    const float P = FMath::Clamp(S / 100.0f, 1e-6f, 1.0f - 1e-6f);
+    return FMath::Loge(P / (1.0f - P));
+}
+
+// Unit quaternion in PLY component order (w, x, y, z)
+FVector4f ToPlyRotation(FQuat4f Q)
+{
+    Q.Normalize();
+    return FVector4f(Q.W, Q.X, Q.Y, Q.Z);
+}
+
+// High-order SH in PLY f_rest order (all red coefficients, then green, then blue), flattened from the triples
+// FPLYParser groups consecutive f_rest values into
+float GetRestCoeff(const FGaussianSplatData &Splat, int32 Channel, int32 Coeff)
+{
+    const int32 NumCoeffs = Splat.HighOrderHarmonicsCoefficients.Num();
+    if (Coeff >= NumCoeffs)
+        return 0.0f;
+    const int32 Flat = Channel * NumCoeffs + Coeff;
+    return Splat.HighOrderHarmonicsCoefficients[Flat / 3][Flat % 3];
+}
+
+void SetRestCoeff(FGaussianSplatData &Splat, int32 Channel, int32 Coeff, float Value)
+{
+    const int32 Flat = Channel * Splat.HighOrderHarmonicsCoefficients.Num() + Coeff;
+    Splat.HighOrderHarmonicsCoefficients[Flat / 3][Flat % 3] = Value;
+}
+
+void EncodeSplat(TConstArrayView<FGaussianSplatData> Splats, TArray<uint8> &OutBytes)
+{
+    OutBytes.SetNumUninitialized(Splats.Num() * sizeof(FSplatRecord));
+    FSplatRecord *Records = reinterpret_cast<FSplatRecord *>(OutBytes.GetData());
+    for (int32 i = 0; i < Splats.Num(); ++i)
+    {
+        const FGaussianSplatData &S = Splats[i];
+        FSplatRecord &R = Records[i];
+        const FVector3f Position = ToPlyPosition(S.Position);
+        const FVector4f Rotation = ToPlyRotation(S.Orientation);
+        for (int32 c = 0; c < 3; ++c)
+        {
+            R.Position[c] = Position[c];
+            R.Scale[c] = FMath::Exp(ToPlyLogScale(S.Scale[c]));
+            R.Color[c] = ToUint8((0.5f + SHC0 * S.ZeroOrderHarmonicsCoefficients[c]) * 255.0f);
+        }
+        R.Color[3] = ToUint8(S.Opacity * 255.0f);
+        for (int32 c = 0; c < 4; ++c)
+            R.Rotation[c] = ToUint8(Rotation[c] * 128.0f + 128.0f);
+    }
+}
+
+bool DecodeSplat(TConstArrayView<uint8> Bytes, TArray<FGaussianSplatData> &OutSplats, FString &OutError)
+{
+    if (Bytes.Num() % sizeof(FSplatRecord) != 0)
+    {
+        OutError = FString::Printf(TEXT("Size %d is not a multiple of the %d byte .splat record"), Bytes.Num(),
+                                   int32(sizeof(FSplatRecord)));
+        return false;
+    }
+
+    const int32 NumSplats = Bytes.Num() / sizeof(FSplatRecord);
+    const FSplatRecord *Records = reinterpret_cast<const FSplatRecord *>(Bytes.GetData());
+    OutSplats.Reset();
+    OutSplats.SetNum(NumSplats);
+    for (int32 i = 0; i < NumSplats; ++i)
+    {
+        const FSplatRecord &R = Records[i];
+        FGaussianSplatData &S = OutSplats[i];
+        S.Position = FGaussianSplatData::ConvertPositionToUnreal(R.Position[0], R.Position[1], R.Position[2]);
+        S.Scale = FGaussianSplatData::ConvertScaleToUnreal(FMath::Loge(FMath::Max(R.Scale[0], UE_SMALL_NUMBER)),
+                                                           FMath::Loge(FMath::Max(R.Scale[1], UE_SMALL_NUMBER)),
+                                                           FMath::Loge(FMath::Max(R.Scale[2], UE_SMALL_NUMBER)));
+        for (int32 c = 0; c < 3; ++c)
+            S.ZeroOrderHarmonicsCoefficients[c] = (R.Color[c] / 255.0f - 0.5f) / SHC0;
+        S.Opacity = R.Color[3] / 255.0f;
+        const auto Unquantize = [](uint8 Value) { return (Value - 128.0f) / 128.0f; };
+        S.Orientation = FGaussianSplatData::ConvertOrientationToUnreal(
+            Unquantize(R.Rotation[0]), Unquantize(R.Rotation[1]), Unquantize(R.Rotation[2]), Unquantize(R.Rotation[3]));
+    }
+    return true;
+}
+
+// SH is quantized to fewer than 8 bits by rounding to a bucket: 5 bits for degree 1, 4 above, like the reference
+// encoder. The bytes stay 0..255 so any decoder reads them.
+uint8 QuantizeSH(float Value, int32 Coeff)
+{
+    const int32 BucketSize = Coeff < 3 ? 8 : 16;
+    const int32 Q = FMath::RoundToInt32(Value * 128.0f) + 128;
+    return uint8(FMath::Clamp((Q + BucketSize / 2) / BucketSize * BucketSize, 0, 255));
+}
+
+bool EncodeSpz(TConstArrayView<FGaussianSplatData> Splats, const FGaussianSplatCompactSettings &Settings,
+               TArray<uint8> &OutBytes, FString &OutError)
+{
+    FSpzHeader Header;
+    Header.NumPoints = Splats.Num();
+    Header.FractionalBits = uint8(FMath::Clamp(Settings.FractionalBits, 0, 23));
+    const int32 SourceDegree = Splats.Num() > 0 ? GetSHDegree(Splats[0].HighOrderHarmonicsCoefficients.Num()) : 0;
+    Header.SHDegree = uint8(FMath::Clamp(FMath::Min(SourceDegree, Settings.MaxSHDegree), 0, 3));
+
+    const int32 N = Splats.Num();
+    const int32 NumCoeffs = GetNumSHCoeffs(Header.SHDegree);
+    const int64 RawSize = sizeof(FSpzHeader) + int64(N) * (9 + 1 + 3 + 3 + 3 + NumCoeffs * 3);
+    if (RawSize > MAX_int32)
+    {
+        OutError = FString::Printf(TEXT("%d splats at SH degree %d exceed the 2 GB .spz limit"), N, Header.SHDegree);
+        return false;
+    }
+
+    TArray<uint8> Raw;
+    Raw.SetNumZeroed(int32(RawSize));
+    FMemory::Memcpy(Raw.GetData(), &Header, sizeof(Header));
+    uint8 *Positions = Raw.GetData() + sizeof(FSpzHeader);
+    uint8 *Alphas = Positions + N * 9;
+    uint8 *Colors = Alphas + N;
+    uint8 *Scales = Colors + N * 3;
+    uint8 *Rotations = Scales + N * 3;
+    uint8 *SH = Rotations + N * 3;
+
+    const float FixedScale = float(1 << Header.FractionalBits);
+    constexpr int32 MaxFixed = (1 << 23) - 1;
+    // Every offset below is within the 2 GB checked above
+    for (int32 i = 0; i < N; ++i)
+    {
+        const FGaussianSplatData &S = Splats[i];
+        const FVector3f Position = ToPlyPosition(S.Position) * FVector3f(1.0f, -1.0f, -1.0f);
+        for (int32 c = 0; c < 3; ++c)
+        {
+            const int32 Fixed = FMath::Clamp(FMath::RoundToInt32(Position[c] * FixedScale), -MaxFixed - 1, MaxFixed);
+            uint8 *Dst = Positions + i * 9 + c * 3;
+            Dst[0] = uint8(Fixed & 0xff);
+            Dst[1] = uint8((Fixed >> 8) & 0xff);
+            Dst[2] = uint8((Fixed >> 16) & 0xff);
+
+            Colors[i * 3 + c] =
+                ToUint8(S.ZeroOrderHarmonicsCoefficients[c] * (SpzColorScale * 255.0f) + 0.5f * 255.0f);
+            Scales[i * 3 + c] = ToUint8((ToPlyLogScale(S.Scale[c]) + 10.0f) * 16.0f);
+        }
+        Alphas[i] = ToUint8(S.Opacity * 255.0f);
+
+        // Only xyz is stored; w is recovered as the positive root
+        FVector4f Rotation = ToPlyRotation(S.Orientation);
+        const float Sign = Rotation[0] < 0.0f ? -1.0f : 1.0f;
+        for (int32 c = 0; c < 3; ++c)
+            Rotations[i * 3 + c] = ToUint8(Rotation[c + 1] * SpzFlipQ[c] * Sign * 127.5f + 127.5f);
+
+        // Coefficient-major with the three channels interleaved
+        uint8 *SplatSH = SH + i * NumCoeffs * 3;
+        for (int32 j = 0; j < NumCoeffs; ++j)
+        {
+            for (int32 c = 0; c < 3; ++c)
+                SplatSH[j * 3 + c] = QuantizeSH(GetRestCoeff(S, c, j) * SpzFlipSH[j], j);
+        }
+    }
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Raw.Num());
+    OutBytes.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Gzip, OutBytes.GetData(), CompressedSize, Raw.GetData(), Raw.Num()))
+    {
+        OutError = TEXT("Gzip compression failed");
+        return false;
+    }
+    OutBytes.SetNum(CompressedSize);
+    return true;
+}
+
+bool DecodeSpz(TConstArrayView<uint8> Bytes, TArray<FGaussianSplatData> &OutSplats, FString &OutError)
+{
+    // The uncompressed size is the last four bytes of the gzip member (modulo 2^32, which the 2 GB limit covers)
+    if (Bytes.Num() < 18 || Bytes[0] != 0x1f || Bytes[1] != 0x8b)
+    {
+        OutError = TEXT("Not a gzip stream");
+        return false;
+    }
+    uint32 RawSize = 0;
+    FMemory::Memcpy(&RawSize, Bytes.GetData() + Bytes.Num() - 4, sizeof(RawSize));
+    if (RawSize < sizeof(FSpzHeader) || RawSize > uint32(MAX_int32))
+    {
+        OutError = FString::Printf(TEXT("Bad uncompressed size %u"), RawSize);
+        return false;
+    }
+
+    TArray<uint8> Raw;
+    Raw.SetNumUninitialized(int32(RawSize));
+    if (!FCompression::UncompressMemory(NAME_Gzip, Raw.GetData(), Raw.Num(), Bytes.GetData(), Bytes.Num()))
+    {
+        OutError = TEXT("Gzip decompression failed");
+        return false;
+    }
+
+    FSpzHeader Header;
+    FMemory::Memcpy(&Header, Raw.GetData(), sizeof(Header));
+    if (Header.Magic != FSpzHeader::MagicValue || Header.Version != FSpzHeader::CurrentVersion)
+    {
+        OutError = FString::Printf(TEXT("Unsupported .spz header (magic 0x%08x, version %u)"), Header.Magic,
+                                   Header.Version);
+        return false;
+    }
+    if (Header.SHDegree > 3 || Header.FractionalBits > 23)
+    {
+        OutError = FString::Printf(TEXT("Unsupported .spz SH degree %d or fractional bits %d"), Header.SHDegree,
+                                   Header.FractionalBits);
+        return false;
+    }
+
+    const int32 NumCoeffs = GetNumSHCoeffs(Header.SHDegree);
+    if (sizeof(FSpzHeader) + int64(Header.NumPoints) * (9 + 1 + 3 + 3 + 3 + NumCoeffs * 3) != RawSize)
+    {
+        OutError = FString::Printf(TEXT("%u points at SH degree %d do not match the %u byte payload"),
+                                   Header.NumPoints, Header.SHDegree, RawSize);
+        return false;
+    }
+    const int32 N = int32(Header.NumPoints);
+
+    const uint8 *Positions = Raw.GetData() + sizeof(FSpzHeader);
+    const uint8 *Alphas = Positions + N * 9;
+    const uint8 *Colors = Alphas + N;
+    const uint8 *Scales = Colors + N * 3;
+    const uint8 *Rotations = Scales + N * 3;
+    const uint8 *SH = Rotations + N * 3;
+
+    const float InvFixedScale = 1.0f / float(1 << Header.FractionalBits);
+    OutSplats.Reset();
+    OutSplats.SetNum(N);
+    for (int32 i = 0; i < N; ++i)
+    {
+        FGaussianSplatData &S = OutSplats[i];
+        FVector3f Position;
+        FVector3f LogScale;
+        FVector3f Rotation;
+        for (int32 c = 0; c < 3; ++c)
+        {
+            const uint8 *Src = Positions + i * 9 + c * 3;
+            int32 Fixed = Src[0] | (Src[1] << 8) | (Src[2] << 16);
+            if (Fixed & 0x800000)
+                Fixed |= int32(0xff000000);
+            Position[c] = Fixed * InvFixedScale;
+
+            S.ZeroOrderHarmonicsCoefficients[c] = (Colors[i * 3 + c] / 255.0f - 0.5f) / SpzColorScale;
+            LogScale[c] = Scales[i * 3 + c] / 16.0f - 10.0f;
+            Rotation[c] = (Rotations[i * 3 + c] / 127.5f - 1.0f) * SpzFlipQ[c];
+        }
+        Position *= FVector3f(1.0f, -1.0f, -1.0f);
+        S.Position = FGaussianSplatData::ConvertPositionToUnreal(Position.X, Position.Y, Position.Z);
+        S.Scale = FGaussianSplatData::ConvertScaleToUnreal(LogScale.X, LogScale.Y, LogScale.Z);
+        S.Opacity = Alphas[i] / 255.0f;
+        const float W = FMath::Sqrt(FMath::Max(0.0f, 1.0f - Rotation.SizeSquared()));
+        S.Orientation = FGaussianSplatData::ConvertOrientationToUnreal(W, Rotation.X, Rotation.Y, Rotation.Z);
+
+        S.HighOrderHarmonicsCoefficients.SetNumZeroed(NumCoeffs);
+        const uint8 *SplatSH = SH + i * NumCoeffs * 3;
+        for (int32 j = 0; j < NumCoeffs; ++j)
+        {
+            for (int32 c = 0; c < 3; ++c)
+                SetRestCoeff(S, c, j, (SplatSH[j * 3 + c] - 128.0f) / 128.0f * SpzFlipSH[j]);
+        }
+    }
+    return true;
+}
+} // namespace GaussianSplatCompactFile
+
+EGaussianSplatCompactFormat FGaussianSplatCompactFile::GetFormat(const FString &FilePath)
+{
+    const FString Extension = FPaths::GetExtension(FilePath);
+    if (Extension.Equals(TEXT("splat"), ESearchCase::IgnoreCase))
+        return EGaussianSplatCompactFormat::Splat;
+    if (Extension.Equals(TEXT("spz"), ESearchCase::IgnoreCase))
+        return EGaussianSplatCompactFormat::Spz;
+    return EGaussianSplatCompactFormat::Unknown;
+}
+
+const TCHAR *FGaussianSplatCompactFile::GetExtension(EGaussianSplatCompactFormat Format)
+{
+    switch (Format)
+    {
+    case EGaussianSplatCompactFormat::Splat:
+        return TEXT("splat");
+    case EGaussianSplatCompactFormat::Spz:
+        return TEXT("spz");
+    default:
+        return TEXT("");
+    }
+}
+
+bool FGaussianSplatCompactFile::Encode(EGaussianSplatCompactFormat Format, TConstArrayView<FGaussianSplatData> Splats,
+                                       const FGaussianSplatCompactSettings &Settings, TArray<uint8> &OutBytes,
+                                       FString &OutError)
+{
+    using namespace GaussianSplatCompactFile;
+
+    GSPLAT_SCOPE(Pack);
+    switch (Format)
+    {
+    case EGaussianSplatCompactFormat::Splat:
+        if (int64(Splats.Num()) * sizeof(FSplatRecord) > MAX_int32)
+        {
+            OutError = FString::Printf(TEXT("%d splats exceed the 2 GB .splat limit"), Splats.Num());
+            return false;
+        }
+        EncodeSplat(Splats, OutBytes);
+        return true;
+    case EGaussianSplatCompactFormat::Spz:
+        return EncodeSpz(Splats, Settings, OutBytes, OutError);
+    default:
+        OutError = TEXT("Unknown compact format");
+        return false;
+    }
+}
+
+bool FGaussianSplatCompactFile::Decode(EGaussianSplatCompactFormat Format, TConstArrayView<uint8> Bytes,
+                                       TArray<FGaussianSplatData> &OutSplats, FString &OutError)
+{
+    using namespace GaussianSplatCompactFile;
+
+    GSPLAT_SCOPE(Decode);
+    switch (Format)
+    {
+    case EGaussianSplatCompactFormat::Splat:
+        return DecodeSplat(Bytes, OutSplats, OutError);
+    case EGaussianSplatCompactFormat::Spz:
+        return DecodeSpz(Bytes, OutSplats, OutError);
+    default:
+        OutError = TEXT("Unknown compact format");
+        return false;
+    }
+}
+
+bool FGaussianSplatCompactFile::Read(const FString &FilePath, TArray<FGaussianSplatData> &OutSplats,
+                                     FString &OutError)
+{
+    TArray<uint8> Bytes;
+    {
+        GSPLAT_SCOPE(FileRead);
+        if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+        {
+            OutError = FString::Printf(TEXT("Failed to read: %s"), *FilePath);
+            return false;
+        }
+    }
+
+    FString Error;
+    if (!Decode(GetFormat(FilePath), Bytes, OutSplats, Error))
+    {
+        OutError = FString::Printf(TEXT("%s: %s"), *FilePath, *Error);
+        return false;
+    }
+    return true;
+}
+
+bool FGaussianSplatCompactFile::Write(const FString &FilePath, TConstArrayView<FGaussianSplatData> Splats,
+                                      const FGaussianSplatCompactSettings &Settings, FString &OutError)
+{
+    TArray<uint8> Bytes;
+    if (!Encode(GetFormat(FilePath), Splats, Settings, Bytes, OutError))
+        return false;
+    if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+    {
+        OutError = FString::Printf(TEXT("Failed to write: %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
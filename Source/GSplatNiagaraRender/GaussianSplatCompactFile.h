@@ -0,0 +1,54 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+enum class EGaussianSplatCompactFormat : uint8
+{
+    // antimatter15 .splat: 32 byte records (float3 position, float3 linear scale, RGBA8, quantized wxyz rotation).
+    // SH0 only; higher-order SH and normals are dropped.
+    Splat,
+    // Niantic .spz (version 2): gzipped attribute streams with 24-bit fixed point positions and 8-bit everything
+    // else, including SH up to degree 3
+    Spz,
+    Unknown
+};
+
+struct FGaussianSplatCompactSettings
+{
+    // .spz only. SH above this degree is dropped; clouds with less SH keep what they have.
+    int32 MaxSHDegree = 3;
+    // .spz only. Position precision is 1 / 2^FractionalBits metres, range +-2^(23 - FractionalBits) metres.
+    int32 FractionalBits = 12;
+};
+
+/**
+ * Readers and writers for the compact community splat formats, as an alternative to raw float PLY. Both formats
+ * store the PLY-space attributes (metres, Y-down, log scale), so clouds go through the same FGaussianSplatData
+ * conversions as FPLYParser on the way in and their inverses on the way out. Encoding is lossy; the
+ * GaussianSplatConvert commandlet reports the round-trip error.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatCompactFile
+{
+public:
+    // From the extension (.splat, .spz); Unknown for anything else, including .ply
+    static EGaussianSplatCompactFormat GetFormat(const FString &FilePath);
+
+    static bool IsCompactFile(const FString &FilePath)
+    {
+        return GetFormat(FilePath) != EGaussianSplatCompactFormat::Unknown;
+    }
+
+    static const TCHAR *GetExtension(EGaussianSplatCompactFormat Format);
+
+    static bool Read(const FString &FilePath, TArray<FGaussianSplatData> &OutSplats, FString &OutError);
+
+    static bool Write(const FString &FilePath, TConstArrayView<FGaussianSplatData> Splats,
+                      const FGaussianSplatCompactSettings &Settings, FString &OutError);
+
+    // In-memory halves of Read and Write
+    static bool Encode(EGaussianSplatCompactFormat Format, TConstArrayView<FGaussianSplatData> Splats,
+                       const FGaussianSplatCompactSettings &Settings, TArray<uint8> &OutBytes, FString &OutError);
+    static bool Decode(EGaussianSplatCompactFormat Format, TConstArrayView<uint8> Bytes,
+                       TArray<FGaussianSplatData> &OutSplats, FString &OutError);
+};
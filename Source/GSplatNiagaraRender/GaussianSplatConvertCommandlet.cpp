@@ -0,0 +1,199 @@
+﻿#include "GaussianSplatConvertCommandlet.h"
+#include "GaussianSplatCleanup.h"
+#include "GaussianSplatCompactFile.h"
+#include "HAL/FileManager.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "PLYParser.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatConvert, Log, All);
+
+namespace GaussianSplatConvert
+{
+// Largest per-attribute differences between a cloud and its decoded copy, in the units FGaussianSplatData uses
+struct FRoundTripError
+{
+    double MeanPosition = 0.0;
+    float MaxPosition = 0.0f;
+    float MaxScaleRatio = 0.0f; // |decoded / source - 1|
+    float MaxRotationDegrees = 0.0f;
+    float MaxOpacity = 0.0f;
+    float MaxColor = 0.0f; // SH0 as a 0..1 color
+    float MaxSH = 0.0f;
+};
+
+FRoundTripError MeasureError(TConstArrayView<FGaussianSplatData> Source, TConstArrayView<FGaussianSplatData> Decoded)
+{
+    FRoundTripError Error;
+    const int32 N = FMath::Min(Source.Num(), Decoded.Num());
+    for (int32 i = 0; i < N; ++i)
+    {
+        const FGaussianSplatData &A = Source[i];
+        const FGaussianSplatData &B = Decoded[i];
+        const float Position = FVector3f::Distance(A.Position, B.Position);
+        Error.MeanPosition += Position;
+        Error.MaxPosition = FMath::Max(Error.MaxPosition, Position);
+        for (int32 c = 0; c < 3; ++c)
+        {
+            if (A.Scale[c] > UE_SMALL_NUMBER)
+                Error.MaxScaleRatio = FMath::Max(Error.MaxScaleRatio, FMath::Abs(B.Scale[c] / A.Scale[c] - 1.0f));
+        }
+        const float Angle = FMath::RadiansToDegrees(A.Orientation.GetNormalized().AngularDistance(B.Orientation));
+        Error.MaxRotationDegrees = FMath::Max(Error.MaxRotationDegrees, Angle);
+        Error.MaxOpacity = FMath::Max(Error.MaxOpacity, FMath::Abs(A.Opacity - B.Opacity));
+        const FLinearColor ColorA = FGaussianSplatData::SHToColor(A.ZeroOrderHarmonicsCoefficients);
+        const FLinearColor ColorB = FGaussianSplatData::SHToColor(B.ZeroOrderHarmonicsCoefficients);
+        Error.MaxColor = FMath::Max(Error.MaxColor, FMath::Abs(ColorA.R - ColorB.R));
+        Error.MaxColor = FMath::Max(Error.MaxColor, FMath::Abs(ColorA.G - ColorB.G));
+        Error.MaxColor = FMath::Max(Error.MaxColor, FMath::Abs(ColorA.B - ColorB.B));
+        // Only the coefficients the format kept
+        const int32 NumSH = FMath::Min(A.HighOrderHarmonicsCoefficients.Num(), B.HighOrderHarmonicsCoefficients.Num());
+        for (int32 k = 0; k < NumSH; ++k)
+        {
+            const FVector3f Delta = A.HighOrderHarmonicsCoefficients[k] - B.HighOrderHarmonicsCoefficients[k];
+            Error.MaxSH = FMath::Max(Error.MaxSH, Delta.GetAbsMax());
+        }
+    }
+    Error.MeanPosition /= FMath::Max(N, 1);
+    return Error;
+}
+
+// Output path for one input: next to it, inside OutputDir, or Output itself for a single file
+FString MakeOutputPath(const FString &Input, const FString &Output, bool bOutputIsDirectory,
+                       EGaussianSplatCompactFormat Format)
+{
+    const FString FileName =
+        FPaths::GetBaseFilename(Input) + TEXT(".") + FGaussianSplatCompactFile::GetExtension(Format);
+    if (Output.IsEmpty())
+        return FPaths::GetPath(Input) / FileName;
+    return bOutputIsDirectory ? Output / FileName : Output;
+}
+} // namespace GaussianSplatConvert
+
+UGaussianSplatConvertCommandlet::UGaussianSplatConvertCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UGaussianSplatConvertCommandlet::Main(const FString &Params)
+{
+    using namespace GaussianSplatConvert;
+
+    FString Input;
+    if (!FParse::Value(*Params, TEXT("Input="), Input))
+    {
+        UE_LOG(LogGaussianSplatConvert, Error, TEXT("Missing -Input=<file.ply|dir>"));
+        return 1;
+    }
+    FString Output;
+    FParse::Value(*Params, TEXT("Output="), Output);
+
+    FString FormatName = TEXT("spz");
+    FParse::Value(*Params, TEXT("Format="), FormatName);
+    const EGaussianSplatCompactFormat Format = FGaussianSplatCompactFile::GetFormat(TEXT("x.") + FormatName);
+    if (Format == EGaussianSplatCompactFormat::Unknown)
+    {
+        UE_LOG(LogGaussianSplatConvert, Error, TEXT("Unknown -Format=%s (expected spz or splat)"), *FormatName);
+        return 1;
+    }
+
+    FGaussianSplatCompactSettings Settings;
+    FParse::Value(*Params, TEXT("SHDegree="), Settings.MaxSHDegree);
+    FParse::Value(*Params, TEXT("FractionalBits="), Settings.FractionalBits);
+    const bool bVerify = FParse::Param(*Params, TEXT("Verify"));
+    const bool bCleanup = FParse::Param(*Params, TEXT("Cleanup"));
+    FGaussianSplatCleanupSettings CleanupSettings;
+    CleanupSettings.bMergeDuplicates = true;
+
+    TArray<FString> Inputs;
+    const bool bInputIsDirectory = IFileManager::Get().DirectoryExists(*Input);
+    if (bInputIsDirectory)
+    {
+        TArray<FString> Names;
+        IFileManager::Get().FindFiles(Names, *(Input / TEXT("*.ply")), true, false);
+        Names.Sort();
+        for (const FString &Name : Names)
+            Inputs.Add(Input / Name);
+    }
+    else
+    {
+        Inputs.Add(Input);
+    }
+    if (Inputs.Num() == 0)
+    {
+        UE_LOG(LogGaussianSplatConvert, Error, TEXT("No .ply files in %s"), *Input);
+        return 1;
+    }
+
+    const bool bOutputIsDirectory =
+        !Output.IsEmpty() && (bInputIsDirectory || IFileManager::Get().DirectoryExists(*Output));
+    if (bOutputIsDirectory)
+        IFileManager::Get().MakeDirectory(*Output, true);
+
+    int32 NumFailed = 0;
+    int64 TotalSourceBytes = 0;
+    int64 TotalOutputBytes = 0;
+    TArray<FGaussianSplatData> Splats;
+    TArray<FGaussianSplatData> Decoded;
+    for (const FString &SourcePath : Inputs)
+    {
+        const FString OutputPath = MakeOutputPath(SourcePath, Output, bOutputIsDirectory, Format);
+        const double Start = FPlatformTime::Seconds();
+
+        FPLYParser Parser;
+        if (!Parser.ParseFile(SourcePath, Splats))
+        {
+            UE_LOG(LogGaussianSplatConvert, Error, TEXT("%s: %s"), *SourcePath, *Parser.GetErrorMessage());
+            ++NumFailed;
+            continue;
+        }
+
+        if (bCleanup)
+        {
+            const int32 NumBefore = Splats.Num();
+            const FGaussianSplatCleanupStats Removed = FGaussianSplatCleanup::Apply(CleanupSettings, Splats);
+            UE_LOG(LogGaussianSplatConvert, Display, TEXT("%s: cleanup %s of %d"), *SourcePath, *Removed.ToString(),
+                   NumBefore);
+        }
+
+        FString Error;
+        if (!FGaussianSplatCompactFile::Write(OutputPath, Splats, Settings, Error))
+        {
+            UE_LOG(LogGaussianSplatConvert, Error, TEXT("%s: %s"), *SourcePath, *Error);
+            ++NumFailed;
+            continue;
+        }
+
+        const int64 SourceBytes = IFileManager::Get().FileSize(*SourcePath);
+        const int64 OutputBytes = IFileManager::Get().FileSize(*OutputPath);
+        TotalSourceBytes += SourceBytes;
+        TotalOutputBytes += OutputBytes;
+        UE_LOG(LogGaussianSplatConvert, Display, TEXT("%s -> %s | %d splats | %lld -> %lld bytes (%.1fx) | %.2f s"),
+               *SourcePath, *OutputPath, Splats.Num(), SourceBytes, OutputBytes,
+               double(SourceBytes) / FMath::Max<int64>(OutputBytes, 1), FPlatformTime::Seconds() - Start);
+
+        if (!bVerify)
+            continue;
+        if (!FGaussianSplatCompactFile::Read(OutputPath, Decoded, Error) || Decoded.Num() != Splats.Num())
+        {
+            UE_LOG(LogGaussianSplatConvert, Error, TEXT("%s: read back failed (%d of %d splats) %s"), *OutputPath,
+                   Decoded.Num(), Splats.Num(), *Error);
+            ++NumFailed;
+            continue;
+        }
+        const FRoundTripError RoundTrip = MeasureError(Splats, Decoded);
+        UE_LOG(LogGaussianSplatConvert, Display,
+               TEXT("  round trip | position mean %.4f max %.4f cm | scale %.2f%% | rotation %.3f deg | opacity %.4f | "
+                    "color %.4f | SH %.4f"),
+               RoundTrip.MeanPosition, RoundTrip.MaxPosition, RoundTrip.MaxScaleRatio * 100.0f,
+               RoundTrip.MaxRotationDegrees, RoundTrip.MaxOpacity, RoundTrip.MaxColor, RoundTrip.MaxSH);
+    }
+
+    UE_LOG(LogGaussianSplatConvert, Display, TEXT("Converted %d of %d files | %lld -> %lld bytes (%.1fx)"),
+           Inputs.Num() - NumFailed, Inputs.Num(), TotalSourceBytes, TotalOutputBytes,
+           double(TotalSourceBytes) / FMath::Max<int64>(TotalOutputBytes, 1));
+    return NumFailed == 0 ? 0 : 1;
+}
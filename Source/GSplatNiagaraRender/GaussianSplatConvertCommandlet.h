@@ -0,0 +1,25 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "GaussianSplatConvertCommandlet.generated.h"
+
+/**
+ * Converts PLY splat clouds to the compact .spz or .splat formats. -Verify reads each output back and logs the
+ * round-trip error against the PLY, so the quantization can be checked on real captures before a library is
+ * converted. -Cleanup drops degenerate splats and merges near-duplicates (default FGaussianSplatCleanupSettings
+ * tolerances) before writing.
+ *
+ * UnrealEditor-Cmd <Project> -run=GaussianSplatConvert -Input=<file.ply|dir> [-Output=<file|dir>]
+ *     [-Format=spz|splat] [-SHDegree=3] [-FractionalBits=12] [-Cleanup] [-Verify]
+ */
+UCLASS()
+class UGaussianSplatConvertCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGaussianSplatConvertCommandlet();
+
+    virtual int32 Main(const FString &Params) override;
+};
@@ -0,0 +1,87 @@
+﻿#include "GaussianSplatCulling.h"
+#include "Async/ParallelFor.h"
+#include "ConvexVolume.h"
+#include "GaussianSplatStats.h"
+
+void FGaussianSplatCulling::BuildParams(const FMatrix &LocalToClip, float ViewHeight, float RadiusScale,
+                                        float MinPixelRadius, FGaussianSplatCullParams &OutParams)
+{
+    FConvexVolume Frustum;
+    GetViewFrustumBounds(Frustum, LocalToClip, true);
+
+    OutParams.NumPlanes = FMath::Min(Frustum.Planes.Num(), FGaussianSplatCullParams::MaxPlanes);
+    for (int32 i = 0; i < OutParams.NumPlanes; ++i)
+    {
+        const FPlane &Plane = Frustum.Planes[i];
+        OutParams.Planes[i] = FVector4f(float(Plane.X), float(Plane.Y), float(Plane.Z), float(Plane.W));
+    }
+    OutParams.RadiusScale = RadiusScale;
+
+    // Clip W is view depth for perspective and constant for orthographic views; clip Y over W spans 2 at the height
+    // of the view, so a local length L along Y covers L * |column 1| * ViewHeight / 2 / W pixels
+    OutParams.DepthPlane = FVector4f(float(LocalToClip.M[0][3]), float(LocalToClip.M[1][3]),
+                                     float(LocalToClip.M[2][3]), float(LocalToClip.M[3][3]));
+    const FVector ClipY(LocalToClip.M[0][1], LocalToClip.M[1][1], LocalToClip.M[2][1]);
+    OutParams.PixelScale = float(ClipY.Size()) * ViewHeight * 0.5f;
+    OutParams.MinPixelRadius = FMath::Max(MinPixelRadius, 0.0f);
+}
+
+bool FGaussianSplatCulling::IsVisible(const FGaussianSplatCullParams &Params, const FVector3f &Position,
+                                      float BoundingRadius, uint32 Index)
+{
+    const float Radius = Params.RadiusScale * BoundingRadius;
+    for (int32 i = 0; i < Params.NumPlanes; ++i)
+    {
+        const FVector4f &Plane = Params.Planes[i];
+        if (Plane.X * Position.X + Plane.Y * Position.Y + Plane.Z * Position.Z - Plane.W > Radius)
+            return false;
+    }
+
+    const float MinPixelRadius = Params.GetSubPixelRadius();
+    if (MinPixelRadius > 0.0f)
+    {
+        const float Keep = GetKeepProbability(GetPixelRadius(Params, Position, BoundingRadius), MinPixelRadius);
+        return HashIndex(Index) < Keep;
+    }
+    return true;
+}
+
+int32 FGaussianSplatCulling::Cull(const FGaussianSplatCullParams &Params, TConstArrayView<FGaussianSplatData> Splats,
+                                  TArray<int32> &OutVisible)
+{
+    GSPLAT_SCOPE(Cull);
+    OutVisible.Reset();
+    if (!Params.bEnabled)
+    {
+        OutVisible.SetNumUninitialized(Splats.Num());
+        for (int32 i = 0; i < Splats.Num(); ++i)
+            OutVisible[i] = i;
+        return Splats.Num();
+    }
+
+    // Each chunk fills its own list so the result stays in index order whatever the scheduling
+    constexpr int32 ChunkSize = 16384;
+    const int32 NumChunks = FMath::DivideAndRoundUp(Splats.Num(), ChunkSize);
+    TArray<TArray<int32>> ChunkVisible;
+    ChunkVisible.SetNum(NumChunks);
+    ParallelFor(TEXT("GaussianSplat.Cull"), NumChunks, 1,
+                [&](int32 Chunk)
+                {
+                    const int32 First = Chunk * ChunkSize;
+                    const int32 Last = FMath::Min(First + ChunkSize, Splats.Num());
+                    TArray<int32> &Visible = ChunkVisible[Chunk];
+                    for (int32 i = First; i < Last; ++i)
+                    {
+                        if (IsVisible(Params, Splats[i].Position, Splats[i].GetBoundingRadius(), uint32(i)))
+                            Visible.Add(i);
+                    }
+                });
+
+    int32 NumVisible = 0;
+    for (const TArray<int32> &Visible : ChunkVisible)
+        NumVisible += Visible.Num();
+    OutVisible.Reserve(NumVisible);
+    for (const TArray<int32> &Visible : ChunkVisible)
+        OutVisible.Append(Visible);
+    return NumVisible;
+}
@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+// Frustum one system instance is culled against, in the system's local space. Sent to the render thread every tick.
+struct FGaussianSplatCullParams
+{
+    static constexpr int32 MaxPlanes = 6;
+
+    // Outward normals: FPlane::PlaneDot above a splat's radius means it is outside
+    FVector4f Planes[MaxPlanes];
+    int32 NumPlanes = 0;
+    // Multiplies FGaussianSplatData::GetBoundingRadius for the frustum test
+    float RadiusScale = 1.0f;
+    // Projected radius in pixels is PixelScale * radius / dot(DepthPlane, position) + DepthPlane.W. Set whenever
+    // there is a player view, even with culling off, so screen sizes can still be queried; PixelScale is 0 otherwise.
+    FVector4f DepthPlane = FVector4f(0.0f, 0.0f, 0.0f, 1.0f);
+    float PixelScale = 0.0f;
+    // Splats whose projected radius is below this are thinned out; 0 keeps them all
+    float MinPixelRadius = 0.0f;
+    // Off when culling is disabled or there is no view to cull against; every splat is then visible
+    bool bEnabled = false;
+
+    bool HasView() const
+    {
+        return PixelScale > 0.0f;
+    }
+
+    // MinPixelRadius when the cull pass actually thins splats, 0 otherwise
+    float GetSubPixelRadius() const
+    {
+        return bEnabled && HasView() ? MinPixelRadius : 0.0f;
+    }
+};
+
+class GSPLATNIAGARARENDER_API FGaussianSplatCulling
+{
+public:
+    // Planes of the frustum of LocalToClip, near plane included, and its screen-size terms for a view ViewHeight
+    // pixels tall. Leaves bEnabled to the caller.
+    static void BuildParams(const FMatrix &LocalToClip, float ViewHeight, float RadiusScale, float MinPixelRadius,
+                            FGaussianSplatCullParams &OutParams);
+
+    // The test GaussianSplatCull.usf runs per splat. Index seeds the sub-pixel thinning.
+    static bool IsVisible(const FGaussianSplatCullParams &Params, const FVector3f &Position, float BoundingRadius,
+                          uint32 Index);
+
+    // Projected bounding radius in pixels; 0 without a view or behind the camera
+    static float GetPixelRadius(const FGaussianSplatCullParams &Params, const FVector3f &Position,
+                                float BoundingRadius)
+    {
+        const float Depth = Params.DepthPlane.X * Position.X + Params.DepthPlane.Y * Position.Y +
+                            Params.DepthPlane.Z * Position.Z + Params.DepthPlane.W;
+        return Depth > 0.0f ? BoundingRadius * Params.PixelScale / Depth : 0.0f;
+    }
+
+    // Chance a splat this many pixels across survives sub-pixel thinning
+    static float GetKeepProbability(float PixelRadius, float MinPixelRadius)
+    {
+        return MinPixelRadius > 0.0f ? FMath::Min(FMath::Square(PixelRadius / MinPixelRadius), 1.0f) : 1.0f;
+    }
+
+    // Opacity of a survivor standing in for its thinned neighbours: keeping a fraction Keep of N overlapping splats
+    // with 1 - (1 - Opacity)^(1 / Keep) each leaves the pixel's expected transmittance (1 - Opacity)^N unchanged
+    static float CompensateOpacity(float Opacity, float Keep)
+    {
+        if (Keep >= 1.0f)
+            return Opacity;
+        return 1.0f - FMath::Pow(FMath::Clamp(1.0f - Opacity, 0.0f, 1.0f), 1.0f / FMath::Max(Keep, 1.0e-4f));
+    }
+
+    // Uniform in [0, 1), the same as HashIndex in GaussianSplatCull.usf
+    static float HashIndex(uint32 Index)
+    {
+        uint32 H = Index;
+        H ^= H >> 16;
+        H *= 0x85ebca6bu;
+        H ^= H >> 13;
+        H *= 0xc2b2ae35u;
+        H ^= H >> 16;
+        return float(H >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // CPU fallback of the GPU pass: the same visible set, in the same ascending index order.
+    // Returns the visible count.
+    static int32 Cull(const FGaussianSplatCullParams &Params, TConstArrayView<FGaussianSplatData> Splats,
+                      TArray<int32> &OutVisible);
+};
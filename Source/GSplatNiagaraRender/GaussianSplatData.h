@@ -3,6 +3,16 @@
 #include "CoreMinimal.h"
 #include "GaussianSplatData.generated.h"
 
+// How splat attributes are laid out in GPU memory
+UENUM(BlueprintType)
+enum class EGaussianSplatBufferLayout : uint8
+{
+    // Four Buffer<float4> streams: position, scale, orientation, SH0 + opacity
+    SeparateStreams,
+    // One ByteAddressBuffer of 64 byte records; a splat's fields share a cache line
+    Interleaved
+};
+
 /**
  * Represents parsed data for a single splat, loaded from a PLY file.
  */
@@ -68,6 +78,26 @@ struct FGaussianSplatData
         return 1.0f / (1.0f + FMath::Exp(-O));
     }
 
+    // Moves the splat into the space of T. Splat scale is multiplied per axis, which is exact for uniform scale and
+    // an approximation for non-uniform scale on rotated splats.
+    void ApplyTransform(const FTransform3f &T)
+    {
+        Position = T.TransformPosition(Position);
+        Normal = T.TransformVectorNoScale(Normal);
+        Orientation = T.GetRotation() * Orientation;
+        Orientation.Normalize();
+        Scale *= T.GetScale3D().GetAbs();
+    }
+
+    // Bounding sphere radius used for culling and screen size: BoundingSigma standard deviations along the largest
+    // axis, which contains the splat whatever its orientation
+    static constexpr float BoundingSigma = 3.0f;
+
+    float GetBoundingRadius() const
+    {
+        return BoundingSigma * Scale.GetAbsMax();
+    }
+
     // SH0 to linear color
     static FLinearColor SHToColor(const FVector3f &SHCoeffs)
     {
@@ -79,3 +109,48 @@ struct FGaussianSplatData
                             1.0f);
     }
 };
+
+/**
+ * GPU-ready record for a single splat, matching the four float4 streams the NDI binds.
+ * Used wherever splats are stored outside FGaussianSplatData (tiled files, streaming pools).
+ */
+struct FGaussianSplatPackedRecord
+{
+    // W is FGaussianSplatData::GetBoundingRadius
+    FVector4f Position;
+    FVector4f Scale;
+    FVector4f Orientation;
+    FVector4f SHZeroCoeffsAndOpacity;
+
+    static FGaussianSplatPackedRecord FromSplat(const FGaussianSplatData &S)
+    {
+        FGaussianSplatPackedRecord R;
+        R.Position = FVector4f(S.Position.X, S.Position.Y, S.Position.Z, S.GetBoundingRadius());
+        R.Scale = FVector4f(S.Scale.X, S.Scale.Y, S.Scale.Z, 0.f);
+        R.Orientation = FVector4f(S.Orientation.X, S.Orientation.Y, S.Orientation.Z, S.Orientation.W);
+        R.SHZeroCoeffsAndOpacity = FVector4f(S.ZeroOrderHarmonicsCoefficients.X, S.ZeroOrderHarmonicsCoefficients.Y,
+                                             S.ZeroOrderHarmonicsCoefficients.Z, S.Opacity);
+        return R;
+    }
+
+    // Inverse of FromSplat; higher-order SH and normals are not part of the record
+    FGaussianSplatData ToSplat() const
+    {
+        FGaussianSplatData S;
+        S.Position = FVector3f(Position.X, Position.Y, Position.Z);
+        S.Scale = FVector3f(Scale.X, Scale.Y, Scale.Z);
+        S.Orientation = FQuat4f(Orientation.X, Orientation.Y, Orientation.Z, Orientation.W);
+        S.ZeroOrderHarmonicsCoefficients =
+            FVector3f(SHZeroCoeffsAndOpacity.X, SHZeroCoeffsAndOpacity.Y, SHZeroCoeffsAndOpacity.Z);
+        S.Opacity = SHZeroCoeffsAndOpacity.W;
+        return S;
+    }
+
+    // Byte offsets of each field inside the record, as read by the interleaved HLSL path
+    static constexpr uint32 PositionOffset = 0;
+    static constexpr uint32 ScaleOffset = 16;
+    static constexpr uint32 OrientationOffset = 32;
+    static constexpr uint32 SHZeroCoeffsAndOpacityOffset = 48;
+    static constexpr uint32 OpacityOffset = 60;
+};
+static_assert(sizeof(FGaussianSplatPackedRecord) == 4 * sizeof(FVector4f), "Packed splat record must be 64 bytes");
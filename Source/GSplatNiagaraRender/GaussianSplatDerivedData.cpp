@@ -0,0 +1,310 @@
+﻿#include "GaussianSplatDerivedData.h"
+#include "GaussianSplatCompactFile.h"
+#include "GaussianSplatStats.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "PLYParser.h"
+#include <atomic>
+
+#if WITH_EDITOR
+#include "DerivedDataCacheInterface.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatDDC, Log, All);
+
+static bool GGaussianSplatDDCEnabled = true;
+static FAutoConsoleVariableRef CVarGaussianSplatDDCEnabled(
+    TEXT("gsplat.DDC.Enabled"), GGaussianSplatDDCEnabled,
+    TEXT("Cache parsed PLY clouds in the Derived Data Cache (editor only)."), ECVF_Default);
+
+static bool GGaussianSplatDDCCompress = true;
+static FAutoConsoleVariableRef CVarGaussianSplatDDCCompress(
+    TEXT("gsplat.DDC.Compress"), GGaussianSplatDDCCompress,
+    TEXT("Oodle-compress cloud blobs before putting them in the Derived Data Cache."), ECVF_Default);
+
+namespace GaussianSplatDerivedData
+{
+// Bump when the parser output or the blob layout changes
+const TCHAR *FormatVersion = TEXT("7C1D4E2A-0B35-4F8E-9A61-3D2B5C8E1F01");
+
+constexpr uint32 BlobMagic = 0x44505347; // 'GSPD'
+constexpr uint32 BlobVersion = 1;
+
+struct FBlobHeader
+{
+    uint32 Magic = BlobMagic;
+    uint32 Version = BlobVersion;
+    int32 NumSplats = 0;
+    // High order SH coefficients per splat; the parser produces the same count for every splat of a file
+    int32 NumSHCoeffs = 0;
+    int32 RawSize = 0;
+    uint32 bCompressed = 0;
+};
+
+// Position, normal, orientation, scale, opacity, SH0, then NumSHCoeffs float3
+constexpr int32 FixedFloatsPerSplat = 3 + 3 + 4 + 3 + 1 + 3;
+
+std::atomic<int64> GHits{0};
+std::atomic<int64> GMisses{0};
+std::atomic<int64> GPuts{0};
+std::atomic<int64> GSkipped{0};
+std::atomic<int64> GBytesRead{0};
+std::atomic<int64> GBytesWritten{0};
+
+// Hashing a multi-GB file costs a full read, so hashes are remembered until the file's size or timestamp changes
+struct FFileHash
+{
+    int64 Size = 0;
+    FDateTime Timestamp;
+    FString Hash;
+};
+FCriticalSection GFileHashLock;
+TMap<FString, FFileHash> GFileHashes;
+} // namespace GaussianSplatDerivedData
+
+bool FGaussianSplatDerivedData::GetFileHash(const FString &FilePath, FString &OutHash)
+{
+    using namespace GaussianSplatDerivedData;
+
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+    if (!StatData.bIsValid || StatData.bIsDirectory)
+        return false;
+
+    {
+        FScopeLock Lock(&GFileHashLock);
+        const FFileHash *Cached = GFileHashes.Find(FilePath);
+        if (Cached && Cached->Size == StatData.FileSize && Cached->Timestamp == StatData.ModificationTime)
+        {
+            OutHash = Cached->Hash;
+            return true;
+        }
+    }
+
+    const FMD5Hash Hash = FMD5Hash::HashFile(*FilePath);
+    if (!Hash.IsValid())
+        return false;
+    OutHash = LexToString(Hash);
+
+    FScopeLock Lock(&GFileHashLock);
+    GFileHashes.Add(FilePath, FFileHash{StatData.FileSize, StatData.ModificationTime, OutHash});
+    return true;
+}
+
+static FAutoConsoleCommand GGaussianSplatDDCStatsCommand(
+    TEXT("gsplat.DDC.Stats"), TEXT("Prints Derived Data Cache hit and miss counters for splat clouds."),
+    FConsoleCommandDelegate::CreateLambda(
+        []()
+        {
+            const FGaussianSplatDerivedDataStats Stats = FGaussianSplatDerivedData::GetStats();
+            UE_LOG(LogGaussianSplatDDC, Display,
+                   TEXT("Splat DDC: Hits=%lld | Misses=%lld | Puts=%lld | Skipped=%lld | Read=%.1f MB | "
+                        "Written=%.1f MB"),
+                   Stats.Hits, Stats.Misses, Stats.Puts, Stats.Skipped, double(Stats.BytesRead) / (1024.0 * 1024.0),
+                   double(Stats.BytesWritten) / (1024.0 * 1024.0));
+        }));
+
+FGaussianSplatDerivedDataStats FGaussianSplatDerivedData::GetStats()
+{
+    using namespace GaussianSplatDerivedData;
+    FGaussianSplatDerivedDataStats Stats;
+    Stats.Hits = GHits.load();
+    Stats.Misses = GMisses.load();
+    Stats.Puts = GPuts.load();
+    Stats.Skipped = GSkipped.load();
+    Stats.BytesRead = GBytesRead.load();
+    Stats.BytesWritten = GBytesWritten.load();
+    return Stats;
+}
+
+void FGaussianSplatDerivedData::Serialize(TConstArrayView<FGaussianSplatData> Splats, bool bCompress,
+                                          TArray<uint8> &OutBlob)
+{
+    using namespace GaussianSplatDerivedData;
+    GSPLAT_SCOPE(Pack);
+
+    FBlobHeader Header;
+    Header.NumSplats = Splats.Num();
+    Header.NumSHCoeffs = Splats.Num() > 0 ? Splats[0].HighOrderHarmonicsCoefficients.Num() : 0;
+    const int32 FloatsPerSplat = FixedFloatsPerSplat + Header.NumSHCoeffs * 3;
+    const int64 RawSize64 = int64(Splats.Num()) * FloatsPerSplat * sizeof(float);
+    OutBlob.Reset();
+    if (RawSize64 > MAX_int32 - int64(sizeof(FBlobHeader)))
+        return;
+    Header.RawSize = int32(RawSize64);
+
+    TArray<float> Raw;
+    Raw.SetNumUninitialized(Splats.Num() * FloatsPerSplat);
+    float *Out = Raw.GetData();
+    for (const FGaussianSplatData &Splat : Splats)
+    {
+        const FVector3f *Vectors[] = {&Splat.Position, &Splat.Normal};
+        for (const FVector3f *V : Vectors)
+        {
+            *Out++ = V->X;
+            *Out++ = V->Y;
+            *Out++ = V->Z;
+        }
+        *Out++ = Splat.Orientation.X;
+        *Out++ = Splat.Orientation.Y;
+        *Out++ = Splat.Orientation.Z;
+        *Out++ = Splat.Orientation.W;
+        *Out++ = Splat.Scale.X;
+        *Out++ = Splat.Scale.Y;
+        *Out++ = Splat.Scale.Z;
+        *Out++ = Splat.Opacity;
+        *Out++ = Splat.ZeroOrderHarmonicsCoefficients.X;
+        *Out++ = Splat.ZeroOrderHarmonicsCoefficients.Y;
+        *Out++ = Splat.ZeroOrderHarmonicsCoefficients.Z;
+        // Splats with fewer coefficients than the first are padded with zeros, extra ones are dropped
+        for (int32 c = 0; c < Header.NumSHCoeffs; ++c)
+        {
+            const FVector3f Coeff = Splat.HighOrderHarmonicsCoefficients.IsValidIndex(c)
+                                        ? Splat.HighOrderHarmonicsCoefficients[c]
+                                        : FVector3f::ZeroVector;
+            *Out++ = Coeff.X;
+            *Out++ = Coeff.Y;
+            *Out++ = Coeff.Z;
+        }
+    }
+
+    int32 PayloadSize = Header.RawSize;
+    const void *Payload = Raw.GetData();
+    TArray<uint8> Compressed;
+    if (bCompress && Header.RawSize > 0)
+    {
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Header.RawSize);
+        Compressed.SetNumUninitialized(CompressedSize);
+        if (FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Raw.GetData(),
+                                         Header.RawSize) &&
+            CompressedSize < Header.RawSize)
+        {
+            Header.bCompressed = 1;
+            PayloadSize = CompressedSize;
+            Payload = Compressed.GetData();
+        }
+    }
+
+    OutBlob.SetNumUninitialized(sizeof(FBlobHeader) + PayloadSize);
+    FMemory::Memcpy(OutBlob.GetData(), &Header, sizeof(FBlobHeader));
+    FMemory::Memcpy(OutBlob.GetData() + sizeof(FBlobHeader), Payload, PayloadSize);
+}
+
+bool FGaussianSplatDerivedData::Deserialize(TConstArrayView<uint8> Blob, TArray<FGaussianSplatData> &OutSplats)
+{
+    using namespace GaussianSplatDerivedData;
+    GSPLAT_SCOPE(Decode);
+
+    FBlobHeader Header;
+    if (Blob.Num() < int32(sizeof(FBlobHeader)))
+        return false;
+    FMemory::Memcpy(&Header, Blob.GetData(), sizeof(FBlobHeader));
+    const int32 FloatsPerSplat = FixedFloatsPerSplat + Header.NumSHCoeffs * 3;
+    if (Header.Magic != BlobMagic || Header.Version != BlobVersion || Header.NumSplats < 0 ||
+        Header.NumSHCoeffs < 0 || int64(Header.NumSplats) * FloatsPerSplat * sizeof(float) != Header.RawSize)
+        return false;
+
+    const uint8 *Payload = Blob.GetData() + sizeof(FBlobHeader);
+    const int32 PayloadSize = Blob.Num() - int32(sizeof(FBlobHeader));
+    TArray<float> Raw;
+    Raw.SetNumUninitialized(Header.NumSplats * FloatsPerSplat);
+    if (Header.bCompressed)
+    {
+        if (!FCompression::UncompressMemory(NAME_Oodle, Raw.GetData(), Header.RawSize, Payload, PayloadSize))
+            return false;
+    }
+    else
+    {
+        if (PayloadSize != Header.RawSize)
+            return false;
+        FMemory::Memcpy(Raw.GetData(), Payload, PayloadSize);
+    }
+
+    OutSplats.SetNum(Header.NumSplats);
+    const float *In = Raw.GetData();
+    for (FGaussianSplatData &Splat : OutSplats)
+    {
+        Splat.Position = FVector3f(In[0], In[1], In[2]);
+        Splat.Normal = FVector3f(In[3], In[4], In[5]);
+        Splat.Orientation = FQuat4f(In[6], In[7], In[8], In[9]);
+        Splat.Scale = FVector3f(In[10], In[11], In[12]);
+        Splat.Opacity = In[13];
+        Splat.ZeroOrderHarmonicsCoefficients = FVector3f(In[14], In[15], In[16]);
+        In += FixedFloatsPerSplat;
+        Splat.HighOrderHarmonicsCoefficients.SetNumUninitialized(Header.NumSHCoeffs);
+        for (FVector3f &Coeff : Splat.HighOrderHarmonicsCoefficients)
+        {
+            Coeff = FVector3f(In[0], In[1], In[2]);
+            In += 3;
+        }
+    }
+    return true;
+}
+
+bool FGaussianSplatDerivedData::LoadPLY(const FString &FilePath, TArray<FGaussianSplatData> &OutSplats,
+                                        FString &OutError)
+{
+    using namespace GaussianSplatDerivedData;
+
+#if WITH_EDITOR
+    FString FileHash;
+    const bool bUseDDC = GGaussianSplatDDCEnabled && GetFileHash(FilePath, FileHash);
+    FString CacheKey;
+    if (bUseDDC)
+    {
+        CacheKey = FDerivedDataCacheInterface::BuildCacheKey(TEXT("GSPLAT"), FormatVersion, *FileHash);
+        TArray<uint8> Blob;
+        if (GetDerivedDataCacheRef().GetSynchronous(*CacheKey, Blob, FilePath))
+        {
+            if (Deserialize(Blob, OutSplats))
+            {
+                ++GHits;
+                GBytesRead += Blob.Num();
+                UE_LOG(LogGaussianSplatDDC, Verbose, TEXT("Hit %s | %d splats | %d bytes"), *FilePath, OutSplats.Num(),
+                       Blob.Num());
+                return true;
+            }
+            UE_LOG(LogGaussianSplatDDC, Warning, TEXT("Corrupt cache entry for %s, re-parsing"), *FilePath);
+        }
+        ++GMisses;
+    }
+#endif
+
+    if (FGaussianSplatCompactFile::IsCompactFile(FilePath))
+    {
+        if (!FGaussianSplatCompactFile::Read(FilePath, OutSplats, OutError))
+            return false;
+    }
+    else
+    {
+        FPLYParser Parser;
+        if (!Parser.ParseFile(FilePath, OutSplats))
+        {
+            OutError = Parser.GetErrorMessage();
+            return false;
+        }
+    }
+
+#if WITH_EDITOR
+    if (bUseDDC)
+    {
+        TArray<uint8> Blob;
+        Serialize(OutSplats, GGaussianSplatDDCCompress, Blob);
+        if (Blob.Num() > 0)
+        {
+            GetDerivedDataCacheRef().Put(*CacheKey, Blob, FilePath);
+            ++GPuts;
+            GBytesWritten += Blob.Num();
+        }
+        else
+        {
+            ++GSkipped;
+            UE_LOG(LogGaussianSplatDDC, Log, TEXT("%s is too large to cache (%d splats)"), *FilePath,
+                   OutSplats.Num());
+        }
+    }
+#endif
+    return true;
+}
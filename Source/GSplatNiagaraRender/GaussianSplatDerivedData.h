@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+struct FGaussianSplatDerivedDataStats
+{
+    // Cumulative since startup
+    int64 Hits = 0;
+    int64 Misses = 0;
+    int64 Puts = 0;
+    // Misses that could not be cached, e.g. clouds whose blob exceeds the 2 GB DDC value limit
+    int64 Skipped = 0;
+    int64 BytesRead = 0;
+    int64 BytesWritten = 0;
+};
+
+/**
+ * Caches parsed PLY clouds in the Derived Data Cache, so the CDO, duplicates and PIE copies of an NDI (and other
+ * machines sharing the cache) skip parsing. Keys combine a hash of the file contents with the format version
+ * below; bump it whenever the parser's output or the blob layout changes. Without the editor this is a plain
+ * FPLYParser::ParseFile.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatDerivedData
+{
+public:
+    // .spz and .splat files are read with FGaussianSplatCompactFile, anything else as PLY
+    static bool LoadPLY(const FString &FilePath, TArray<FGaussianSplatData> &OutSplats, FString &OutError);
+
+    // Blob round trip, exposed for tools. Deserialize returns false on a corrupt or mismatched blob.
+    static void Serialize(TConstArrayView<FGaussianSplatData> Splats, bool bCompress, TArray<uint8> &OutBlob);
+    static bool Deserialize(TConstArrayView<uint8> Blob, TArray<FGaussianSplatData> &OutSplats);
+
+    // MD5 of the file contents as hex. Remembered per path until the file's size or timestamp changes, so repeated
+    // calls on an unchanged file are a stat. Thread safe.
+    static bool GetFileHash(const FString &FilePath, FString &OutHash);
+
+    static FGaussianSplatDerivedDataStats GetStats();
+};
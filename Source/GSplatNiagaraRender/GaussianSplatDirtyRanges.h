@@ -0,0 +1,101 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGaussianSplatDirtyRange
+{
+    int32 Start = 0;
+    int32 Count = 0;
+
+    int32 End() const
+    {
+        return Start + Count;
+    }
+};
+
+/**
+ * Accumulates edited splat ranges between uploads. Ranges are merged on demand so a burst of small edits becomes a
+ * handful of contiguous buffer writes.
+ */
+class FGaussianSplatDirtyRanges
+{
+public:
+    void Add(int32 Start, int32 Count)
+    {
+        if (Count > 0)
+            Ranges.Add(FGaussianSplatDirtyRange{Start, Count});
+    }
+
+    void AddIndices(TArrayView<const int32> Indices)
+    {
+        if (Indices.Num() == 0)
+            return;
+
+        TArray<int32> Sorted(Indices.GetData(), Indices.Num());
+        Sorted.Sort();
+        FGaussianSplatDirtyRange Run{Sorted[0], 1};
+        for (int32 i = 1; i < Sorted.Num(); ++i)
+        {
+            if (Sorted[i] <= Run.End())
+            {
+                Run.Count = FMath::Max(Run.Count, Sorted[i] - Run.Start + 1);
+                continue;
+            }
+            Ranges.Add(Run);
+            Run = FGaussianSplatDirtyRange{Sorted[i], 1};
+        }
+        Ranges.Add(Run);
+    }
+
+    // Sorts, clamps to [0, NumElements) and joins ranges that overlap or are separated by at most GapTolerance
+    void Merge(int32 NumElements, int32 GapTolerance)
+    {
+        for (FGaussianSplatDirtyRange &Range : Ranges)
+        {
+            const int32 ClampedStart = FMath::Clamp(Range.Start, 0, NumElements);
+            const int32 ClampedEnd = FMath::Clamp(Range.End(), ClampedStart, NumElements);
+            Range = FGaussianSplatDirtyRange{ClampedStart, ClampedEnd - ClampedStart};
+        }
+        Ranges.RemoveAll([](const FGaussianSplatDirtyRange &Range) { return Range.Count <= 0; });
+        Ranges.Sort([](const FGaussianSplatDirtyRange &A, const FGaussianSplatDirtyRange &B)
+                    { return A.Start < B.Start; });
+
+        int32 Write = 0;
+        for (int32 Read = 1; Read < Ranges.Num(); ++Read)
+        {
+            FGaussianSplatDirtyRange &Last = Ranges[Write];
+            const FGaussianSplatDirtyRange &Next = Ranges[Read];
+            if (Next.Start <= Last.End() + GapTolerance)
+                Last.Count = FMath::Max(Last.End(), Next.End()) - Last.Start;
+            else
+                Ranges[++Write] = Next;
+        }
+        Ranges.SetNum(Ranges.Num() > 0 ? Write + 1 : 0, EAllowShrinking::No);
+    }
+
+    int64 GetTotalCount() const
+    {
+        int64 Total = 0;
+        for (const FGaussianSplatDirtyRange &Range : Ranges)
+            Total += Range.Count;
+        return Total;
+    }
+
+    bool IsEmpty() const
+    {
+        return Ranges.Num() == 0;
+    }
+
+    void Reset()
+    {
+        Ranges.Reset();
+    }
+
+    const TArray<FGaussianSplatDirtyRange> &GetRanges() const
+    {
+        return Ranges;
+    }
+
+private:
+    TArray<FGaussianSplatDirtyRange> Ranges;
+};
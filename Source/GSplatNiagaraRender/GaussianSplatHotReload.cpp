@@ -0,0 +1,244 @@
+﻿#include "GaussianSplatHotReload.h"
+
+#if WITH_EDITOR
+
+#include "Async/Async.h"
+#include "DirectoryWatcherModule.h"
+#include "GaussianSplatDerivedData.h"
+#include "GaussianSplatNiagaraDataInterface.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatHotReload, Log, All);
+
+static bool GGaussianSplatHotReloadEnabled = true;
+static FAutoConsoleVariableRef CVarGaussianSplatHotReloadEnabled(
+    TEXT("gsplat.HotReload.Enabled"), GGaussianSplatHotReloadEnabled,
+    TEXT("Re-import PLY files referenced by splat NDIs when they change on disk (editor only)."), ECVF_Default);
+
+static float GGaussianSplatHotReloadSettleSeconds = 0.5f;
+static FAutoConsoleVariableRef CVarGaussianSplatHotReloadSettleSeconds(
+    TEXT("gsplat.HotReload.SettleSeconds"), GGaussianSplatHotReloadSettleSeconds,
+    TEXT("Seconds without further change notifications before a modified PLY is re-imported."), ECVF_Default);
+
+namespace GaussianSplatHotReload
+{
+FString NormalizePath(const FString &Path)
+{
+    FString Full = FPaths::ConvertRelativePathToFull(Path);
+    FPaths::NormalizeFilename(Full);
+    return Full;
+}
+} // namespace GaussianSplatHotReload
+
+FGaussianSplatHotReload &FGaussianSplatHotReload::Get()
+{
+    // Never destroyed: the watcher and ticker it unregisters from may already be gone at static destruction
+    static FGaussianSplatHotReload *Instance = new FGaussianSplatHotReload();
+    return *Instance;
+}
+
+FGaussianSplatHotReload::FGaussianSplatHotReload()
+{
+    TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FGaussianSplatHotReload::Tick), 0.1f);
+}
+
+void FGaussianSplatHotReload::Register(UGaussianSplatNiagaraDataInterface *NDI, const TArray<FString> &InFiles)
+{
+    check(IsInGameThread());
+    TArray<FString> NewFiles;
+    for (const FString &InFile : InFiles)
+    {
+        if (!InFile.IsEmpty())
+            NewFiles.AddUnique(GaussianSplatHotReload::NormalizePath(InFile));
+    }
+
+    // New files are added before stale ones are dropped, so re-registering the same set keeps its watches
+    for (const FString &File : NewFiles)
+    {
+        FWatchedFile *Watched = Files.Find(File);
+        if (!Watched)
+        {
+            Watched = &Files.Add(File);
+            const FFileStatData StatData = IFileManager::Get().GetStatData(*File);
+            if (StatData.bIsValid)
+            {
+                Watched->Size = StatData.FileSize;
+                Watched->Timestamp = StatData.ModificationTime;
+            }
+            // Usually already known from the DDC lookup of the load that led here
+            FGaussianSplatDerivedData::GetFileHash(File, Watched->Hash);
+            WatchDirectory(FPaths::GetPath(File));
+        }
+        Watched->Users.AddUnique(NDI);
+    }
+
+    if (const TArray<FString> *OldFiles = FilesByUser.Find(NDI))
+    {
+        for (const FString &File : *OldFiles)
+        {
+            if (!NewFiles.Contains(File))
+                RemoveUser(File, NDI);
+        }
+    }
+
+    if (NewFiles.Num() > 0)
+        FilesByUser.Add(NDI, MoveTemp(NewFiles));
+    else
+        FilesByUser.Remove(NDI);
+}
+
+void FGaussianSplatHotReload::Unregister(UGaussianSplatNiagaraDataInterface *NDI)
+{
+    Register(NDI, TArray<FString>());
+}
+
+void FGaussianSplatHotReload::RemoveUser(const FString &File, UGaussianSplatNiagaraDataInterface *NDI)
+{
+    FWatchedFile *Watched = Files.Find(File);
+    if (!Watched)
+        return;
+    Watched->Users.RemoveAll([NDI](const TWeakObjectPtr<UGaussianSplatNiagaraDataInterface> &User)
+                             { return !User.IsValid() || User.Get() == NDI; });
+    // A reload in flight finds the entry gone and drops its result
+    if (Watched->Users.Num() == 0)
+    {
+        Files.Remove(File);
+        UnwatchDirectory(FPaths::GetPath(File));
+    }
+}
+
+void FGaussianSplatHotReload::WatchDirectory(const FString &Directory)
+{
+    if (TPair<FDelegateHandle, int32> *Existing = Directories.Find(Directory))
+    {
+        ++Existing->Value;
+        return;
+    }
+
+    FDirectoryWatcherModule &Module =
+        FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    FDelegateHandle Handle;
+    if (IDirectoryWatcher *Watcher = Module.Get())
+    {
+        Watcher->RegisterDirectoryChangedCallback_Handle(
+            Directory,
+            IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FGaussianSplatHotReload::OnDirectoryChanged),
+            Handle);
+    }
+    Directories.Add(Directory, TPair<FDelegateHandle, int32>(Handle, 1));
+}
+
+void FGaussianSplatHotReload::UnwatchDirectory(const FString &Directory)
+{
+    TPair<FDelegateHandle, int32> *Existing = Directories.Find(Directory);
+    if (!Existing || --Existing->Value > 0)
+        return;
+
+    FDirectoryWatcherModule *Module = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    if (Module && Module->Get() && Existing->Key.IsValid())
+        Module->Get()->UnregisterDirectoryChangedCallback_Handle(Directory, Existing->Key);
+    Directories.Remove(Directory);
+}
+
+void FGaussianSplatHotReload::OnDirectoryChanged(const TArray<FFileChangeData> &Changes)
+{
+    const double Now = FPlatformTime::Seconds();
+    for (const FFileChangeData &Change : Changes)
+    {
+        if (Change.Action == FFileChangeData::FCA_Removed)
+            continue;
+        if (FWatchedFile *Watched = Files.Find(GaussianSplatHotReload::NormalizePath(Change.Filename)))
+            Watched->PendingSince = Now;
+    }
+}
+
+bool FGaussianSplatHotReload::Tick(float DeltaTime)
+{
+    if (!GGaussianSplatHotReloadEnabled)
+        return true;
+
+    const double Now = FPlatformTime::Seconds();
+    for (TPair<FString, FWatchedFile> &Pair : Files)
+    {
+        FWatchedFile &Watched = Pair.Value;
+        if (Watched.PendingSince == 0.0 || Watched.bReloading ||
+            Now - Watched.PendingSince < GGaussianSplatHotReloadSettleSeconds)
+            continue;
+
+        Watched.PendingSince = 0.0;
+        const FFileStatData StatData = IFileManager::Get().GetStatData(*Pair.Key);
+        const bool bSameStat =
+            StatData.FileSize == Watched.Size && StatData.ModificationTime == Watched.Timestamp;
+        if (!StatData.bIsValid || bSameStat)
+            continue;
+
+        Watched.Size = StatData.FileSize;
+        Watched.Timestamp = StatData.ModificationTime;
+        StartReload(Pair.Key, Watched);
+    }
+    return true;
+}
+
+void FGaussianSplatHotReload::StartReload(const FString &File, FWatchedFile &Watched)
+{
+    Watched.bReloading = true;
+    auto Reload = [File, OldHash = Watched.Hash]()
+    {
+        FString NewHash;
+        TArray<FGaussianSplatData> Splats;
+        bool bParsed = false;
+        // A hash match means the file was saved again without changes and only the timestamp moved
+        if (FGaussianSplatDerivedData::GetFileHash(File, NewHash) && NewHash != OldHash)
+        {
+            FString Error;
+            bParsed = FGaussianSplatDerivedData::LoadPLY(File, Splats, Error);
+            if (!bParsed)
+                UE_LOG(LogGaussianSplatHotReload, Warning, TEXT("Re-import of %s failed: %s"), *File, *Error);
+        }
+
+        AsyncTask(ENamedThreads::GameThread,
+                  [File, NewHash, Splats = MoveTemp(Splats), bParsed]() mutable
+                  { FGaussianSplatHotReload::Get().FinishReload(File, NewHash, MoveTemp(Splats), bParsed); });
+    };
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Reload));
+}
+
+void FGaussianSplatHotReload::FinishReload(const FString &File, const FString &NewHash,
+                                           TArray<FGaussianSplatData> &&Splats, bool bParsed)
+{
+    FWatchedFile *Watched = Files.Find(File);
+    if (!Watched)
+        return;
+    Watched->bReloading = false;
+
+    if (!bParsed)
+    {
+        // Failed parses keep the old hash, so saving the same broken file again still retries
+        if (NewHash == Watched->Hash)
+            UE_LOG(LogGaussianSplatHotReload, Verbose, TEXT("%s touched but unchanged, skipped"), *File);
+        return;
+    }
+
+    Watched->Hash = NewHash;
+    int32 NumUsers = 0;
+    // Copied because applying re-registers the NDI, which may reshape Files
+    const TArray<TWeakObjectPtr<UGaussianSplatNiagaraDataInterface>> Users = Watched->Users;
+    for (const TWeakObjectPtr<UGaussianSplatNiagaraDataInterface> &User : Users)
+    {
+        if (UGaussianSplatNiagaraDataInterface *NDI = User.Get())
+        {
+            NDI->ApplyReloadedFile(File, Splats);
+            ++NumUsers;
+        }
+    }
+    UE_LOG(LogGaussianSplatHotReload, Log, TEXT("Re-imported %s | %d splats | %d NDIs"), *File, Splats.Num(),
+           NumUsers);
+}
+
+#endif
@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+#include "Containers/Ticker.h"
+#include "GaussianSplatData.h"
+
+class UGaussianSplatNiagaraDataInterface;
+struct FFileChangeData;
+
+/**
+ * Editor-only watcher that re-imports PLY files when they change on disk. Every NDI registers the files it loaded;
+ * their directories are watched and change notifications are debounced, since exporters write in several chunks.
+ * A settled file is compared by size and timestamp, then by content hash, so touches and identical re-exports are
+ * ignored. Real changes are parsed on a worker and handed to every NDI using the file in the same game thread
+ * callback; live instances then re-init on their next tick. Game thread only.
+ */
+class FGaussianSplatHotReload
+{
+public:
+    static FGaussianSplatHotReload &Get();
+
+    // Replaces the set of files NDI is notified about
+    void Register(UGaussianSplatNiagaraDataInterface *NDI, const TArray<FString> &Files);
+    void Unregister(UGaussianSplatNiagaraDataInterface *NDI);
+
+private:
+    struct FWatchedFile
+    {
+        TArray<TWeakObjectPtr<UGaussianSplatNiagaraDataInterface>> Users;
+        int64 Size = INDEX_NONE;
+        FDateTime Timestamp;
+        FString Hash;
+        // Time of the last change notification; 0 when nothing is pending
+        double PendingSince = 0.0;
+        bool bReloading = false;
+    };
+
+    FGaussianSplatHotReload();
+
+    void RemoveUser(const FString &File, UGaussianSplatNiagaraDataInterface *NDI);
+    void WatchDirectory(const FString &Directory);
+    void UnwatchDirectory(const FString &Directory);
+    void OnDirectoryChanged(const TArray<FFileChangeData> &Changes);
+    bool Tick(float DeltaTime);
+    void StartReload(const FString &File, FWatchedFile &Watched);
+    void FinishReload(const FString &File, const FString &NewHash, TArray<FGaussianSplatData> &&Splats, bool bParsed);
+
+    TMap<FString, FWatchedFile> Files;
+    TMap<UGaussianSplatNiagaraDataInterface *, TArray<FString>> FilesByUser;
+    // Directory -> watcher handle and the number of watched files inside it
+    TMap<FString, TPair<FDelegateHandle, int32>> Directories;
+    FTSTicker::FDelegateHandle TickHandle;
+};
+
+#endif
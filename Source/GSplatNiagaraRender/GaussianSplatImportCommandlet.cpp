@@ -0,0 +1,106 @@
+﻿#include "GaussianSplatImportCommandlet.h"
+#include "Dom/JsonObject.h"
+#include "GaussianSplatBatchImport.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatImportCommandlet, Log, All);
+
+UGaussianSplatImportCommandlet::UGaussianSplatImportCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UGaussianSplatImportCommandlet::Main(const FString &Params)
+{
+    FString Input;
+    if (!FParse::Value(*Params, TEXT("Input="), Input))
+    {
+        UE_LOG(LogGaussianSplatImportCommandlet, Error, TEXT("Missing -Input=<file|dir|list.txt>"));
+        return 1;
+    }
+    FGaussianSplatBatchImportSettings Settings;
+    FParse::Value(*Params, TEXT("Jobs="), Settings.MaxFilesInFlight);
+    int32 MemoryMB = 0;
+    if (FParse::Value(*Params, TEXT("MemoryMB="), MemoryMB))
+        Settings.MemoryBudgetBytes = int64(MemoryMB) * 1024 * 1024;
+    FString ReportPath;
+    FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+    TArray<FString> Files;
+    FGaussianSplatBatchImport::CollectFiles(Input, Files);
+    if (Files.Num() == 0)
+    {
+        UE_LOG(LogGaussianSplatImportCommandlet, Error, TEXT("No splat files in %s"), *Input);
+        return 1;
+    }
+
+    const double Start = FPlatformTime::Seconds();
+    const TArray<FGaussianSplatImportResult> Results = FGaussianSplatBatchImport::Run(Files, Settings);
+    const double WallSeconds = FPlatformTime::Seconds() - Start;
+
+    int32 NumFailed = 0;
+    int64 TotalBytes = 0;
+    int64 TotalSplats = 0;
+    TArray<TSharedPtr<FJsonValue>> FileValues;
+    for (const FGaussianSplatImportResult &Result : Results)
+    {
+        TSharedRef<FJsonObject> File = MakeShared<FJsonObject>();
+        File->SetStringField(TEXT("path"), Result.FilePath);
+        File->SetBoolField(TEXT("succeeded"), Result.bSucceeded);
+        File->SetNumberField(TEXT("bytes"), double(Result.FileBytes));
+        File->SetNumberField(TEXT("estimatedBytes"), double(Result.EstimatedBytes));
+        File->SetNumberField(TEXT("splats"), Result.NumSplats);
+        File->SetNumberField(TEXT("queuedSeconds"), Result.QueuedSeconds);
+        File->SetNumberField(TEXT("loadSeconds"), Result.LoadSeconds);
+        File->SetNumberField(TEXT("mbPerSecond"), Result.GetMBPerSecond());
+        File->SetNumberField(TEXT("splatsPerSecond"), Result.GetSplatsPerSecond());
+        FileValues.Add(MakeShared<FJsonValueObject>(File));
+
+        if (!Result.bSucceeded)
+        {
+            File->SetStringField(TEXT("error"), Result.Error);
+            UE_LOG(LogGaussianSplatImportCommandlet, Error, TEXT("%s: %s"), *Result.FilePath, *Result.Error);
+            ++NumFailed;
+            continue;
+        }
+        TotalBytes += Result.FileBytes;
+        TotalSplats += Result.NumSplats;
+        UE_LOG(LogGaussianSplatImportCommandlet, Display,
+               TEXT("%s | %d splats | %.1f MB | queued %.2f s | %.2f s | %.1f MB/s | %.2f M splats/s"),
+               *Result.FilePath, Result.NumSplats, double(Result.FileBytes) / (1024.0 * 1024.0), Result.QueuedSeconds,
+               Result.LoadSeconds, Result.GetMBPerSecond(), Result.GetSplatsPerSecond() / 1.0e6);
+    }
+
+    const double Seconds = FMath::Max(WallSeconds, UE_DOUBLE_SMALL_NUMBER);
+    UE_LOG(LogGaussianSplatImportCommandlet, Display,
+           TEXT("Imported %d of %d files | %lld splats | %.1f MB in %.2f s | %.1f MB/s | %.2f M splats/s"),
+           Results.Num() - NumFailed, Results.Num(), TotalSplats, double(TotalBytes) / (1024.0 * 1024.0), WallSeconds,
+           double(TotalBytes) / (1024.0 * 1024.0) / Seconds, double(TotalSplats) / Seconds / 1.0e6);
+
+    if (!ReportPath.IsEmpty())
+    {
+        TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+        Root->SetNumberField(TEXT("wallSeconds"), WallSeconds);
+        Root->SetNumberField(TEXT("bytes"), double(TotalBytes));
+        Root->SetNumberField(TEXT("splats"), double(TotalSplats));
+        Root->SetNumberField(TEXT("errors"), NumFailed);
+        Root->SetArrayField(TEXT("files"), FileValues);
+
+        FString Json;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        FJsonSerializer::Serialize(Root, Writer);
+        if (!FFileHelper::SaveStringToFile(Json, *ReportPath))
+        {
+            UE_LOG(LogGaussianSplatImportCommandlet, Error, TEXT("Failed to write %s"), *ReportPath);
+            return 1;
+        }
+        UE_LOG(LogGaussianSplatImportCommandlet, Display, TEXT("Wrote %s"), *ReportPath);
+    }
+    return NumFailed == 0 ? 0 : 1;
+}
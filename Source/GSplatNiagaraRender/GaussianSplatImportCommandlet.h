@@ -0,0 +1,24 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "GaussianSplatImportCommandlet.generated.h"
+
+/**
+ * Imports many splat files in parallel with FGaussianSplatBatchImport, filling the Derived Data Cache so NDIs that
+ * reference them later skip parsing. Input is a file, a directory, or a .txt list with one path per line. Logs
+ * queue time and throughput per file, and -Report writes the same per-file figures to JSON.
+ *
+ * UnrealEditor-Cmd <Project> -run=GaussianSplatImport -Input=<file|dir|list.txt> [-Jobs=N] [-MemoryMB=N]
+ *     [-Report=<file.json>]
+ */
+UCLASS()
+class UGaussianSplatImportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGaussianSplatImportCommandlet();
+
+    virtual int32 Main(const FString &Params) override;
+};
@@ -1,13 +1,100 @@
 ﻿#include "GaussianSplatNiagaraDataInterface.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "Math/TranslationMatrix.h"
+#include "GaussianSplatBatchImport.h"
+#include "GaussianSplatBudgetSubsystem.h"
+#include "GaussianSplatDerivedData.h"
+#include "GaussianSplatHotReload.h"
+#include "GaussianSplatTiledFile.h"
+#include "GaussianSplatPacking.h"
+#include "GaussianSplatSequenceFile.h"
+#include "GaussianSplatStats.h"
+#include "NiagaraDataInterfaceUtilities.h"
+#include "NiagaraCompileHashVisitor.h"
 #include "NiagaraParameterStore.h"
 #include "NiagaraShaderParametersBuilder.h"
 #include "NiagaraSystemInstance.h"
 #include "NiagaraTypes.h"
 #include "PLYParser.h"
+#include "SceneView.h"
 #include "ShaderParameterUtils.h"
+#include "UObject/UObjectIterator.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplat, Log, All);
 
+static int32 GGaussianSplatCullEnable = 1;
+static FAutoConsoleVariableRef CVarGaussianSplatCullEnable(
+    TEXT("gsplat.Cull.Enable"), GGaussianSplatCullEnable,
+    TEXT("Allow view culling on NDIs that enable it. 0 publishes every splat."), ECVF_Scalability);
+
+static int32 GGaussianSplatCullCPU = 0;
+static FAutoConsoleVariableRef CVarGaussianSplatCullCPU(
+    TEXT("gsplat.Cull.CPU"), GGaussianSplatCullCPU,
+    TEXT("Cull on the CPU every frame even when only GPU emitters read the NDI, making GetSplatCount exact for game "
+         "code instead of a few frames late."),
+    ECVF_Default);
+
+static FAutoConsoleCommand GGaussianSplatMemoryTopCommand(
+    TEXT("gsplat.Memory.Top"), TEXT("Prints the splat clouds using the most CPU and GPU memory. Arg: count (10)."),
+    FConsoleCommandWithArgsDelegate::CreateLambda(
+        [](const TArray<FString> &Args)
+        {
+            const int32 MaxCount = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+            struct FEntry
+            {
+                const UGaussianSplatNiagaraDataInterface *NDI = nullptr;
+                FGaussianSplatCPUMemory CPU;
+                FGaussianSplatGPUMemory GPU;
+            };
+            TArray<FEntry> Entries;
+            for (TObjectIterator<UGaussianSplatNiagaraDataInterface> It(RF_ClassDefaultObject | RF_ArchetypeObject);
+                 It; ++It)
+            {
+                FEntry &Entry = Entries.AddDefaulted_GetRef();
+                Entry.NDI = *It;
+                Entry.CPU = It->GetCPUMemory();
+                Entry.GPU = It->GetGPUMemory();
+            }
+            Entries.Sort([](const FEntry &A, const FEntry &B)
+                         { return A.CPU.GetTotal() + A.GPU.GetTotal() > B.CPU.GetTotal() + B.GPU.GetTotal(); });
+
+            auto ToMB = [](int64 Bytes) { return double(Bytes) / (1024.0 * 1024.0); };
+            int64 TotalCPU = 0;
+            int64 TotalGPU = 0;
+            for (const FEntry &Entry : Entries)
+            {
+                TotalCPU += Entry.CPU.GetTotal();
+                TotalGPU += Entry.GPU.GetTotal();
+            }
+            UE_LOG(LogGaussianSplat, Display, TEXT("Splat memory: %d clouds | CPU %.1f MB | GPU %.1f MB"),
+                   Entries.Num(), ToMB(TotalCPU), ToMB(TotalGPU));
+            for (int32 i = 0; i < FMath::Min(MaxCount, Entries.Num()); ++i)
+            {
+                const FEntry &Entry = Entries[i];
+                const FGaussianSplatCPUMemory &CPU = Entry.CPU;
+                const FGaussianSplatGPUMemory &GPU = Entry.GPU;
+                UE_LOG(LogGaussianSplat, Display, TEXT("  %s | %d splats | CPU %.1f MB | GPU %.1f MB"),
+                       *Entry.NDI->GetPathName(), Entry.NDI->GetSplatCount(), ToMB(CPU.GetTotal()),
+                       ToMB(GPU.GetTotal()));
+                UE_LOG(LogGaussianSplat, Display,
+                       TEXT("    CPU: splats %.1f | SH %.1f | VM %.1f | grid %.1f | tables %.1f | pending %.1f "
+                            "(last init staged %.1f)"),
+                       ToMB(CPU.Splats), ToMB(CPU.HarmonicsCoefficients), ToMB(CPU.VMData), ToMB(CPU.SpatialGrid),
+                       ToMB(CPU.Tables), ToMB(CPU.PendingUploads), ToMB(Entry.NDI->GetLastInitUploadBytes()));
+                UE_LOG(LogGaussianSplat, Display,
+                       TEXT("    GPU: pos %.1f | scale %.1f | rot %.1f | SH0 %.1f | records %.1f | tables %.1f | "
+                            "culling %.1f | raster %.1f"),
+                       ToMB(GPU.Positions), ToMB(GPU.Scales), ToMB(GPU.Orientations),
+                       ToMB(GPU.SHZeroCoeffsAndOpacity), ToMB(GPU.Records), ToMB(GPU.Tables), ToMB(GPU.Culling),
+                       ToMB(GPU.Raster));
+            }
+        }));
+
 #define LOCTEXT_NAMESPACE "GaussianSplatNiagaraDataInterface"
 
 // Function names
@@ -17,6 +104,23 @@ const FString UGaussianSplatNiagaraDataInterface::GetScaleFunctionName = TEXT("G
 const FString UGaussianSplatNiagaraDataInterface::GetOrientationFunctionName = TEXT("GetSplatOrientation");
 const FString UGaussianSplatNiagaraDataInterface::GetOpacityFunctionName = TEXT("GetSplatOpacity");
 const FString UGaussianSplatNiagaraDataInterface::GetColorFunctionName = TEXT("GetSplatColor");
+const FString UGaussianSplatNiagaraDataInterface::GetAttributesFunctionName = TEXT("GetSplatAttributes");
+const FString UGaussianSplatNiagaraDataInterface::GetCloudCountFunctionName = TEXT("GetCloudCount");
+const FString UGaussianSplatNiagaraDataInterface::GetSplatCloudFunctionName = TEXT("GetSplatCloud");
+const FString UGaussianSplatNiagaraDataInterface::GetCloudSplatRangeFunctionName = TEXT("GetCloudSplatRange");
+const FString UGaussianSplatNiagaraDataInterface::GetCloudInstanceCountFunctionName = TEXT("GetCloudInstanceCount");
+const FString UGaussianSplatNiagaraDataInterface::GetInstancedSplatIndexFunctionName = TEXT("GetInstancedSplatIndex");
+const FString UGaussianSplatNiagaraDataInterface::GetInstancedSplatAttributesFunctionName =
+    TEXT("GetInstancedSplatAttributes");
+const FString UGaussianSplatNiagaraDataInterface::GetSequenceFrameFunctionName = TEXT("GetSequenceFrame");
+const FString UGaussianSplatNiagaraDataInterface::GetVisibleSplatIndexFunctionName = TEXT("GetVisibleSplatIndex");
+const FString UGaussianSplatNiagaraDataInterface::GetSplatScreenSizeFunctionName = TEXT("GetSplatScreenSize");
+const FString UGaussianSplatNiagaraDataInterface::GetSplatsInRadiusFunctionName = TEXT("GetSplatsInRadius");
+const FString UGaussianSplatNiagaraDataInterface::GetSplatInRadiusFunctionName = TEXT("GetSplatInRadius");
+const FString UGaussianSplatNiagaraDataInterface::GetNearestSplatFunctionName = TEXT("GetNearestSplat");
+const FString UGaussianSplatNiagaraDataInterface::SetSplatPositionFunctionName = TEXT("SetSplatPosition");
+const FString UGaussianSplatNiagaraDataInterface::SetSplatOpacityFunctionName = TEXT("SetSplatOpacity");
+const FString UGaussianSplatNiagaraDataInterface::ResetSplatFunctionName = TEXT("ResetSplat");
 
 // Shader parameter names
 const FString UGaussianSplatNiagaraDataInterface::SplatsCountParamName = TEXT("_SplatsCount");
@@ -25,6 +129,55 @@ const FString UGaussianSplatNiagaraDataInterface::PositionsBufferName = TEXT("_P
 const FString UGaussianSplatNiagaraDataInterface::ScalesBufferName = TEXT("_Scales");
 const FString UGaussianSplatNiagaraDataInterface::OrientationsBufferName = TEXT("_Orientations");
 const FString UGaussianSplatNiagaraDataInterface::SHZeroCoeffsBufferName = TEXT("_SHZeroCoeffsAndOpacity");
+const FString UGaussianSplatNiagaraDataInterface::SplatRecordsBufferName = TEXT("_SplatRecords");
+const FString UGaussianSplatNiagaraDataInterface::UseIndirectionParamName = TEXT("_UseIndirection");
+const FString UGaussianSplatNiagaraDataInterface::IndirectionBufferName = TEXT("_Indirection");
+
+const FString UGaussianSplatNiagaraDataInterface::BaseOffsetParamName = TEXT("_BaseOffset");
+
+// HLSL helper emitted per DI: maps a splat index to its buffer element (arena offset, plus indirection when streaming)
+const FString UGaussianSplatNiagaraDataInterface::ResolveIndexFunctionName = TEXT("_ResolveSplatIndex");
+
+// Multi-cloud table; FindCloud binary searches the offsets for the cloud containing a splat index
+const FString UGaussianSplatNiagaraDataInterface::NumCloudsParamName = TEXT("_NumClouds");
+const FString UGaussianSplatNiagaraDataInterface::CloudOffsetsBufferName = TEXT("_CloudOffsets");
+const FString UGaussianSplatNiagaraDataInterface::CloudTintsBufferName = TEXT("_CloudTints");
+const FString UGaussianSplatNiagaraDataInterface::FindCloudFunctionName = TEXT("_FindCloud");
+
+// Instancing
+const FString UGaussianSplatNiagaraDataInterface::NumCloudInstancesParamName = TEXT("_NumCloudInstances");
+const FString UGaussianSplatNiagaraDataInterface::CloudInstancesBufferName = TEXT("_CloudInstances");
+
+// Sequence
+const FString UGaussianSplatNiagaraDataInterface::SequenceFrameParamName = TEXT("_SequenceFrame");
+
+// View culling; the visible list is written by FGaussianSplatCullCS before the simulation stage
+const FString UGaussianSplatNiagaraDataInterface::CullEnabledParamName = TEXT("_CullEnabled");
+const FString UGaussianSplatNiagaraDataInterface::VisibleCountBufferName = TEXT("_VisibleCount");
+const FString UGaussianSplatNiagaraDataInterface::VisibleIndicesBufferName = TEXT("_VisibleIndices");
+
+// Screen size and sub-pixel opacity compensation; see FGaussianSplatCullParams
+const FString UGaussianSplatNiagaraDataInterface::ScreenDepthPlaneParamName = TEXT("_ScreenDepthPlane");
+const FString UGaussianSplatNiagaraDataInterface::ScreenPixelScaleParamName = TEXT("_ScreenPixelScale");
+const FString UGaussianSplatNiagaraDataInterface::SubPixelRadiusParamName = TEXT("_SubPixelRadius");
+const FString UGaussianSplatNiagaraDataInterface::PixelRadiusFunctionName = TEXT("_PixelRadius");
+const FString UGaussianSplatNiagaraDataInterface::CompensateOpacityFunctionName = TEXT("_CompensateOpacity");
+
+// Spatial grid, see FGaussianSplatSpatialGrid; GridSplats holds each sorted splat's centre and index bits
+const FString UGaussianSplatNiagaraDataInterface::GridOriginParamName = TEXT("_GridOrigin");
+const FString UGaussianSplatNiagaraDataInterface::GridInvCellSizeParamName = TEXT("_GridInvCellSize");
+const FString UGaussianSplatNiagaraDataInterface::GridDimsParamName = TEXT("_GridDims");
+const FString UGaussianSplatNiagaraDataInterface::GridCellStartsBufferName = TEXT("_GridCellStarts");
+const FString UGaussianSplatNiagaraDataInterface::GridSplatsBufferName = TEXT("_GridSplats");
+const FString UGaussianSplatNiagaraDataInterface::GridCellFunctionName = TEXT("_GridCell");
+
+// Writable splats, see FGaussianSplatDeformBuffers_RT: reads come from Live, writes go to LiveOut, Rest is the upload
+const FString UGaussianSplatNiagaraDataInterface::RestPositionsBufferName = TEXT("_RestPositions");
+const FString UGaussianSplatNiagaraDataInterface::RestSHZeroBufferName = TEXT("_RestSHZero");
+const FString UGaussianSplatNiagaraDataInterface::LivePositionsBufferName = TEXT("_LivePositions");
+const FString UGaussianSplatNiagaraDataInterface::LiveSHZeroBufferName = TEXT("_LiveSHZero");
+const FString UGaussianSplatNiagaraDataInterface::LivePositionsOutBufferName = TEXT("_LivePositionsOut");
+const FString UGaussianSplatNiagaraDataInterface::LiveSHZeroOutBufferName = TEXT("_LiveSHZeroOut");
 
 // VM function binders
 DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatCount);
@@ -33,11 +186,23 @@ DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatScale)
 DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatOrientation);
 DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatOpacity);
 DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatColor);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatAttributes);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetCloudCount);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatCloud);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetCloudSplatRange);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetCloudInstanceCount);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetInstancedSplatIndex);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetInstancedSplatAttributes);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetVisibleSplatIndex);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatScreenSize);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatsInRadius);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatInRadius);
+DEFINE_NDI_DIRECT_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetNearestSplat);
 
 // Construction & Lifecycle
 
 UGaussianSplatNiagaraDataInterface::UGaussianSplatNiagaraDataInterface(const FObjectInitializer &ObjectInitializer)
-    : Super(ObjectInitializer), GlobalTint(FLinearColor::White), bGPUDataDirty(false)
+    : Super(ObjectInitializer), GlobalTint(FLinearColor::White), RenderDataRevision(0)
 {
     Proxy.Reset(new FNDIGaussianSplatProxy());
     UE_LOG(LogGaussianSplat, Log, TEXT("[Constructor] %s | Proxy=%p"), *GetName(), Proxy.Get());
@@ -61,11 +226,11 @@ void UGaussianSplatNiagaraDataInterface::PostInitProperties()
 
     MarkRenderDataDirty();
 
-    if (!PlyFilePath.FilePath.IsEmpty())
+    if (HasSource())
     {
-        UE_LOG(LogGaussianSplat, Log, TEXT("[PostInitProperties] %s | Path not empty, calling LoadPlyFile"),
-               *GetName());
-        LoadPlyFile();
+        UE_LOG(LogGaussianSplat, Log, TEXT("[PostInitProperties] %s | Source set, loading | Clouds=%d"), *GetName(),
+               Clouds.Num());
+        LoadSource();
     }
     else
     {
@@ -77,7 +242,7 @@ void UGaussianSplatNiagaraDataInterface::PostLoad()
 {
     Super::PostLoad();
 
-    const bool bHasPath = !PlyFilePath.FilePath.IsEmpty();
+    const bool bHasPath = HasSource();
     const bool bHasSplats = Splats.Num() > 0;
 
     UE_LOG(LogGaussianSplat, Log,
@@ -89,7 +254,7 @@ void UGaussianSplatNiagaraDataInterface::PostLoad()
     {
         UE_LOG(LogGaussianSplat, Log,
                TEXT("[PostLoad] %s | Path set but Splats empty (not serialized) — reloading from disk"), *GetName());
-        LoadPlyFile();
+        LoadSource();
     }
     else if (bHasPath && bHasSplats)
     {
@@ -117,9 +282,117 @@ void UGaussianSplatNiagaraDataInterface::PostEditChangeProperty(struct FProperty
 
     if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, PlyFilePath))
     {
-        UE_LOG(LogGaussianSplat, Log, TEXT("[PostEditChangeProperty] %s | PlyFilePath changed — calling LoadPlyFile"),
+        if (!IsMultiCloud() && IsSourceUpToDate({PlyFilePath.FilePath}))
+        {
+            UE_LOG(LogGaussianSplat, Log, TEXT("[PostEditChangeProperty] %s | PlyFilePath unchanged on disk — skipped"),
+                   *GetName());
+        }
+        else
+        {
+            UE_LOG(LogGaussianSplat, Log,
+                   TEXT("[PostEditChangeProperty] %s | PlyFilePath changed — calling LoadPlyFile"), *GetName());
+            LoadPlyFile();
+        }
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, Clouds) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, Cleanup))
+    {
+        UE_LOG(LogGaussianSplat, Log, TEXT("[PostEditChangeProperty] %s | Clouds changed — reloading %d clouds"),
+               *GetName(), Clouds.Num());
+        if (IsMultiCloud())
+            LoadClouds();
+        else
+            LoadPlyFile();
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, TiledFilePath) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, StreamingBudgetMB) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, MaxInFlightTileReads) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, MaxStreamingDistance))
+    {
+        UE_LOG(LogGaussianSplat, Log, TEXT("[PostEditChangeProperty] %s | Streaming settings changed — reopening"),
                *GetName());
-        LoadPlyFile();
+        StreamingManager.Reset();
+        // The pool and indirection are sized for the old budget; reopening creates new ones
+        FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+        ENQUEUE_RENDER_COMMAND(ReleaseGaussianSplatStreamingPool)(
+            [RT_Proxy](FRHICommandListImmediate &RHICmdList)
+            {
+                RT_Proxy->StreamingPool.Release();
+                RT_Proxy->UpdateGPUMemoryStat();
+            });
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, SequenceFilePath) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, SequenceRingSize) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, bLoopSequence))
+    {
+        UE_LOG(LogGaussianSplat, Log, TEXT("[PostEditChangeProperty] %s | Sequence settings changed — reopening"),
+               *GetName());
+        SequencePlayer.Reset();
+        // Otherwise the proxy would keep binding the old sequence after the path is cleared
+        FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+        ENQUEUE_RENDER_COMMAND(ReleaseGaussianSplatSequenceBuffers)(
+            [RT_Proxy](FRHICommandListImmediate &RHICmdList)
+            {
+                RT_Proxy->SequenceBuffers.Release();
+                RT_Proxy->UpdateGPUMemoryStat();
+            });
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, CloudInstances) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, InstanceDecimationDistance) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, MaxInstanceDecimationStride))
+    {
+        UE_LOG(LogGaussianSplat, Log, TEXT("[PostEditChangeProperty] %s | Instancing changed — %d instances"),
+               *GetName(), CloudInstances.Num());
+        // Repacked on the next tick; the cloud itself stays uploaded
+        LastInstancingUpdateFrame = 0;
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, bViewCulling) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, CullRadiusSigma) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, SubPixelCullRadius))
+    {
+        UE_LOG(LogGaussianSplat, Log,
+               TEXT("[PostEditChangeProperty] %s | Culling changed — enabled=%d radius=%.2f sub-pixel=%.2f px"),
+               *GetName(), bViewCulling, CullRadiusSigma, SubPixelCullRadius);
+        LastCullFrame = 0;
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, RasterTarget) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, RasterKeysPerSplat))
+    {
+        UE_LOG(LogGaussianSplat, Log,
+               TEXT("[PostEditChangeProperty] %s | Tile rasterizer changed — target=%s keys/splat=%.1f"), *GetName(),
+               *GetNameSafe(RasterTarget), RasterKeysPerSplat);
+        LastRasterFrame = 0;
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, bBuildSpatialGrid) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, SpatialGridSplatsPerCell))
+    {
+        UE_LOG(LogGaussianSplat, Log,
+               TEXT("[PostEditChangeProperty] %s | Spatial grid changed — enabled=%d splats/cell=%d, rebuilding"),
+               *GetName(), bBuildSpatialGrid, SpatialGridSplatsPerCell);
+        MarkRenderDataDirty();
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, bWritableSplats))
+    {
+        UE_LOG(LogGaussianSplat, Log,
+               TEXT("[PostEditChangeProperty] %s | Writable splats changed — enabled=%d, re-uploading"), *GetName(),
+               bWritableSplats);
+        MarkRenderDataDirty();
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, CPUResidency) ||
+             MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, CPUProxyLevel))
+    {
+        UE_LOG(LogGaussianSplat, Log,
+               TEXT("[PostEditChangeProperty] %s | CPU residency changed — policy=%d proxy level=%d trimmed=%d"),
+               *GetName(), int32(CPUResidency), CPUProxyLevel, bCPUSplatsTrimmed);
+        // Applied after the next upload; a copy trimmed under the old policy comes back whole first
+        if (bCPUSplatsTrimmed)
+            LoadSource();
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, BufferLayout))
+    {
+        UE_LOG(LogGaussianSplat, Log, TEXT("[PostEditChangeProperty] %s | BufferLayout changed — re-uploading"),
+               *GetName());
+        MarkRenderDataDirty();
     }
     else if (PropName == GET_MEMBER_NAME_CHECKED(UGaussianSplatNiagaraDataInterface, GlobalTint))
     {
@@ -138,6 +411,15 @@ void UGaussianSplatNiagaraDataInterface::PostEditChangeProperty(struct FProperty
 void UGaussianSplatNiagaraDataInterface::BeginDestroy()
 {
     UE_LOG(LogGaussianSplat, Log, TEXT("[BeginDestroy] %s | Splats=%d"), *GetName(), Splats.Num());
+    StreamingManager.Reset();
+    SequencePlayer.Reset();
+    SetAccountedMemory(0, 0);
+    if (UGaussianSplatBudgetSubsystem *Budget = UGaussianSplatBudgetSubsystem::Get())
+        Budget->Unregister(this);
+#if WITH_EDITOR
+    if (!HasAnyFlags(RF_ClassDefaultObject))
+        FGaussianSplatHotReload::Get().Unregister(this);
+#endif
     Super::BeginDestroy();
     UE_LOG(LogGaussianSplat, Log, TEXT("[BeginDestroy] %s | Complete"), *GetName());
 }
@@ -159,23 +441,98 @@ void UGaussianSplatNiagaraDataInterface::LoadPlyFile()
     LoadFromPLYFile(FullPath);
 }
 
+void UGaussianSplatNiagaraDataInterface::LoadSource()
+{
+    if (IsMultiCloud())
+        LoadClouds();
+    else
+        LoadPlyFile();
+}
+
+bool UGaussianSplatNiagaraDataInterface::LoadClouds()
+{
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    TArray<FGaussianSplatData> Combined;
+    FGaussianSplatCloudTable NewTable;
+    bool bAllParsed = true;
+
+    // Clouds load in parallel, each distinct file once. Cached untransformed, so moving a cloud does not invalidate
+    // its entry.
+    TArray<FString> Files;
+    TArray<int32> CloudFiles;
+    for (const FGaussianSplatCloud &Cloud : Clouds)
+        CloudFiles.Add(Files.AddUnique(Cloud.PlyFile.FilePath));
+    TArray<TArray<FGaussianSplatData>> FileSplats;
+    FileSplats.SetNum(Files.Num());
+    auto OnFileLoaded = [this, &Files, &FileSplats](int32 FileIndex, TArray<FGaussianSplatData> &Loaded)
+    {
+        PrepareSourceSplats(Files[FileIndex], Loaded);
+        FileSplats[FileIndex] = MoveTemp(Loaded);
+    };
+    const TArray<FGaussianSplatImportResult> Results =
+        FGaussianSplatBatchImport::Run(Files, FGaussianSplatBatchImportSettings(), OnFileLoaded);
+
+    for (int32 CloudIdx = 0; CloudIdx < Clouds.Num(); ++CloudIdx)
+    {
+        const FGaussianSplatCloud &Cloud = Clouds[CloudIdx];
+        const int32 FileIndex = CloudFiles[CloudIdx];
+        if (!Results[FileIndex].bSucceeded)
+        {
+            // Keep the slot so cloud indices stay stable for the graph
+            UE_LOG(LogGaussianSplat, Error, TEXT("[LoadClouds] %s | Cloud %d '%s' PARSE FAILED: %s"), *GetName(),
+                   CloudIdx, *Cloud.PlyFile.FilePath, *Results[FileIndex].Error);
+            bAllParsed = false;
+        }
+        // The last cloud using a file takes its splats, the others copy them
+        const bool bLastUse = CloudFiles.FindLast(FileIndex) == CloudIdx;
+        TArray<FGaussianSplatData> CloudSplats = bLastUse ? MoveTemp(FileSplats[FileIndex]) : FileSplats[FileIndex];
+
+        const FTransform3f Transform(Cloud.Transform);
+        if (!Transform.Equals(FTransform3f::Identity))
+        {
+            for (FGaussianSplatData &Splat : CloudSplats)
+                Splat.ApplyTransform(Transform);
+        }
+
+        NewTable.Add(CloudSplats.Num(), Cloud.Tint);
+        Combined.Append(MoveTemp(CloudSplats));
+    }
+
+    Splats = MoveTemp(Combined);
+    CloudTable = MoveTemp(NewTable);
+    CurrentSplatCount = Splats.Num();
+    bCPUSplatsTrimmed = false;
+    MarkRenderDataDirty();
+
+    LoadedSourceFiles.Reset();
+    for (const FGaussianSplatCloud &Cloud : Clouds)
+        LoadedSourceFiles.Add(Cloud.PlyFile.FilePath);
+    OnSourceLoaded();
+
+    UE_LOG(LogGaussianSplat, Log, TEXT("[LoadClouds] %s | %d clouds | %d splats"), *GetName(), CloudTable.Num(),
+           Splats.Num());
+    return bAllParsed;
+}
+
 bool UGaussianSplatNiagaraDataInterface::LoadFromPLYFile(const FString &FilePath)
 {
     UE_LOG(LogGaussianSplat, Log, TEXT("[LoadFromPLYFile] %s | Attempting to load: '%s' | ExistingSplats=%d"),
            *GetName(), *FilePath, Splats.Num());
 
-    FPLYParser Parser;
+    LLM_SCOPE_BYTAG(GaussianSplat);
     TArray<FGaussianSplatData> ParsedSplats;
-    if (!Parser.ParseFile(FilePath, ParsedSplats))
+    FString Error;
+    if (!FGaussianSplatDerivedData::LoadPLY(FilePath, ParsedSplats, Error))
     {
-        UE_LOG(LogGaussianSplat, Error, TEXT("[LoadFromPLYFile] %s | PARSE FAILED: %s"), *GetName(),
-               *Parser.GetErrorMessage());
+        UE_LOG(LogGaussianSplat, Error, TEXT("[LoadFromPLYFile] %s | PARSE FAILED: %s"), *GetName(), *Error);
         return false;
     }
 
+    PrepareSourceSplats(FilePath, ParsedSplats);
     const int32 ParsedCount = ParsedSplats.Num();
-    Splats = MoveTemp(ParsedSplats);
-    CurrentSplatCount = Splats.Num();
+    SetSingleCloudSplats(MoveTemp(ParsedSplats));
+    LoadedSourceFiles = {FilePath};
+    OnSourceLoaded();
 
     UE_LOG(LogGaussianSplat, Log, TEXT("[LoadFromPLYFile] %s | PARSE OK: %d splats"), *GetName(), ParsedCount);
 
@@ -188,7 +545,6 @@ bool UGaussianSplatNiagaraDataInterface::LoadFromPLYFile(const FString &FilePath
                First.Scale.Z, First.Opacity);
     }
 
-    MarkRenderDataDirty();
     // GPU upload now happens in InitPerInstanceData when a NiagaraComponent activates
     UE_LOG(LogGaussianSplat, Log,
            TEXT("[LoadFromPLYFile] %s | Data stored in Splats — GPU upload deferred to InitPerInstanceData"),
@@ -196,213 +552,1369 @@ bool UGaussianSplatNiagaraDataInterface::LoadFromPLYFile(const FString &FilePath
     return true;
 }
 
-int32 UGaussianSplatNiagaraDataInterface::GetSplatCount() const
+void UGaussianSplatNiagaraDataInterface::SetSingleCloudSplats(TArray<FGaussianSplatData> &&NewSplats)
 {
-    return Splats.Num();
+    Splats = MoveTemp(NewSplats);
+    CurrentSplatCount = Splats.Num();
+    bCPUSplatsTrimmed = false;
+    CloudTable.Reset();
+    CloudTable.Add(Splats.Num(), FLinearColor::White);
+    MarkRenderDataDirty();
 }
 
-void UGaussianSplatNiagaraDataInterface::ClearSplats()
+void UGaussianSplatNiagaraDataInterface::PrepareSourceSplats(const FString &SourceFile,
+                                                             TArray<FGaussianSplatData> &InOutSplats) const
 {
-    Splats.Empty();
-    CurrentSplatCount = 0;
-    MarkRenderDataDirty();
+    if (InOutSplats.Num() == 0)
+        return;
+
+    const int32 NumBefore = InOutSplats.Num();
+    if (Cleanup.IsEnabled())
+    {
+        const FGaussianSplatCleanupStats Stats = FGaussianSplatCleanup::Apply(Cleanup, InOutSplats);
+        if (Stats.GetTotal() > 0)
+        {
+            UE_LOG(LogGaussianSplat, Log, TEXT("[Cleanup] %s | '%s' | %s of %d (%.1f%%)"), *GetName(), *SourceFile,
+                   *Stats.ToString(), NumBefore, 100.0 * Stats.GetTotal() / NumBefore);
+        }
+    }
+    FGaussianSplatCleanup::Decimate(1 << BudgetLevel, InOutSplats);
 }
 
-bool UGaussianSplatNiagaraDataInterface::Equals(const UNiagaraDataInterface *Other) const
+void UGaussianSplatNiagaraDataInterface::SetBudgetLevel(int32 Level)
 {
-    if (!Super::Equals(Other))
-        return false;
+    Level = FMath::Clamp(Level, 0, 16);
+    if (Level == BudgetLevel || !CanChangeBudgetLevel())
+        return;
 
-    const UGaussianSplatNiagaraDataInterface *OtherNDI = Cast<UGaussianSplatNiagaraDataInterface>(Other);
-    if (!OtherNDI)
-        return false;
+    const int32 OldLevel = BudgetLevel;
+    BudgetLevel = Level;
+    // Not loaded yet; the first load applies the level
+    if (GetLoadedSplatCount() == 0)
+        return;
+    // The splats a finer level needs were dropped, so they come back from the source (usually via the DDC), as does
+    // a trimmed CPU copy
+    if (Level < OldLevel || bCPUSplatsTrimmed)
+    {
+        LoadSource();
+        return;
+    }
 
-    const bool bPathEqual = PlyFilePath.FilePath == OtherNDI->PlyFilePath.FilePath;
-    const bool bTintEqual = GlobalTint == OtherNDI->GlobalTint;
-    return bPathEqual && bTintEqual;
+    // Coarser: thin each cloud's range in place so the cloud table stays valid
+    const int32 Stride = 1 << (Level - OldLevel);
+    TArray<FGaussianSplatData> Kept;
+    Kept.Reserve(Splats.Num() / Stride + CloudTable.Num());
+    FGaussianSplatCloudTable NewTable;
+    for (int32 Cloud = 0; Cloud < CloudTable.Num(); ++Cloud)
+    {
+        const int32 First = CloudTable.GetFirst(Cloud);
+        const int32 Count = CloudTable.GetCount(Cloud);
+        for (int32 i = 0; i < Count; i += Stride)
+            Kept.Add(MoveTemp(Splats[First + i]));
+        NewTable.Add((Count + Stride - 1) / Stride, CloudTable.Tints[Cloud]);
+    }
+    Splats = MoveTemp(Kept);
+    CloudTable = MoveTemp(NewTable);
+    CurrentSplatCount = Splats.Num();
+    MarkRenderDataDirty();
 }
 
-void UGaussianSplatNiagaraDataInterface::MarkRenderDataDirty()
+float UGaussianSplatNiagaraDataInterface::GetBudgetViewDistance() const
 {
-    bGPUDataDirty = true;
+    // Ticks run every frame an instance is alive, so anything older means there is none
+    return GFrameCounter - BudgetViewDistanceFrame <= 1 ? BudgetViewDistance : MAX_flt;
 }
 
-bool UGaussianSplatNiagaraDataInterface::CopyToInternal(UNiagaraDataInterface *Destination) const
+void UGaussianSplatNiagaraDataInterface::UpdateBudgetViewDistance(FNiagaraSystemInstance *SystemInstance)
 {
-    if (!Super::CopyToInternal(Destination))
-        return false;
-
-    UGaussianSplatNiagaraDataInterface *DestNDI = Cast<UGaussianSplatNiagaraDataInterface>(Destination);
-    if (!DestNDI)
-        return false;
-
-    // Copy all game-thread data; GPU upload is deferred to InitPerInstanceData
-    DestNDI->PlyFilePath = PlyFilePath;
-    DestNDI->GlobalTint = GlobalTint;
-    DestNDI->Splats = Splats;
-    DestNDI->CurrentSplatCount = CurrentSplatCount;
-    DestNDI->MarkRenderDataDirty();
+    const float Distance =
+        float(FVector::Dist(GetViewLocation(SystemInstance), SystemInstance->GetWorldTransform().GetLocation()));
+    if (BudgetViewDistanceFrame != GFrameCounter)
+    {
+        BudgetViewDistanceFrame = GFrameCounter;
+        BudgetViewDistance = Distance;
+    }
+    else
+    {
+        BudgetViewDistance = FMath::Min(BudgetViewDistance, Distance);
+    }
+}
 
-    UE_LOG(LogGaussianSplat, Log, TEXT("[CopyToInternal] %s -> %s | Path='%s' | Splats=%d | Tint=(%.2f,%.2f,%.2f)"),
-           *GetName(), *DestNDI->GetName(), *PlyFilePath.FilePath, Splats.Num(), GlobalTint.R, GlobalTint.G,
-           GlobalTint.B);
+void UGaussianSplatNiagaraDataInterface::OnSourceLoaded()
+{
+#if WITH_EDITOR
+    if (HasAnyFlags(RF_ClassDefaultObject))
+        return;
+    LoadedSourceHash = HashSourceFiles(LoadedSourceFiles);
+    FGaussianSplatHotReload::Get().Register(this, LoadedSourceFiles);
+#endif
+}
 
-    return true;
+#if WITH_EDITOR
+FString UGaussianSplatNiagaraDataInterface::HashSourceFiles(const TArray<FString> &Files)
+{
+    FString Combined;
+    for (const FString &File : Files)
+    {
+        FString Hash;
+        if (!FGaussianSplatDerivedData::GetFileHash(File, Hash))
+            return FString();
+        Combined += Hash;
+    }
+    return Combined;
 }
 
-// Niagara Function Declarations
+bool UGaussianSplatNiagaraDataInterface::IsSourceUpToDate(const TArray<FString> &Files) const
+{
+    // Hashes are cached by size and timestamp, so this only reads files that were touched since they were loaded
+    return GetLoadedSplatCount() > 0 && Files == LoadedSourceFiles && !LoadedSourceHash.IsEmpty() &&
+           HashSourceFiles(Files) == LoadedSourceHash;
+}
 
-void UGaussianSplatNiagaraDataInterface::GetFunctions(TArray<FNiagaraFunctionSignature> &OutFunctions)
+void UGaussianSplatNiagaraDataInterface::ApplyReloadedFile(const FString &File,
+                                                           const TArray<FGaussianSplatData> &FileSplats)
 {
-    // GetSplatCount
+    UE_LOG(LogGaussianSplat, Log, TEXT("[ApplyReloadedFile] %s | '%s' changed on disk | %d splats"), *GetName(),
+           *File, FileSplats.Num());
+    // Without an intact CPU copy laid out as Clouds there is nothing to splice into, so every cloud is reloaded
+    if (IsMultiCloud() &&
+        (bCPUSplatsTrimmed || CloudTable.Num() != Clouds.Num() || CloudTable.Offsets.Last() != Splats.Num()))
     {
-        FNiagaraFunctionSignature Sig;
-        Sig.Name = *GetSplatCountFunctionName;
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
-        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Count")));
-        Sig.bMemberFunction = true;
-        Sig.bRequiresContext = false;
-        OutFunctions.Add(Sig);
+        LoadClouds();
+        return;
     }
 
-    // GetSplatPosition
+    TArray<FGaussianSplatData> NewSplats = FileSplats;
+    PrepareSourceSplats(File, NewSplats);
+    if (!IsMultiCloud())
     {
-        FNiagaraFunctionSignature Sig;
-        Sig.Name = *GetPositionFunctionName;
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
-        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Position")));
-        Sig.bMemberFunction = true;
-        Sig.bRequiresContext = false;
-        OutFunctions.Add(Sig);
+        SetSingleCloudSplats(MoveTemp(NewSplats));
+        OnSourceLoaded();
+        return;
     }
 
-    // GetSplatScale
+    // Only the clouds reading File are replaced; the others keep their splats
+    TArray<FGaussianSplatData> Combined;
+    FGaussianSplatCloudTable NewTable;
+    for (int32 CloudIdx = 0; CloudIdx < Clouds.Num(); ++CloudIdx)
     {
-        FNiagaraFunctionSignature Sig;
-        Sig.Name = *GetScaleFunctionName;
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
-        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Scale")));
-        Sig.bMemberFunction = true;
-        Sig.bRequiresContext = false;
-        OutFunctions.Add(Sig);
+        const FGaussianSplatCloud &Cloud = Clouds[CloudIdx];
+        if (Cloud.PlyFile.FilePath != File)
+        {
+            const int32 Count = CloudTable.GetCount(CloudIdx);
+            Combined.Append(MakeArrayView(Splats.GetData() + CloudTable.GetFirst(CloudIdx), Count));
+            NewTable.Add(Count, Cloud.Tint);
+            continue;
+        }
+
+        const int32 First = Combined.Num();
+        Combined.Append(NewSplats);
+        const FTransform3f Transform(Cloud.Transform);
+        if (!Transform.Equals(FTransform3f::Identity))
+        {
+            for (int32 i = First; i < Combined.Num(); ++i)
+                Combined[i].ApplyTransform(Transform);
+        }
+        NewTable.Add(NewSplats.Num(), Cloud.Tint);
     }
 
-    // GetSplatOrientation
+    Splats = MoveTemp(Combined);
+    CloudTable = MoveTemp(NewTable);
+    CurrentSplatCount = Splats.Num();
+    MarkRenderDataDirty();
+    OnSourceLoaded();
+}
+#endif
+
+bool UGaussianSplatNiagaraDataInterface::BuildTiledFileFromPLY(const FString &PlyPath, const FString &OutTiledPath,
+                                                               int32 TileCapacity)
+{
+    // The parser loads the file into one TArray, so anything past int32 would fail partway through or wrap
+    const int64 PlySize = IFileManager::Get().FileSize(*PlyPath);
+    if (PlySize > MAX_int32)
     {
-        FNiagaraFunctionSignature Sig;
-        Sig.Name = *GetOrientationFunctionName;
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
-        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetQuatDef(), TEXT("Orientation")));
-        Sig.bMemberFunction = true;
-        Sig.bRequiresContext = false;
-        OutFunctions.Add(Sig);
+        UE_LOG(LogGaussianSplat, Error,
+               TEXT("[BuildTiledFileFromPLY] '%s' is %lld bytes; conversion supports PLY files up to 2 GB"), *PlyPath,
+               PlySize);
+        return false;
     }
 
-    // GetSplatOpacity
+    FPLYParser Parser;
+    TArray<FGaussianSplatData> ParsedSplats;
+    if (!Parser.ParseFile(PlyPath, ParsedSplats))
     {
-        FNiagaraFunctionSignature Sig;
-        Sig.Name = *GetOpacityFunctionName;
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
-        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Opacity")));
-        Sig.bMemberFunction = true;
-        Sig.bRequiresContext = false;
-        OutFunctions.Add(Sig);
+        UE_LOG(LogGaussianSplat, Error, TEXT("[BuildTiledFileFromPLY] PARSE FAILED: %s"), *Parser.GetErrorMessage());
+        return false;
     }
 
-    // GetSplatColor
+    FString Error;
+    if (!FGaussianSplatTiledFile::Write(OutTiledPath, ParsedSplats, TileCapacity, Error))
     {
-        FNiagaraFunctionSignature Sig;
-        Sig.Name = *GetColorFunctionName;
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
-        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
-        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetColorDef(), TEXT("Color")));
-        Sig.bMemberFunction = true;
-        Sig.bRequiresContext = false;
-        OutFunctions.Add(Sig);
+        UE_LOG(LogGaussianSplat, Error, TEXT("[BuildTiledFileFromPLY] WRITE FAILED: %s"), *Error);
+        return false;
     }
+    return true;
 }
 
-// CPU VM Function Binding & Implementations
-
-void UGaussianSplatNiagaraDataInterface::GetVMExternalFunction(const FVMExternalFunctionBindingInfo &BindingInfo,
-                                                               void *InstanceData, FVMExternalFunction &OutFunc)
+bool UGaussianSplatNiagaraDataInterface::OpenStreaming()
 {
-    if (BindingInfo.Name == *GetSplatCountFunctionName)
-        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatCount)::Bind(this, OutFunc);
-    else if (BindingInfo.Name == *GetPositionFunctionName)
-        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatPosition)::Bind(this, OutFunc);
-    else if (BindingInfo.Name == *GetScaleFunctionName)
-        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatScale)::Bind(this, OutFunc);
-    else if (BindingInfo.Name == *GetOrientationFunctionName)
-        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatOrientation)::Bind(this, OutFunc);
-    else if (BindingInfo.Name == *GetOpacityFunctionName)
-        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatOpacity)::Bind(this, OutFunc);
-    else if (BindingInfo.Name == *GetColorFunctionName)
-        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatColor)::Bind(this, OutFunc);
+    FGaussianSplatStreamingSettings Settings;
+    // ClampMax only applies in the editor; values set from code are clamped here
+    Settings.ResidencyBudgetBytes = int64(FMath::Clamp(StreamingBudgetMB, 16, 4096)) * 1024 * 1024;
+    Settings.MaxInFlightReads = MaxInFlightTileReads;
+    Settings.MaxStreamingDistance = MaxStreamingDistance;
+
+    TUniquePtr<FGaussianSplatStreamingManager> NewManager = MakeUnique<FGaussianSplatStreamingManager>();
+    FString Error;
+    if (!NewManager->Open(TiledFilePath.FilePath, Settings, Error))
+    {
+        UE_LOG(LogGaussianSplat, Error, TEXT("[OpenStreaming] %s | OPEN FAILED: %s"), *GetName(), *Error);
+        return false;
+    }
+
+    StreamingManager = MoveTemp(NewManager);
+    LastStreamingUpdateFrame = 0;
+
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    const uint32 PoolElements = uint32(StreamingManager->GetPoolElementCount());
+    ENQUEUE_RENDER_COMMAND(InitGaussianSplatStreamingPool)(
+        [RT_Proxy, PoolElements](FRHICommandListImmediate &RHICmdList)
+        { RT_Proxy->InitStreamingPool(RHICmdList, PoolElements); });
+    return true;
 }
 
-void UGaussianSplatNiagaraDataInterface::GetSplatCount(FVectorVMExternalFunctionContext &Context) const
+void UGaussianSplatNiagaraDataInterface::TickStreaming(FNiagaraSystemInstance *SystemInstance)
 {
-    FNDIOutputParam<int32> OutCount(Context);
-    const int32 Count = Splats.Num();
-    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
-        OutCount.SetAndAdvance(Count);
+    // Every instance of this NDI shares one pool, so residency is driven once per frame
+    if (!StreamingManager || LastStreamingUpdateFrame == GFrameCounter)
+        return;
+    LastStreamingUpdateFrame = GFrameCounter;
+
+    const bool bResidencyChanged = StreamingManager->Update(GetLocalViewOrigin(SystemInstance));
+    TArray<FGaussianSplatTileUpload> Uploads = StreamingManager->ConsumeUploads();
+    if (!bResidencyChanged && Uploads.Num() == 0)
+        return;
+
+    TArray<uint32> Indirection;
+    StreamingManager->BuildIndirection(Indirection);
+
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    const uint32 TileCapacity = StreamingManager->GetTileCapacity();
+    ENQUEUE_RENDER_COMMAND(UpdateGaussianSplatStreaming)(
+        [RT_Proxy, Uploads = MoveTemp(Uploads), Indirection = MoveTemp(Indirection),
+         TileCapacity](FRHICommandListImmediate &RHICmdList)
+        {
+            RT_Proxy->UploadStreamingTiles(RHICmdList, Uploads, TileCapacity);
+            RT_Proxy->UploadStreamingIndirection(RHICmdList, Indirection);
+        });
 }
 
-void UGaussianSplatNiagaraDataInterface::GetSplatPosition(FVectorVMExternalFunctionContext &Context) const
+bool UGaussianSplatNiagaraDataInterface::BuildSequenceFromPLYs(const FString &PlyDirectoryOrFrame,
+                                                               const FString &OutSequencePath, float FrameRate,
+                                                               int32 KeyframeInterval)
 {
-    FNDIInputParam<int32> IndexParam(Context);
-    FNDIOutputParam<float> OutPosX(Context);
-    FNDIOutputParam<float> OutPosY(Context);
-    FNDIOutputParam<float> OutPosZ(Context);
+    TArray<FString> FrameFiles;
+    FGaussianSplatSequenceFile::FindFrameFiles(PlyDirectoryOrFrame, FrameFiles);
+    UE_LOG(LogGaussianSplat, Log, TEXT("[BuildSequenceFromPLYs] '%s' | %d frames"), *PlyDirectoryOrFrame,
+           FrameFiles.Num());
 
-    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    FString Error;
+    if (!FGaussianSplatSequenceFile::Write(OutSequencePath, FrameFiles, FrameRate, KeyframeInterval, Error))
     {
-        const int32 Index = IndexParam.GetAndAdvance();
-        if (Splats.IsValidIndex(Index))
-        {
-            const FGaussianSplatData &S = Splats[Index];
-            OutPosX.SetAndAdvance(S.Position.X);
-            OutPosY.SetAndAdvance(S.Position.Y);
-            OutPosZ.SetAndAdvance(S.Position.Z);
-        }
-        else
-        {
-            OutPosX.SetAndAdvance(0.0f);
-            OutPosY.SetAndAdvance(0.0f);
-            OutPosZ.SetAndAdvance(0.0f);
-        }
+        UE_LOG(LogGaussianSplat, Error, TEXT("[BuildSequenceFromPLYs] WRITE FAILED: %s"), *Error);
+        return false;
     }
+    return true;
 }
 
-void UGaussianSplatNiagaraDataInterface::GetSplatScale(FVectorVMExternalFunctionContext &Context) const
+bool UGaussianSplatNiagaraDataInterface::OpenSequence()
+{
+    FGaussianSplatSequenceSettings Settings;
+    Settings.RingSize = SequenceRingSize;
+    Settings.bLoop = bLoopSequence;
+
+    TUniquePtr<FGaussianSplatSequencePlayer> NewPlayer = MakeUnique<FGaussianSplatSequencePlayer>();
+    FString Error;
+    if (!NewPlayer->Open(SequenceFilePath.FilePath, Settings, Error))
+    {
+        UE_LOG(LogGaussianSplat, Error, TEXT("[OpenSequence] %s | %s"), *GetName(), *Error);
+        return false;
+    }
+    SequencePlayer = MoveTemp(NewPlayer);
+    SequencePlayTime = double(SequenceFrameIndex) / SequencePlayer->GetHeader().FrameRate;
+    PresentedSequenceFrame = INDEX_NONE;
+    PresentedSequenceSplats = 0;
+
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    const uint32 MaxSplats = uint32(SequencePlayer->GetHeader().MaxSplats);
+    ENQUEUE_RENDER_COMMAND(InitGaussianSplatSequenceBuffers)(
+        [RT_Proxy, MaxSplats](FRHICommandListImmediate &RHICmdList)
+        { RT_Proxy->InitSequenceBuffers(RHICmdList, MaxSplats); });
+    return true;
+}
+
+void UGaussianSplatNiagaraDataInterface::SetSequenceFrame(int32 FrameIndex)
+{
+    SequenceFrameIndex = FMath::Max(FrameIndex, 0);
+    if (SequencePlayer)
+        SequencePlayTime = double(SequenceFrameIndex) / SequencePlayer->GetHeader().FrameRate;
+}
+
+void UGaussianSplatNiagaraDataInterface::TickSequence(float DeltaSeconds)
+{
+    // One playhead per NDI, shared by every instance like the streaming pool
+    if (!SequencePlayer || LastSequenceUpdateFrame == GFrameCounter)
+        return;
+    LastSequenceUpdateFrame = GFrameCounter;
+
+    const double FrameRate = SequencePlayer->GetHeader().FrameRate;
+    int64 PlayFrame = SequenceFrameIndex;
+    if (bAutoPlaySequence)
+    {
+        SequencePlayTime += double(DeltaSeconds) * SequencePlaybackRate;
+        PlayFrame = int64(FMath::FloorToDouble(SequencePlayTime * FrameRate));
+    }
+
+    // Never blocks: a frame that is not decoded yet leaves the previous one on screen
+    FGaussianSplatSequenceFrameRef Frame = SequencePlayer->Update(PlayFrame);
+    if (!Frame)
+        return;
+    PresentedSequenceFrame = Frame->FileFrame;
+    PresentedSequenceSplats = Frame->Records.Num();
+
+    // The decoded frame is shared with the render thread rather than copied
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    ENQUEUE_RENDER_COMMAND(UploadGaussianSplatSequenceFrame)(
+        [RT_Proxy, Frame = MoveTemp(Frame)](FRHICommandListImmediate &RHICmdList)
+        { RT_Proxy->UploadSequenceFrame(RHICmdList, *Frame); });
+}
+
+FVector UGaussianSplatNiagaraDataInterface::GetViewLocation(FNiagaraSystemInstance *SystemInstance)
+{
+    const UWorld *World = SystemInstance->GetWorld();
+    if (World && World->ViewLocationsRenderedLastFrame.Num() > 0)
+        return World->ViewLocationsRenderedLastFrame[0];
+    return SystemInstance->GetWorldTransform().GetLocation();
+}
+
+FVector3f UGaussianSplatNiagaraDataInterface::GetLocalViewOrigin(FNiagaraSystemInstance *SystemInstance)
+{
+    return FVector3f(SystemInstance->GetWorldTransform().InverseTransformPosition(GetViewLocation(SystemInstance)));
+}
+
+bool UGaussianSplatNiagaraDataInterface::GetPlayerProjectionData(FNiagaraSystemInstance *SystemInstance,
+                                                                 FSceneViewProjectionData &OutProjectionData)
+{
+    const UWorld *World = SystemInstance->GetWorld();
+    const APlayerController *PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+    const ULocalPlayer *LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+    if (!LocalPlayer || !LocalPlayer->ViewportClient || !LocalPlayer->ViewportClient->Viewport)
+        return false;
+    return LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, OutProjectionData);
+}
+
+bool UGaussianSplatNiagaraDataInterface::GetLocalToClip(FNiagaraSystemInstance *SystemInstance,
+                                                        FMatrix &OutLocalToClip, float &OutViewHeight)
+{
+    FSceneViewProjectionData ProjectionData;
+    if (!GetPlayerProjectionData(SystemInstance, ProjectionData))
+        return false;
+    OutLocalToClip =
+        SystemInstance->GetWorldTransform().ToMatrixWithScale() * ProjectionData.ComputeViewProjectionMatrix();
+    OutViewHeight = float(ProjectionData.GetConstrainedViewRect().Height());
+    return true;
+}
+
+bool UGaussianSplatNiagaraDataInterface::IsViewCulled() const
+{
+    // Streaming already keeps only nearby tiles, and sequences and instances are indexed by particle directly
+    return bViewCulling && GGaussianSplatCullEnable != 0 && !IsStreaming() && !IsSequence() && !IsInstanced();
+}
+
+void UGaussianSplatNiagaraDataInterface::UpdateViewCulling(FGaussianSplatPerInstanceData *InstData,
+                                                           FNiagaraSystemInstance *SystemInstance)
+{
+    // Without a player view (editor viewports, servers) nothing is culled. The view is kept with culling off too, for
+    // GetSplatScreenSize.
+    InstData->CullParams = FGaussianSplatCullParams();
+    FMatrix LocalToClip;
+    float ViewHeight = 0.0f;
+    if (GetLocalToClip(SystemInstance, LocalToClip, ViewHeight))
+    {
+        FGaussianSplatCulling::BuildParams(LocalToClip, ViewHeight, CullRadiusSigma / FGaussianSplatData::BoundingSigma,
+                                           SubPixelCullRadius, InstData->CullParams);
+        InstData->CullParams.bEnabled = IsViewCulled();
+    }
+
+    // Each system instance keeps its own count and list, as each has its own transform and view
+    if (!InstData->CullParams.bEnabled)
+    {
+        InstData->VisibleSplatCount = INDEX_NONE;
+        InstData->VisibleSplats.Empty();
+    }
+    else if (!bCPUSplatsTrimmed && (IsUsedWithCPUScript() || GGaussianSplatCullCPU != 0))
+    {
+        InstData->VisibleSplatCount =
+            FGaussianSplatCulling::Cull(InstData->CullParams, Splats, InstData->VisibleSplats);
+    }
+    else
+    {
+        InstData->VisibleSplats.Empty();
+        InstData->VisibleSplatCount = GetProxyAs<FNDIGaussianSplatProxy>()->GetVisibleCount(SystemInstance->GetId());
+    }
+
+    // The Blueprint count and the CPU screen size follow the first instance ticked, like streaming
+    if (LastCullFrame == GFrameCounter)
+        return;
+    LastCullFrame = GFrameCounter;
+    CPUCullParams = InstData->CullParams;
+    VisibleSplatCount = InstData->VisibleSplatCount;
+}
+
+void UGaussianSplatNiagaraDataInterface::TickUploads()
+{
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    if (LastUploadFrame == GFrameCounter || !RT_Proxy->HasPendingUploads())
+        return;
+    LastUploadFrame = GFrameCounter;
+
+    ENQUEUE_RENDER_COMMAND(UploadGaussianSplatSlices)(
+        [RT_Proxy](FRHICommandListImmediate &RHICmdList) { RT_Proxy->UploadPendingSlices(RHICmdList); });
+}
+
+void UGaussianSplatNiagaraDataInterface::TickRasterizer(FNiagaraSystemInstance *SystemInstance)
+{
+    if (!RasterTarget || IsStreaming() || IsSequence() || IsInstanced() || LastRasterFrame == GFrameCounter)
+        return;
+    LastRasterFrame = GFrameCounter;
+
+    FSceneViewProjectionData ProjectionData;
+    if (!GetPlayerProjectionData(SystemInstance, ProjectionData))
+        return;
+    // The blend pass writes the target directly
+    if (!RasterTarget->bCanCreateUAV)
+    {
+        UE_LOG(LogGaussianSplat, Log, TEXT("[TickRasterizer] %s | Enabling UAV on render target %s"), *GetName(),
+               *RasterTarget->GetName());
+        RasterTarget->bCanCreateUAV = true;
+        RasterTarget->UpdateResourceImmediate(false);
+    }
+    FTextureRenderTargetResource *Target = RasterTarget->GameThread_GetRenderTargetResource();
+    if (!Target)
+        return;
+
+    const FGaussianSplatRasterView View = FGaussianSplatRasterView::Make(
+        SystemInstance->GetWorldTransform().ToMatrixWithScale(),
+        FTranslationMatrix(-ProjectionData.ViewOrigin) * ProjectionData.ViewRotationMatrix,
+        ProjectionData.ProjectionMatrix, FIntPoint(RasterTarget->SizeX, RasterTarget->SizeY));
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    const FNiagaraSystemInstanceID InstanceID = SystemInstance->GetId();
+    const float KeysPerSplat = RasterKeysPerSplat;
+    ENQUEUE_RENDER_COMMAND(RasterizeGaussianSplats)(
+        [RT_Proxy, InstanceID, View, Target, KeysPerSplat](FRHICommandListImmediate &RHICmdList)
+        { RT_Proxy->Rasterize(RHICmdList, InstanceID, View, Target, KeysPerSplat); });
+}
+
+void UGaussianSplatNiagaraDataInterface::SetCloudInstances(const TArray<FGaussianSplatCloudInstance> &NewInstances)
+{
+    CloudInstances = NewInstances;
+    LastInstancingUpdateFrame = 0;
+}
+
+int32 UGaussianSplatNiagaraDataInterface::GetDecimationStride(float Distance) const
+{
+    if (InstanceDecimationDistance <= 0.0f || Distance <= InstanceDecimationDistance)
+        return 1;
+    const uint32 Ratio = uint32(FMath::Min(FMath::CeilToFloat(Distance / InstanceDecimationDistance), 65536.0f));
+    return FMath::Clamp(int32(FMath::RoundUpToPowerOfTwo(Ratio)), 1, FMath::Max(MaxInstanceDecimationStride, 1));
+}
+
+void UGaussianSplatNiagaraDataInterface::TickInstancing(FNiagaraSystemInstance *SystemInstance)
+{
+    // Instance transforms are shared by every system instance; strides follow the first view, like streaming
+    if (LastInstancingUpdateFrame == GFrameCounter || (!IsInstanced() && PackedCloudInstances.Num() == 0))
+        return;
+    LastInstancingUpdateFrame = GFrameCounter;
+
+    TArray<FVector4f> Packed;
+    Packed.Reserve(CloudInstances.Num() * 3);
+    const FVector3f ViewOrigin = GetLocalViewOrigin(SystemInstance);
+    for (const FGaussianSplatCloudInstance &Instance : CloudInstances)
+    {
+        const FVector3f Location(Instance.Transform.GetLocation());
+        const FQuat4f Rotation(Instance.Transform.GetRotation().GetNormalized());
+        const float UniformScale = float(Instance.Transform.GetMaximumAxisScale());
+        const int32 Stride = GetDecimationStride(FVector3f::Dist(ViewOrigin, Location));
+        Packed.Add(FVector4f(Location, UniformScale));
+        Packed.Add(FVector4f(Rotation.X, Rotation.Y, Rotation.Z, Rotation.W));
+        Packed.Add(FVector4f(Instance.Tint.R, Instance.Tint.G, Instance.Tint.B, float(Stride)));
+    }
+
+    // Strides only change when an instance crosses a distance band, so most frames upload nothing
+    if (Packed == PackedCloudInstances)
+        return;
+    PackedCloudInstances = Packed;
+
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    ENQUEUE_RENDER_COMMAND(UpdateGaussianSplatInstances)(
+        [RT_Proxy, Packed = MoveTemp(Packed)](FRHICommandListImmediate &RHICmdList)
+        { RT_Proxy->UploadCloudInstances(RHICmdList, Packed); });
+}
+
+void UGaussianSplatNiagaraDataInterface::PublishSplatCount(FGaussianSplatPerInstanceData *InstData,
+                                                           FNiagaraSystemInstance *SystemInstance) const
+{
+    const int32 SplatCount = GetSpawnedSplatCount();
+    if (InstData->PublishedSplatCount == SplatCount)
+        return;
+    InstData->PublishedSplatCount = SplatCount;
+
+    FNiagaraVariable SplatCountVar(FNiagaraTypeDefinition::GetIntDef(), TEXT("User.SplatCount"));
+    SystemInstance->GetOverrideParameters()->SetParameterValue<int32>(SplatCount, SplatCountVar, true);
+}
+
+int32 UGaussianSplatNiagaraDataInterface::GetSplatCount() const
+{
+    return ResolveSplatCount(VisibleSplatCount);
+}
+
+int32 UGaussianSplatNiagaraDataInterface::ResolveSplatCount(int32 CulledCount) const
+{
+    if (StreamingManager)
+        return int32(StreamingManager->GetStats().ResidentSplats);
+    if (IsSequence())
+        return PresentedSequenceSplats;
+    if (IsViewCulled() && CulledCount != INDEX_NONE)
+        return CulledCount;
+    return GetSpawnedSplatCount();
+}
+
+int32 UGaussianSplatNiagaraDataInterface::GetSpawnedSplatCount() const
+{
+    // Instanced mode spawns one particle per (instance, splat) pair
+    const int32 NumInstances = PackedCloudInstances.Num() / 3;
+    return GetLoadedSplatCount() * FMath::Max(NumInstances, 1);
+}
+
+void UGaussianSplatNiagaraDataInterface::ClearSplats()
+{
+    Splats.Empty();
+    CPUData.Reset();
+    SpatialGrid.Reset();
+    CloudTable.Reset();
+    CurrentSplatCount = 0;
+    bCPUSplatsTrimmed = false;
+    MarkRenderDataDirty();
+    LoadedSourceFiles.Reset();
+    OnSourceLoaded();
+}
+
+bool UGaussianSplatNiagaraDataInterface::Equals(const UNiagaraDataInterface *Other) const
+{
+    if (!Super::Equals(Other))
+        return false;
+
+    const UGaussianSplatNiagaraDataInterface *OtherNDI = Cast<UGaussianSplatNiagaraDataInterface>(Other);
+    if (!OtherNDI)
+        return false;
+
+    const bool bPathEqual = PlyFilePath.FilePath == OtherNDI->PlyFilePath.FilePath;
+    const bool bTintEqual = GlobalTint == OtherNDI->GlobalTint;
+    const bool bLayoutEqual = BufferLayout == OtherNDI->BufferLayout;
+    const bool bCleanupEqual = Cleanup == OtherNDI->Cleanup;
+    bool bCloudsEqual = Clouds.Num() == OtherNDI->Clouds.Num();
+    for (int32 i = 0; bCloudsEqual && i < Clouds.Num(); ++i)
+    {
+        const FGaussianSplatCloud &A = Clouds[i];
+        const FGaussianSplatCloud &B = OtherNDI->Clouds[i];
+        bCloudsEqual = A.PlyFile.FilePath == B.PlyFile.FilePath && A.Transform.Equals(B.Transform, 0.0) &&
+                       A.Tint == B.Tint;
+    }
+    const bool bStreamingEqual = TiledFilePath.FilePath == OtherNDI->TiledFilePath.FilePath &&
+                                 StreamingBudgetMB == OtherNDI->StreamingBudgetMB &&
+                                 MaxInFlightTileReads == OtherNDI->MaxInFlightTileReads &&
+                                 MaxStreamingDistance == OtherNDI->MaxStreamingDistance;
+    const bool bSequenceEqual = SequenceFilePath.FilePath == OtherNDI->SequenceFilePath.FilePath &&
+                                SequenceRingSize == OtherNDI->SequenceRingSize &&
+                                bLoopSequence == OtherNDI->bLoopSequence &&
+                                bAutoPlaySequence == OtherNDI->bAutoPlaySequence &&
+                                SequencePlaybackRate == OtherNDI->SequencePlaybackRate &&
+                                SequenceFrameIndex == OtherNDI->SequenceFrameIndex;
+    bool bInstancesEqual = CloudInstances.Num() == OtherNDI->CloudInstances.Num() &&
+                           InstanceDecimationDistance == OtherNDI->InstanceDecimationDistance &&
+                           MaxInstanceDecimationStride == OtherNDI->MaxInstanceDecimationStride;
+    const bool bBudgetEqual = BudgetPriority == OtherNDI->BudgetPriority;
+    const bool bCullEqual = bViewCulling == OtherNDI->bViewCulling && CullRadiusSigma == OtherNDI->CullRadiusSigma &&
+                            SubPixelCullRadius == OtherNDI->SubPixelCullRadius;
+    const bool bRasterEqual =
+        RasterTarget == OtherNDI->RasterTarget && RasterKeysPerSplat == OtherNDI->RasterKeysPerSplat;
+    const bool bSpatialEqual = bBuildSpatialGrid == OtherNDI->bBuildSpatialGrid &&
+                               SpatialGridSplatsPerCell == OtherNDI->SpatialGridSplatsPerCell;
+    const bool bDeformEqual = bWritableSplats == OtherNDI->bWritableSplats;
+    const bool bResidencyEqual = CPUResidency == OtherNDI->CPUResidency && CPUProxyLevel == OtherNDI->CPUProxyLevel;
+    for (int32 i = 0; bInstancesEqual && i < CloudInstances.Num(); ++i)
+    {
+        const FGaussianSplatCloudInstance &A = CloudInstances[i];
+        const FGaussianSplatCloudInstance &B = OtherNDI->CloudInstances[i];
+        bInstancesEqual = A.Transform.Equals(B.Transform, 0.0) && A.Tint == B.Tint;
+    }
+    return bPathEqual && bTintEqual && bLayoutEqual && bCleanupEqual && bCloudsEqual && bStreamingEqual &&
+           bSequenceEqual && bInstancesEqual && bBudgetEqual && bCullEqual && bRasterEqual && bSpatialEqual &&
+           bDeformEqual && bResidencyEqual;
+}
+
+void UGaussianSplatNiagaraDataInterface::MarkRenderDataDirty()
+{
+    ++RenderDataRevision;
+    // A full re-init supersedes any partial edits still queued
+    PendingDirtyRanges.Reset();
+    SetAccountedMemory(GetCPUMemoryBytes(), GetLoadedSplatCount());
+}
+
+int64 UGaussianSplatNiagaraDataInterface::GetGPUMemoryBytes() const
+{
+    const FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    return RT_Proxy ? RT_Proxy->GetAccountedGPUBytes() : 0;
+}
+
+FGaussianSplatGPUMemory UGaussianSplatNiagaraDataInterface::GetGPUMemory() const
+{
+    const FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    return RT_Proxy ? RT_Proxy->GetAccountedGPUMemory() : FGaussianSplatGPUMemory();
+}
+
+FGaussianSplatCPUMemory UGaussianSplatNiagaraDataInterface::GetCPUMemory() const
+{
+    FGaussianSplatCPUMemory Memory;
+    Memory.Splats = Splats.GetAllocatedSize();
+    for (const FGaussianSplatData &Splat : Splats)
+        Memory.HarmonicsCoefficients += Splat.HighOrderHarmonicsCoefficients.GetAllocatedSize();
+    Memory.VMData = CPUData.GetAllocatedSize();
+    Memory.SpatialGrid = SpatialGrid.GetAllocatedSize();
+    Memory.Tables = CloudTable.Offsets.GetAllocatedSize() + CloudTable.Tints.GetAllocatedSize() +
+                    PackedCloudInstances.GetAllocatedSize();
+    if (const FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>())
+        Memory.PendingUploads = RT_Proxy->GetRenderThreadCPUBytes();
+    return Memory;
+}
+
+void UGaussianSplatNiagaraDataInterface::GetResourceSizeEx(FResourceSizeEx &CumulativeResourceSize)
+{
+    Super::GetResourceSizeEx(CumulativeResourceSize);
+
+    const FGaussianSplatCPUMemory CPU = GetCPUMemory();
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("Splats"), CPU.Splats);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("HarmonicsCoefficients"), CPU.HarmonicsCoefficients);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("VMData"), CPU.VMData);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("SpatialGrid"), CPU.SpatialGrid);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("Tables"), CPU.Tables);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("PendingUploads"), CPU.PendingUploads);
+
+    const FGaussianSplatGPUMemory GPU = GetGPUMemory();
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("Positions"), GPU.Positions);
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("Scales"), GPU.Scales);
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("Orientations"), GPU.Orientations);
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("SHZeroCoeffsAndOpacity"), GPU.SHZeroCoeffsAndOpacity);
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("Records"), GPU.Records);
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("GPUTables"), GPU.Tables);
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("Culling"), GPU.Culling);
+    CumulativeResourceSize.AddDedicatedVideoMemoryBytes(TEXT("Raster"), GPU.Raster);
+}
+
+void UGaussianSplatNiagaraDataInterface::SetAccountedMemory(int64 CPUBytes, int32 NumSplats)
+{
+    if (CPUBytes > AccountedCPUBytes)
+        INC_MEMORY_STAT_BY(STAT_GaussianSplat_CPUMemory, CPUBytes - AccountedCPUBytes);
+    else if (CPUBytes < AccountedCPUBytes)
+        DEC_MEMORY_STAT_BY(STAT_GaussianSplat_CPUMemory, AccountedCPUBytes - CPUBytes);
+    INC_DWORD_STAT_BY(STAT_GaussianSplat_LoadedSplats, NumSplats);
+    DEC_DWORD_STAT_BY(STAT_GaussianSplat_LoadedSplats, AccountedSplats);
+    AccountedCPUBytes = CPUBytes;
+    AccountedSplats = NumSplats;
+}
+
+void UGaussianSplatNiagaraDataInterface::UpdateSplatRange(int32 Start, int32 Count)
+{
+    if (bCPUSplatsTrimmed)
+    {
+        UE_LOG(LogGaussianSplat, Warning, TEXT("[UpdateSplatRange] %s | Splats was trimmed by CPUResidency, ignored"),
+               *GetName());
+        return;
+    }
+    PendingDirtyRanges.Add(Start, Count);
+}
+
+void UGaussianSplatNiagaraDataInterface::UpdateSplats(const TArray<int32> &Indices)
+{
+    if (bCPUSplatsTrimmed)
+    {
+        UE_LOG(LogGaussianSplat, Warning, TEXT("[UpdateSplats] %s | Splats was trimmed by CPUResidency, ignored"),
+               *GetName());
+        return;
+    }
+    PendingDirtyRanges.AddIndices(Indices);
+}
+
+void UGaussianSplatNiagaraDataInterface::FlushSplatUpdates()
+{
+    if (PendingDirtyRanges.IsEmpty())
+        return;
+
+    // Small gaps are cheaper to re-upload than to split into separate buffer locks
+    constexpr int32 MergeGapTolerance = 64;
+    const int32 NumSplats = Splats.Num();
+    PendingDirtyRanges.Merge(NumSplats, MergeGapTolerance);
+
+    if (CPUDataRevision == RenderDataRevision)
+    {
+        for (const FGaussianSplatDirtyRange &Range : PendingDirtyRanges.GetRanges())
+            CPUData.UpdateRange(Splats, Range.Start, Range.Count);
+    }
+
+    // Packed once here; the proxy splits records into streams only for instances using that layout
+    struct FRangeUpload
+    {
+        int32 Start = 0;
+        TArray<FGaussianSplatPackedRecord> Records;
+    };
+    TArray<FRangeUpload> RangeUploads;
+    RangeUploads.Reserve(PendingDirtyRanges.GetRanges().Num());
+    int64 UploadBytes = 0;
+    for (const FGaussianSplatDirtyRange &Range : PendingDirtyRanges.GetRanges())
+    {
+        FRangeUpload &Upload = RangeUploads.AddDefaulted_GetRef();
+        Upload.Start = Range.Start;
+        FGaussianSplatPacking::PackRecords(MakeArrayView(Splats).Slice(Range.Start, Range.Count), Upload.Records);
+        UploadBytes += Upload.Records.GetAllocatedSize();
+    }
+
+    UE_LOG(LogGaussianSplat, Verbose, TEXT("[FlushSplatUpdates] %s | %d ranges | %lld splats"), *GetName(),
+           RangeUploads.Num(), PendingDirtyRanges.GetTotalCount());
+    PendingDirtyRanges.Reset();
+
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    RT_Proxy->AddPendingUploadBytes(UploadBytes);
+    ENQUEUE_RENDER_COMMAND(UpdateGaussianSplatRanges)(
+        [RT_Proxy, RangeUploads = MoveTemp(RangeUploads), NumSplats, UploadBytes](FRHICommandListImmediate &RHICmdList)
+        {
+            for (auto &Pair : RT_Proxy->SystemInstancesToData_RT)
+            {
+                FGaussianSplatInstanceData_RT &InstanceData = Pair.Value;
+                // Instances built from a different splat set are about to be re-initialised anyway
+                if (!InstanceData.HasAllocation() || InstanceData.SplatsCount != NumSplats)
+                    continue;
+
+                // Slices still to upload take the edit too, or they would overwrite it when they land
+                for (const FRangeUpload &Upload : RangeUploads)
+                {
+                    RT_Proxy->UploadRecords(RHICmdList, InstanceData, Upload.Start, Upload.Records);
+                    RT_Proxy->PatchPendingRecords(InstanceData, Upload.Start, Upload.Records);
+                }
+            }
+            RT_Proxy->AddPendingUploadBytes(-UploadBytes);
+        });
+}
+
+void UGaussianSplatNiagaraDataInterface::ResetDeformation()
+{
+    if (!IsWritable())
+        return;
+
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    ENQUEUE_RENDER_COMMAND(ResetGaussianSplatDeformation)([RT_Proxy](FRHICommandListImmediate &)
+                                                          { RT_Proxy->ResetDeformation(); });
+}
+
+bool UGaussianSplatNiagaraDataInterface::CopyToInternal(UNiagaraDataInterface *Destination) const
+{
+    if (!Super::CopyToInternal(Destination))
+        return false;
+
+    UGaussianSplatNiagaraDataInterface *DestNDI = Cast<UGaussianSplatNiagaraDataInterface>(Destination);
+    if (!DestNDI)
+        return false;
+
+    // Copy all game-thread data; GPU upload is deferred to InitPerInstanceData
+    DestNDI->PlyFilePath = PlyFilePath;
+    DestNDI->GlobalTint = GlobalTint;
+    DestNDI->BufferLayout = BufferLayout;
+    DestNDI->Clouds = Clouds;
+    DestNDI->Cleanup = Cleanup;
+    DestNDI->Splats = Splats;
+    DestNDI->CloudTable = CloudTable;
+    DestNDI->CurrentSplatCount = CurrentSplatCount;
+    DestNDI->TiledFilePath = TiledFilePath;
+    DestNDI->StreamingBudgetMB = StreamingBudgetMB;
+    DestNDI->MaxInFlightTileReads = MaxInFlightTileReads;
+    DestNDI->MaxStreamingDistance = MaxStreamingDistance;
+    DestNDI->SequenceFilePath = SequenceFilePath;
+    DestNDI->SequenceRingSize = SequenceRingSize;
+    DestNDI->bLoopSequence = bLoopSequence;
+    DestNDI->bAutoPlaySequence = bAutoPlaySequence;
+    DestNDI->SequencePlaybackRate = SequencePlaybackRate;
+    DestNDI->SequenceFrameIndex = SequenceFrameIndex;
+    DestNDI->CloudInstances = CloudInstances;
+    DestNDI->InstanceDecimationDistance = InstanceDecimationDistance;
+    DestNDI->MaxInstanceDecimationStride = MaxInstanceDecimationStride;
+    DestNDI->BudgetPriority = BudgetPriority;
+    DestNDI->bViewCulling = bViewCulling;
+    DestNDI->CullRadiusSigma = CullRadiusSigma;
+    DestNDI->SubPixelCullRadius = SubPixelCullRadius;
+    DestNDI->RasterTarget = RasterTarget;
+    DestNDI->RasterKeysPerSplat = RasterKeysPerSplat;
+    DestNDI->bBuildSpatialGrid = bBuildSpatialGrid;
+    DestNDI->SpatialGridSplatsPerCell = SpatialGridSplatsPerCell;
+    DestNDI->bWritableSplats = bWritableSplats;
+    DestNDI->CPUResidency = CPUResidency;
+    DestNDI->CPUProxyLevel = CPUProxyLevel;
+    // A trimmed copy is reloaded by the destination's first instance
+    DestNDI->bCPUSplatsTrimmed = bCPUSplatsTrimmed;
+    // The copied splats are already thinned to this level
+    DestNDI->BudgetLevel = BudgetLevel;
+    DestNDI->MarkRenderDataDirty();
+    // Copies follow re-imports of the source too
+    DestNDI->LoadedSourceFiles = LoadedSourceFiles;
+    DestNDI->OnSourceLoaded();
+
+    UE_LOG(LogGaussianSplat, Log, TEXT("[CopyToInternal] %s -> %s | Path='%s' | Splats=%d | Tint=(%.2f,%.2f,%.2f)"),
+           *GetName(), *DestNDI->GetName(), *PlyFilePath.FilePath, Splats.Num(), GlobalTint.R, GlobalTint.G,
+           GlobalTint.B);
+
+    return true;
+}
+
+// Niagara Function Declarations
+
+void UGaussianSplatNiagaraDataInterface::GetFunctions(TArray<FNiagaraFunctionSignature> &OutFunctions)
+{
+    // GetSplatCount
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetSplatCountFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Count")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatPosition
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetPositionFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Position")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatScale
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetScaleFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Scale")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatOrientation
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetOrientationFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetQuatDef(), TEXT("Orientation")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatOpacity
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetOpacityFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Opacity")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatColor
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetColorFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetColorDef(), TEXT("Color")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatAttributes — everything above in one call
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetAttributesFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Position")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Scale")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetQuatDef(), TEXT("Orientation")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetColorDef(), TEXT("Color")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetCloudCount
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetCloudCountFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Count")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatCloud — which cloud a splat came from, and its index within that cloud
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetSplatCloudFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CloudIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("LocalIndex")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetCloudSplatRange
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetCloudSplatRangeFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CloudIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("StartIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Count")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetCloudInstanceCount
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetCloudInstanceCountFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Count")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetInstancedSplatIndex — splits a particle index into (instance, splat) in instanced mode
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetInstancedSplatIndexFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("ParticleIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("InstanceIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("SplatIndex")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetInstancedSplatAttributes — GetSplatAttributes placed by one instance. Visible is false for splats dropped
+    // by distance decimation.
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetInstancedSplatAttributesFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("InstanceIndex")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("SplatIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Position")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Scale")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetQuatDef(), TEXT("Orientation")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetColorDef(), TEXT("Color")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("Visible")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetVisibleSplatIndex — maps [0, GetSplatCount) to the splats that survived view culling; the identity when
+    // culling is off. Visible is false past the count.
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetVisibleSplatIndexFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("VisibleIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("SplatIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("Visible")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatScreenSize — projected bounding radius in pixels for the first player's view; 0 without a view, behind
+    // the camera, or for streamed and sequence clouds
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetSplatScreenSizeFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("PixelRadius")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatsInRadius — splats whose centre is within Radius of Center, up to MaxCount. Needs bBuildSpatialGrid.
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetSplatsInRadiusFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Center")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Radius")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("MaxCount")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Count")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSplatInRadius — the Nth splat GetSplatsInRadius counts, for walking [0, Count). Each call rescans the
+    // cells, so keep counts small. Valid is false past the end.
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetSplatInRadiusFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Center")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Radius")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Nth")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("SplatIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("Valid")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetNearestSplat — closest splat centre to Position within MaxDistance (0 searches the whole grid)
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetNearestSplatFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Position")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("MaxDistance")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("SplatIndex")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Distance")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("Valid")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // SetSplatPosition — GPU write, seen by every reader from the next frame. Needs bWritableSplats; Success is false
+    // without it or for an out-of-range index. Within a frame the last write wins, as for the other writes below.
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *SetSplatPositionFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Position")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("Success")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        Sig.bRequiresExecPin = true;
+        Sig.bWriteFunction = true;
+        Sig.bSupportsCPU = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // SetSplatOpacity — replaces the stored opacity, before any sub-pixel compensation
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *SetSplatOpacityFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Opacity")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("Success")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        Sig.bRequiresExecPin = true;
+        Sig.bWriteFunction = true;
+        Sig.bSupportsCPU = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // ResetSplat — back to the uploaded position and colour
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *ResetSplatFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Index")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("Success")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        Sig.bRequiresExecPin = true;
+        Sig.bWriteFunction = true;
+        Sig.bSupportsCPU = false;
+        OutFunctions.Add(Sig);
+    }
+
+    // GetSequenceFrame — file frame currently bound, INDEX_NONE before the first one lands. GPU only like sequences.
+    {
+        FNiagaraFunctionSignature Sig;
+        Sig.Name = *GetSequenceFrameFunctionName;
+        Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("GaussianSplatNDI")));
+        Sig.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("FrameIndex")));
+        Sig.bMemberFunction = true;
+        Sig.bRequiresContext = false;
+        Sig.bSupportsCPU = false;
+        OutFunctions.Add(Sig);
+    }
+}
+
+// CPU VM Function Binding & Implementations
+
+void UGaussianSplatNiagaraDataInterface::GetVMExternalFunction(const FVMExternalFunctionBindingInfo &BindingInfo,
+                                                               void *InstanceData, FVMExternalFunction &OutFunc)
 {
-    FNDIInputParam<int32> IndexParam(Context);
-    FNDIOutputParam<float> OutX(Context);
-    FNDIOutputParam<float> OutY(Context);
-    FNDIOutputParam<float> OutZ(Context);
+    if (BindingInfo.Name == *GetSplatCountFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatCount)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetPositionFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatPosition)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetScaleFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatScale)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetOrientationFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatOrientation)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetOpacityFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatOpacity)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetColorFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatColor)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetAttributesFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatAttributes)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetCloudCountFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetCloudCount)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetSplatCloudFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatCloud)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetCloudSplatRangeFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetCloudSplatRange)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetCloudInstanceCountFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetCloudInstanceCount)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetInstancedSplatIndexFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetInstancedSplatIndex)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetInstancedSplatAttributesFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetInstancedSplatAttributes)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetVisibleSplatIndexFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetVisibleSplatIndex)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetSplatScreenSizeFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatScreenSize)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetSplatsInRadiusFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatsInRadius)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetSplatInRadiusFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetSplatInRadius)::Bind(this, OutFunc);
+    else if (BindingInfo.Name == *GetNearestSplatFunctionName)
+        NDI_FUNC_BINDER(UGaussianSplatNiagaraDataInterface, GetNearestSplat)::Bind(this, OutFunc);
+}
 
+void UGaussianSplatNiagaraDataInterface::GetSplatCount(FVectorVMExternalFunctionContext &Context) const
+{
+    VectorVM::FUserPtrHandler<FGaussianSplatPerInstanceData> InstData(Context);
+    FNDIOutputParam<int32> OutCount(Context);
+    const int32 Count = ResolveSplatCount(InstData->VisibleSplatCount);
     for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+        OutCount.SetAndAdvance(Count);
+}
+
+namespace GaussianSplatVM
+{
+constexpr int32 ChunkSize = 128;
+
+// Clamped splat indices for a slice of the VM batch
+struct FIndexChunk
+{
+    int32 Indices[ChunkSize];
+    int32 Num = 0;
+    // Indices[i] == Indices[0] + i for the whole chunk, all in range: planes can be copied instead of gathered
+    bool bContiguous = false;
+};
+
+// Spawn scripts usually read splat ExecIndex, so most chunks come out contiguous
+void ReadIndexChunk(FNDIInputParam<int32> &IndexParam, const FGaussianSplatCPUData &Data, int32 Remaining,
+                    FIndexChunk &Chunk)
+{
+    Chunk.Num = FMath::Min(Remaining, ChunkSize);
+    for (int32 i = 0; i < Chunk.Num; ++i)
+        Chunk.Indices[i] = IndexParam.GetAndAdvance();
+
+    const int32 First = Chunk.Indices[0];
+    bool bContiguous = First >= 0 && First + Chunk.Num <= Data.Num();
+    for (int32 i = 1; i < Chunk.Num; ++i)
+        bContiguous &= Chunk.Indices[i] == First + i;
+    Chunk.bContiguous = bContiguous;
+
+    if (!bContiguous)
     {
-        const int32 Index = IndexParam.GetAndAdvance();
-        if (Splats.IsValidIndex(Index))
+        for (int32 i = 0; i < Chunk.Num; ++i)
+            Chunk.Indices[i] = Data.ClampIndex(Chunk.Indices[i]);
+    }
+}
+
+void WritePlane(FNDIOutputParam<float> &Out, const TArray<float> &Plane, const FIndexChunk &Chunk)
+{
+    // Unbound outputs write to a single dummy slot, so only SetAndAdvance is safe on them
+    const float *RESTRICT Src = Plane.GetData();
+    if (Chunk.bContiguous && Out.IsValid())
+    {
+        FMemory::Memcpy(Out.Data.GetDest(), Src + Chunk.Indices[0], Chunk.Num * sizeof(float));
+        for (int32 i = 0; i < Chunk.Num; ++i)
+            Out.Data.Advance();
+        return;
+    }
+    for (int32 i = 0; i < Chunk.Num; ++i)
+        Out.SetAndAdvance(Src[Chunk.Indices[i]]);
+}
+
+// Projected radius of every splat in the chunk, 4 lanes at a time. OutPixelRadius holds ChunkSize floats.
+void ComputePixelRadii(const FGaussianSplatCPUData &Data, const FGaussianSplatCullParams &View,
+                       const FIndexChunk &Chunk, float *OutPixelRadius)
+{
+    alignas(16) float PX[4], PY[4], PZ[4], Radius[4];
+    for (int32 Base = 0; Base < Chunk.Num; Base += 4)
+    {
+        const int32 NumLanes = FMath::Min(4, Chunk.Num - Base);
+        const float *LaneX = PX, *LaneY = PY, *LaneZ = PZ, *LaneRadius = Radius;
+        if (Chunk.bContiguous && NumLanes == 4)
+        {
+            const int32 First = Chunk.Indices[Base];
+            LaneX = Data.PositionX.GetData() + First;
+            LaneY = Data.PositionY.GetData() + First;
+            LaneZ = Data.PositionZ.GetData() + First;
+            LaneRadius = Data.BoundingRadius.GetData() + First;
+        }
+        else
+        {
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                const int32 Index = Lane < NumLanes ? Chunk.Indices[Base + Lane] : Data.Num();
+                PX[Lane] = Data.PositionX.GetData()[Index];
+                PY[Lane] = Data.PositionY.GetData()[Index];
+                PZ[Lane] = Data.PositionZ.GetData()[Index];
+                Radius[Lane] = Data.BoundingRadius.GetData()[Index];
+            }
+        }
+        FGaussianSplatCPUData::PixelRadius4(LaneX, LaneY, LaneZ, LaneRadius, View.DepthPlane, View.PixelScale,
+                                            OutPixelRadius + Base);
+    }
+}
+
+// Opacity, raised for splats that survived sub-pixel thinning so they stand in for the ones dropped
+void WriteOpacity(const FGaussianSplatCPUData &Data, const FGaussianSplatCullParams &View, const FIndexChunk &Chunk,
+                  FNDIOutputParam<float> &OutA)
+{
+    const float SubPixelRadius = View.GetSubPixelRadius();
+    if (SubPixelRadius <= 0.0f)
+    {
+        WritePlane(OutA, Data.Opacity, Chunk);
+        return;
+    }
+    alignas(16) float PixelRadius[ChunkSize];
+    ComputePixelRadii(Data, View, Chunk, PixelRadius);
+    for (int32 i = 0; i < Chunk.Num; ++i)
+    {
+        const float Keep = FGaussianSplatCulling::GetKeepProbability(PixelRadius[i], SubPixelRadius);
+        OutA.SetAndAdvance(FGaussianSplatCulling::CompensateOpacity(Data.Opacity[Chunk.Indices[i]], Keep));
+    }
+}
+
+// Tinted SH0 colour plus opacity, converting 4 lanes at a time. Per-cloud tints only apply with several clouds.
+void WriteColors(const FGaussianSplatCPUData &Data, const FGaussianSplatCloudTable &Clouds,
+                 const FGaussianSplatCullParams &View, const FIndexChunk &Chunk, const FLinearColor &Tint,
+                 FNDIOutputParam<float> &OutR, FNDIOutputParam<float> &OutG, FNDIOutputParam<float> &OutB,
+                 FNDIOutputParam<float> &OutA)
+{
+    const bool bCloudTints = Clouds.Num() > 1;
+    alignas(16) float SHR[4], SHG[4], SHB[4], R[4], G[4], B[4];
+    for (int32 Base = 0; Base < Chunk.Num; Base += 4)
+    {
+        const int32 NumLanes = FMath::Min(4, Chunk.Num - Base);
+        const float *LaneR = SHR, *LaneG = SHG, *LaneB = SHB;
+        if (Chunk.bContiguous && NumLanes == 4)
         {
-            const FGaussianSplatData &S = Splats[Index];
-            OutX.SetAndAdvance(S.Scale.X);
-            OutY.SetAndAdvance(S.Scale.Y);
-            OutZ.SetAndAdvance(S.Scale.Z);
+            const int32 First = Chunk.Indices[Base];
+            LaneR = Data.SHZeroR.GetData() + First;
+            LaneG = Data.SHZeroG.GetData() + First;
+            LaneB = Data.SHZeroB.GetData() + First;
         }
         else
         {
-            OutX.SetAndAdvance(1.0f);
-            OutY.SetAndAdvance(1.0f);
-            OutZ.SetAndAdvance(1.0f);
+            // Tail lanes point at the sentinel so the 4-wide conversion always reads valid memory
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                const int32 Index = Lane < NumLanes ? Chunk.Indices[Base + Lane] : Data.Num();
+                SHR[Lane] = Data.SHZeroR.GetData()[Index];
+                SHG[Lane] = Data.SHZeroG.GetData()[Index];
+                SHB[Lane] = Data.SHZeroB.GetData()[Index];
+            }
+        }
+        FGaussianSplatCPUData::SHToColor4(LaneR, LaneG, LaneB, Tint, R, G, B);
+
+        for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+        {
+            const FLinearColor CloudTint =
+                bCloudTints ? Clouds.Tints[Clouds.FindCloud(Chunk.Indices[Base + Lane])] : FLinearColor::White;
+            OutR.SetAndAdvance(R[Lane] * CloudTint.R);
+            OutG.SetAndAdvance(G[Lane] * CloudTint.G);
+            OutB.SetAndAdvance(B[Lane] * CloudTint.B);
         }
     }
+    WriteOpacity(Data, View, Chunk, OutA);
+}
+} // namespace GaussianSplatVM
+
+void UGaussianSplatNiagaraDataInterface::GetSplatPosition(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> IndexParam(Context);
+    FNDIOutputParam<float> OutPosX(Context);
+    FNDIOutputParam<float> OutPosY(Context);
+    FNDIOutputParam<float> OutPosZ(Context);
+
+    GaussianSplatVM::FIndexChunk Chunk;
+    for (int32 Done = 0; Done < Context.GetNumInstances(); Done += Chunk.Num)
+    {
+        GaussianSplatVM::ReadIndexChunk(IndexParam, CPUData, Context.GetNumInstances() - Done, Chunk);
+        GaussianSplatVM::WritePlane(OutPosX, CPUData.PositionX, Chunk);
+        GaussianSplatVM::WritePlane(OutPosY, CPUData.PositionY, Chunk);
+        GaussianSplatVM::WritePlane(OutPosZ, CPUData.PositionZ, Chunk);
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetSplatScale(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> IndexParam(Context);
+    FNDIOutputParam<float> OutX(Context);
+    FNDIOutputParam<float> OutY(Context);
+    FNDIOutputParam<float> OutZ(Context);
+
+    GaussianSplatVM::FIndexChunk Chunk;
+    for (int32 Done = 0; Done < Context.GetNumInstances(); Done += Chunk.Num)
+    {
+        GaussianSplatVM::ReadIndexChunk(IndexParam, CPUData, Context.GetNumInstances() - Done, Chunk);
+        GaussianSplatVM::WritePlane(OutX, CPUData.ScaleX, Chunk);
+        GaussianSplatVM::WritePlane(OutY, CPUData.ScaleY, Chunk);
+        GaussianSplatVM::WritePlane(OutZ, CPUData.ScaleZ, Chunk);
+    }
 }
 
 void UGaussianSplatNiagaraDataInterface::GetSplatOrientation(FVectorVMExternalFunctionContext &Context) const
@@ -413,24 +1925,14 @@ void UGaussianSplatNiagaraDataInterface::GetSplatOrientation(FVectorVMExternalFu
     FNDIOutputParam<float> OutZ(Context);
     FNDIOutputParam<float> OutW(Context);
 
-    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    GaussianSplatVM::FIndexChunk Chunk;
+    for (int32 Done = 0; Done < Context.GetNumInstances(); Done += Chunk.Num)
     {
-        const int32 Index = IndexParam.GetAndAdvance();
-        if (Splats.IsValidIndex(Index))
-        {
-            const FGaussianSplatData &S = Splats[Index];
-            OutX.SetAndAdvance(S.Orientation.X);
-            OutY.SetAndAdvance(S.Orientation.Y);
-            OutZ.SetAndAdvance(S.Orientation.Z);
-            OutW.SetAndAdvance(S.Orientation.W);
-        }
-        else
-        {
-            OutX.SetAndAdvance(0.0f);
-            OutY.SetAndAdvance(0.0f);
-            OutZ.SetAndAdvance(0.0f);
-            OutW.SetAndAdvance(1.0f);
-        }
+        GaussianSplatVM::ReadIndexChunk(IndexParam, CPUData, Context.GetNumInstances() - Done, Chunk);
+        GaussianSplatVM::WritePlane(OutX, CPUData.OrientationX, Chunk);
+        GaussianSplatVM::WritePlane(OutY, CPUData.OrientationY, Chunk);
+        GaussianSplatVM::WritePlane(OutZ, CPUData.OrientationZ, Chunk);
+        GaussianSplatVM::WritePlane(OutW, CPUData.OrientationW, Chunk);
     }
 }
 
@@ -439,13 +1941,11 @@ void UGaussianSplatNiagaraDataInterface::GetSplatOpacity(FVectorVMExternalFuncti
     FNDIInputParam<int32> IndexParam(Context);
     FNDIOutputParam<float> OutOpacity(Context);
 
-    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    GaussianSplatVM::FIndexChunk Chunk;
+    for (int32 Done = 0; Done < Context.GetNumInstances(); Done += Chunk.Num)
     {
-        const int32 Index = IndexParam.GetAndAdvance();
-        if (Splats.IsValidIndex(Index))
-            OutOpacity.SetAndAdvance(Splats[Index].Opacity);
-        else
-            OutOpacity.SetAndAdvance(0.0f);
+        GaussianSplatVM::ReadIndexChunk(IndexParam, CPUData, Context.GetNumInstances() - Done, Chunk);
+        GaussianSplatVM::WriteOpacity(CPUData, CPUCullParams, Chunk, OutOpacity);
     }
 }
 
@@ -457,26 +1957,256 @@ void UGaussianSplatNiagaraDataInterface::GetSplatColor(FVectorVMExternalFunction
     FNDIOutputParam<float> OutB(Context);
     FNDIOutputParam<float> OutA(Context);
 
+    GaussianSplatVM::FIndexChunk Chunk;
+    for (int32 Done = 0; Done < Context.GetNumInstances(); Done += Chunk.Num)
+    {
+        GaussianSplatVM::ReadIndexChunk(IndexParam, CPUData, Context.GetNumInstances() - Done, Chunk);
+        GaussianSplatVM::WriteColors(CPUData, CloudTable, CPUCullParams, Chunk, GlobalTint, OutR, OutG, OutB,
+                                     OutA);
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetSplatAttributes(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> IndexParam(Context);
+    FNDIOutputParam<float> OutPosX(Context);
+    FNDIOutputParam<float> OutPosY(Context);
+    FNDIOutputParam<float> OutPosZ(Context);
+    FNDIOutputParam<float> OutScaleX(Context);
+    FNDIOutputParam<float> OutScaleY(Context);
+    FNDIOutputParam<float> OutScaleZ(Context);
+    FNDIOutputParam<float> OutRotX(Context);
+    FNDIOutputParam<float> OutRotY(Context);
+    FNDIOutputParam<float> OutRotZ(Context);
+    FNDIOutputParam<float> OutRotW(Context);
+    FNDIOutputParam<float> OutR(Context);
+    FNDIOutputParam<float> OutG(Context);
+    FNDIOutputParam<float> OutB(Context);
+    FNDIOutputParam<float> OutA(Context);
+
+    GaussianSplatVM::FIndexChunk Chunk;
+    for (int32 Done = 0; Done < Context.GetNumInstances(); Done += Chunk.Num)
+    {
+        GaussianSplatVM::ReadIndexChunk(IndexParam, CPUData, Context.GetNumInstances() - Done, Chunk);
+        GaussianSplatVM::WritePlane(OutPosX, CPUData.PositionX, Chunk);
+        GaussianSplatVM::WritePlane(OutPosY, CPUData.PositionY, Chunk);
+        GaussianSplatVM::WritePlane(OutPosZ, CPUData.PositionZ, Chunk);
+        GaussianSplatVM::WritePlane(OutScaleX, CPUData.ScaleX, Chunk);
+        GaussianSplatVM::WritePlane(OutScaleY, CPUData.ScaleY, Chunk);
+        GaussianSplatVM::WritePlane(OutScaleZ, CPUData.ScaleZ, Chunk);
+        GaussianSplatVM::WritePlane(OutRotX, CPUData.OrientationX, Chunk);
+        GaussianSplatVM::WritePlane(OutRotY, CPUData.OrientationY, Chunk);
+        GaussianSplatVM::WritePlane(OutRotZ, CPUData.OrientationZ, Chunk);
+        GaussianSplatVM::WritePlane(OutRotW, CPUData.OrientationW, Chunk);
+        GaussianSplatVM::WriteColors(CPUData, CloudTable, CPUCullParams, Chunk, GlobalTint, OutR, OutG, OutB,
+                                     OutA);
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetCloudCount(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIOutputParam<int32> OutCount(Context);
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+        OutCount.SetAndAdvance(CloudTable.Num());
+}
+
+void UGaussianSplatNiagaraDataInterface::GetSplatCloud(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> IndexParam(Context);
+    FNDIOutputParam<int32> OutCloud(Context);
+    FNDIOutputParam<int32> OutLocalIndex(Context);
+
     for (int32 i = 0; i < Context.GetNumInstances(); ++i)
     {
         const int32 Index = IndexParam.GetAndAdvance();
-        if (Splats.IsValidIndex(Index))
-        {
-            const FGaussianSplatData &S = Splats[Index];
-            FLinearColor Color = FGaussianSplatData::SHToColor(S.ZeroOrderHarmonicsCoefficients);
-            Color *= GlobalTint;
-            OutR.SetAndAdvance(Color.R);
-            OutG.SetAndAdvance(Color.G);
-            OutB.SetAndAdvance(Color.B);
-            OutA.SetAndAdvance(S.Opacity);
-        }
-        else
+        const int32 Cloud = CloudTable.FindCloud(Index);
+        OutCloud.SetAndAdvance(Cloud);
+        OutLocalIndex.SetAndAdvance(Index - CloudTable.GetFirst(Cloud));
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetCloudSplatRange(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> CloudParam(Context);
+    FNDIOutputParam<int32> OutStart(Context);
+    FNDIOutputParam<int32> OutCount(Context);
+
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    {
+        const int32 Cloud = CloudParam.GetAndAdvance();
+        OutStart.SetAndAdvance(CloudTable.GetFirst(Cloud));
+        OutCount.SetAndAdvance(CloudTable.GetCount(Cloud));
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetCloudInstanceCount(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIOutputParam<int32> OutCount(Context);
+    const int32 Count = PackedCloudInstances.Num() / 3;
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+        OutCount.SetAndAdvance(Count);
+}
+
+void UGaussianSplatNiagaraDataInterface::GetInstancedSplatIndex(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> ParticleParam(Context);
+    FNDIOutputParam<int32> OutInstance(Context);
+    FNDIOutputParam<int32> OutSplat(Context);
+
+    const int32 SplatsPerInstance = FMath::Max(CPUData.Num(), 1);
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    {
+        const int32 ParticleIndex = ParticleParam.GetAndAdvance();
+        OutInstance.SetAndAdvance(ParticleIndex / SplatsPerInstance);
+        OutSplat.SetAndAdvance(ParticleIndex % SplatsPerInstance);
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetInstancedSplatAttributes(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> InstanceParam(Context);
+    FNDIInputParam<int32> SplatParam(Context);
+    FNDIOutputParam<FVector3f> OutPosition(Context);
+    FNDIOutputParam<FVector3f> OutScale(Context);
+    FNDIOutputParam<FQuat4f> OutOrientation(Context);
+    FNDIOutputParam<FLinearColor> OutColor(Context);
+    FNDIOutputParam<FNiagaraBool> OutVisible(Context);
+
+    const int32 NumInstances = PackedCloudInstances.Num() / 3;
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    {
+        const int32 InstanceIndex = InstanceParam.GetAndAdvance();
+        const int32 SplatIndex = SplatParam.GetAndAdvance();
+
+        // With no instances every read is placed by the identity, matching GetSplatAttributes
+        FVector4f LocationScale(0.0f, 0.0f, 0.0f, 1.0f);
+        FQuat4f Rotation = FQuat4f::Identity;
+        FVector4f TintStride(1.0f, 1.0f, 1.0f, 1.0f);
+        const bool bValidInstance = NumInstances == 0 || (InstanceIndex >= 0 && InstanceIndex < NumInstances);
+        if (NumInstances > 0 && bValidInstance)
         {
-            OutR.SetAndAdvance(0.0f);
-            OutG.SetAndAdvance(0.0f);
-            OutB.SetAndAdvance(0.0f);
-            OutA.SetAndAdvance(0.0f);
+            const FVector4f *Packed = &PackedCloudInstances[InstanceIndex * 3];
+            LocationScale = Packed[0];
+            Rotation = FQuat4f(Packed[1].X, Packed[1].Y, Packed[1].Z, Packed[1].W);
+            TintStride = Packed[2];
         }
+        const int32 Stride = FMath::Max(int32(TintStride.W), 1);
+
+        const int32 Index = CPUData.ClampIndex(SplatIndex);
+        const FVector3f LocalPosition(CPUData.PositionX[Index], CPUData.PositionY[Index], CPUData.PositionZ[Index]);
+        const FVector3f Location(LocationScale.X, LocationScale.Y, LocationScale.Z);
+        OutPosition.SetAndAdvance(Location + Rotation.RotateVector(LocalPosition) * LocationScale.W);
+
+        // Kept splats grow so a decimated instance covers roughly the same screen area
+        const float ScaleFactor = LocationScale.W * FMath::Sqrt(float(Stride));
+        OutScale.SetAndAdvance(FVector3f(CPUData.ScaleX[Index], CPUData.ScaleY[Index], CPUData.ScaleZ[Index]) *
+                               ScaleFactor);
+
+        FQuat4f Orientation = Rotation * FQuat4f(CPUData.OrientationX[Index], CPUData.OrientationY[Index],
+                                                 CPUData.OrientationZ[Index], CPUData.OrientationW[Index]);
+        Orientation.Normalize();
+        OutOrientation.SetAndAdvance(Orientation);
+
+        const FLinearColor CloudTint = CloudTable.Num() > 1 ? CloudTable.Tints[CloudTable.FindCloud(Index)]
+                                                            : FLinearColor::White;
+        const FVector3f SHZero(CPUData.SHZeroR[Index], CPUData.SHZeroG[Index], CPUData.SHZeroB[Index]);
+        FLinearColor Color = FGaussianSplatData::SHToColor(SHZero);
+        Color *= GlobalTint * CloudTint * FLinearColor(TintStride.X, TintStride.Y, TintStride.Z, 1.0f);
+        Color.A = CPUData.Opacity[Index];
+        OutColor.SetAndAdvance(Color);
+
+        const bool bVisible =
+            bValidInstance && SplatIndex >= 0 && SplatIndex < CPUData.Num() && (SplatIndex % Stride) == 0;
+        OutVisible.SetAndAdvance(FNiagaraBool(bVisible));
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetVisibleSplatIndex(FVectorVMExternalFunctionContext &Context) const
+{
+    VectorVM::FUserPtrHandler<FGaussianSplatPerInstanceData> InstData(Context);
+    FNDIInputParam<int32> VisibleParam(Context);
+    FNDIOutputParam<int32> OutSplat(Context);
+    FNDIOutputParam<FNiagaraBool> OutVisible(Context);
+
+    // The instance's CPU list exists whenever a CPU emitter reads a culled NDI; otherwise every splat counts as visible
+    const TArray<int32> &VisibleSplats = InstData->VisibleSplats;
+    const bool bCulled = IsViewCulled() && InstData->VisibleSplatCount != INDEX_NONE &&
+                         VisibleSplats.Num() == InstData->VisibleSplatCount;
+    const int32 Count = bCulled ? InstData->VisibleSplatCount : CPUData.Num();
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    {
+        const int32 VisibleIndex = VisibleParam.GetAndAdvance();
+        const bool bVisible = VisibleIndex >= 0 && VisibleIndex < Count;
+        OutSplat.SetAndAdvance(bVisible ? (bCulled ? VisibleSplats[VisibleIndex] : VisibleIndex) : 0);
+        OutVisible.SetAndAdvance(FNiagaraBool(bVisible));
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetSplatScreenSize(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<int32> IndexParam(Context);
+    FNDIOutputParam<float> OutPixelRadius(Context);
+
+    alignas(16) float PixelRadius[GaussianSplatVM::ChunkSize];
+    GaussianSplatVM::FIndexChunk Chunk;
+    for (int32 Done = 0; Done < Context.GetNumInstances(); Done += Chunk.Num)
+    {
+        GaussianSplatVM::ReadIndexChunk(IndexParam, CPUData, Context.GetNumInstances() - Done, Chunk);
+        GaussianSplatVM::ComputePixelRadii(CPUData, CPUCullParams, Chunk, PixelRadius);
+        for (int32 i = 0; i < Chunk.Num; ++i)
+            OutPixelRadius.SetAndAdvance(PixelRadius[i]);
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetSplatsInRadius(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<FVector3f> CenterParam(Context);
+    FNDIInputParam<float> RadiusParam(Context);
+    FNDIInputParam<int32> MaxCountParam(Context);
+    FNDIOutputParam<int32> OutCount(Context);
+
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    {
+        const FVector3f Center = CenterParam.GetAndAdvance();
+        const float Radius = RadiusParam.GetAndAdvance();
+        OutCount.SetAndAdvance(SpatialGrid.CountInRadius(Center, Radius, MaxCountParam.GetAndAdvance()));
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetSplatInRadius(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<FVector3f> CenterParam(Context);
+    FNDIInputParam<float> RadiusParam(Context);
+    FNDIInputParam<int32> NthParam(Context);
+    FNDIOutputParam<int32> OutSplat(Context);
+    FNDIOutputParam<FNiagaraBool> OutValid(Context);
+
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    {
+        const FVector3f Center = CenterParam.GetAndAdvance();
+        const float Radius = RadiusParam.GetAndAdvance();
+        const int32 Splat = SpatialGrid.GetInRadius(Center, Radius, NthParam.GetAndAdvance());
+        OutSplat.SetAndAdvance(FMath::Max(Splat, 0));
+        OutValid.SetAndAdvance(FNiagaraBool(Splat != INDEX_NONE));
+    }
+}
+
+void UGaussianSplatNiagaraDataInterface::GetNearestSplat(FVectorVMExternalFunctionContext &Context) const
+{
+    FNDIInputParam<FVector3f> PositionParam(Context);
+    FNDIInputParam<float> MaxDistanceParam(Context);
+    FNDIOutputParam<int32> OutSplat(Context);
+    FNDIOutputParam<float> OutDistance(Context);
+    FNDIOutputParam<FNiagaraBool> OutValid(Context);
+
+    for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+    {
+        const FVector3f Position = PositionParam.GetAndAdvance();
+        float Distance = 0.0f;
+        const int32 Splat = SpatialGrid.FindNearest(Position, MaxDistanceParam.GetAndAdvance(), &Distance);
+        OutSplat.SetAndAdvance(FMath::Max(Splat, 0));
+        OutDistance.SetAndAdvance(Distance);
+        OutValid.SetAndAdvance(FNiagaraBool(Splat != INDEX_NONE));
     }
 }
 
@@ -498,38 +2228,124 @@ void UGaussianSplatNiagaraDataInterface::SetShaderParameters(
 
     FNDIGaussianSplatProxy &DIProxy = Context.GetProxy<FNDIGaussianSplatProxy>();
 
-    // Lazily create fallback buffer on render thread — guaranteed valid after this
-    if (!DIProxy.FallbackBuffer.IsValid())
-    {
-        FRHICommandListImmediate &RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
-        const uint32 BytesPerElement = sizeof(FVector4f);
-        FRHIResourceCreateInfo CreateInfo(TEXT("GSplat_Fallback"));
-        DIProxy.FallbackBuffer.Buffer =
-            RHICmdList.CreateVertexBuffer(BytesPerElement, BUF_ShaderResource | BUF_Dynamic, CreateInfo);
-        DIProxy.FallbackBuffer.SRV =
-            RHICmdList.CreateShaderResourceView(DIProxy.FallbackBuffer.Buffer, BytesPerElement, PF_A32B32G32R32F);
-        // Zero it out
-        void *Mapped = RHICmdList.LockBuffer(DIProxy.FallbackBuffer.Buffer, 0, BytesPerElement, RLM_WriteOnly);
-        if (Mapped)
-        {
-            FMemory::Memzero(Mapped, BytesPerElement);
-            RHICmdList.UnlockBuffer(DIProxy.FallbackBuffer.Buffer);
-        }
+    // Lazily create fallback buffers on render thread — guaranteed valid after this
+    DIProxy.EnsureFallbackBuffers(FRHICommandListExecutor::GetImmediateCommandList());
+
+    ShaderParameters->BaseOffset = 0;
+    ShaderParameters->UseIndirection = 0;
+    ShaderParameters->Indirection = DIProxy.FallbackIndirectionBuffer.SRV;
+    ShaderParameters->SplatRecords = DIProxy.FallbackRecordBuffer.SRV;
+    const bool bHasCloudTable = DIProxy.NumClouds > 0 && DIProxy.CloudOffsetsBuffer.IsValid();
+    ShaderParameters->NumClouds = bHasCloudTable ? DIProxy.NumClouds : 0;
+    ShaderParameters->CloudOffsets =
+        bHasCloudTable ? DIProxy.CloudOffsetsBuffer.SRV : DIProxy.FallbackIndirectionBuffer.SRV;
+    ShaderParameters->CloudTints = bHasCloudTable ? DIProxy.CloudTintsBuffer.SRV : DIProxy.FallbackCloudTintBuffer.SRV;
+    const bool bHasInstances = DIProxy.NumCloudInstances > 0 && DIProxy.CloudInstancesBuffer.IsValid();
+    ShaderParameters->NumCloudInstances = bHasInstances ? DIProxy.NumCloudInstances : 0;
+    ShaderParameters->CloudInstances = bHasInstances ? DIProxy.CloudInstancesBuffer.SRV : DIProxy.FallbackBuffer.SRV;
+    ShaderParameters->SequenceFrame = DIProxy.SequenceBuffers.FrameIndex;
+    ShaderParameters->CullEnabled = 0;
+    ShaderParameters->VisibleCount = DIProxy.FallbackIndirectionBuffer.SRV;
+    ShaderParameters->VisibleIndices = DIProxy.FallbackIndirectionBuffer.SRV;
+    ShaderParameters->ScreenDepthPlane = FVector4f(0.0f, 0.0f, 0.0f, 1.0f);
+    ShaderParameters->ScreenPixelScale = 0.0f;
+    ShaderParameters->SubPixelRadius = 0.0f;
+    const bool bHasGrid = DIProxy.SpatialGridDims.X > 0 && DIProxy.SpatialSplatsBuffer.IsValid();
+    ShaderParameters->GridOrigin = DIProxy.SpatialGridOrigin;
+    ShaderParameters->GridInvCellSize = DIProxy.SpatialGridInvCellSize;
+    ShaderParameters->GridDims = bHasGrid ? DIProxy.SpatialGridDims : FIntVector::ZeroValue;
+    ShaderParameters->GridCellStarts =
+        bHasGrid ? DIProxy.SpatialCellStartsBuffer.SRV : DIProxy.FallbackIndirectionBuffer.SRV;
+    ShaderParameters->GridSplats = bHasGrid ? DIProxy.SpatialSplatsBuffer.SRV : DIProxy.FallbackBuffer.SRV;
+    ShaderParameters->RestPositions = DIProxy.FallbackBuffer.SRV;
+    ShaderParameters->RestSHZero = DIProxy.FallbackBuffer.SRV;
+    ShaderParameters->LivePositions = DIProxy.FallbackBuffer.SRV;
+    ShaderParameters->LiveSHZero = DIProxy.FallbackBuffer.SRV;
+    ShaderParameters->LivePositionsOut = DIProxy.FallbackUAVBuffer.UAV;
+    ShaderParameters->LiveSHZeroOut = DIProxy.FallbackUAVBuffer.UAV;
+
+    // Streaming NDIs read through the shared pool; the indirection packs resident tiles into a dense range
+    const FGaussianSplatStreamingPool_RT &Pool = DIProxy.StreamingPool;
+    if (Pool.IsValid())
+    {
+        ShaderParameters->SplatsCount = Pool.ResidentSplats;
+        const FGaussianSplatInstanceData_RT *StreamingInstance =
+            DIProxy.SystemInstancesToData_RT.Find(Context.GetSystemInstanceID());
+        ShaderParameters->GlobalTint = StreamingInstance ? StreamingInstance->GlobalTint : FVector3f::OneVector;
+        ShaderParameters->Positions = Pool.PositionsBuffer.SRV;
+        ShaderParameters->Scales = Pool.ScalesBuffer.SRV;
+        ShaderParameters->Orientations = Pool.OrientationsBuffer.SRV;
+        ShaderParameters->SHZeroCoeffsAndOpacity = Pool.SHZeroCoeffsAndOpacityBuffer.SRV;
+        ShaderParameters->UseIndirection = 1;
+        ShaderParameters->Indirection = Pool.IndirectionBuffer.SRV;
+        return;
+    }
+
+    // Sequences read whichever set was flipped to the front last
+    const FGaussianSplatSequenceBuffers_RT &Sequence = DIProxy.SequenceBuffers;
+    if (Sequence.IsValid())
+    {
+        const FGaussianSplatSequenceBuffers_RT::FSet &Front = Sequence.GetFront();
+        const FGaussianSplatInstanceData_RT *SequenceInstance =
+            DIProxy.SystemInstancesToData_RT.Find(Context.GetSystemInstanceID());
+        ShaderParameters->SplatsCount = Front.SplatCount;
+        ShaderParameters->GlobalTint = SequenceInstance ? SequenceInstance->GlobalTint : FVector3f::OneVector;
+        ShaderParameters->Positions = Front.PositionsBuffer.SRV;
+        ShaderParameters->Scales = Front.ScalesBuffer.SRV;
+        ShaderParameters->Orientations = Front.OrientationsBuffer.SRV;
+        ShaderParameters->SHZeroCoeffsAndOpacity = Front.SHZeroCoeffsAndOpacityBuffer.SRV;
+        return;
     }
 
     const FNiagaraSystemInstanceID InstanceID = Context.GetSystemInstanceID();
     FGaussianSplatInstanceData_RT *InstanceData = DIProxy.SystemInstancesToData_RT.Find(InstanceID);
 
-    const bool bReady = InstanceData && InstanceData->AreBuffersValid() && InstanceData->SplatsCount > 0;
+    const EGaussianSplatBufferLayout Layout =
+        InstanceData ? InstanceData->Layout : EGaussianSplatBufferLayout::SeparateStreams;
+    const FGaussianSplatBufferArena &Arena = DIProxy.GetArena(Layout);
+    const bool bReady = InstanceData && InstanceData->HasAllocation() && InstanceData->SplatsCount > 0 &&
+                        Arena.IsValidHandle(InstanceData->Allocation) && Arena.IsValid();
+    const bool bInterleaved = Layout == EGaussianSplatBufferLayout::Interleaved;
 
-    // ALWAYS bind valid SRVs
-    ShaderParameters->SplatsCount = bReady ? InstanceData->SplatsCount : 0;
+    // ALWAYS bind valid SRVs. The arena offset is resolved every frame since defragmentation can move ranges.
+    // Counts only the slices uploaded so far, so a cloud under gsplat.Upload.FrameBudgetMB fills in over a few frames
+    ShaderParameters->SplatsCount = bReady ? InstanceData->GetResidentCount() : 0;
     ShaderParameters->GlobalTint = bReady ? InstanceData->GlobalTint : FVector3f::OneVector;
-    ShaderParameters->Positions = bReady ? InstanceData->PositionsBuffer.SRV : DIProxy.FallbackBuffer.SRV;
-    ShaderParameters->Scales = bReady ? InstanceData->ScalesBuffer.SRV : DIProxy.FallbackBuffer.SRV;
-    ShaderParameters->Orientations = bReady ? InstanceData->OrientationsBuffer.SRV : DIProxy.FallbackBuffer.SRV;
-    ShaderParameters->SHZeroCoeffsAndOpacity =
-        bReady ? InstanceData->SHZeroCoeffsAndOpacityBuffer.SRV : DIProxy.FallbackBuffer.SRV;
+    ShaderParameters->BaseOffset = bReady ? int32(Arena.GetRange(InstanceData->Allocation).Offset) : 0;
+    if (bReady && bInterleaved)
+        ShaderParameters->SplatRecords = Arena.GetRecordsSRV();
+    auto StreamSRV = [&](FGaussianSplatBufferArena::EStream Stream) -> FRHIShaderResourceView *
+    { return bReady && !bInterleaved ? Arena.GetSRV(Stream) : DIProxy.FallbackBuffer.SRV.GetReference(); };
+    ShaderParameters->Positions = StreamSRV(FGaussianSplatBufferArena::Stream_Positions);
+    ShaderParameters->Scales = StreamSRV(FGaussianSplatBufferArena::Stream_Scales);
+    ShaderParameters->Orientations = StreamSRV(FGaussianSplatBufferArena::Stream_Orientations);
+    ShaderParameters->SHZeroCoeffsAndOpacity = StreamSRV(FGaussianSplatBufferArena::Stream_SHZeroCoeffsAndOpacity);
+
+    if (bReady)
+    {
+        ShaderParameters->ScreenDepthPlane = InstanceData->Cull.DepthPlane;
+        ShaderParameters->ScreenPixelScale = InstanceData->Cull.PixelScale;
+    }
+    // Only this frame's list is trusted; until PreStage has culled, every splat stays visible
+    if (bReady && InstanceData->HasCullResult())
+    {
+        ShaderParameters->CullEnabled = 1;
+        ShaderParameters->VisibleCount = InstanceData->VisibleCountBuffer.SRV;
+        ShaderParameters->VisibleIndices = InstanceData->VisibleIndicesBuffer.SRV;
+        ShaderParameters->SubPixelRadius = InstanceData->Cull.GetSubPixelRadius();
+    }
+    // PreStage has already flipped this frame, so Front holds last frame's writes
+    if (bReady && InstanceData->Deform.IsValid())
+    {
+        const FGaussianSplatDeformBuffers_RT &Deform = InstanceData->Deform;
+        const int32 Back = Deform.Front ^ 1;
+        ShaderParameters->RestPositions = Deform.RestPositions.SRV;
+        ShaderParameters->RestSHZero = Deform.RestSHZero.SRV;
+        ShaderParameters->LivePositions = Deform.LivePositions[Deform.Front].SRV;
+        ShaderParameters->LiveSHZero = Deform.LiveSHZero[Deform.Front].SRV;
+        ShaderParameters->LivePositionsOut = Deform.LivePositions[Back].UAV;
+        ShaderParameters->LiveSHZeroOut = Deform.LiveSHZero[Back].UAV;
+    }
 }
 
 void UGaussianSplatNiagaraDataInterface::DestroyPerInstanceData(void *PerInstanceData,
@@ -538,66 +2354,295 @@ void UGaussianSplatNiagaraDataInterface::DestroyPerInstanceData(void *PerInstanc
     FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
     const FNiagaraSystemInstanceID InstanceID = SystemInstance->GetId();
 
-    UE_LOG(LogGaussianSplat, Log, TEXT("[DestroyPerInstanceData] %s | Removing RT instance data"), *GetName());
+    UE_LOG(LogGaussianSplat, Verbose, TEXT("[DestroyPerInstanceData] %s | Removing RT instance data"), *GetName());
+    static_cast<FGaussianSplatPerInstanceData *>(PerInstanceData)->~FGaussianSplatPerInstanceData();
 
     ENQUEUE_RENDER_COMMAND(DestroyGaussianSplatInstance)(
         [RT_Proxy, InstanceID](FRHICommandListImmediate &RHICmdList)
         {
             FGaussianSplatInstanceData_RT *Data = RT_Proxy->SystemInstancesToData_RT.Find(InstanceID);
             if (Data)
-                Data->ReleaseBuffers();
+                RT_Proxy->ReleaseInstanceData(RHICmdList, *Data);
             RT_Proxy->SystemInstancesToData_RT.Remove(InstanceID);
-            UE_LOG(LogTemp, Log, TEXT("[DestroyPerInstanceData RT] Instance removed"));
+            RT_Proxy->ForgetVisibleCount(InstanceID);
+            UE_LOG(LogTemp, Verbose, TEXT("[DestroyPerInstanceData RT] Instance removed"));
         });
 }
 
+bool UGaussianSplatNiagaraDataInterface::PerInstanceTick(void *PerInstanceData,
+                                                         FNiagaraSystemInstance *SystemInstance, float DeltaSeconds)
+{
+    UpdateBudgetViewDistance(SystemInstance);
+    if (IsStreaming())
+    {
+        TickStreaming(SystemInstance);
+        return false;
+    }
+    if (IsSequence())
+    {
+        TickSequence(DeltaSeconds);
+        return false;
+    }
+
+    // Splats replaced wholesale (reload, clear, ...) need fresh buffers; returning true re-inits the instance
+    FGaussianSplatPerInstanceData *InstData = static_cast<FGaussianSplatPerInstanceData *>(PerInstanceData);
+    if (InstData->UploadedRevision != RenderDataRevision)
+        return true;
+
+    FlushSplatUpdates();
+    TickUploads();
+    TickInstancing(SystemInstance);
+    UpdateViewCulling(InstData, SystemInstance);
+    TickRasterizer(SystemInstance);
+    PublishSplatCount(InstData, SystemInstance);
+    return false;
+}
+
+void UGaussianSplatNiagaraDataInterface::ProvidePerInstanceDataForRenderThread(
+    void *DataForRenderThread, void *PerInstanceData, const FNiagaraSystemInstanceID &SystemInstance)
+{
+    const FGaussianSplatPerInstanceData *InstData = static_cast<const FGaussianSplatPerInstanceData *>(PerInstanceData);
+    new (DataForRenderThread) FGaussianSplatCullParams(InstData->CullParams);
+}
+
 bool UGaussianSplatNiagaraDataInterface::InitPerInstanceData(void *PerInstanceData,
                                                              FNiagaraSystemInstance *SystemInstance)
 {
-    if (Splats.Num() == 0 && !PlyFilePath.FilePath.IsEmpty())
+    GSPLAT_SCOPE(InitPerInstance);
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    FGaussianSplatPerInstanceData *InstData = new (PerInstanceData) FGaussianSplatPerInstanceData();
+    if (UGaussianSplatBudgetSubsystem *Budget = UGaussianSplatBudgetSubsystem::Get())
+        Budget->Register(this);
+
+    if (IsStreaming())
+    {
+        if (!StreamingManager && !OpenStreaming())
+            return false;
+
+        // Per-instance buffers stay as fallbacks; reads go through the shared streaming pool
+        FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+        const FNiagaraSystemInstanceID InstanceID = SystemInstance->GetId();
+        const FVector3f Tint(GlobalTint.R, GlobalTint.G, GlobalTint.B);
+        ENQUEUE_RENDER_COMMAND(InitGaussianSplatStreamingInstance)(
+            [RT_Proxy, InstanceID, Tint](FRHICommandListImmediate &RHICmdList)
+            {
+                FGaussianSplatInstanceData_RT &InstanceData = RT_Proxy->SystemInstancesToData_RT.Add(InstanceID);
+                InstanceData.GlobalTint = Tint;
+            });
+        // No flush: until the pool and instance exist on the render thread, SetShaderParameters binds the fallbacks
+
+        // Spawn enough particles to cover a full pool; GetSplatCount reports how many are resident
+        FNiagaraVariable SplatCountVar(FNiagaraTypeDefinition::GetIntDef(), TEXT("User.SplatCount"));
+        SystemInstance->GetOverrideParameters()->SetParameterValue<int32>(
+            int32(StreamingManager->GetPoolElementCount()), SplatCountVar, true);
+        return true;
+    }
+
+    if (IsSequence())
+    {
+        if (!SequencePlayer && !OpenSequence())
+            return false;
+
+        // Reads go through the proxy's double-buffered sequence sets; the instance only carries its tint
+        FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+        const FNiagaraSystemInstanceID InstanceID = SystemInstance->GetId();
+        const FVector3f Tint(GlobalTint.R, GlobalTint.G, GlobalTint.B);
+        ENQUEUE_RENDER_COMMAND(InitGaussianSplatSequenceInstance)(
+            [RT_Proxy, InstanceID, Tint](FRHICommandListImmediate &RHICmdList)
+            {
+                FGaussianSplatInstanceData_RT &InstanceData = RT_Proxy->SystemInstancesToData_RT.FindOrAdd(InstanceID);
+                InstanceData.GlobalTint = Tint;
+            });
+        // No flush, as with streaming: the sequence sets bind once the render thread has created them
+
+        // Spawn enough particles for the largest frame; GetSplatCount reports the current one
+        FNiagaraVariable SplatCountVar(FNiagaraTypeDefinition::GetIntDef(), TEXT("User.SplatCount"));
+        SystemInstance->GetOverrideParameters()->SetParameterValue<int32>(SequencePlayer->GetHeader().MaxSplats,
+                                                                          SplatCountVar, true);
+        return true;
+    }
+
+    // Unknown usage (e.g. before the first compile) builds both copies
+    const bool bNeedsCPUData = IsUsedWithCPUScript() || !IsUsedWithGPUScript();
+    const bool bNeedsGPUData = IsUsedWithGPUScript() || !IsUsedWithCPUScript();
+
+    // Without the CPU copy, a live instance's upload of this revision is shared; the source is reloaded when there
+    // is none or a CPU emitter now needs the splats
+    if (bCPUSplatsTrimmed && !bNeedsCPUData && ShareResidentUpload(SystemInstance))
+    {
+        InstData->UploadedRevision = RenderDataRevision;
+        TickInstancing(SystemInstance);
+        PublishSplatCount(InstData, SystemInstance);
+        return true;
+    }
+    if ((Splats.Num() == 0 || bCPUSplatsTrimmed) && HasSource())
+    {
+        UE_LOG(LogGaussianSplat, Verbose,
+               TEXT("[InitPerInstanceData] %s | Splats empty or trimmed, loading from '%s' | Clouds=%d"), *GetName(),
+               *PlyFilePath.FilePath, Clouds.Num());
+        LoadSource();
+    }
+
+    // Edits made before this upload are already in the copy below
+    FlushSplatUpdates();
+    InstData->UploadedRevision = RenderDataRevision;
+
+    if (bNeedsCPUData && CPUDataRevision != RenderDataRevision)
+    {
+        CPUData.Build(Splats);
+        CPUDataRevision = RenderDataRevision;
+        SetAccountedMemory(GetCPUMemoryBytes(), GetLoadedSplatCount());
+    }
+    // Both targets query the game thread copy's layout, so it is built whatever the usage
+    if (bBuildSpatialGrid && (SpatialGridRevision != RenderDataRevision || SpatialGrid.Num() != Splats.Num()))
+    {
+        SpatialGrid.Build(Splats, SpatialGridSplatsPerCell);
+        SpatialGridRevision = RenderDataRevision;
+        SetAccountedMemory(GetCPUMemoryBytes(), GetLoadedSplatCount());
+        UE_LOG(LogGaussianSplat, Verbose, TEXT("[InitPerInstanceData] %s | Spatial grid %dx%dx%d, cell %.2f cm"),
+               *GetName(), SpatialGrid.Dims.X, SpatialGrid.Dims.Y, SpatialGrid.Dims.Z, SpatialGrid.CellSize);
+    }
+    else if (!bBuildSpatialGrid && !SpatialGrid.IsEmpty())
+    {
+        SpatialGrid.Reset();
+        SetAccountedMemory(GetCPUMemoryBytes(), GetLoadedSplatCount());
+    }
+
+    // The instance buffer is independent of the splats, so it is packed before the cloud upload is flushed below
+    TickInstancing(SystemInstance);
+    if (!bNeedsGPUData)
     {
-        UE_LOG(LogGaussianSplat, Warning, TEXT("[InitPerInstanceData] %s | Splats empty, loading from '%s'"),
-               *GetName(), *PlyFilePath.FilePath);
-        LoadFromPLYFile(PlyFilePath.FilePath);
+        PublishSplatCount(InstData, SystemInstance);
+        return true;
     }
 
     FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
     const FNiagaraSystemInstanceID InstanceID = SystemInstance->GetId();
     const FVector3f Tint(GlobalTint.R, GlobalTint.G, GlobalTint.B);
-    TArray<FGaussianSplatData> SplatsCopy = Splats; // safe GT-side copy
-
-    UE_LOG(LogGaussianSplat, Warning, TEXT("[InitPerInstanceData] %s | NumSplats=%d — enqueuing GPU init"), *GetName(),
-           SplatsCopy.Num());
+    const EGaussianSplatBufferLayout Layout = GetEffectiveBufferLayout();
+    const bool bWritable = IsWritable();
+    const uint32 Revision = RenderDataRevision;
+    // Packed here rather than copied: a record is what every layout uploads from, and unlike FGaussianSplatData it
+    // does not drag the SH arrays along
+    TArray<FGaussianSplatPackedRecord> Records;
+    FGaussianSplatPacking::PackRecords(Splats, Records);
+
+    TArray<uint32> CloudOffsets;
+    TArray<FVector4f> CloudTints;
+    for (int32 Offset : CloudTable.Offsets)
+        CloudOffsets.Add(uint32(Offset));
+    for (const FLinearColor &CloudTint : CloudTable.Tints)
+        CloudTints.Add(FVector4f(CloudTint.R, CloudTint.G, CloudTint.B, CloudTint.A));
+    TArray<uint32> GridCellStarts;
+    TArray<FVector4f> GridSplats;
+    if (bBuildSpatialGrid)
+    {
+        GridCellStarts = SpatialGrid.CellStarts;
+        SpatialGrid.PackSplats(GridSplats);
+    }
+    const FVector3f GridOrigin = SpatialGrid.Origin;
+    const float GridInvCellSize = SpatialGrid.InvCellSize;
+    const FIntVector GridDims = SpatialGrid.Dims;
+
+    LastInitUploadBytes = Records.GetAllocatedSize() + CloudOffsets.GetAllocatedSize() +
+                          CloudTints.GetAllocatedSize() + GridCellStarts.GetAllocatedSize() +
+                          GridSplats.GetAllocatedSize();
+    RT_Proxy->AddPendingUploadBytes(LastInitUploadBytes);
+    UE_LOG(LogGaussianSplat, Verbose,
+           TEXT("[InitPerInstanceData] %s | NumSplats=%d | %.1f MB staged — enqueuing GPU init"), *GetName(),
+           Records.Num(), double(LastInitUploadBytes) / (1024.0 * 1024.0));
 
     ENQUEUE_RENDER_COMMAND(InitGaussianSplatInstance)(
-        [RT_Proxy, SplatsCopy = MoveTemp(SplatsCopy), InstanceID, Tint](FRHICommandListImmediate &RHICmdList)
+        [RT_Proxy, Records = MoveTemp(Records), InstanceID, Tint, Layout, bWritable, Revision,
+         CloudOffsets = MoveTemp(CloudOffsets), CloudTints = MoveTemp(CloudTints),
+         GridCellStarts = MoveTemp(GridCellStarts), GridSplats = MoveTemp(GridSplats), GridOrigin, GridInvCellSize,
+         GridDims, UploadBytes = LastInitUploadBytes](FRHICommandListImmediate &RHICmdList) mutable
         {
-            UE_LOG(LogTemp, Warning, TEXT("[InitPerInstanceData RT] NumSplats=%d"), SplatsCopy.Num());
+            UE_LOG(LogTemp, Verbose, TEXT("[InitPerInstanceData RT] NumSplats=%d"), Records.Num());
 
-            FGaussianSplatInstanceData_RT &InstanceData = RT_Proxy->SystemInstancesToData_RT.Add(InstanceID);
+            // FindOrAdd so a re-init of the same instance frees its previous arena range
+            FGaussianSplatInstanceData_RT &InstanceData = RT_Proxy->SystemInstancesToData_RT.FindOrAdd(InstanceID);
             InstanceData.GlobalTint = Tint;
-
-            if (SplatsCopy.Num() > 0)
-                RT_Proxy->InitializeAndUpload(RHICmdList, InstanceData, SplatsCopy);
-            else
-                RT_Proxy->CreateFallbackBuffers(RHICmdList, InstanceData);
+            RT_Proxy->InitializeAndUpload(RHICmdList, InstanceData, MoveTemp(Records), Layout, bWritable);
+            InstanceData.Revision = Revision;
+            // Every instance shares the NDI's splats, so the last upload is as good as any
+            RT_Proxy->UploadCloudTable(RHICmdList, CloudOffsets, CloudTints);
+            RT_Proxy->UploadSpatialGrid(RHICmdList, GridCellStarts, GridSplats, GridOrigin, GridInvCellSize, GridDims);
+            RT_Proxy->AddPendingUploadBytes(-UploadBytes);
         });
 
     // CRITICAL: block game thread until render command has fully executed.
-    // Guarantees that SystemInstancesToData_RT has a valid entry with non-null
-    // SRVs before SetShaderParameters can ever be called for this instance.
+    // Guarantees that SystemInstancesToData_RT has a valid entry with an arena
+    // range before SetShaderParameters can ever be called for this instance.
     FlushRenderingCommands();
 
-    UE_LOG(LogGaussianSplat, Warning, TEXT("[InitPerInstanceData] %s | Flush complete — buffers guaranteed valid"),
+    UE_LOG(LogGaussianSplat, Verbose, TEXT("[InitPerInstanceData] %s | Flush complete — buffers guaranteed valid"),
            *GetName());
-    // set splat count user parameter
-    FNiagaraVariable SplatCountVar(FNiagaraTypeDefinition::GetIntDef(), TEXT("User.SplatCount"));
-
-    SystemInstance->GetOverrideParameters()->SetParameterValue<int32>(Splats.Num(), SplatCountVar, true);
+    PublishSplatCount(InstData, SystemInstance);
+    if (!bNeedsCPUData)
+        ApplyCPUResidency();
 
     return true;
 }
 
+bool UGaussianSplatNiagaraDataInterface::ShareResidentUpload(FNiagaraSystemInstance *SystemInstance)
+{
+    FNDIGaussianSplatProxy *RT_Proxy = GetProxyAs<FNDIGaussianSplatProxy>();
+    const FNiagaraSystemInstanceID InstanceID = SystemInstance->GetId();
+    const FVector3f Tint(GlobalTint.R, GlobalTint.G, GlobalTint.B);
+    const EGaussianSplatBufferLayout Layout = GetEffectiveBufferLayout();
+    const bool bWritable = IsWritable();
+    const uint32 Revision = RenderDataRevision;
+
+    // Read back after the flush below, like the full init's buffers
+    bool bShared = false;
+    ENQUEUE_RENDER_COMMAND(ShareGaussianSplatUpload)(
+        [RT_Proxy, InstanceID, Tint, Layout, bWritable, Revision, &bShared](FRHICommandListImmediate &RHICmdList)
+        {
+            FGaussianSplatInstanceData_RT &InstanceData = RT_Proxy->SystemInstancesToData_RT.FindOrAdd(InstanceID);
+            InstanceData.GlobalTint = Tint;
+            bShared = RT_Proxy->ShareUpload(RHICmdList, InstanceData, Revision, Layout, bWritable);
+        });
+    FlushRenderingCommands();
+
+    UE_LOG(LogGaussianSplat, Verbose, TEXT("[ShareResidentUpload] %s | Revision=%u | Shared=%d"), *GetName(), Revision,
+           bShared);
+    return bShared;
+}
+
+void UGaussianSplatNiagaraDataInterface::ApplyCPUResidency()
+{
+    // Without a source nothing could bring the splats back
+    if (CPUResidency == EGaussianSplatCPUResidency::KeepAll || bCPUSplatsTrimmed || !HasSource() ||
+        Splats.Num() == 0)
+        return;
+
+    // The cloud table follows the kept splats so CPU lookups stay in range; the GPU copy of the table was uploaded
+    // with the full cloud and is only replaced by the reload that also restores Splats
+    CurrentSplatCount = Splats.Num();
+    const bool bReleaseAll = CPUResidency == EGaussianSplatCPUResidency::ReleaseAfterUpload;
+    const int32 Stride = 1 << FMath::Clamp(CPUProxyLevel, 1, 8);
+    TArray<FGaussianSplatData> Kept;
+    if (!bReleaseAll)
+        Kept.Reserve(Splats.Num() / Stride + CloudTable.Num());
+    FGaussianSplatCloudTable NewTable;
+    for (int32 Cloud = 0; Cloud < CloudTable.Num(); ++Cloud)
+    {
+        const int32 First = CloudTable.GetFirst(Cloud);
+        const int32 NumKept = bReleaseAll ? 0 : (CloudTable.GetCount(Cloud) + Stride - 1) / Stride;
+        for (int32 i = 0; i < NumKept; ++i)
+            Kept.Add(MoveTemp(Splats[First + i * Stride]));
+        NewTable.Add(NumKept, CloudTable.Tints[Cloud]);
+    }
+    Splats = MoveTemp(Kept);
+    CloudTable = MoveTemp(NewTable);
+    bCPUSplatsTrimmed = true;
+    SetAccountedMemory(GetCPUMemoryBytes(), GetLoadedSplatCount());
+
+    UE_LOG(LogGaussianSplat, Verbose, TEXT("[ApplyCPUResidency] %s | Policy=%d | %d of %d splats kept on the CPU"),
+           *GetName(), int32(CPUResidency), Splats.Num(), CurrentSplatCount);
+}
+
 // HLSL Code Generation
 
 void UGaussianSplatNiagaraDataInterface::GetParameterDefinitionHLSL(const FNiagaraDataInterfaceGPUParamInfo &ParamInfo,
@@ -611,6 +2656,99 @@ void UGaussianSplatNiagaraDataInterface::GetParameterDefinitionHLSL(const FNiaga
     OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *ScalesBufferName);
     OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *OrientationsBufferName);
     OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *SHZeroCoeffsBufferName);
+    OutHLSL.Appendf(TEXT("ByteAddressBuffer %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *SplatRecordsBufferName);
+    OutHLSL.Appendf(TEXT("int %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *BaseOffsetParamName);
+    OutHLSL.Appendf(TEXT("int %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *UseIndirectionParamName);
+    OutHLSL.Appendf(TEXT("Buffer<uint> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *IndirectionBufferName);
+
+    OutHLSL.Appendf(TEXT("int %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *NumCloudsParamName);
+    OutHLSL.Appendf(TEXT("Buffer<uint> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *CloudOffsetsBufferName);
+    OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *CloudTintsBufferName);
+    OutHLSL.Appendf(TEXT("int %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *NumCloudInstancesParamName);
+    OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *CloudInstancesBufferName);
+    OutHLSL.Appendf(TEXT("int %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *SequenceFrameParamName);
+    OutHLSL.Appendf(TEXT("int %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *CullEnabledParamName);
+    OutHLSL.Appendf(TEXT("Buffer<uint> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *VisibleCountBufferName);
+    OutHLSL.Appendf(TEXT("Buffer<uint> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *VisibleIndicesBufferName);
+    OutHLSL.Appendf(TEXT("float4 %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *ScreenDepthPlaneParamName);
+    OutHLSL.Appendf(TEXT("float %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *ScreenPixelScaleParamName);
+    OutHLSL.Appendf(TEXT("float %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *SubPixelRadiusParamName);
+    OutHLSL.Appendf(TEXT("float3 %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *GridOriginParamName);
+    OutHLSL.Appendf(TEXT("float %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *GridInvCellSizeParamName);
+    OutHLSL.Appendf(TEXT("int3 %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *GridDimsParamName);
+    OutHLSL.Appendf(TEXT("Buffer<uint> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *GridCellStartsBufferName);
+    OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *GridSplatsBufferName);
+    OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *RestPositionsBufferName);
+    OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *RestSHZeroBufferName);
+    OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *LivePositionsBufferName);
+    OutHLSL.Appendf(TEXT("Buffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *LiveSHZeroBufferName);
+    OutHLSL.Appendf(TEXT("RWBuffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol,
+                    *LivePositionsOutBufferName);
+    OutHLSL.Appendf(TEXT("RWBuffer<float4> %s%s;\n"), *ParamInfo.DataInterfaceHLSLSymbol, *LiveSHZeroOutBufferName);
+
+    const TCHAR *Symbol = *ParamInfo.DataInterfaceHLSLSymbol;
+    OutHLSL.Appendf(TEXT("int %s%s(int Index) { return %s%s + (%s%s != 0 ? (int)%s%s[Index] : Index); }\n"), Symbol,
+                    *ResolveIndexFunctionName, Symbol, *BaseOffsetParamName, Symbol, *UseIndirectionParamName, Symbol,
+                    *IndirectionBufferName);
+
+    // Last cloud whose first splat is <= Index. With zero or one cloud the loop never runs.
+    static const TCHAR *FindCloudHLSL = TEXT(R"(
+		int {Symbol}{FindCloud}(int Index)
+		{
+			int Lo = 0;
+			int Hi = max({Symbol}{NumClouds} - 1, 0);
+			while (Lo < Hi)
+			{
+				int Mid = (Lo + Hi + 1) >> 1;
+				if ((int){Symbol}{CloudOffsets}[Mid] <= Index)
+					Lo = Mid;
+				else
+					Hi = Mid - 1;
+			}
+			return Lo;
+		}
+
+		// FGaussianSplatCulling::GetPixelRadius; W of the position is the bounding radius
+		float {Symbol}{PixelRadius}(float4 PositionAndRadius)
+		{
+			float Depth = dot({Symbol}{DepthPlane}.xyz, PositionAndRadius.xyz) + {Symbol}{DepthPlane}.w;
+			return Depth > 0.0 ? PositionAndRadius.w * {Symbol}{PixelScale} / Depth : 0.0;
+		}
+
+		// FGaussianSplatCulling::CompensateOpacity for the splats the cull pass kept
+		float {Symbol}{CompensateOpacity}(float Opacity, float4 PositionAndRadius)
+		{
+			if ({Symbol}{SubPixelRadius} <= 0.0)
+				return Opacity;
+			float Keep = min(Square({Symbol}{PixelRadius}(PositionAndRadius) / {Symbol}{SubPixelRadius}), 1.0);
+			if (Keep >= 1.0)
+				return Opacity;
+			return 1.0 - pow(saturate(1.0 - Opacity), 1.0 / max(Keep, 1.0e-4));
+		}
+
+		// FGaussianSplatSpatialGrid::GetCell: positions outside the grid land one cell past its edge
+		int3 {Symbol}{GridCell}(float3 Position)
+		{
+			float3 Local = (Position - {Symbol}{GridOrigin}) * {Symbol}{GridInvCellSize};
+			return (int3)floor(clamp(Local, -1.0, float3({Symbol}{GridDims})));
+		}
+	)");
+    const TMap<FString, FStringFormatArg> Args = {
+        {TEXT("Symbol"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol)},
+        {TEXT("FindCloud"), FStringFormatArg(FindCloudFunctionName)},
+        {TEXT("NumClouds"), FStringFormatArg(NumCloudsParamName)},
+        {TEXT("CloudOffsets"), FStringFormatArg(CloudOffsetsBufferName)},
+        {TEXT("PixelRadius"), FStringFormatArg(PixelRadiusFunctionName)},
+        {TEXT("CompensateOpacity"), FStringFormatArg(CompensateOpacityFunctionName)},
+        {TEXT("DepthPlane"), FStringFormatArg(ScreenDepthPlaneParamName)},
+        {TEXT("PixelScale"), FStringFormatArg(ScreenPixelScaleParamName)},
+        {TEXT("SubPixelRadius"), FStringFormatArg(SubPixelRadiusParamName)},
+        {TEXT("GridCell"), FStringFormatArg(GridCellFunctionName)},
+        {TEXT("GridOrigin"), FStringFormatArg(GridOriginParamName)},
+        {TEXT("GridInvCellSize"), FStringFormatArg(GridInvCellSizeParamName)},
+        {TEXT("GridDims"), FStringFormatArg(GridDimsParamName)},
+    };
+    OutHLSL += FString::Format(FindCloudHLSL, Args);
 }
 
 bool UGaussianSplatNiagaraDataInterface::GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo &ParamInfo,
@@ -626,29 +2764,55 @@ bool UGaussianSplatNiagaraDataInterface::GetFunctionHLSL(const FNiagaraDataInter
         static const TCHAR *FormatHLSL = TEXT(R"(
 			void {FunctionName}(out int OutCount)
 			{
-				OutCount = {SplatsCount};
+				OutCount = {CullEnabled} != 0 ? (int){VisibleCount}[0] : {SplatsCount} * max({NumInstances}, 1);
 			}
 		)");
         const TMap<FString, FStringFormatArg> Args = {
             {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
             {TEXT("SplatsCount"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + SplatsCountParamName)},
+            {TEXT("NumInstances"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + NumCloudInstancesParamName)},
+            {TEXT("CullEnabled"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + CullEnabledParamName)},
+            {TEXT("VisibleCount"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + VisibleCountBufferName)},
         };
         OutHLSL += FString::Format(FormatHLSL, Args);
         return true;
     }
 
+    // Expression reading one field of splat Index. Separate streams fetch a whole float4 and swizzle; interleaved
+    // records load only the dwords the field occupies. Writable positions and colours come from the live buffers,
+    // which are per instance and need no base offset.
+    const FString &Symbol = ParamInfo.DataInterfaceHLSLSymbol;
+    const bool bInterleaved = GetEffectiveBufferLayout() == EGaussianSplatBufferLayout::Interleaved;
+    const bool bWritable = IsWritable();
+    const FString Element = Symbol + ResolveIndexFunctionName + TEXT("(Index)");
+    auto FieldLoad = [&](const FString &StreamBufferName, const TCHAR *Swizzle, const TCHAR *LoadOp,
+                         uint32 RecordOffset) -> FString
+    {
+        if (bWritable && StreamBufferName == PositionsBufferName)
+            return FString::Printf(TEXT("%s%s[Index]%s"), *Symbol, *LivePositionsBufferName, Swizzle);
+        if (bWritable && StreamBufferName == SHZeroCoeffsBufferName)
+            return FString::Printf(TEXT("%s%s[Index]%s"), *Symbol, *LiveSHZeroBufferName, Swizzle);
+        if (bInterleaved)
+            return FString::Printf(TEXT("asfloat(%s%s.%s(%s * %u + %u))"), *Symbol, *SplatRecordsBufferName, LoadOp,
+                                   *Element, uint32(sizeof(FGaussianSplatPackedRecord)), RecordOffset);
+        return FString::Printf(TEXT("%s%s[%s]%s"), *Symbol, *StreamBufferName, *Element, Swizzle);
+    };
+    const FString PositionAndRadiusLoad =
+        FieldLoad(PositionsBufferName, TEXT(""), TEXT("Load4"), FGaussianSplatPackedRecord::PositionOffset);
+
     // GetSplatPosition
     if (FunctionInfo.DefinitionName == *GetPositionFunctionName)
     {
         static const TCHAR *FormatHLSL = TEXT(R"(
 			void {FunctionName}(int Index, out float3 OutPosition)
 			{
-				OutPosition = {PositionsBuffer}[Index].xyz;
+				OutPosition = {Load};
 			}
 		)");
         const TMap<FString, FStringFormatArg> Args = {
             {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
-            {TEXT("PositionsBuffer"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + PositionsBufferName)},
+            {TEXT("Load"), FStringFormatArg(FieldLoad(PositionsBufferName, TEXT(".xyz"), TEXT("Load3"),
+                                                      FGaussianSplatPackedRecord::PositionOffset))},
         };
         OutHLSL += FString::Format(FormatHLSL, Args);
         return true;
@@ -660,12 +2824,13 @@ bool UGaussianSplatNiagaraDataInterface::GetFunctionHLSL(const FNiagaraDataInter
         static const TCHAR *FormatHLSL = TEXT(R"(
 			void {FunctionName}(int Index, out float3 OutScale)
 			{
-				OutScale = {ScalesBuffer}[Index].xyz;
+				OutScale = {Load};
 			}
 		)");
         const TMap<FString, FStringFormatArg> Args = {
             {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
-            {TEXT("ScalesBuffer"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + ScalesBufferName)},
+            {TEXT("Load"), FStringFormatArg(FieldLoad(ScalesBufferName, TEXT(".xyz"), TEXT("Load3"),
+                                                      FGaussianSplatPackedRecord::ScaleOffset))},
         };
         OutHLSL += FString::Format(FormatHLSL, Args);
         return true;
@@ -677,12 +2842,13 @@ bool UGaussianSplatNiagaraDataInterface::GetFunctionHLSL(const FNiagaraDataInter
         static const TCHAR *FormatHLSL = TEXT(R"(
 			void {FunctionName}(int Index, out float4 OutOrientation)
 			{
-				OutOrientation = {OrientationsBuffer}[Index];
+				OutOrientation = {Load};
 			}
 		)");
         const TMap<FString, FStringFormatArg> Args = {
             {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
-            {TEXT("OrientationsBuffer"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + OrientationsBufferName)},
+            {TEXT("Load"), FStringFormatArg(FieldLoad(OrientationsBufferName, TEXT(""), TEXT("Load4"),
+                                                      FGaussianSplatPackedRecord::OrientationOffset))},
         };
         OutHLSL += FString::Format(FormatHLSL, Args);
         return true;
@@ -694,12 +2860,18 @@ bool UGaussianSplatNiagaraDataInterface::GetFunctionHLSL(const FNiagaraDataInter
         static const TCHAR *FormatHLSL = TEXT(R"(
 			void {FunctionName}(int Index, out float OutOpacity)
 			{
-				OutOpacity = {SHBuffer}[Index].w;
+				OutOpacity = {Load};
+				if ({SubPixelRadius} > 0.0)
+					OutOpacity = {CompensateOpacity}(OutOpacity, {PositionLoad});
 			}
 		)");
         const TMap<FString, FStringFormatArg> Args = {
             {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
-            {TEXT("SHBuffer"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + SHZeroCoeffsBufferName)},
+            {TEXT("Load"), FStringFormatArg(FieldLoad(SHZeroCoeffsBufferName, TEXT(".w"), TEXT("Load"),
+                                                      FGaussianSplatPackedRecord::OpacityOffset))},
+            {TEXT("PositionLoad"), FStringFormatArg(PositionAndRadiusLoad)},
+            {TEXT("SubPixelRadius"), FStringFormatArg(Symbol + SubPixelRadiusParamName)},
+            {TEXT("CompensateOpacity"), FStringFormatArg(Symbol + CompensateOpacityFunctionName)},
         };
         OutHLSL += FString::Format(FormatHLSL, Args);
         return true;
@@ -711,25 +2883,480 @@ bool UGaussianSplatNiagaraDataInterface::GetFunctionHLSL(const FNiagaraDataInter
         static const TCHAR *FormatHLSL = TEXT(R"(
 			void {FunctionName}(int Index, out float4 OutColor)
 			{
-				float4 SHData = {SHBuffer}[Index];
+				float4 SHData = {Load};
 				float3 SHCoeffs = SHData.xyz;
 				float Opacity = SHData.w;
+				if ({SubPixelRadius} > 0.0)
+					Opacity = {CompensateOpacity}(Opacity, {PositionLoad});
 
 				// SH0 constant for base color calculation
 				const float C0 = 0.28209479177387814;
 				float3 BaseColor = SHCoeffs * C0 + 0.5;
 				BaseColor = saturate(BaseColor);
 
-				// Apply global tint
-				BaseColor *= {GlobalTint};
+				// Apply global and per-cloud tint
+				BaseColor *= {GlobalTint} * {CloudTints}[{FindCloud}(Index)].rgb;
 
 				OutColor = float4(BaseColor, Opacity);
 			}
 		)");
         const TMap<FString, FStringFormatArg> Args = {
             {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
-            {TEXT("SHBuffer"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + SHZeroCoeffsBufferName)},
-            {TEXT("GlobalTint"), FStringFormatArg(ParamInfo.DataInterfaceHLSLSymbol + GlobalTintParamName)},
+            {TEXT("Load"), FStringFormatArg(FieldLoad(SHZeroCoeffsBufferName, TEXT(""), TEXT("Load4"),
+                                                      FGaussianSplatPackedRecord::SHZeroCoeffsAndOpacityOffset))},
+            {TEXT("PositionLoad"), FStringFormatArg(PositionAndRadiusLoad)},
+            {TEXT("SubPixelRadius"), FStringFormatArg(Symbol + SubPixelRadiusParamName)},
+            {TEXT("CompensateOpacity"), FStringFormatArg(Symbol + CompensateOpacityFunctionName)},
+            {TEXT("GlobalTint"), FStringFormatArg(Symbol + GlobalTintParamName)},
+            {TEXT("CloudTints"), FStringFormatArg(Symbol + CloudTintsBufferName)},
+            {TEXT("FindCloud"), FStringFormatArg(Symbol + FindCloudFunctionName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetSplatAttributes — with the interleaved layout this reads the whole record once
+    if (FunctionInfo.DefinitionName == *GetAttributesFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int Index, out float3 OutPosition, out float3 OutScale, out float4 OutOrientation,
+				out float4 OutColor)
+			{
+				float4 PositionAndRadius = {PositionLoad};
+				OutPosition = PositionAndRadius.xyz;
+				OutScale = {ScaleLoad};
+				OutOrientation = {OrientationLoad};
+				float4 SHData = {SHLoad};
+				const float C0 = 0.28209479177387814;
+				float3 Tint = {GlobalTint} * {CloudTints}[{FindCloud}(Index)].rgb;
+				OutColor = float4(saturate(SHData.xyz * C0 + 0.5) * Tint, SHData.w);
+				if ({SubPixelRadius} > 0.0)
+					OutColor.a = {CompensateOpacity}(OutColor.a, PositionAndRadius);
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("PositionLoad"), FStringFormatArg(PositionAndRadiusLoad)},
+            {TEXT("ScaleLoad"), FStringFormatArg(FieldLoad(ScalesBufferName, TEXT(".xyz"), TEXT("Load3"),
+                                                           FGaussianSplatPackedRecord::ScaleOffset))},
+            {TEXT("OrientationLoad"), FStringFormatArg(FieldLoad(OrientationsBufferName, TEXT(""), TEXT("Load4"),
+                                                                 FGaussianSplatPackedRecord::OrientationOffset))},
+            {TEXT("SHLoad"), FStringFormatArg(FieldLoad(SHZeroCoeffsBufferName, TEXT(""), TEXT("Load4"),
+                                                        FGaussianSplatPackedRecord::SHZeroCoeffsAndOpacityOffset))},
+            {TEXT("GlobalTint"), FStringFormatArg(Symbol + GlobalTintParamName)},
+            {TEXT("CloudTints"), FStringFormatArg(Symbol + CloudTintsBufferName)},
+            {TEXT("FindCloud"), FStringFormatArg(Symbol + FindCloudFunctionName)},
+            {TEXT("SubPixelRadius"), FStringFormatArg(Symbol + SubPixelRadiusParamName)},
+            {TEXT("CompensateOpacity"), FStringFormatArg(Symbol + CompensateOpacityFunctionName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetSplatScreenSize
+    if (FunctionInfo.DefinitionName == *GetSplatScreenSizeFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int Index, out float OutPixelRadius)
+			{
+				OutPixelRadius = {PixelRadius}({PositionLoad});
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("PositionLoad"), FStringFormatArg(PositionAndRadiusLoad)},
+            {TEXT("PixelRadius"), FStringFormatArg(Symbol + PixelRadiusFunctionName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetCloudCount
+    if (FunctionInfo.DefinitionName == *GetCloudCountFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(out int OutCount)
+			{
+				OutCount = {NumClouds};
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("NumClouds"), FStringFormatArg(Symbol + NumCloudsParamName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetSplatCloud
+    if (FunctionInfo.DefinitionName == *GetSplatCloudFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int Index, out int OutCloudIndex, out int OutLocalIndex)
+			{
+				OutCloudIndex = {FindCloud}(Index);
+				OutLocalIndex = Index - ({NumClouds} > 0 ? (int){CloudOffsets}[OutCloudIndex] : 0);
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("FindCloud"), FStringFormatArg(Symbol + FindCloudFunctionName)},
+            {TEXT("NumClouds"), FStringFormatArg(Symbol + NumCloudsParamName)},
+            {TEXT("CloudOffsets"), FStringFormatArg(Symbol + CloudOffsetsBufferName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetCloudSplatRange
+    if (FunctionInfo.DefinitionName == *GetCloudSplatRangeFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int CloudIndex, out int OutStartIndex, out int OutCount)
+			{
+				bool bValid = CloudIndex >= 0 && CloudIndex < {NumClouds};
+				OutStartIndex = bValid ? (int){CloudOffsets}[CloudIndex] : 0;
+				OutCount = bValid ? (int){CloudOffsets}[CloudIndex + 1] - OutStartIndex : 0;
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("NumClouds"), FStringFormatArg(Symbol + NumCloudsParamName)},
+            {TEXT("CloudOffsets"), FStringFormatArg(Symbol + CloudOffsetsBufferName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetCloudInstanceCount
+    if (FunctionInfo.DefinitionName == *GetCloudInstanceCountFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(out int OutCount)
+			{
+				OutCount = {NumInstances};
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("NumInstances"), FStringFormatArg(Symbol + NumCloudInstancesParamName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetInstancedSplatIndex
+    if (FunctionInfo.DefinitionName == *GetInstancedSplatIndexFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int ParticleIndex, out int OutInstanceIndex, out int OutSplatIndex)
+			{
+				int SplatsPerInstance = max({SplatsCount}, 1);
+				OutInstanceIndex = ParticleIndex / SplatsPerInstance;
+				OutSplatIndex = ParticleIndex - OutInstanceIndex * SplatsPerInstance;
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("SplatsCount"), FStringFormatArg(Symbol + SplatsCountParamName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetInstancedSplatAttributes — instance record is (location, scale), rotation, (tint, stride)
+    if (FunctionInfo.DefinitionName == *GetInstancedSplatAttributesFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int InstanceIndex, int SplatIndex, out float3 OutPosition, out float3 OutScale,
+				out float4 OutOrientation, out float4 OutColor, out bool OutVisible)
+			{
+				float4 LocationScale = float4(0, 0, 0, 1);
+				float4 Rotation = float4(0, 0, 0, 1);
+				float4 TintStride = float4(1, 1, 1, 1);
+				bool bValidInstance = {NumInstances} == 0 || (InstanceIndex >= 0 && InstanceIndex < {NumInstances});
+				if ({NumInstances} > 0 && bValidInstance)
+				{
+					LocationScale = {Instances}[InstanceIndex * 3];
+					Rotation = {Instances}[InstanceIndex * 3 + 1];
+					TintStride = {Instances}[InstanceIndex * 3 + 2];
+				}
+				int Stride = max((int)TintStride.w, 1);
+
+				int Index = clamp(SplatIndex, 0, max({SplatsCount} - 1, 0));
+				float3 LocalPosition = {PositionLoad};
+				float3 T = 2.0 * cross(Rotation.xyz, LocalPosition);
+				float3 Rotated = LocalPosition + Rotation.w * T + cross(Rotation.xyz, T);
+				OutPosition = LocationScale.xyz + Rotated * LocationScale.w;
+
+				// Kept splats grow so a decimated instance covers roughly the same screen area
+				OutScale = {ScaleLoad} * (LocationScale.w * sqrt((float)Stride));
+
+				float4 SplatRotation = {OrientationLoad};
+				float3 RotatedXYZ = Rotation.w * SplatRotation.xyz + SplatRotation.w * Rotation.xyz;
+				RotatedXYZ += cross(Rotation.xyz, SplatRotation.xyz);
+				float RotatedW = Rotation.w * SplatRotation.w - dot(Rotation.xyz, SplatRotation.xyz);
+				OutOrientation = normalize(float4(RotatedXYZ, RotatedW));
+
+				float4 SHData = {SHLoad};
+				const float C0 = 0.28209479177387814;
+				float3 Tint = {GlobalTint} * {CloudTints}[{FindCloud}(Index)].rgb * TintStride.rgb;
+				OutColor = float4(saturate(SHData.xyz * C0 + 0.5) * Tint, SHData.w);
+
+				bool bInRange = SplatIndex >= 0 && SplatIndex < {SplatsCount};
+				OutVisible = bValidInstance && bInRange && (SplatIndex % Stride) == 0;
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("NumInstances"), FStringFormatArg(Symbol + NumCloudInstancesParamName)},
+            {TEXT("Instances"), FStringFormatArg(Symbol + CloudInstancesBufferName)},
+            {TEXT("SplatsCount"), FStringFormatArg(Symbol + SplatsCountParamName)},
+            {TEXT("PositionLoad"), FStringFormatArg(FieldLoad(PositionsBufferName, TEXT(".xyz"), TEXT("Load3"),
+                                                              FGaussianSplatPackedRecord::PositionOffset))},
+            {TEXT("ScaleLoad"), FStringFormatArg(FieldLoad(ScalesBufferName, TEXT(".xyz"), TEXT("Load3"),
+                                                           FGaussianSplatPackedRecord::ScaleOffset))},
+            {TEXT("OrientationLoad"), FStringFormatArg(FieldLoad(OrientationsBufferName, TEXT(""), TEXT("Load4"),
+                                                                 FGaussianSplatPackedRecord::OrientationOffset))},
+            {TEXT("SHLoad"), FStringFormatArg(FieldLoad(SHZeroCoeffsBufferName, TEXT(""), TEXT("Load4"),
+                                                        FGaussianSplatPackedRecord::SHZeroCoeffsAndOpacityOffset))},
+            {TEXT("GlobalTint"), FStringFormatArg(Symbol + GlobalTintParamName)},
+            {TEXT("CloudTints"), FStringFormatArg(Symbol + CloudTintsBufferName)},
+            {TEXT("FindCloud"), FStringFormatArg(Symbol + FindCloudFunctionName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetVisibleSplatIndex
+    if (FunctionInfo.DefinitionName == *GetVisibleSplatIndexFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int VisibleIndex, out int OutSplatIndex, out bool OutVisible)
+			{
+				int Count = {CullEnabled} != 0 ? (int){VisibleCount}[0] : {SplatsCount};
+				OutVisible = VisibleIndex >= 0 && VisibleIndex < Count;
+				OutSplatIndex = 0;
+				if (OutVisible)
+				{
+					OutSplatIndex = {CullEnabled} != 0 ? (int){VisibleIndices}[VisibleIndex] : VisibleIndex;
+				}
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("SplatsCount"), FStringFormatArg(Symbol + SplatsCountParamName)},
+            {TEXT("CullEnabled"), FStringFormatArg(Symbol + CullEnabledParamName)},
+            {TEXT("VisibleCount"), FStringFormatArg(Symbol + VisibleCountBufferName)},
+            {TEXT("VisibleIndices"), FStringFormatArg(Symbol + VisibleIndicesBufferName)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // Spatial queries walk the same cells in the same order as FGaussianSplatSpatialGrid, so they agree with the VM
+    const TMap<FString, FStringFormatArg> GridArgs = {
+        {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+        {TEXT("GridCell"), FStringFormatArg(Symbol + GridCellFunctionName)},
+        {TEXT("GridInvCellSize"), FStringFormatArg(Symbol + GridInvCellSizeParamName)},
+        {TEXT("GridDims"), FStringFormatArg(Symbol + GridDimsParamName)},
+        {TEXT("CellStarts"), FStringFormatArg(Symbol + GridCellStartsBufferName)},
+        {TEXT("GridSplats"), FStringFormatArg(Symbol + GridSplatsBufferName)},
+    };
+
+    // GetSplatsInRadius
+    if (FunctionInfo.DefinitionName == *GetSplatsInRadiusFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(float3 Center, float Radius, int MaxCount, out int OutCount)
+			{
+				OutCount = 0;
+				int3 First = max({GridCell}(Center - Radius), 0);
+				int3 Last = Radius >= 0.0 ? min({GridCell}(Center + Radius), {GridDims} - 1) : -1;
+				float RadiusSq = Radius * Radius;
+				for (int Z = First.z; Z <= Last.z && OutCount < MaxCount; ++Z)
+				for (int Y = First.y; Y <= Last.y && OutCount < MaxCount; ++Y)
+				for (int X = First.x; X <= Last.x && OutCount < MaxCount; ++X)
+				{
+					int Cell = (Z * {GridDims}.y + Y) * {GridDims}.x + X;
+					uint End = {CellStarts}[Cell + 1];
+					for (uint Slot = {CellStarts}[Cell]; Slot < End && OutCount < MaxCount; ++Slot)
+					{
+						float3 Delta = {GridSplats}[Slot].xyz - Center;
+						if (dot(Delta, Delta) <= RadiusSq)
+							++OutCount;
+					}
+				}
+			}
+		)");
+        OutHLSL += FString::Format(FormatHLSL, GridArgs);
+        return true;
+    }
+
+    // GetSplatInRadius
+    if (FunctionInfo.DefinitionName == *GetSplatInRadiusFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(float3 Center, float Radius, int Nth, out int OutSplatIndex, out bool OutValid)
+			{
+				OutSplatIndex = 0;
+				OutValid = false;
+				int Seen = 0;
+				int3 First = max({GridCell}(Center - Radius), 0);
+				int3 Last = Radius >= 0.0 && Nth >= 0 ? min({GridCell}(Center + Radius), {GridDims} - 1) : -1;
+				float RadiusSq = Radius * Radius;
+				for (int Z = First.z; Z <= Last.z && !OutValid; ++Z)
+				for (int Y = First.y; Y <= Last.y && !OutValid; ++Y)
+				for (int X = First.x; X <= Last.x && !OutValid; ++X)
+				{
+					int Cell = (Z * {GridDims}.y + Y) * {GridDims}.x + X;
+					uint End = {CellStarts}[Cell + 1];
+					for (uint Slot = {CellStarts}[Cell]; Slot < End && !OutValid; ++Slot)
+					{
+						float4 Splat = {GridSplats}[Slot];
+						float3 Delta = Splat.xyz - Center;
+						if (dot(Delta, Delta) <= RadiusSq)
+						{
+							OutValid = Seen == Nth;
+							OutSplatIndex = OutValid ? asint(Splat.w) : 0;
+							++Seen;
+						}
+					}
+				}
+			}
+		)");
+        OutHLSL += FString::Format(FormatHLSL, GridArgs);
+        return true;
+    }
+
+    // GetNearestSplat — FGaussianSplatSpatialGrid::FindNearest: shells of cells around the query's cell, stopping once
+    // the next shell is further than the best hit
+    if (FunctionInfo.DefinitionName == *GetNearestSplatFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(float3 Position, float MaxDistance, out int OutSplatIndex, out float OutDistance,
+				out bool OutValid)
+			{
+				int Best = -1;
+				float BestDistSq = MaxDistance > 0.0 ? MaxDistance * MaxDistance : 3.402823e38;
+				int3 Dims = {GridDims};
+				int3 Center = {GridCell}(Position);
+				int3 Reach = max(Center, Dims - 1 - Center);
+				int MaxRing = Dims.x > 0 ? max(Reach.x, max(Reach.y, Reach.z)) : -1;
+				if (MaxDistance > 0.0)
+					MaxRing = min(MaxRing, (int)ceil(min(MaxDistance * {GridInvCellSize}, 1.0e6)) + 1);
+
+				for (int Ring = 0; Ring <= MaxRing; ++Ring)
+				{
+					float MinDist = max(Ring - 1, 0) / {GridInvCellSize};
+					if (MinDist * MinDist > BestDistSq)
+						break;
+					for (int DZ = -Ring; DZ <= Ring; ++DZ)
+					{
+						int Z = Center.z + DZ;
+						if (Z < 0 || Z >= Dims.z)
+							continue;
+						for (int DY = -Ring; DY <= Ring; ++DY)
+						{
+							int Y = Center.y + DY;
+							if (Y < 0 || Y >= Dims.y)
+								continue;
+							int Step = (abs(DZ) == Ring || abs(DY) == Ring) ? 1 : 2 * Ring;
+							for (int DX = -Ring; DX <= Ring; DX += Step)
+							{
+								int X = Center.x + DX;
+								if (X < 0 || X >= Dims.x)
+									continue;
+								int Cell = (Z * Dims.y + Y) * Dims.x + X;
+								uint End = {CellStarts}[Cell + 1];
+								for (uint Slot = {CellStarts}[Cell]; Slot < End; ++Slot)
+								{
+									float4 Splat = {GridSplats}[Slot];
+									float3 Delta = Splat.xyz - Position;
+									float DistSq = dot(Delta, Delta);
+									int Index = asint(Splat.w);
+									if (DistSq < BestDistSq || (DistSq == BestDistSq && (Best < 0 || Index < Best)))
+									{
+										BestDistSq = DistSq;
+										Best = Index;
+									}
+								}
+							}
+						}
+					}
+				}
+				OutValid = Best >= 0;
+				OutSplatIndex = max(Best, 0);
+				OutDistance = OutValid ? sqrt(BestDistSq) : 0.0;
+			}
+		)");
+        OutHLSL += FString::Format(FormatHLSL, GridArgs);
+        return true;
+    }
+
+    // SetSplatPosition / SetSplatOpacity / ResetSplat — write the back buffers PreStage seeded with this frame's
+    // values. Without bWritableSplats they compile to a failed write so graphs still build.
+    const bool bSetPosition = FunctionInfo.DefinitionName == *SetSplatPositionFunctionName;
+    const bool bSetOpacity = FunctionInfo.DefinitionName == *SetSplatOpacityFunctionName;
+    const bool bResetSplat = FunctionInfo.DefinitionName == *ResetSplatFunctionName;
+    if (bSetPosition || bSetOpacity || bResetSplat)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(int Index{Value}, out bool OutSuccess)
+			{
+				OutSuccess = {Writable} && Index >= 0 && Index < {SplatsCount};
+				if (OutSuccess)
+				{
+					{Write}
+				}
+			}
+		)");
+        const TCHAR *Value = TEXT("");
+        FString Write;
+        const FString LivePositions = Symbol + LivePositionsBufferName;
+        const FString LiveSHZero = Symbol + LiveSHZeroBufferName;
+        const FString PositionsOut = Symbol + LivePositionsOutBufferName;
+        const FString SHZeroOut = Symbol + LiveSHZeroOutBufferName;
+        if (bSetPosition)
+        {
+            // W keeps the bounding radius
+            Value = TEXT(", float3 Position");
+            Write = FString::Printf(TEXT("%s[Index] = float4(Position, %s[Index].w);"), *PositionsOut, *LivePositions);
+        }
+        else if (bSetOpacity)
+        {
+            Value = TEXT(", float Opacity");
+            Write = FString::Printf(TEXT("%s[Index] = float4(%s[Index].xyz, saturate(Opacity));"), *SHZeroOut,
+                                    *LiveSHZero);
+        }
+        else
+        {
+            Write = FString::Printf(TEXT("%s[Index] = %s%s[Index]; %s[Index] = %s%s[Index];"), *PositionsOut, *Symbol,
+                                    *RestPositionsBufferName, *SHZeroOut, *Symbol, *RestSHZeroBufferName);
+        }
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("Value"), FStringFormatArg(Value)},
+            {TEXT("Writable"), FStringFormatArg(bWritable ? TEXT("true") : TEXT("false"))},
+            {TEXT("SplatsCount"), FStringFormatArg(Symbol + SplatsCountParamName)},
+            {TEXT("Write"), FStringFormatArg(Write)},
+        };
+        OutHLSL += FString::Format(FormatHLSL, Args);
+        return true;
+    }
+
+    // GetSequenceFrame
+    if (FunctionInfo.DefinitionName == *GetSequenceFrameFunctionName)
+    {
+        static const TCHAR *FormatHLSL = TEXT(R"(
+			void {FunctionName}(out int OutFrameIndex)
+			{
+				OutFrameIndex = {SequenceFrame};
+			}
+		)");
+        const TMap<FString, FStringFormatArg> Args = {
+            {TEXT("FunctionName"), FStringFormatArg(FunctionInfo.InstanceName)},
+            {TEXT("SequenceFrame"), FStringFormatArg(Symbol + SequenceFrameParamName)},
         };
         OutHLSL += FString::Format(FormatHLSL, Args);
         return true;
@@ -738,58 +3365,14 @@ bool UGaussianSplatNiagaraDataInterface::GetFunctionHLSL(const FNiagaraDataInter
     return false;
 }
 
-// void UGaussianSplatNiagaraDataInterface::MarkRenderDataDirty()
-//{
-//	const bool bWasDirty = bGPUDataDirty;
-//	bGPUDataDirty = true;
-//	UE_LOG(LogGaussianSplat, Verbose, TEXT("[MarkRenderDataDirty] %s | WasDirty=%d -> Now dirty"), *GetName(),
-//bWasDirty);
-// }
-//
-// void UGaussianSplatNiagaraDataInterface::PrepareGPUData()
-//{
-//	FNDIGaussianSplatProxy* SplatProxy = static_cast<FNDIGaussianSplatProxy*>(Proxy.Get());
-//	if (!SplatProxy)
-//	{
-//		UE_LOG(LogGaussianSplat, Error, TEXT("[PrepareGPUData] %s | Proxy is null! Cannot proceed."), *GetName());
-//		return;
-//	}
-//
-//	const int32 Count = Splats.Num();
-//	const bool bBuffersValid = SplatProxy->AreBuffersValid();
-//	const bool bCountMismatch = SplatProxy->SplatsCount != Count;
-//	const bool bProxyNeedsInit = !bBuffersValid || bCountMismatch;
-//
-//	UE_LOG(LogGaussianSplat, Log, TEXT("[PrepareGPUData] %s | Splats=%d | Dirty=%d | BuffersValid=%d | ProxyCount=%d |
-//CountMismatch=%d | NeedsInit=%d | Proxy=%p"), 		*GetName(), Count, bGPUDataDirty, bBuffersValid,
-//SplatProxy->SplatsCount, bCountMismatch, bProxyNeedsInit, SplatProxy);
-//
-//	if (bGPUDataDirty || bProxyNeedsInit)
-//	{
-//		if (Count > 0)
-//		{
-//			UE_LOG(LogGaussianSplat, Log, TEXT("[PrepareGPUData] %s | Uploading %d splats to GPU (Dirty=%d,
-//NeedsInit=%d)"), 				*GetName(), Count, bGPUDataDirty, bProxyNeedsInit); 			SplatProxy->InitializeBuffers(Count);
-//			SplatProxy->UploadDataToGPU(Splats);
-//			SplatProxy->SplatsCount = Count;
-//			SplatProxy->GlobalTint = FVector3f(GlobalTint.R, GlobalTint.G, GlobalTint.B);
-//			UE_LOG(LogGaussianSplat, Log, TEXT("[PrepareGPUData] %s | Upload complete. ProxyCount=%d, ProxyValid=%d"),
-//				*GetName(), SplatProxy->SplatsCount, SplatProxy->AreBuffersValid());
-//		}
-//		else
-//		{
-//			UE_LOG(LogGaussianSplat, Log, TEXT("[PrepareGPUData] %s | No splats (Count=0), creating fallback buffers"),
-//*GetName()); 			SplatProxy->EnsureFallbackBuffers();
-//		}
-//
-//		bGPUDataDirty = false;
-//		UE_LOG(LogGaussianSplat, Log, TEXT("[PrepareGPUData] %s | Cleared dirty flag"), *GetName());
-//	}
-//	else
-//	{
-//		UE_LOG(LogGaussianSplat, Log, TEXT("[PrepareGPUData] %s | SKIPPED: not dirty and proxy up to date"),
-//*GetName());
-//	}
-// }
+#if WITH_EDITORONLY_DATA
+bool UGaussianSplatNiagaraDataInterface::AppendCompileHash(FNiagaraCompileHashVisitor *InVisitor) const
+{
+    bool bSuccess = Super::AppendCompileHash(InVisitor);
+    bSuccess &= InVisitor->UpdatePOD(TEXT("GaussianSplatBufferLayout"), int32(GetEffectiveBufferLayout()));
+    bSuccess &= InVisitor->UpdatePOD(TEXT("GaussianSplatWritable"), IsWritable());
+    return bSuccess;
+}
+#endif
 
 #undef LOCTEXT_NAMESPACE
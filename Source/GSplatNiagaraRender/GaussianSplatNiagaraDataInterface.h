@@ -1,7 +1,12 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "GaussianSplatCPUData.h"
+#include "GaussianSplatCleanup.h"
+#include "GaussianSplatCloudTable.h"
 #include "GaussianSplatData.h"
+#include "GaussianSplatDirtyRanges.h"
+#include "GaussianSplatSpatialGrid.h"
 #include "GaussianSplatNiagaraDataInterface.generated.h"
 #include "NDIGaussianSplatProxy.h"
 #include "NiagaraCommon.h"
@@ -9,6 +14,9 @@
 #include "NiagaraShared.h"
 #include "VectorVM.h"
 
+class UTextureRenderTarget2D;
+struct FSceneViewProjectionData;
+
 BEGIN_SHADER_PARAMETER_STRUCT(FGaussianSplatShaderParameters, )
 SHADER_PARAMETER(int, SplatsCount)
 SHADER_PARAMETER(FVector3f, GlobalTint)
@@ -16,8 +24,117 @@ SHADER_PARAMETER_SRV(Buffer<float4>, Positions)
 SHADER_PARAMETER_SRV(Buffer<float4>, Scales)
 SHADER_PARAMETER_SRV(Buffer<float4>, Orientations)
 SHADER_PARAMETER_SRV(Buffer<float4>, SHZeroCoeffsAndOpacity)
+SHADER_PARAMETER_SRV(ByteAddressBuffer, SplatRecords)
+SHADER_PARAMETER(int, BaseOffset)
+SHADER_PARAMETER(int, UseIndirection)
+SHADER_PARAMETER_SRV(Buffer<uint>, Indirection)
+SHADER_PARAMETER(int, NumClouds)
+SHADER_PARAMETER_SRV(Buffer<uint>, CloudOffsets)
+SHADER_PARAMETER_SRV(Buffer<float4>, CloudTints)
+SHADER_PARAMETER(int, NumCloudInstances)
+SHADER_PARAMETER_SRV(Buffer<float4>, CloudInstances)
+SHADER_PARAMETER(int, SequenceFrame)
+SHADER_PARAMETER(int, CullEnabled)
+SHADER_PARAMETER_SRV(Buffer<uint>, VisibleCount)
+SHADER_PARAMETER_SRV(Buffer<uint>, VisibleIndices)
+SHADER_PARAMETER(FVector4f, ScreenDepthPlane)
+SHADER_PARAMETER(float, ScreenPixelScale)
+SHADER_PARAMETER(float, SubPixelRadius)
+SHADER_PARAMETER(FVector3f, GridOrigin)
+SHADER_PARAMETER(float, GridInvCellSize)
+SHADER_PARAMETER(FIntVector, GridDims)
+SHADER_PARAMETER_SRV(Buffer<uint>, GridCellStarts)
+SHADER_PARAMETER_SRV(Buffer<float4>, GridSplats)
+SHADER_PARAMETER_SRV(Buffer<float4>, RestPositions)
+SHADER_PARAMETER_SRV(Buffer<float4>, RestSHZero)
+SHADER_PARAMETER_SRV(Buffer<float4>, LivePositions)
+SHADER_PARAMETER_SRV(Buffer<float4>, LiveSHZero)
+SHADER_PARAMETER_UAV(RWBuffer<float4>, LivePositionsOut)
+SHADER_PARAMETER_UAV(RWBuffer<float4>, LiveSHZeroOut)
 END_SHADER_PARAMETER_STRUCT()
 
+// What an NDI keeps of Splats once its instances have the splats on the GPU
+UENUM(BlueprintType)
+enum class EGaussianSplatCPUResidency : uint8
+{
+    KeepAll,
+    // Splats is emptied
+    ReleaseAfterUpload,
+    // Splats keeps every 2^CPUProxyLevel-th splat of each cloud
+    LowResProxy
+};
+
+// One source cloud of a multi-cloud NDI
+USTRUCT(BlueprintType)
+struct FGaussianSplatCloud
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaussian Splat",
+              meta = (FilePathFilter = "Splat files (*.ply;*.spz;*.splat)|*.ply;*.spz;*.splat"))
+    FFilePath PlyFile;
+
+    // Baked into the splats when the clouds are loaded
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaussian Splat")
+    FTransform Transform;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaussian Splat")
+    FLinearColor Tint = FLinearColor::White;
+};
+
+// One placement of the cloud in instanced mode. Only location, rotation and the largest scale axis are used.
+USTRUCT(BlueprintType)
+struct FGaussianSplatCloudInstance
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaussian Splat")
+    FTransform Transform;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaussian Splat")
+    FLinearColor Tint = FLinearColor::White;
+};
+
+// Game thread bytes of one NDI by what they hold
+struct FGaussianSplatCPUMemory
+{
+    // The FGaussianSplatData array itself, then the SH arrays each splat owns
+    int64 Splats = 0;
+    int64 HarmonicsCoefficients = 0;
+    // Planar copy the VM and CPU culling read
+    int64 VMData = 0;
+    int64 SpatialGrid = 0;
+    // Cloud table and packed cloud instances
+    int64 Tables = 0;
+    // Copies queued for the render thread that it has not uploaded yet, plus its upload scratch
+    int64 PendingUploads = 0;
+
+    // What the NDI keeps between frames, which is what the budget and STAT_GaussianSplat_CPUMemory count
+    int64 GetResident() const
+    {
+        return Splats + HarmonicsCoefficients + VMData + SpatialGrid + Tables;
+    }
+    int64 GetTotal() const
+    {
+        return GetResident() + PendingUploads;
+    }
+};
+
+// Lives in the Niagara per-instance block
+struct FGaussianSplatPerInstanceData
+{
+    // RenderDataRevision this instance's GPU data was built from; a mismatch triggers a full re-init
+    uint32 UploadedRevision = 0;
+    // Last value written to User.SplatCount, so instanced mode only republishes it when the instance count changes
+    int32 PublishedSplatCount = INDEX_NONE;
+    // Frustum for this tick, handed to the render thread through ProvidePerInstanceDataForRenderThread
+    FGaussianSplatCullParams CullParams;
+    // This instance's splats that passed the last CPU cull, in index order, and their count; INDEX_NONE when not
+    // culling. GPU emitters see the proxy's read back count for the instance here instead, a few frames old.
+    TArray<int32> VisibleSplats;
+    int32 VisibleSplatCount = INDEX_NONE;
+};
+
 UCLASS(EditInlineNew, Category = "Gaussian Splat", meta = (DisplayName = "Gaussian Splat NDI"))
 class GSPLATNIAGARARENDER_API UGaussianSplatNiagaraDataInterface : public UNiagaraDataInterface
 {
@@ -32,41 +149,283 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaussian Splat")
     FLinearColor GlobalTint;
 
-    UPROPERTY(EditAnywhere, Category = "Source", meta = (FilePathFilter = "ply"))
+    UPROPERTY(EditAnywhere, Category = "Source",
+              meta = (FilePathFilter = "Splat files (*.ply;*.spz;*.splat)|*.ply;*.spz;*.splat"))
     FFilePath PlyFilePath;
 
+    // When non-empty, replaces PlyFilePath: every cloud is concatenated into one set of buffers so a single
+    // dispatch covers them all. GetSplatCloud maps a splat index back to its cloud.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Source")
+    TArray<FGaussianSplatCloud> Clouds;
+
+    // Applied to each source file as it is loaded; the removal counts are logged
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Source")
+    FGaussianSplatCleanupSettings Cleanup;
+
+    // Interleaved reads every attribute of a splat from one 64 byte record instead of four separate buffers.
+    // Streaming always uses separate streams.
+    UPROPERTY(EditAnywhere, Category = "Gaussian Splat")
+    EGaussianSplatBufferLayout BufferLayout = EGaussianSplatBufferLayout::SeparateStreams;
+
+    // Octree tile file written by BuildTiledFileFromPLY; when set, tiles are streamed around the camera instead of
+    // loading PlyFilePath whole
+    UPROPERTY(EditAnywhere, Category = "Streaming", meta = (FilePathFilter = "gstiles"))
+    FFilePath TiledFilePath;
+
+    // GPU pool size for resident tiles. Split over four buffers, so the cap keeps each well under the 2 GB limit.
+    UPROPERTY(EditAnywhere, Category = "Streaming",
+              meta = (ClampMin = "16", UIMin = "16", ClampMax = "4096", UIMax = "4096"))
+    int32 StreamingBudgetMB = 512;
+
+    UPROPERTY(EditAnywhere, Category = "Streaming", meta = (ClampMin = "1", UIMin = "1"))
+    int32 MaxInFlightTileReads = 8;
+
+    // Tiles beyond this distance from the camera are never requested (0 = unlimited)
+    UPROPERTY(EditAnywhere, Category = "Streaming", meta = (ClampMin = "0", Units = "cm"))
+    float MaxStreamingDistance = 0.0f;
+
+    // Animated sequence built by BuildSequenceFromPLYs. Frames are decoded ahead on worker threads and played on the
+    // GPU; User.SplatCount is set to the largest frame. Ignored when TiledFilePath is set.
+    UPROPERTY(EditAnywhere, Category = "Sequence", meta = (FilePathFilter = "gsseq"))
+    FFilePath SequenceFilePath;
+
+    // Frames decoded ahead of the playhead; each costs one frame of packed splats in memory
+    UPROPERTY(EditAnywhere, Category = "Sequence", meta = (ClampMin = "1", UIMin = "1", UIMax = "16"))
+    int32 SequenceRingSize = 4;
+
+    UPROPERTY(EditAnywhere, Category = "Sequence")
+    bool bLoopSequence = true;
+
+    // Advance at the file's frame rate times SequencePlaybackRate; otherwise show SequenceFrameIndex
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sequence")
+    bool bAutoPlaySequence = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sequence", meta = (ClampMin = "0"))
+    float SequencePlaybackRate = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sequence", meta = (ClampMin = "0"))
+    int32 SequenceFrameIndex = 0;
+
+    // Instanced mode: the cloud is uploaded once and placed at each of these, in system local space. Spawn
+    // User.SplatCount particles (splats x instances) and read them through GetInstancedSplatIndex.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instancing")
+    TArray<FGaussianSplatCloudInstance> CloudInstances;
+
+    // Instances further than this from the camera keep only every Nth splat, N doubling with each doubling of
+    // distance (0 = no decimation)
+    UPROPERTY(EditAnywhere, Category = "Instancing", meta = (ClampMin = "0", Units = "cm"))
+    float InstanceDecimationDistance = 0.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Instancing", meta = (ClampMin = "1", UIMin = "1"))
+    int32 MaxInstanceDecimationStride = 16;
+
+    // Over the splat memory budget, clouds with lower priority lose detail first. See UGaussianSplatBudgetSubsystem.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget")
+    int32 BudgetPriority = 0;
+
+    // Cull splats outside the player's view every frame. GetSplatCount then returns the visible count and
+    // GetVisibleSplatIndex maps [0, count) to the visible splats; spawn User.SplatCount particles and kill those at
+    // or past the count. Single clouds only: streaming, sequences and instancing ignore it.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Culling")
+    bool bViewCulling = false;
+
+    // A splat's bounding radius, in standard deviations along its largest axis
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Culling",
+              meta = (ClampMin = "0", UIMax = "4", EditCondition = "bViewCulling"))
+    float CullRadiusSigma = 3.0f;
+
+    // Thin out splats whose projected radius (see GetSplatScreenSize) is below this many pixels: each survives with
+    // probability (radius / threshold)^2, and GetSplatOpacity/Color/Attributes raise the survivors' opacity to stand
+    // in for the dropped ones. 0 keeps every splat in view.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Culling",
+              meta = (ClampMin = "0", UIMax = "4", EditCondition = "bViewCulling"))
+    float SubPixelCullRadius = 0.0f;
+
+    // Also draws the cloud from the player's view into this target every frame with the compute tile rasterizer,
+    // premultiplied with coverage in alpha. Sized by the target; single clouds only, like culling.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tile Rasterizer")
+    TObjectPtr<UTextureRenderTarget2D> RasterTarget;
+
+    // Tile keys reserved per splat. Splats touching more tiles than fit are dropped from the tiles past the budget.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tile Rasterizer", meta = (ClampMin = "1", UIMax = "16"))
+    float RasterKeysPerSplat = 4.0f;
+
+    // Builds a uniform grid over the splat centres at load so GetSplatsInRadius, GetSplatInRadius and GetNearestSplat
+    // can be called from CPU and GPU emitters; without it they find nothing. Positions are in the system's local
+    // space, like GetSplatPosition. Single and multi-cloud only; edits through UpdateSplatRange are not seen until
+    // the next reload.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spatial Queries")
+    bool bBuildSpatialGrid = false;
+
+    // Average splats per grid cell. Fewer means more cells and cheaper queries with small radii.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spatial Queries",
+              meta = (ClampMin = "1", UIMax = "64", EditCondition = "bBuildSpatialGrid"))
+    int32 SpatialGridSplatsPerCell = 8;
+
+    // Lets GPU emitters move splats and change their opacity with SetSplatPosition, SetSplatOpacity and ResetSplat.
+    // Positions and colours get two extra GPU copies that are ping-ponged each frame, so writes are seen by every
+    // reader, culling included, from the next frame on. CPU emitters, the tile rasterizer and the spatial grid keep
+    // seeing the uploaded pose. Single and multi-cloud only.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deformation")
+    bool bWritableSplats = false;
+
+    // Frees Splats after the first GPU upload when only GPU emitters read this NDI; those read the GPU copy, which
+    // new instances share with a live one. Without a live instance, or once a CPU emitter or a change needs the
+    // full set, the source is reloaded through the Derived Data Cache. Until then GetSplatCount still reports the
+    // uploaded count, UpdateSplatRange and UpdateSplats are ignored, and a proxy's indices do not match the GPU's.
+    // Single and multi-cloud NDIs with a source file only.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory")
+    EGaussianSplatCPUResidency CPUResidency = EGaussianSplatCPUResidency::KeepAll;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory",
+              meta = (ClampMin = "1", ClampMax = "8",
+                      EditCondition = "CPUResidency == EGaussianSplatCPUResidency::LowResProxy"))
+    int32 CPUProxyLevel = 3;
+
     UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
     bool LoadFromPLYFile(const FString &FilePath);
 
+    // Re-reads every entry of Clouds; clouds that fail to parse stay in the table with zero splats
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    bool LoadClouds();
+
+    // Converts a PLY into the tiled on-disk layout used for streaming. Not out of core: the whole PLY is parsed into
+    // memory and the octree built over it before anything is written, so the conversion needs RAM for the entire
+    // cloud (roughly 2x its splats plus the file) even though playback of the result streams. PLY files over 2 GB are
+    // rejected; split larger captures into several clouds.
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    static bool BuildTiledFileFromPLY(const FString &PlyPath, const FString &OutTiledPath, int32 TileCapacity = 16384);
+
+    bool IsStreaming() const
+    {
+        return !TiledFilePath.FilePath.IsEmpty();
+    }
+
+    bool IsSequence() const
+    {
+        return !IsStreaming() && !SequenceFilePath.FilePath.IsEmpty();
+    }
+
+    // Converts numbered per-frame PLYs (a directory, or any one frame of the set) into a sequence file
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    static bool BuildSequenceFromPLYs(const FString &PlyDirectoryOrFrame, const FString &OutSequencePath,
+                                      float FrameRate = 30.0f, int32 KeyframeInterval = 30);
+
+    // Jumps playback to a file frame; with auto play the clock continues from there
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    void SetSequenceFrame(int32 FrameIndex);
+
+    // File frame currently on screen, or INDEX_NONE before the first frame has decoded
+    UFUNCTION(BlueprintPure, Category = "Gaussian Splat")
+    int32 GetSequenceFrame() const
+    {
+        return PresentedSequenceFrame;
+    }
+
+    const FGaussianSplatSequencePlayer *GetSequencePlayer() const
+    {
+        return SequencePlayer.Get();
+    }
+
+    bool IsMultiCloud() const
+    {
+        return Clouds.Num() > 0;
+    }
+
+    bool IsInstanced() const
+    {
+        return CloudInstances.Num() > 0;
+    }
+
+    // Replaces CloudInstances; picked up on the next tick without re-uploading the cloud
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    void SetCloudInstances(const TArray<FGaussianSplatCloudInstance> &NewInstances);
+
+    // Ranges within Splats, so after a CPUResidency trim they cover the kept splats rather than the GPU copy
+    const FGaussianSplatCloudTable &GetCloudTable() const
+    {
+        return CloudTable;
+    }
+
+    EGaussianSplatBufferLayout GetEffectiveBufferLayout() const
+    {
+        return IsStreaming() || IsSequence() ? EGaussianSplatBufferLayout::SeparateStreams : BufferLayout;
+    }
+
+    const FGaussianSplatStreamingManager *GetStreamingManager() const
+    {
+        return StreamingManager.Get();
+    }
+
     UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
     int32 GetSplatCount() const;
 
+    // True when CPUResidency has freed or thinned Splats since the last load
+    UFUNCTION(BlueprintPure, Category = "Gaussian Splat")
+    bool IsCPUCopyTrimmed() const
+    {
+        return bCPUSplatsTrimmed;
+    }
+
     UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
     void ClearSplats();
 
+    // Call after editing Splats[Start, Start + Count) in place. Ranges are merged and uploaded into every live
+    // instance's existing buffers on the next tick, without a re-init.
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    void UpdateSplatRange(int32 Start, int32 Count);
+
+    // Same as UpdateSplatRange for a scattered set of edited splats
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    void UpdateSplats(const TArray<int32> &Indices);
+
+    // Pushes pending range updates to the render thread now instead of waiting for the next tick
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    void FlushSplatUpdates();
+
+    // Puts every splat of every instance back to the uploaded pose before the next frame's GPU stages
+    UFUNCTION(BlueprintCallable, Category = "Gaussian Splat")
+    void ResetDeformation();
+
+    bool IsWritable() const
+    {
+        return bWritableSplats && !IsStreaming() && !IsSequence();
+    }
+
     virtual void PostInitProperties() override;
     virtual void PostLoad() override;
 #if WITH_EDITOR
     virtual void PostEditChangeProperty(struct FPropertyChangedEvent &PropertyChangedEvent) override;
 #endif
     virtual void BeginDestroy() override;
+    // Tagged per stream, so memreport and the size map show where a cloud's memory goes
+    virtual void GetResourceSizeEx(FResourceSizeEx &CumulativeResourceSize) override;
 
     virtual bool CopyToInternal(UNiagaraDataInterface *Destination) const override;
     virtual bool Equals(const UNiagaraDataInterface *Other) const override;
     virtual void GetFunctions(TArray<FNiagaraFunctionSignature> &OutFunctions) override;
     virtual void GetVMExternalFunction(const FVMExternalFunctionBindingInfo &BindingInfo, void *InstanceData,
                                        FVMExternalFunction &OutFunc) override;
+    // Streaming and sequence data only ever live in GPU buffers
     virtual bool CanExecuteOnTarget(ENiagaraSimTarget Target) const override
     {
-        return Target == ENiagaraSimTarget::GPUComputeSim;
+        return Target == ENiagaraSimTarget::GPUComputeSim || (!IsStreaming() && !IsSequence());
     }
 
     virtual bool InitPerInstanceData(void *PerInstanceData, FNiagaraSystemInstance *SystemInstance) override;
     virtual void DestroyPerInstanceData(void *PerInstanceData, FNiagaraSystemInstance *SystemInstance) override;
+    virtual bool PerInstanceTick(void *PerInstanceData, FNiagaraSystemInstance *SystemInstance,
+                                 float DeltaSeconds) override;
+    virtual bool HasPreSimulateTick() const override
+    {
+        return true;
+    }
     virtual int32 PerInstanceDataSize() const override
     {
-        return sizeof(int32);
+        return sizeof(FGaussianSplatPerInstanceData);
     }
+    virtual void ProvidePerInstanceDataForRenderThread(void *DataForRenderThread, void *PerInstanceData,
+                                                       const FNiagaraSystemInstanceID &SystemInstance) override;
 
     virtual void BuildShaderParameters(FNiagaraShaderParametersBuilder &ShaderParametersBuilder) const override;
     virtual void SetShaderParameters(const FNiagaraDataInterfaceSetShaderParametersContext &Context) const override;
@@ -75,19 +434,126 @@ public:
     virtual bool GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo &ParamInfo,
                                  const FNiagaraDataInterfaceGeneratedFunction &FunctionInfo, int FunctionInstanceIndex,
                                  FString &OutHLSL) override;
+#if WITH_EDITORONLY_DATA
+    // The generated HLSL depends on the buffer layout
+    virtual bool AppendCompileHash(FNiagaraCompileHashVisitor *InVisitor) const override;
+#endif
 
-    // CPU VM stubs
+    // CPU VM, reading the planar CPUData copy
     void GetSplatCount(FVectorVMExternalFunctionContext &Context) const;
     void GetSplatPosition(FVectorVMExternalFunctionContext &Context) const;
     void GetSplatScale(FVectorVMExternalFunctionContext &Context) const;
     void GetSplatOrientation(FVectorVMExternalFunctionContext &Context) const;
     void GetSplatOpacity(FVectorVMExternalFunctionContext &Context) const;
     void GetSplatColor(FVectorVMExternalFunctionContext &Context) const;
+    void GetSplatAttributes(FVectorVMExternalFunctionContext &Context) const;
+    void GetCloudCount(FVectorVMExternalFunctionContext &Context) const;
+    void GetSplatCloud(FVectorVMExternalFunctionContext &Context) const;
+    void GetCloudSplatRange(FVectorVMExternalFunctionContext &Context) const;
+    void GetCloudInstanceCount(FVectorVMExternalFunctionContext &Context) const;
+    void GetInstancedSplatIndex(FVectorVMExternalFunctionContext &Context) const;
+    void GetInstancedSplatAttributes(FVectorVMExternalFunctionContext &Context) const;
+    void GetVisibleSplatIndex(FVectorVMExternalFunctionContext &Context) const;
+    void GetSplatScreenSize(FVectorVMExternalFunctionContext &Context) const;
+    void GetSplatsInRadius(FVectorVMExternalFunctionContext &Context) const;
+    void GetSplatInRadius(FVectorVMExternalFunctionContext &Context) const;
+    void GetNearestSplat(FVectorVMExternalFunctionContext &Context) const;
 
     void MarkRenderDataDirty();
 
+    // Game thread copies of the splats: the array with its SH coefficients, the planar VM copy and the tables
+    FGaussianSplatCPUMemory GetCPUMemory() const;
+    int64 GetCPUMemoryBytes() const
+    {
+        return GetCPUMemory().GetResident();
+    }
+    // Splat buffers of every instance, as last measured on the render thread
+    FGaussianSplatGPUMemory GetGPUMemory() const;
+    int64 GetGPUMemoryBytes() const;
+    // Bytes InitPerInstanceData last copied for the render thread, on top of GetCPUMemory while the upload ran
+    int64 GetLastInitUploadBytes() const
+    {
+        return LastInitUploadBytes;
+    }
+
+    // Detail level chosen by the budget: level N keeps one splat in 2^N of each source cloud. Coarsening thins the
+    // loaded splats in place; refining reloads the source.
+    int32 GetBudgetLevel() const
+    {
+        return BudgetLevel;
+    }
+    void SetBudgetLevel(int32 Level);
+    // Streaming and sequences manage their own memory, and there is nothing to reload without a source
+    bool CanChangeBudgetLevel() const
+    {
+        return !IsStreaming() && !IsSequence() && HasSource();
+    }
+    // Closest any instance was to the camera over the last frame; MAX_flt when none ticked
+    float GetBudgetViewDistance() const;
+
+#if WITH_EDITOR
+    // Called by FGaussianSplatHotReload when a file this NDI loaded has new contents
+    void ApplyReloadedFile(const FString &File, const TArray<FGaussianSplatData> &FileSplats);
+#endif
+
 private:
     void LoadPlyFile();
+    // LoadClouds in multi-cloud mode, LoadPlyFile otherwise
+    void LoadSource();
+    bool HasSource() const
+    {
+        return IsMultiCloud() || !PlyFilePath.FilePath.IsEmpty();
+    }
+    bool OpenStreaming();
+    void TickStreaming(FNiagaraSystemInstance *SystemInstance);
+    void TickInstancing(FNiagaraSystemInstance *SystemInstance);
+    bool OpenSequence();
+    void TickSequence(float DeltaSeconds);
+    int32 GetDecimationStride(float Distance) const;
+    void PublishSplatCount(FGaussianSplatPerInstanceData *InstData, FNiagaraSystemInstance *SystemInstance) const;
+    // GetSplatCount for an instance whose last cull kept CulledCount splats (INDEX_NONE when not culled)
+    int32 ResolveSplatCount(int32 CulledCount) const;
+    // Particles an unculled cloud spawns: the loaded splats once per cloud instance, as published in User.SplatCount
+    int32 GetSpawnedSplatCount() const;
+    // Splats in the GPU copy, which is Splats.Num() until CPUResidency trims Splats
+    int32 GetLoadedSplatCount() const
+    {
+        return bCPUSplatsTrimmed ? CurrentSplatCount : Splats.Num();
+    }
+    // Frees or thins Splats as CPUResidency asks, once the GPU has them
+    void ApplyCPUResidency();
+    // Initialises the instance from another live instance's upload of this revision; false when there is none
+    bool ShareResidentUpload(FNiagaraSystemInstance *SystemInstance);
+    // Camera position in world space, falling back to the system origin
+    static FVector GetViewLocation(FNiagaraSystemInstance *SystemInstance);
+    // Camera position in the system's local space, falling back to the system origin
+    static FVector3f GetLocalViewOrigin(FNiagaraSystemInstance *SystemInstance);
+    void UpdateBudgetViewDistance(FNiagaraSystemInstance *SystemInstance);
+    bool IsViewCulled() const;
+    // Builds this tick's frustum, and for CPU emitters the visible list of the first instance each frame
+    void UpdateViewCulling(FGaussianSplatPerInstanceData *InstData, FNiagaraSystemInstance *SystemInstance);
+    // The first local player's view; false without one
+    static bool GetPlayerProjectionData(FNiagaraSystemInstance *SystemInstance,
+                                        FSceneViewProjectionData &OutProjectionData);
+    // System local space to the first local player's clip space, and the view's height in pixels; false without a
+    // player view
+    static bool GetLocalToClip(FNiagaraSystemInstance *SystemInstance, FMatrix &OutLocalToClip, float &OutViewHeight);
+    // Queues the tile rasterizer into RasterTarget for the first instance each frame
+    void TickRasterizer(FNiagaraSystemInstance *SystemInstance);
+    // Queues this frame's slices of uploads the gsplat.Upload.FrameBudgetMB cap spread over several frames
+    void TickUploads();
+    // Moves this NDI's share of the CPU memory and splat count stats to the given values
+    void SetAccountedMemory(int64 CPUBytes, int32 NumSplats);
+    void SetSingleCloudSplats(TArray<FGaussianSplatData> &&NewSplats);
+    // Per source file, before cloud transforms: cleanup, then the budget level's decimation
+    void PrepareSourceSplats(const FString &SourceFile, TArray<FGaussianSplatData> &InOutSplats) const;
+    // Records the hashes of LoadedSourceFiles and (re)registers them for hot reload. Editor only; no-op otherwise.
+    void OnSourceLoaded();
+#if WITH_EDITOR
+    static FString HashSourceFiles(const TArray<FString> &Files);
+    // True when Files are what Splats was loaded from and none of them changed since
+    bool IsSourceUpToDate(const TArray<FString> &Files) const;
+#endif
 
     static const FString GetSplatCountFunctionName;
     static const FString GetPositionFunctionName;
@@ -95,12 +561,117 @@ private:
     static const FString GetOrientationFunctionName;
     static const FString GetOpacityFunctionName;
     static const FString GetColorFunctionName;
+    static const FString GetAttributesFunctionName;
+    static const FString GetCloudCountFunctionName;
+    static const FString GetSplatCloudFunctionName;
+    static const FString GetCloudSplatRangeFunctionName;
+    static const FString GetCloudInstanceCountFunctionName;
+    static const FString GetInstancedSplatIndexFunctionName;
+    static const FString GetInstancedSplatAttributesFunctionName;
+    static const FString GetSequenceFrameFunctionName;
+    static const FString GetVisibleSplatIndexFunctionName;
+    static const FString GetSplatScreenSizeFunctionName;
+    static const FString GetSplatsInRadiusFunctionName;
+    static const FString GetSplatInRadiusFunctionName;
+    static const FString GetNearestSplatFunctionName;
+    static const FString SetSplatPositionFunctionName;
+    static const FString SetSplatOpacityFunctionName;
+    static const FString ResetSplatFunctionName;
     static const FString SplatsCountParamName;
     static const FString GlobalTintParamName;
     static const FString PositionsBufferName;
     static const FString ScalesBufferName;
     static const FString OrientationsBufferName;
     static const FString SHZeroCoeffsBufferName;
+    static const FString SplatRecordsBufferName;
+    static const FString BaseOffsetParamName;
+    static const FString UseIndirectionParamName;
+    static const FString IndirectionBufferName;
+    static const FString ResolveIndexFunctionName;
+    static const FString NumCloudsParamName;
+    static const FString CloudOffsetsBufferName;
+    static const FString CloudTintsBufferName;
+    static const FString FindCloudFunctionName;
+    static const FString NumCloudInstancesParamName;
+    static const FString CloudInstancesBufferName;
+    static const FString SequenceFrameParamName;
+    static const FString CullEnabledParamName;
+    static const FString VisibleCountBufferName;
+    static const FString VisibleIndicesBufferName;
+    static const FString ScreenDepthPlaneParamName;
+    static const FString ScreenPixelScaleParamName;
+    static const FString SubPixelRadiusParamName;
+    static const FString PixelRadiusFunctionName;
+    static const FString CompensateOpacityFunctionName;
+    static const FString GridOriginParamName;
+    static const FString GridInvCellSizeParamName;
+    static const FString GridDimsParamName;
+    static const FString GridCellStartsBufferName;
+    static const FString GridSplatsBufferName;
+    static const FString GridCellFunctionName;
+    static const FString RestPositionsBufferName;
+    static const FString RestSHZeroBufferName;
+    static const FString LivePositionsBufferName;
+    static const FString LiveSHZeroBufferName;
+    static const FString LivePositionsOutBufferName;
+    static const FString LiveSHZeroOutBufferName;
+
+    // Bumped by MarkRenderDataDirty whenever Splats is replaced wholesale
+    uint32 RenderDataRevision;
+
+    // Edits recorded by UpdateSplatRange / UpdateSplats since the last flush
+    FGaussianSplatDirtyRanges PendingDirtyRanges;
+
+    // Built in InitPerInstanceData when a CPU emitter may read this NDI; CPUDataRevision tracks RenderDataRevision
+    FGaussianSplatCPUData CPUData;
+    uint32 CPUDataRevision = 0;
+
+    // Built in InitPerInstanceData when bBuildSpatialGrid is set, tracking RenderDataRevision the same way
+    FGaussianSplatSpatialGrid SpatialGrid;
+    uint32 SpatialGridRevision = 0;
+
+    // Cloud ranges and tints of Splats; one entry when loaded from a single PLY. Trimming Splats keeps it as
+    // uploaded.
+    FGaussianSplatCloudTable CloudTable;
+    // Set by ApplyCPUResidency, cleared whenever Splats is loaded again
+    bool bCPUSplatsTrimmed = false;
+
+    TUniquePtr<FGaussianSplatStreamingManager> StreamingManager;
+    uint64 LastStreamingUpdateFrame = 0;
+
+    TUniquePtr<FGaussianSplatSequencePlayer> SequencePlayer;
+    // Seconds of auto play since the start of the sequence, scaled by SequencePlaybackRate
+    double SequencePlayTime = 0.0;
+    int32 PresentedSequenceFrame = INDEX_NONE;
+    int32 PresentedSequenceSplats = 0;
+    uint64 LastSequenceUpdateFrame = 0;
+
+    // CloudInstances packed as 3 float4 each: (location, scale), rotation, (tint, decimation stride). Rebuilt once
+    // per frame; re-uploaded only when it changes.
+    TArray<FVector4f> PackedCloudInstances;
+    uint64 LastInstancingUpdateFrame = 0;
+
+    // VisibleSplatCount and view of the first instance ticked each frame: the count for the Blueprint GetSplatCount,
+    // the view for the CPU screen size and opacity compensation
+    int32 VisibleSplatCount = INDEX_NONE;
+    uint64 LastCullFrame = 0;
+    FGaussianSplatCullParams CPUCullParams;
+    uint64 LastRasterFrame = 0;
+    uint64 LastUploadFrame = 0;
+
+    int32 BudgetLevel = 0;
+    float BudgetViewDistance = MAX_flt;
+    uint64 BudgetViewDistanceFrame = 0;
+
+    // PLY files Splats was loaded from: one path, or every cloud in multi-cloud mode
+    TArray<FString> LoadedSourceFiles;
+#if WITH_EDITOR
+    // Concatenated content hashes of LoadedSourceFiles at load time
+    FString LoadedSourceHash;
+#endif
 
-    bool bGPUDataDirty;
+    // What SetAccountedMemory last added to STAT_GaussianSplat_CPUMemory and STAT_GaussianSplat_LoadedSplats
+    int64 AccountedCPUBytes = 0;
+    int32 AccountedSplats = 0;
+    int64 LastInitUploadBytes = 0;
 };
@@ -0,0 +1,39 @@
+﻿#include "GaussianSplatPacking.h"
+#include "GaussianSplatStats.h"
+
+void FGaussianSplatPacking::PackRecords(TConstArrayView<FGaussianSplatData> Splats,
+                                        TArray<FGaussianSplatPackedRecord> &OutRecords)
+{
+    GSPLAT_SCOPE(Pack);
+    OutRecords.SetNumUninitialized(Splats.Num());
+    for (int32 i = 0; i < Splats.Num(); ++i)
+        OutRecords[i] = FGaussianSplatPackedRecord::FromSplat(Splats[i]);
+}
+
+void FGaussianSplatPacking::UnpackRecords(TConstArrayView<FGaussianSplatPackedRecord> Records,
+                                          TArray<FGaussianSplatData> &OutSplats)
+{
+    OutSplats.Reset(Records.Num());
+    for (const FGaussianSplatPackedRecord &Record : Records)
+        OutSplats.Add(Record.ToSplat());
+}
+
+void FGaussianSplatPacking::SplitRecords(TConstArrayView<FGaussianSplatPackedRecord> Records,
+                                         FGaussianSplatStreams &OutStreams)
+{
+    GSPLAT_SCOPE(Pack);
+    const int32 Count = Records.Num();
+    OutStreams.Positions.SetNumUninitialized(Count, EAllowShrinking::No);
+    OutStreams.Scales.SetNumUninitialized(Count, EAllowShrinking::No);
+    OutStreams.Orientations.SetNumUninitialized(Count, EAllowShrinking::No);
+    OutStreams.SHZeroCoeffsAndOpacity.SetNumUninitialized(Count, EAllowShrinking::No);
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const FGaussianSplatPackedRecord &Record = Records[i];
+        OutStreams.Positions[i] = Record.Position;
+        OutStreams.Scales[i] = Record.Scale;
+        OutStreams.Orientations[i] = Record.Orientation;
+        OutStreams.SHZeroCoeffsAndOpacity[i] = Record.SHZeroCoeffsAndOpacity;
+    }
+}
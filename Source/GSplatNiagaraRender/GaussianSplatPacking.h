@@ -0,0 +1,40 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+// CPU-side mirror of the four float4 streams of the separate-streams layout
+struct FGaussianSplatStreams
+{
+    TArray<FVector4f> Positions;
+    TArray<FVector4f> Scales;
+    TArray<FVector4f> Orientations;
+    TArray<FVector4f> SHZeroCoeffsAndOpacity;
+
+    int32 Num() const
+    {
+        return Positions.Num();
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return Positions.GetAllocatedSize() + Scales.GetAllocatedSize() + Orientations.GetAllocatedSize() +
+               SHZeroCoeffsAndOpacity.GetAllocatedSize();
+    }
+};
+
+/**
+ * Converts between FGaussianSplatData and the GPU layouts. Packed records are the common currency: they are what
+ * the interleaved layout uploads verbatim, what tiled files store, and what gets split into streams otherwise.
+ * Every field is kept as fp32, so a pack/unpack round trip is exact; only normals and higher-order SH are dropped.
+ */
+class FGaussianSplatPacking
+{
+public:
+    static void PackRecords(TConstArrayView<FGaussianSplatData> Splats, TArray<FGaussianSplatPackedRecord> &OutRecords);
+    static void UnpackRecords(TConstArrayView<FGaussianSplatPackedRecord> Records,
+                              TArray<FGaussianSplatData> &OutSplats);
+
+    // Records -> separate streams. OutStreams keeps its allocation between calls so it can be reused as scratch.
+    static void SplitRecords(TConstArrayView<FGaussianSplatPackedRecord> Records, FGaussianSplatStreams &OutStreams);
+};
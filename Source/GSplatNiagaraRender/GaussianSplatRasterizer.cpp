@@ -0,0 +1,301 @@
+﻿#include "GaussianSplatRasterizer.h"
+#include "Async/ParallelFor.h"
+#include "GaussianSplatStats.h"
+#include "Math/InverseRotationMatrix.h"
+#include "Math/PerspectiveMatrix.h"
+#include "Math/TranslationMatrix.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatRaster, Log, All);
+
+FGaussianSplatRasterView FGaussianSplatRasterView::Make(const FMatrix &LocalToWorld, const FMatrix &WorldToView,
+                                                        const FMatrix &Projection, FIntPoint Size)
+{
+    // UE view space is Y up; pixel rows go down
+    const FMatrix FlipY(FPlane(1, 0, 0, 0), FPlane(0, -1, 0, 0), FPlane(0, 0, 1, 0), FPlane(0, 0, 0, 1));
+
+    FGaussianSplatRasterView View;
+    View.LocalToView = FMatrix44f(LocalToWorld * WorldToView * FlipY);
+    View.Size = Size;
+    // NDC = XY * (M00, M11) / Z + (M20, M21), then NDC -> pixels
+    View.Focal = FVector2f(float(Projection.M[0][0]) * Size.X * 0.5f, float(Projection.M[1][1]) * Size.Y * 0.5f);
+    View.Principal = FVector2f(Size.X * 0.5f * (1.0f + float(Projection.M[2][0])),
+                               Size.Y * 0.5f * (1.0f - float(Projection.M[2][1])));
+    return View;
+}
+
+FGaussianSplatRasterView FGaussianSplatRasterView::MakeLookAt(const FVector &Location, const FRotator &Rotation,
+                                                              float FOVDegrees, FIntPoint Size)
+{
+    // Same as FSceneView: world axes (forward, right, up) become view (Z, X, Y)
+    const FMatrix ViewRotation = FInverseRotationMatrix(Rotation) * FMatrix(FPlane(0, 0, 1, 0), FPlane(1, 0, 0, 0),
+                                                                            FPlane(0, 1, 0, 0), FPlane(0, 0, 0, 1));
+    const FMatrix WorldToView = FTranslationMatrix(-Location) * ViewRotation;
+    const float HalfFOV = FMath::DegreesToRadians(FMath::Clamp(FOVDegrees, 1.0f, 170.0f)) * 0.5f;
+    const FReversedZPerspectiveMatrix Projection(HalfFOV, float(Size.X), float(Size.Y), 10.0f);
+    return Make(FMatrix::Identity, WorldToView, Projection, Size);
+}
+
+bool FGaussianSplatRasterizer::Project(const FGaussianSplatRasterView &View, const FGaussianSplatData &Splat,
+                                       const FLinearColor &Tint, FGaussianSplatProjected &OutProjected)
+{
+    if (Splat.Opacity < MinAlpha)
+        return false;
+
+    const FVector4f ViewPosition = View.LocalToView.TransformPosition(Splat.Position);
+    const float Z = ViewPosition.Z;
+    if (Z <= View.NearZ)
+        return false;
+
+    // Covariance R S S^T R^T of the splat in local space, column vector convention
+    const FQuat4f Q = Splat.Orientation.GetNormalized();
+    const float R[3][3] = {
+        {1.0f - 2.0f * (Q.Y * Q.Y + Q.Z * Q.Z), 2.0f * (Q.X * Q.Y - Q.W * Q.Z), 2.0f * (Q.X * Q.Z + Q.W * Q.Y)},
+        {2.0f * (Q.X * Q.Y + Q.W * Q.Z), 1.0f - 2.0f * (Q.X * Q.X + Q.Z * Q.Z), 2.0f * (Q.Y * Q.Z - Q.W * Q.X)},
+        {2.0f * (Q.X * Q.Z - Q.W * Q.Y), 2.0f * (Q.Y * Q.Z + Q.W * Q.X), 1.0f - 2.0f * (Q.X * Q.X + Q.Y * Q.Y)},
+    };
+    float M[3][3];
+    for (int32 i = 0; i < 3; ++i)
+        for (int32 j = 0; j < 3; ++j)
+            M[i][j] = R[i][j] * Splat.Scale[j];
+
+    // Into view space: the linear part of LocalToView, transposed since FMatrix multiplies row vectors
+    float VM[3][3];
+    for (int32 i = 0; i < 3; ++i)
+        for (int32 j = 0; j < 3; ++j)
+            VM[i][j] = View.LocalToView.M[0][i] * M[0][j] + View.LocalToView.M[1][i] * M[1][j] +
+                       View.LocalToView.M[2][i] * M[2][j];
+
+    // Jacobian of the perspective divide. The point is clamped a little outside the screen so splats far off to the
+    // side do not blow up.
+    const FVector2f Limit = FVector2f(View.Size) * 0.65f / View.Focal;
+    const float TX = FMath::Clamp(ViewPosition.X / Z, -Limit.X, Limit.X);
+    const float TY = FMath::Clamp(ViewPosition.Y / Z, -Limit.Y, Limit.Y);
+    const float J[2][3] = {
+        {View.Focal.X / Z, 0.0f, -View.Focal.X * TX / Z},
+        {0.0f, View.Focal.Y / Z, -View.Focal.Y * TY / Z},
+    };
+
+    // 2D covariance J (VM VM^T) J^T, with JVM = J VM
+    float JVM[2][3];
+    for (int32 i = 0; i < 2; ++i)
+        for (int32 j = 0; j < 3; ++j)
+            JVM[i][j] = J[i][0] * VM[0][j] + J[i][1] * VM[1][j] + J[i][2] * VM[2][j];
+    // Low-pass: every splat covers at least about a pixel
+    const float A = JVM[0][0] * JVM[0][0] + JVM[0][1] * JVM[0][1] + JVM[0][2] * JVM[0][2] + 0.3f;
+    const float B = JVM[0][0] * JVM[1][0] + JVM[0][1] * JVM[1][1] + JVM[0][2] * JVM[1][2];
+    const float C = JVM[1][0] * JVM[1][0] + JVM[1][1] * JVM[1][1] + JVM[1][2] * JVM[1][2] + 0.3f;
+    const float Det = A * C - B * B;
+    if (Det <= 0.0f)
+        return false;
+
+    // Three standard deviations along the major axis
+    const float Mid = 0.5f * (A + C);
+    const float Lambda = Mid + FMath::Sqrt(FMath::Max(0.1f, Mid * Mid - Det));
+    const float Radius = FMath::CeilToFloat(3.0f * FMath::Sqrt(Lambda));
+
+    const FVector2f Center = View.Principal + View.Focal * FVector2f(ViewPosition.X / Z, ViewPosition.Y / Z);
+    const FIntPoint TileCount = View.GetTileCount();
+    const float TileSize = float(FGaussianSplatRasterView::TileSize);
+    OutProjected.TileMin.X = FMath::Clamp(FMath::FloorToInt((Center.X - Radius) / TileSize), 0, TileCount.X);
+    OutProjected.TileMin.Y = FMath::Clamp(FMath::FloorToInt((Center.Y - Radius) / TileSize), 0, TileCount.Y);
+    OutProjected.TileMax.X = FMath::Clamp(FMath::FloorToInt((Center.X + Radius) / TileSize) + 1, 0, TileCount.X);
+    OutProjected.TileMax.Y = FMath::Clamp(FMath::FloorToInt((Center.Y + Radius) / TileSize) + 1, 0, TileCount.Y);
+    if (OutProjected.TileMax.X <= OutProjected.TileMin.X || OutProjected.TileMax.Y <= OutProjected.TileMin.Y)
+        return false;
+
+    const FLinearColor Color = FGaussianSplatData::SHToColor(Splat.ZeroOrderHarmonicsCoefficients) * Tint;
+    OutProjected.Center = Center;
+    OutProjected.Depth = Z;
+    OutProjected.Conic = FVector3f(C / Det, -B / Det, A / Det);
+    OutProjected.Opacity = Splat.Opacity;
+    OutProjected.Color = FVector3f(Color.R, Color.G, Color.B);
+    return true;
+}
+
+uint32 FGaussianSplatRasterizer::MakeSortKey(const FGaussianSplatRasterView &View, uint32 Tile, float Depth)
+{
+    // Log depth keeps relative precision constant from NearZ to FarZ
+    const uint32 DepthBits = View.GetDepthBits();
+    const uint32 MaxDepth = (1u << DepthBits) - 1;
+    const float T =
+        FMath::Clamp(FMath::Loge(Depth / View.NearZ) / FMath::Loge(View.FarZ / View.NearZ), 0.0f, 1.0f);
+    return (Tile << DepthBits) | FMath::Min(uint32(T * float(MaxDepth)), MaxDepth);
+}
+
+void FGaussianSplatRasterizer::SortPairs(TArray<uint32> &Keys, TArray<uint32> &Values)
+{
+    const int32 Num = Keys.Num();
+    if (Num < 2)
+        return;
+    TArray<uint32> ScratchKeys;
+    TArray<uint32> ScratchValues;
+    ScratchKeys.SetNumUninitialized(Num);
+    ScratchValues.SetNumUninitialized(Num);
+
+    uint32 *SrcKeys = Keys.GetData();
+    uint32 *SrcValues = Values.GetData();
+    uint32 *DstKeys = ScratchKeys.GetData();
+    uint32 *DstValues = ScratchValues.GetData();
+    for (uint32 Shift = 0; Shift < 32; Shift += 8)
+    {
+        uint32 Offsets[256] = {};
+        for (int32 i = 0; i < Num; ++i)
+            ++Offsets[(SrcKeys[i] >> Shift) & 0xFF];
+        if (Offsets[(SrcKeys[0] >> Shift) & 0xFF] == uint32(Num))
+            continue;
+
+        uint32 Sum = 0;
+        for (uint32 &Offset : Offsets)
+        {
+            const uint32 Count = Offset;
+            Offset = Sum;
+            Sum += Count;
+        }
+        for (int32 i = 0; i < Num; ++i)
+        {
+            const uint32 Slot = Offsets[(SrcKeys[i] >> Shift) & 0xFF]++;
+            DstKeys[Slot] = SrcKeys[i];
+            DstValues[Slot] = SrcValues[i];
+        }
+        Swap(SrcKeys, DstKeys);
+        Swap(SrcValues, DstValues);
+    }
+
+    if (SrcKeys != Keys.GetData())
+    {
+        Swap(Keys, ScratchKeys);
+        Swap(Values, ScratchValues);
+    }
+}
+
+void FGaussianSplatRasterizer::Render(const FGaussianSplatRasterView &View, TConstArrayView<FGaussianSplatData> Splats,
+                                      TArray<FLinearColor> &OutPixels, FGaussianSplatRasterStats *OutStats)
+{
+    GSPLAT_SCOPE(Raster);
+    FGaussianSplatRasterStats Stats;
+    OutPixels.Reset();
+    if (!View.IsValid())
+    {
+        if (OutStats)
+            *OutStats = Stats;
+        return;
+    }
+    OutPixels.SetNumZeroed(View.Size.X * View.Size.Y);
+
+    // Project, and count the tiles each splat touches
+    double Start = FPlatformTime::Seconds();
+    const int32 N = Splats.Num();
+    TArray<FGaussianSplatProjected> Projected;
+    TArray<int32> TileCounts;
+    Projected.SetNumUninitialized(N);
+    TileCounts.SetNumUninitialized(N);
+    ParallelFor(TEXT("GaussianSplat.Raster.Project"), N, 4096,
+                [&](int32 i)
+                {
+                    const bool bVisible = Project(View, Splats[i], FLinearColor::White, Projected[i]);
+                    TileCounts[i] = bVisible ? Projected[i].GetNumTiles() : 0;
+                });
+
+    // Each splat gets a slice of the key array
+    TArray<int32> Offsets;
+    Offsets.SetNumUninitialized(N);
+    int64 NumKeys = 0;
+    for (int32 i = 0; i < N; ++i)
+    {
+        Offsets[i] = int32(NumKeys);
+        NumKeys += TileCounts[i];
+        Stats.NumProjected += TileCounts[i] > 0;
+    }
+    if (NumKeys > MAX_int32)
+    {
+        UE_LOG(LogGaussianSplatRaster, Warning, TEXT("%lld tile keys for %d splats is more than one array holds"),
+               NumKeys, N);
+        if (OutStats)
+            *OutStats = Stats;
+        return;
+    }
+    Stats.NumKeys = NumKeys;
+
+    const FIntPoint TileCount = View.GetTileCount();
+    TArray<uint32> Keys;
+    TArray<uint32> Values;
+    Keys.SetNumUninitialized(int32(NumKeys));
+    Values.SetNumUninitialized(int32(NumKeys));
+    ParallelFor(TEXT("GaussianSplat.Raster.Duplicate"), N, 4096,
+                [&](int32 i)
+                {
+                    if (TileCounts[i] == 0)
+                        return;
+                    const FGaussianSplatProjected &P = Projected[i];
+                    int32 Slot = Offsets[i];
+                    for (int32 TY = P.TileMin.Y; TY < P.TileMax.Y; ++TY)
+                    {
+                        for (int32 TX = P.TileMin.X; TX < P.TileMax.X; ++TX)
+                        {
+                            Keys[Slot] = MakeSortKey(View, uint32(TY * TileCount.X + TX), P.Depth);
+                            Values[Slot] = uint32(i);
+                            ++Slot;
+                        }
+                    }
+                });
+    Stats.ProjectSeconds = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    SortPairs(Keys, Values);
+
+    // Sorted keys are grouped by tile; each tile owns [X, Y)
+    const uint32 DepthBits = View.GetDepthBits();
+    TArray<FIntPoint> Ranges;
+    Ranges.SetNumZeroed(View.GetNumTiles());
+    for (int32 i = 0; i < Keys.Num(); ++i)
+    {
+        const uint32 Tile = Keys[i] >> DepthBits;
+        if (i == 0 || (Keys[i - 1] >> DepthBits) != Tile)
+            Ranges[Tile].X = i;
+        Ranges[Tile].Y = i + 1;
+    }
+    Stats.SortSeconds = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    ParallelFor(TEXT("GaussianSplat.Raster.Blend"), View.GetNumTiles(), 1,
+                [&](int32 Tile)
+                {
+                    const FIntPoint Range = Ranges[Tile];
+                    const int32 X0 = (Tile % TileCount.X) * FGaussianSplatRasterView::TileSize;
+                    const int32 Y0 = (Tile / TileCount.X) * FGaussianSplatRasterView::TileSize;
+                    const int32 X1 = FMath::Min(X0 + FGaussianSplatRasterView::TileSize, View.Size.X);
+                    const int32 Y1 = FMath::Min(Y0 + FGaussianSplatRasterView::TileSize, View.Size.Y);
+                    for (int32 Y = Y0; Y < Y1; ++Y)
+                    {
+                        for (int32 X = X0; X < X1; ++X)
+                        {
+                            const FVector2f Pixel(X + 0.5f, Y + 0.5f);
+                            float Transmittance = 1.0f;
+                            FVector3f Color = FVector3f::ZeroVector;
+                            for (int32 k = Range.X; k < Range.Y; ++k)
+                            {
+                                const FGaussianSplatProjected &P = Projected[Values[k]];
+                                const FVector2f D = P.Center - Pixel;
+                                const float Power = -0.5f * (P.Conic.X * D.X * D.X + P.Conic.Z * D.Y * D.Y) -
+                                                    P.Conic.Y * D.X * D.Y;
+                                if (Power > 0.0f)
+                                    continue;
+                                const float Alpha = FMath::Min(0.99f, P.Opacity * FMath::Exp(Power));
+                                if (Alpha < MinAlpha)
+                                    continue;
+                                const float Next = Transmittance * (1.0f - Alpha);
+                                if (Next < MinTransmittance)
+                                    break;
+                                Color += P.Color * (Alpha * Transmittance);
+                                Transmittance = Next;
+                            }
+                            OutPixels[Y * View.Size.X + X] =
+                                FLinearColor(Color.X, Color.Y, Color.Z, 1.0f - Transmittance);
+                        }
+                    }
+                });
+    Stats.BlendSeconds = FPlatformTime::Seconds() - Start;
+
+    if (OutStats)
+        *OutStats = Stats;
+}
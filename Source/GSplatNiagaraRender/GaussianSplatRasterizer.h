@@ -0,0 +1,116 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+/**
+ * Camera of the tile rasterizer, in the cloud's local space. View space is X right, Y down, Z forward, so a point
+ * lands on pixel Principal + Focal * XY / Z.
+ */
+struct FGaussianSplatRasterView
+{
+    static constexpr int32 TileSize = 16;
+
+    FMatrix44f LocalToView = FMatrix44f::Identity;
+    // In pixels
+    FVector2f Focal = FVector2f(1.0f, 1.0f);
+    FVector2f Principal = FVector2f::ZeroVector;
+    FIntPoint Size = FIntPoint::ZeroValue;
+    // Splats closer than NearZ are dropped. Sort keys quantize log depth over [NearZ, FarZ].
+    float NearZ = 10.0f;
+    float FarZ = 1.0e7f;
+
+    bool IsValid() const
+    {
+        return Size.X > 0 && Size.Y > 0;
+    }
+
+    FIntPoint GetTileCount() const
+    {
+        return FIntPoint(FMath::DivideAndRoundUp(Size.X, TileSize), FMath::DivideAndRoundUp(Size.Y, TileSize));
+    }
+
+    int32 GetNumTiles() const
+    {
+        return GetTileCount().X * GetTileCount().Y;
+    }
+
+    // Sort keys are (tile, depth) packed in 32 bits. One tile id above the last is left free, so the all-ones key
+    // the GPU clears unused slots to never names a real tile.
+    uint32 GetTileBits() const
+    {
+        return FMath::CeilLogTwo(uint32(GetNumTiles()) + 1);
+    }
+
+    uint32 GetDepthBits() const
+    {
+        return 32 - GetTileBits();
+    }
+
+    // From an engine view: world to UE view space (X right, Y up, Z forward) and its projection matrix
+    static FGaussianSplatRasterView Make(const FMatrix &LocalToWorld, const FMatrix &WorldToView,
+                                         const FMatrix &Projection, FIntPoint Size);
+
+    // A camera at Location looking along Rotation with a horizontal field of view, for tools
+    static FGaussianSplatRasterView MakeLookAt(const FVector &Location, const FRotator &Rotation, float FOVDegrees,
+                                               FIntPoint Size);
+};
+
+// One splat after projection, as both the CPU and GPU paths store it
+struct FGaussianSplatProjected
+{
+    // Pixel position and view depth
+    FVector2f Center;
+    float Depth;
+    // Inverse of the 2D covariance: (xx, xy, yy)
+    FVector3f Conic;
+    float Opacity;
+    FVector3f Color;
+    // Tiles overlapped, [Min, Max)
+    FIntPoint TileMin;
+    FIntPoint TileMax;
+
+    int32 GetNumTiles() const
+    {
+        return (TileMax.X - TileMin.X) * (TileMax.Y - TileMin.Y);
+    }
+};
+
+struct FGaussianSplatRasterStats
+{
+    int32 NumProjected = 0;
+    int64 NumKeys = 0;
+    double ProjectSeconds = 0.0;
+    double SortSeconds = 0.0;
+    double BlendSeconds = 0.0;
+};
+
+/**
+ * 3DGS-style tile rasterizer on the CPU: splats are projected to 2D conics, duplicated into every 16x16 tile they
+ * touch under a (tile, depth) key, radix sorted, and blended front to back per tile until a pixel is opaque.
+ * This is the reference for GaussianSplatRaster.usf: projection, key layout and blending are the same math, so
+ * the two agree up to float rounding. Used headless by the GaussianSplatRender commandlet.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatRasterizer
+{
+public:
+    // Below this a splat no longer contributes to a pixel, and once transmittance drops under the other a pixel
+    // takes no more splats
+    static constexpr float MinAlpha = 1.0f / 255.0f;
+    static constexpr float MinTransmittance = 1.0e-4f;
+
+    // False when the splat is behind the near plane, degenerate, or covers no tile
+    static bool Project(const FGaussianSplatRasterView &View, const FGaussianSplatData &Splat, const FLinearColor &Tint,
+                        FGaussianSplatProjected &OutProjected);
+
+    static uint32 MakeSortKey(const FGaussianSplatRasterView &View, uint32 Tile, float Depth);
+
+    // Stable LSD radix sort of (key, value) pairs, one byte per pass. Passes where every key has the same digit are
+    // skipped, which drops most of the tile bits on small views.
+    static void SortPairs(TArray<uint32> &Keys, TArray<uint32> &Values);
+
+    // Premultiplied color with coverage (1 - transmittance) in alpha, row major, Size.X * Size.Y pixels. OutStats is
+    // written on every path, early outs included.
+    static void Render(const FGaussianSplatRasterView &View, TConstArrayView<FGaussianSplatData> Splats,
+                       TArray<FLinearColor> &OutPixels, FGaussianSplatRasterStats *OutStats = nullptr);
+};
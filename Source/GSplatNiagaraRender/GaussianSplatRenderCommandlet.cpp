@@ -0,0 +1,84 @@
+﻿#include "GaussianSplatRenderCommandlet.h"
+#include "GaussianSplatDerivedData.h"
+#include "GaussianSplatRasterizer.h"
+#include "ImageUtils.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatRender, Log, All);
+
+UGaussianSplatRenderCommandlet::UGaussianSplatRenderCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UGaussianSplatRenderCommandlet::Main(const FString &Params)
+{
+    FString Input;
+    FString Output;
+    if (!FParse::Value(*Params, TEXT("Input="), Input) || !FParse::Value(*Params, TEXT("Output="), Output))
+    {
+        UE_LOG(LogGaussianSplatRender, Error, TEXT("Usage: -Input=<file.ply> -Output=<file.png|exr>"));
+        return 1;
+    }
+    FIntPoint Size(1280, 720);
+    FParse::Value(*Params, TEXT("Width="), Size.X);
+    FParse::Value(*Params, TEXT("Height="), Size.Y);
+    float FOV = 60.0f;
+    float Yaw = 0.0f;
+    float Pitch = -15.0f;
+    FParse::Value(*Params, TEXT("FOV="), FOV);
+    FParse::Value(*Params, TEXT("Yaw="), Yaw);
+    FParse::Value(*Params, TEXT("Pitch="), Pitch);
+    if (Size.X <= 0 || Size.Y <= 0)
+    {
+        UE_LOG(LogGaussianSplatRender, Error, TEXT("Invalid image size %dx%d"), Size.X, Size.Y);
+        return 1;
+    }
+
+    TArray<FGaussianSplatData> Splats;
+    FString Error;
+    if (!FGaussianSplatDerivedData::LoadPLY(Input, Splats, Error) || Splats.Num() == 0)
+    {
+        UE_LOG(LogGaussianSplatRender, Error, TEXT("%s: %s"), *Input, Error.IsEmpty() ? TEXT("no splats") : *Error);
+        return 1;
+    }
+
+    FBox3f Bounds(ForceInit);
+    for (const FGaussianSplatData &Splat : Splats)
+        Bounds += Splat.Position;
+    const FVector Center(Bounds.GetCenter());
+    // Far enough back that the bounding sphere fits the horizontal field of view
+    float Distance = Bounds.GetExtent().Size() / FMath::Max(FMath::Tan(FMath::DegreesToRadians(FOV) * 0.5f), 0.05f);
+    FParse::Value(*Params, TEXT("Distance="), Distance);
+
+    const FRotator Rotation(Pitch, Yaw, 0.0f);
+    const FVector Location = Center - Rotation.Vector() * Distance;
+    FGaussianSplatRasterView View = FGaussianSplatRasterView::MakeLookAt(Location, Rotation, FOV, Size);
+    View.FarZ = FMath::Max(View.FarZ, Distance * 4.0f);
+
+    const double Start = FPlatformTime::Seconds();
+    TArray<FLinearColor> Pixels;
+    FGaussianSplatRasterStats Stats;
+    FGaussianSplatRasterizer::Render(View, Splats, Pixels, &Stats);
+    const double Seconds = FPlatformTime::Seconds() - Start;
+
+    // Premultiplied over black is the color itself
+    for (FLinearColor &Pixel : Pixels)
+        Pixel.A = 1.0f;
+    if (!FImageUtils::SaveImageByExtension(*Output, FImageView(Pixels.GetData(), Size.X, Size.Y)))
+    {
+        UE_LOG(LogGaussianSplatRender, Error, TEXT("Failed to write %s"), *Output);
+        return 1;
+    }
+
+    UE_LOG(LogGaussianSplatRender, Display,
+           TEXT("%s -> %s | %dx%d | %d splats, %d projected, %lld keys (%.2f per splat) | project %.1f ms, sort %.1f "
+                "ms, blend %.1f ms, total %.1f ms"),
+           *Input, *Output, Size.X, Size.Y, Splats.Num(), Stats.NumProjected, Stats.NumKeys,
+           double(Stats.NumKeys) / FMath::Max(Stats.NumProjected, 1), Stats.ProjectSeconds * 1000.0,
+           Stats.SortSeconds * 1000.0, Stats.BlendSeconds * 1000.0, Seconds * 1000.0);
+    return 0;
+}
@@ -0,0 +1,25 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "GaussianSplatRenderCommandlet.generated.h"
+
+/**
+ * Renders a splat cloud to an image with the CPU tile rasterizer (FGaussianSplatRasterizer), without a GPU or a
+ * level. The camera orbits the cloud's bounds center at -Distance (default: fits the bounds) from -Yaw and -Pitch
+ * degrees. The image is composited over black. Used to check captures headless and as the reference image for the
+ * GPU rasterizer.
+ *
+ * UnrealEditor-Cmd <Project> -run=GaussianSplatRender -Input=<file.ply> -Output=<file.png|exr>
+ *     [-Width=1280] [-Height=720] [-FOV=60] [-Yaw=0] [-Pitch=-15] [-Distance=<cm>]
+ */
+UCLASS()
+class UGaussianSplatRenderCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGaussianSplatRenderCommandlet();
+
+    virtual int32 Main(const FString &Params) override;
+};
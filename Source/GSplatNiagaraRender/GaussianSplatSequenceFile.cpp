@@ -0,0 +1,323 @@
+﻿#include "GaussianSplatSequenceFile.h"
+#include "GaussianSplatPacking.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+#include "PLYParser.h"
+#include "Serialization/Archive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatSequence, Log, All);
+
+namespace GaussianSplatSequenceFile
+{
+void SerializeHeader(FArchive &Ar, FGaussianSplatSequenceHeader &Header)
+{
+    Ar << Header.Magic;
+    Ar << Header.Version;
+    Ar << Header.NumFrames;
+    Ar << Header.MaxSplats;
+    Ar << Header.FrameRate;
+    Ar << Header.KeyframeInterval;
+}
+
+void SerializeFrame(FArchive &Ar, FGaussianSplatSequenceFrameInfo &Frame)
+{
+    Ar << Frame.DataOffset;
+    Ar << Frame.StoredSize;
+    Ar << Frame.SplatCount;
+    Ar << Frame.Flags;
+}
+
+// Payload sizes are int32 in the table and in FCompression
+constexpr int32 MaxSplatsPerFrame = MAX_int32 / sizeof(FGaussianSplatPackedRecord);
+
+// Number at the end of a file name ("frame_0042" -> 42), or INDEX_NONE
+int64 ParseTrailingNumber(const FString &BaseName, FString &OutPrefix)
+{
+    int32 DigitsStart = BaseName.Len();
+    while (DigitsStart > 0 && FChar::IsDigit(BaseName[DigitsStart - 1]))
+        --DigitsStart;
+    OutPrefix = BaseName.Left(DigitsStart);
+    if (DigitsStart == BaseName.Len())
+        return INDEX_NONE;
+    return FCString::Atoi64(*BaseName.Mid(DigitsStart));
+}
+} // namespace GaussianSplatSequenceFile
+
+void FGaussianSplatSequenceFile::FindFrameFiles(const FString &DirectoryOrFile, TArray<FString> &OutFiles)
+{
+    using namespace GaussianSplatSequenceFile;
+
+    OutFiles.Reset();
+    const bool bIsDirectory = IFileManager::Get().DirectoryExists(*DirectoryOrFile);
+    const FString Directory = bIsDirectory ? DirectoryOrFile : FPaths::GetPath(DirectoryOrFile);
+
+    // A single file selects its numbered siblings: frame_0001.ply -> frame_*.ply
+    FString RequiredPrefix;
+    if (!bIsDirectory && ParseTrailingNumber(FPaths::GetBaseFilename(DirectoryOrFile), RequiredPrefix) == INDEX_NONE)
+    {
+        OutFiles.Add(DirectoryOrFile);
+        return;
+    }
+
+    TArray<FString> Names;
+    IFileManager::Get().FindFiles(Names, *(Directory / TEXT("*.ply")), true, false);
+
+    struct FFrameFile
+    {
+        int64 Number;
+        FString Name;
+    };
+    TArray<FFrameFile> Candidates;
+    for (const FString &Name : Names)
+    {
+        FString Prefix;
+        const int64 Number = ParseTrailingNumber(FPaths::GetBaseFilename(Name), Prefix);
+        if (!bIsDirectory && (Number == INDEX_NONE || Prefix != RequiredPrefix))
+            continue;
+        Candidates.Add(FFrameFile{Number, Name});
+    }
+    Candidates.Sort([](const FFrameFile &A, const FFrameFile &B)
+                    { return A.Number != B.Number ? A.Number < B.Number : A.Name < B.Name; });
+
+    OutFiles.Reserve(Candidates.Num());
+    for (const FFrameFile &Candidate : Candidates)
+        OutFiles.Add(Directory / Candidate.Name);
+}
+
+void FGaussianSplatSequenceFile::EncodeFramePlanes(TConstArrayView<FGaussianSplatPackedRecord> Records,
+                                                   TConstArrayView<FGaussianSplatPackedRecord> Previous,
+                                                   TArray<uint32> &OutPlanes)
+{
+    const int32 N = Records.Num();
+    OutPlanes.SetNumUninitialized(N * DwordsPerRecord, EAllowShrinking::No);
+
+    const uint32 *Src = reinterpret_cast<const uint32 *>(Records.GetData());
+    const uint32 *Prev = Previous.Num() == N ? reinterpret_cast<const uint32 *>(Previous.GetData()) : nullptr;
+    uint32 *Dst = OutPlanes.GetData();
+    for (int32 i = 0; i < N; ++i)
+    {
+        for (int32 d = 0; d < DwordsPerRecord; ++d)
+        {
+            const uint32 Value = Src[i * DwordsPerRecord + d];
+            Dst[int64(d) * N + i] = Prev ? Value ^ Prev[i * DwordsPerRecord + d] : Value;
+        }
+    }
+}
+
+bool FGaussianSplatSequenceFile::ResolveFrame(const FGaussianSplatSequenceFrameInfo &Frame,
+                                              TConstArrayView<uint32> Planes,
+                                              TConstArrayView<FGaussianSplatPackedRecord> Previous,
+                                              TArray<FGaussianSplatPackedRecord> &OutRecords)
+{
+    const int32 N = Frame.SplatCount;
+    if (Planes.Num() != N * DwordsPerRecord)
+        return false;
+    if (!Frame.IsKeyframe() && Previous.Num() != N)
+        return false;
+
+    OutRecords.SetNumUninitialized(N, EAllowShrinking::No);
+    uint32 *Dst = reinterpret_cast<uint32 *>(OutRecords.GetData());
+    const uint32 *Prev = Frame.IsKeyframe() ? nullptr : reinterpret_cast<const uint32 *>(Previous.GetData());
+    const uint32 *Src = Planes.GetData();
+
+    // Splat-major so the output is written sequentially; the sixteen plane reads are each sequential too
+    for (int32 i = 0; i < N; ++i)
+    {
+        for (int32 d = 0; d < DwordsPerRecord; ++d)
+        {
+            const uint32 Value = Src[int64(d) * N + i];
+            Dst[i * DwordsPerRecord + d] = Prev ? Value ^ Prev[i * DwordsPerRecord + d] : Value;
+        }
+    }
+    return true;
+}
+
+bool FGaussianSplatSequenceFile::Write(const FString &FilePath, const TArray<FString> &PlyFiles, float FrameRate,
+                                       int32 KeyframeInterval, FString &OutError)
+{
+    using namespace GaussianSplatSequenceFile;
+
+    if (PlyFiles.Num() == 0)
+    {
+        OutError = TEXT("No frames to write");
+        return false;
+    }
+
+    FGaussianSplatSequenceHeader Header;
+    Header.NumFrames = PlyFiles.Num();
+    Header.FrameRate = FrameRate > 0.0f ? FrameRate : 30.0f;
+    Header.KeyframeInterval = FMath::Max(KeyframeInterval, 1);
+    TArray<FGaussianSplatSequenceFrameInfo> Frames;
+    Frames.SetNum(Header.NumFrames);
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        OutError = FString::Printf(TEXT("Failed to open for writing: %s"), *FilePath);
+        return false;
+    }
+
+    // Placeholder table; rewritten once the payload offsets and sizes are known
+    SerializeHeader(*Writer, Header);
+    for (FGaussianSplatSequenceFrameInfo &Frame : Frames)
+        SerializeFrame(*Writer, Frame);
+
+    TArray<FGaussianSplatData> Parsed;
+    TArray<FGaussianSplatPackedRecord> Records;
+    TArray<FGaussianSplatPackedRecord> Previous;
+    TArray<uint32> Planes;
+    TArray<uint8> Compressed;
+    int64 TotalRawBytes = 0;
+    int64 TotalStoredBytes = 0;
+    for (int32 FrameIndex = 0; FrameIndex < PlyFiles.Num(); ++FrameIndex)
+    {
+        FPLYParser Parser;
+        if (!Parser.ParseFile(PlyFiles[FrameIndex], Parsed))
+        {
+            OutError = FString::Printf(TEXT("Frame %d (%s): %s"), FrameIndex, *PlyFiles[FrameIndex],
+                                       *Parser.GetErrorMessage());
+            return false;
+        }
+        if (Parsed.Num() > MaxSplatsPerFrame)
+        {
+            OutError = FString::Printf(TEXT("Frame %d has too many splats (%d)"), FrameIndex, Parsed.Num());
+            return false;
+        }
+        FGaussianSplatPacking::PackRecords(Parsed, Records);
+
+        FGaussianSplatSequenceFrameInfo &Frame = Frames[FrameIndex];
+        Frame.SplatCount = Records.Num();
+        const bool bKeyframe = FrameIndex % Header.KeyframeInterval == 0 || Records.Num() != Previous.Num();
+        Frame.Flags = bKeyframe ? FGaussianSplatSequenceFrameInfo::Flag_Keyframe : 0;
+        EncodeFramePlanes(Records, bKeyframe ? TConstArrayView<FGaussianSplatPackedRecord>() : Previous, Planes);
+
+        const int32 RawSize = int32(Frame.GetRawSize());
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, RawSize);
+        Compressed.SetNumUninitialized(CompressedSize, EAllowShrinking::No);
+        const bool bCompressed =
+            RawSize > 0 &&
+            FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Planes.GetData(), RawSize) &&
+            CompressedSize < RawSize;
+
+        Frame.DataOffset = Writer->Tell();
+        if (bCompressed)
+        {
+            Frame.Flags |= FGaussianSplatSequenceFrameInfo::Flag_Compressed;
+            Frame.StoredSize = CompressedSize;
+            Writer->Serialize(Compressed.GetData(), CompressedSize);
+        }
+        else
+        {
+            Frame.StoredSize = RawSize;
+            Writer->Serialize(Planes.GetData(), RawSize);
+        }
+
+        Header.MaxSplats = FMath::Max(Header.MaxSplats, Frame.SplatCount);
+        TotalRawBytes += RawSize;
+        TotalStoredBytes += Frame.StoredSize;
+        Swap(Previous, Records);
+    }
+
+    Writer->Seek(0);
+    SerializeHeader(*Writer, Header);
+    for (FGaussianSplatSequenceFrameInfo &Frame : Frames)
+        SerializeFrame(*Writer, Frame);
+
+    if (!Writer->Close())
+    {
+        OutError = FString::Printf(TEXT("Failed to write: %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogGaussianSplatSequence, Log,
+           TEXT("Wrote %d frames (max %d splats, keyframe every %d) to %s | %lld MB -> %lld MB"), Header.NumFrames,
+           Header.MaxSplats, Header.KeyframeInterval, *FilePath, TotalRawBytes >> 20, TotalStoredBytes >> 20);
+    return true;
+}
+
+bool FGaussianSplatSequenceFile::ReadTable(const FString &FilePath, FGaussianSplatSequenceHeader &OutHeader,
+                                           TArray<FGaussianSplatSequenceFrameInfo> &OutFrames, FString &OutError)
+{
+    using namespace GaussianSplatSequenceFile;
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        OutError = FString::Printf(TEXT("File not found: %s"), *FilePath);
+        return false;
+    }
+
+    SerializeHeader(*Reader, OutHeader);
+    if (Reader->IsError() || OutHeader.Magic != FGaussianSplatSequenceHeader::MagicValue)
+    {
+        OutError = TEXT("Invalid splat sequence: bad magic");
+        return false;
+    }
+    if (OutHeader.Version != FGaussianSplatSequenceHeader::CurrentVersion)
+    {
+        OutError = FString::Printf(TEXT("Unsupported splat sequence version %u"), OutHeader.Version);
+        return false;
+    }
+    if (OutHeader.NumFrames <= 0 || OutHeader.MaxSplats < 0 || OutHeader.MaxSplats > MaxSplatsPerFrame ||
+        OutHeader.FrameRate <= 0.0f)
+    {
+        OutError = TEXT("Invalid splat sequence: corrupt header");
+        return false;
+    }
+
+    OutFrames.SetNum(OutHeader.NumFrames);
+    for (FGaussianSplatSequenceFrameInfo &Frame : OutFrames)
+        SerializeFrame(*Reader, Frame);
+
+    if (Reader->IsError())
+    {
+        OutError = TEXT("Invalid splat sequence: truncated frame table");
+        return false;
+    }
+
+    const int64 FileSize = Reader->TotalSize();
+    for (int32 i = 0; i < OutFrames.Num(); ++i)
+    {
+        const FGaussianSplatSequenceFrameInfo &Frame = OutFrames[i];
+        const bool bSizeValid = Frame.IsCompressed() ? Frame.StoredSize >= 0 : Frame.StoredSize == Frame.GetRawSize();
+        if (Frame.SplatCount < 0 || Frame.SplatCount > OutHeader.MaxSplats || !bSizeValid ||
+            Frame.DataOffset + Frame.StoredSize > FileSize)
+        {
+            OutError = FString::Printf(TEXT("Invalid splat sequence: frame %d out of range"), i);
+            return false;
+        }
+        // The first frame has nothing to be a delta of
+        if (i == 0 && !Frame.IsKeyframe())
+        {
+            OutError = TEXT("Invalid splat sequence: first frame is not a keyframe");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FGaussianSplatSequenceFile::ReadFramePlanes(const FString &FilePath, const FGaussianSplatSequenceFrameInfo &Frame,
+                                                 TArray<uint32> &OutPlanes)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+        return false;
+
+    const int32 RawSize = int32(Frame.GetRawSize());
+    OutPlanes.SetNumUninitialized(Frame.SplatCount * DwordsPerRecord, EAllowShrinking::No);
+    Reader->Seek(Frame.DataOffset);
+    if (!Frame.IsCompressed())
+    {
+        Reader->Serialize(OutPlanes.GetData(), RawSize);
+        return !Reader->IsError();
+    }
+
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(Frame.StoredSize);
+    Reader->Serialize(Compressed.GetData(), Frame.StoredSize);
+    if (Reader->IsError())
+        return false;
+    return FCompression::UncompressMemory(NAME_Oodle, OutPlanes.GetData(), RawSize, Compressed.GetData(),
+                                          Frame.StoredSize);
+}
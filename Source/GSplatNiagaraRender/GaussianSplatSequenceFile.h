@@ -0,0 +1,92 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+/**
+ * On-disk container for animated splat sequences (one splat cloud per frame).
+ *
+ * File layout:
+ *   FGaussianSplatSequenceHeader
+ *   FGaussianSplatSequenceFrameInfo[NumFrames]
+ *   frame payloads
+ *
+ * A payload is the frame's packed records transposed into sixteen dword planes (every splat's first dword, then
+ * every splat's second, ...). Delta frames XOR each dword with the previous frame's, so splats that did not move
+ * become runs of zero bits, and the planes are then Oodle-compressed. Keyframes are stored without the XOR every
+ * KeyframeInterval frames and whenever the splat count changes, so decoding can start there.
+ */
+struct FGaussianSplatSequenceHeader
+{
+    static constexpr uint32 MagicValue = 0x51535347; // 'GSSQ'
+    static constexpr uint32 CurrentVersion = 1;
+
+    uint32 Magic = MagicValue;
+    uint32 Version = CurrentVersion;
+    int32 NumFrames = 0;
+    int32 MaxSplats = 0; // largest frame, so a player can size its buffers once
+    float FrameRate = 30.0f;
+    int32 KeyframeInterval = 0;
+};
+
+struct FGaussianSplatSequenceFrameInfo
+{
+    enum EFlags : uint32
+    {
+        Flag_Keyframe = 1 << 0,
+        Flag_Compressed = 1 << 1,
+    };
+
+    int64 DataOffset = 0; // absolute byte offset of the payload
+    int32 StoredSize = 0; // payload bytes on disk
+    int32 SplatCount = 0;
+    uint32 Flags = 0;
+
+    bool IsKeyframe() const
+    {
+        return (Flags & Flag_Keyframe) != 0;
+    }
+
+    bool IsCompressed() const
+    {
+        return (Flags & Flag_Compressed) != 0;
+    }
+
+    int64 GetRawSize() const
+    {
+        return int64(SplatCount) * sizeof(FGaussianSplatPackedRecord);
+    }
+};
+
+class GSPLATNIAGARARENDER_API FGaussianSplatSequenceFile
+{
+public:
+    static constexpr int32 DefaultKeyframeInterval = 30;
+    static constexpr int32 DwordsPerRecord = sizeof(FGaussianSplatPackedRecord) / sizeof(uint32);
+
+    // Collects the frames of a sequence: every .ply in a directory, or the numbered siblings of a single .ply,
+    // ordered by the number at the end of the file name
+    static void FindFrameFiles(const FString &DirectoryOrFile, TArray<FString> &OutFiles);
+
+    // Parses each PLY in order and writes the container. Only two frames are held in memory at a time.
+    static bool Write(const FString &FilePath, const TArray<FString> &PlyFiles, float FrameRate,
+                      int32 KeyframeInterval, FString &OutError);
+
+    // Reads the header and frame table only
+    static bool ReadTable(const FString &FilePath, FGaussianSplatSequenceHeader &OutHeader,
+                          TArray<FGaussianSplatSequenceFrameInfo> &OutFrames, FString &OutError);
+
+    // Decoding is split so the expensive half can run out of order. ReadFramePlanes loads and decompresses one
+    // payload and depends on nothing else; ResolveFrame undoes the delta and needs the previous frame's records.
+    // Both are thread safe.
+    static bool ReadFramePlanes(const FString &FilePath, const FGaussianSplatSequenceFrameInfo &Frame,
+                                TArray<uint32> &OutPlanes);
+    // Returns false for a delta frame whose previous frame does not match in size.
+    static bool ResolveFrame(const FGaussianSplatSequenceFrameInfo &Frame, TConstArrayView<uint32> Planes,
+                             TConstArrayView<FGaussianSplatPackedRecord> Previous,
+                             TArray<FGaussianSplatPackedRecord> &OutRecords);
+
+    // Inverse of ResolveFrame. Previous is empty for keyframes.
+    static void EncodeFramePlanes(TConstArrayView<FGaussianSplatPackedRecord> Records,
+                                  TConstArrayView<FGaussianSplatPackedRecord> Previous, TArray<uint32> &OutPlanes);
+};
@@ -0,0 +1,182 @@
+﻿#include "GaussianSplatSequencePlayer.h"
+#include "GaussianSplatStats.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatSequencePlayer, Log, All);
+
+FGaussianSplatSequencePlayer::FGaussianSplatSequencePlayer() {}
+
+FGaussianSplatSequencePlayer::~FGaussianSplatSequencePlayer()
+{
+    Close();
+}
+
+bool FGaussianSplatSequencePlayer::Open(const FString &FilePath, const FGaussianSplatSequenceSettings &InSettings,
+                                        FString &OutError)
+{
+    Close();
+
+    if (!FGaussianSplatSequenceFile::ReadTable(FilePath, Header, Frames, OutError))
+    {
+        Frames.Empty();
+        return false;
+    }
+
+    Path = FilePath;
+    Settings = InSettings;
+    Settings.RingSize = FMath::Max(Settings.RingSize, 1);
+    Stats = FGaussianSplatSequenceStats();
+    NextDecodeFrame = INDEX_NONE;
+
+    UE_LOG(LogGaussianSplatSequencePlayer, Log, TEXT("Opened %s | Frames=%d | MaxSplats=%d | %.1f fps | Ring=%d"),
+           *FilePath, Frames.Num(), Header.MaxSplats, Header.FrameRate, Settings.RingSize);
+    return true;
+}
+
+void FGaussianSplatSequencePlayer::Close()
+{
+    // Decode tasks only touch memory they hold references to, but waiting keeps file handles from outliving us
+    Flush();
+    Queue.Empty();
+    Frames.Empty();
+    ChainTail.Reset();
+    ChainTailTask = UE::Tasks::FTask();
+    NextDecodeFrame = INDEX_NONE;
+    PresentedFrame = INDEX_NONE;
+}
+
+void FGaussianSplatSequencePlayer::Flush()
+{
+    for (FQueuedFrame &Queued : Queue)
+        Queued.Task.Wait();
+    ChainTailTask.Wait();
+}
+
+int32 FGaussianSplatSequencePlayer::ToFileFrame(int64 PlayFrame) const
+{
+    const int64 NumFrames = FMath::Max(Frames.Num(), 1);
+    if (Settings.bLoop)
+        return int32(((PlayFrame % NumFrames) + NumFrames) % NumFrames);
+    return int32(FMath::Clamp<int64>(PlayFrame, 0, NumFrames - 1));
+}
+
+int64 FGaussianSplatSequencePlayer::GetKeyframeStart(int64 PlayFrame) const
+{
+    // Frame 0 is always a keyframe, so the walk never crosses into the previous loop
+    const int32 FileFrame = ToFileFrame(PlayFrame);
+    int32 KeyFrame = FileFrame;
+    while (KeyFrame > 0 && !Frames[KeyFrame].IsKeyframe())
+        --KeyFrame;
+    return PlayFrame - (FileFrame - KeyFrame);
+}
+
+void FGaussianSplatSequencePlayer::Restart(int64 PlayFrame)
+{
+    ++Stats.Seeks;
+    // In-flight decodes finish on their own; their results are simply never presented
+    Queue.Reset();
+    ChainTail.Reset();
+    ChainTailTask = UE::Tasks::FTask();
+    NextDecodeFrame = GetKeyframeStart(PlayFrame);
+    PresentedFrame = INDEX_NONE;
+}
+
+void FGaussianSplatSequencePlayer::IssueDecode(int64 PlayFrame)
+{
+    const int32 FileFrame = ToFileFrame(PlayFrame);
+    const FGaussianSplatSequenceFrameInfo Info = Frames[FileFrame];
+
+    TSharedRef<FGaussianSplatSequenceFrame, ESPMode::ThreadSafe> Frame =
+        MakeShared<FGaussianSplatSequenceFrame, ESPMode::ThreadSafe>();
+    Frame->PlayFrame = PlayFrame;
+    Frame->FileFrame = FileFrame;
+
+    // Stage 1 has no dependencies, so a full ring decompresses in parallel
+    TSharedRef<TArray<uint32>, ESPMode::ThreadSafe> Planes = MakeShared<TArray<uint32>, ESPMode::ThreadSafe>();
+    UE::Tasks::FTask ReadTask = UE::Tasks::Launch(
+        UE_SOURCE_LOCATION,
+        [Path = Path, Info, Planes]()
+        {
+            GSPLAT_SCOPE(Decode);
+            LLM_SCOPE_BYTAG(GaussianSplat);
+            if (!FGaussianSplatSequenceFile::ReadFramePlanes(Path, Info, *Planes))
+                Planes->Empty();
+        });
+
+    // Stage 2 is serial along the delta chain
+    TSharedPtr<FGaussianSplatSequenceFrame, ESPMode::ThreadSafe> Previous = Info.IsKeyframe() ? nullptr : ChainTail;
+    UE::Tasks::FTask ResolveTask = UE::Tasks::Launch(
+        UE_SOURCE_LOCATION,
+        [Info, Planes, Frame, Previous]() mutable
+        {
+            GSPLAT_SCOPE(Decode);
+            LLM_SCOPE_BYTAG(GaussianSplat);
+            TConstArrayView<FGaussianSplatPackedRecord> PreviousRecords;
+            if (Previous && Previous->bValid)
+                PreviousRecords = Previous->Records;
+            Frame->bValid = FGaussianSplatSequenceFile::ResolveFrame(Info, *Planes, PreviousRecords, Frame->Records);
+            // Release the previous frame as soon as it is no longer needed instead of when the task is destroyed
+            Previous.Reset();
+            Planes->Empty();
+        },
+        UE::Tasks::Prerequisites(ReadTask, ChainTailTask));
+
+    ChainTail = Frame;
+    ChainTailTask = ResolveTask;
+    Queue.Add(FQueuedFrame{Frame, ResolveTask});
+    Stats.BytesRead += Info.StoredSize;
+}
+
+FGaussianSplatSequenceFrameRef FGaussianSplatSequencePlayer::Update(int64 PlayFrame)
+{
+    if (!IsOpen())
+        return nullptr;
+
+    PlayFrame = Settings.bLoop ? FMath::Max<int64>(PlayFrame, 0)
+                               : FMath::Clamp<int64>(PlayFrame, 0, Frames.Num() - 1);
+
+    if (NextDecodeFrame == INDEX_NONE)
+    {
+        NextDecodeFrame = GetKeyframeStart(PlayFrame);
+    }
+    else
+    {
+        // Backwards, or so far ahead that restarting at the wanted frame's keyframe beats decoding the gap
+        const int64 QueueStart = Queue.Num() > 0 ? Queue[0].Frame->PlayFrame : NextDecodeFrame;
+        const bool bBackwards = PresentedFrame != INDEX_NONE ? PlayFrame < PresentedFrame : PlayFrame < QueueStart;
+        const bool bFarAhead =
+            PlayFrame >= NextDecodeFrame + Settings.RingSize && GetKeyframeStart(PlayFrame) > NextDecodeFrame;
+        if (bBackwards || bFarAhead)
+            Restart(PlayFrame);
+    }
+
+    // Everything finished up to the playhead is consumed; only the newest of it is worth presenting
+    FGaussianSplatSequenceFrameRef Result;
+    int32 NumConsumed = 0;
+    while (NumConsumed < Queue.Num() && Queue[NumConsumed].Frame->PlayFrame <= PlayFrame &&
+           Queue[NumConsumed].Task.IsCompleted())
+    {
+        const FGaussianSplatSequenceFrame &Frame = *Queue[NumConsumed].Frame;
+        ++Stats.FramesDecoded;
+        if (Frame.bValid)
+            Result = Queue[NumConsumed].Frame;
+        else
+            ++Stats.DecodeErrors;
+        ++NumConsumed;
+    }
+    Queue.RemoveAt(0, NumConsumed, EAllowShrinking::No);
+
+    // Keep the ring full. Without looping, decoding stops at the last frame.
+    while (Queue.Num() < Settings.RingSize && (Settings.bLoop || NextDecodeFrame < Frames.Num()))
+        IssueDecode(NextDecodeFrame++);
+
+    if (Result && Result->PlayFrame <= PresentedFrame)
+        Result.Reset();
+    if (Result)
+    {
+        PresentedFrame = Result->PlayFrame;
+        ++Stats.FramesPresented;
+    }
+    if (PresentedFrame < PlayFrame)
+        ++Stats.LateUpdates;
+    return Result;
+}
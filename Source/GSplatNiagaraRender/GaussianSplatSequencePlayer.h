@@ -0,0 +1,111 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+#include "GaussianSplatSequenceFile.h"
+#include "Tasks/Task.h"
+
+struct FGaussianSplatSequenceSettings
+{
+    // Frames decoded ahead of the playhead. Each holds MaxSplats packed records.
+    int32 RingSize = 4;
+
+    // Play frames past the end as frame % NumFrames; otherwise hold the last frame
+    bool bLoop = true;
+};
+
+struct FGaussianSplatSequenceStats
+{
+    // Cumulative since Open
+    int64 FramesDecoded = 0;
+    int64 FramesPresented = 0;
+    int64 BytesRead = 0;
+    // Updates where the wanted frame had not finished decoding and an older one was shown instead
+    int64 LateUpdates = 0;
+    int32 Seeks = 0;
+    int32 DecodeErrors = 0;
+};
+
+// A decoded frame, shared read-only between the player and the render thread upload that consumes it
+struct FGaussianSplatSequenceFrame
+{
+    int64 PlayFrame = 0; // unwrapped frame number; the file frame is PlayFrame % NumFrames when looping
+    int32 FileFrame = 0;
+    TArray<FGaussianSplatPackedRecord> Records;
+    bool bValid = false;
+};
+using FGaussianSplatSequenceFrameRef = TSharedPtr<const FGaussianSplatSequenceFrame, ESPMode::ThreadSafe>;
+
+/**
+ * Plays a FGaussianSplatSequenceFile by decoding frames ahead of the playhead on the task graph.
+ *
+ * Each frame is two tasks: a read + decompress that runs as soon as a worker is free, and a delta resolve that
+ * waits for its read and for the previous frame's resolve. RingSize frames are in flight or waiting to be
+ * presented at once. Update never blocks: if the wanted frame is not ready, the newest older frame is returned
+ * and playback catches up on a later call. Like FGaussianSplatStreamingManager it owns no GPU resources, so it
+ * can be driven headless. Game thread only.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatSequencePlayer
+{
+public:
+    FGaussianSplatSequencePlayer();
+    ~FGaussianSplatSequencePlayer();
+
+    bool Open(const FString &FilePath, const FGaussianSplatSequenceSettings &InSettings, FString &OutError);
+    void Close();
+
+    bool IsOpen() const
+    {
+        return Frames.Num() > 0;
+    }
+
+    // Moves the playhead to PlayFrame, keeps the ring full behind it and returns a frame to present when one
+    // newer than the last returned has finished decoding. Seeking backwards or far ahead restarts decoding at the
+    // preceding keyframe.
+    FGaussianSplatSequenceFrameRef Update(int64 PlayFrame);
+
+    // Blocks until every queued decode has finished
+    void Flush();
+
+    int32 GetNumFrames() const
+    {
+        return Frames.Num();
+    }
+
+    const FGaussianSplatSequenceHeader &GetHeader() const
+    {
+        return Header;
+    }
+
+    const FGaussianSplatSequenceStats &GetStats() const
+    {
+        return Stats;
+    }
+
+    int32 ToFileFrame(int64 PlayFrame) const;
+
+private:
+    struct FQueuedFrame
+    {
+        TSharedRef<FGaussianSplatSequenceFrame, ESPMode::ThreadSafe> Frame;
+        UE::Tasks::FTask Task;
+    };
+
+    void Restart(int64 PlayFrame);
+    void IssueDecode(int64 PlayFrame);
+    int64 GetKeyframeStart(int64 PlayFrame) const;
+
+    FString Path;
+    FGaussianSplatSequenceSettings Settings;
+    FGaussianSplatSequenceHeader Header;
+    TArray<FGaussianSplatSequenceFrameInfo> Frames;
+    // Decode order == play order
+    TArray<FQueuedFrame> Queue;
+    // INDEX_NONE until the first Update picks the starting keyframe
+    int64 NextDecodeFrame = INDEX_NONE;
+    int64 PresentedFrame = INDEX_NONE;
+    // Tail of the delta chain the next issued frame resolves against
+    TSharedPtr<FGaussianSplatSequenceFrame, ESPMode::ThreadSafe> ChainTail;
+    UE::Tasks::FTask ChainTailTask;
+    FGaussianSplatSequenceStats Stats;
+};
@@ -0,0 +1,237 @@
+﻿#include "GaussianSplatSpatialGrid.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "GaussianSplatStats.h"
+
+void FGaussianSplatSpatialGrid::Build(TConstArrayView<FGaussianSplatData> Splats, int32 TargetSplatsPerCell)
+{
+    GSPLAT_SCOPE(BuildSpatialGrid);
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    Reset();
+    const int32 NumSplats = Splats.Num();
+    if (NumSplats == 0)
+        return;
+
+    constexpr int32 ChunkSize = 16384;
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumSplats, ChunkSize);
+
+    TArray<FBox3f> ChunkBounds;
+    ChunkBounds.Init(FBox3f(ForceInit), NumChunks);
+    ParallelFor(TEXT("GaussianSplat.GridBounds"), NumChunks, 1,
+                [&](int32 Chunk)
+                {
+                    const int32 Last = FMath::Min((Chunk + 1) * ChunkSize, NumSplats);
+                    for (int32 i = Chunk * ChunkSize; i < Last; ++i)
+                        ChunkBounds[Chunk] += Splats[i].Position;
+                });
+    FBox3f Bounds(ForceInit);
+    for (const FBox3f &Box : ChunkBounds)
+        Bounds += Box;
+
+    // Cubic cells holding TargetSplatsPerCell on average. Axes shorter than a cell do not divide the volume, so flat
+    // and thin clouds get cells sized over the axes they actually span.
+    const FVector3f Extent = Bounds.GetSize().ComponentMax(FVector3f(UE_KINDA_SMALL_NUMBER));
+    const double TargetCells = FMath::Max(double(NumSplats) / FMath::Max(TargetSplatsPerCell, 1), 1.0);
+    CellSize = 0.0f;
+    for (int32 Pass = 0; Pass < 3; ++Pass)
+    {
+        double Volume = 1.0;
+        int32 NumAxes = 0;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (Extent[Axis] >= CellSize)
+            {
+                Volume *= Extent[Axis];
+                ++NumAxes;
+            }
+        }
+        CellSize = NumAxes > 0 ? float(FMath::Pow(Volume / TargetCells, 1.0 / NumAxes)) : Extent.GetMax();
+    }
+    CellSize = FMath::Max(CellSize, Extent.GetMax() / MaxDimsPerAxis);
+    InvCellSize = 1.0f / CellSize;
+    Origin = Bounds.Min;
+    Dims = FIntVector(FMath::Clamp(FMath::FloorToInt32(Extent.X * InvCellSize) + 1, 1, MaxDimsPerAxis),
+                      FMath::Clamp(FMath::FloorToInt32(Extent.Y * InvCellSize) + 1, 1, MaxDimsPerAxis),
+                      FMath::Clamp(FMath::FloorToInt32(Extent.Z * InvCellSize) + 1, 1, MaxDimsPerAxis));
+    const int32 NumCells = Dims.X * Dims.Y * Dims.Z;
+
+    // Counting sort: count per cell, prefix sum, scatter. Scattering races within a cell, so each cell is sorted
+    // by index afterwards to keep the layout deterministic.
+    TArray<int32> SplatCells;
+    SplatCells.SetNumUninitialized(NumSplats);
+    TArray<int32> Cursors;
+    Cursors.SetNumZeroed(NumCells);
+    ParallelFor(TEXT("GaussianSplat.GridCount"), NumChunks, 1,
+                [&](int32 Chunk)
+                {
+                    const int32 Last = FMath::Min((Chunk + 1) * ChunkSize, NumSplats);
+                    for (int32 i = Chunk * ChunkSize; i < Last; ++i)
+                    {
+                        SplatCells[i] = GetCellIndex(ClampCell(GetCell(Splats[i].Position)));
+                        FPlatformAtomics::InterlockedIncrement(&Cursors[SplatCells[i]]);
+                    }
+                });
+
+    CellStarts.SetNumUninitialized(NumCells + 1);
+    uint32 Running = 0;
+    for (int32 Cell = 0; Cell < NumCells; ++Cell)
+    {
+        CellStarts[Cell] = Running;
+        Running += uint32(Cursors[Cell]);
+        Cursors[Cell] = int32(CellStarts[Cell]);
+    }
+    CellStarts[NumCells] = Running;
+
+    SortedIndices.SetNumUninitialized(NumSplats);
+    ParallelFor(TEXT("GaussianSplat.GridScatter"), NumChunks, 1,
+                [&](int32 Chunk)
+                {
+                    const int32 Last = FMath::Min((Chunk + 1) * ChunkSize, NumSplats);
+                    for (int32 i = Chunk * ChunkSize; i < Last; ++i)
+                        SortedIndices[FPlatformAtomics::InterlockedAdd(&Cursors[SplatCells[i]], 1)] = i;
+                });
+
+    SortedPositions.SetNumUninitialized(NumSplats);
+    constexpr int32 CellsPerBatch = 1024;
+    ParallelFor(TEXT("GaussianSplat.GridSort"), FMath::DivideAndRoundUp(NumCells, CellsPerBatch), 1,
+                [&](int32 Batch)
+                {
+                    const int32 LastCell = FMath::Min((Batch + 1) * CellsPerBatch, NumCells);
+                    for (int32 Cell = Batch * CellsPerBatch; Cell < LastCell; ++Cell)
+                    {
+                        const int32 Start = int32(CellStarts[Cell]);
+                        const int32 Count = int32(CellStarts[Cell + 1]) - Start;
+                        Algo::Sort(MakeArrayView(SortedIndices.GetData() + Start, Count));
+                        for (int32 Slot = Start; Slot < Start + Count; ++Slot)
+                            SortedPositions[Slot] = Splats[SortedIndices[Slot]].Position;
+                    }
+                });
+}
+
+void FGaussianSplatSpatialGrid::Reset()
+{
+    Origin = FVector3f::ZeroVector;
+    CellSize = 1.0f;
+    InvCellSize = 1.0f;
+    Dims = FIntVector::ZeroValue;
+    CellStarts.Empty();
+    SortedIndices.Empty();
+    SortedPositions.Empty();
+}
+
+int32 FGaussianSplatSpatialGrid::CountInRadius(const FVector3f &Center, float Radius, int32 MaxCount) const
+{
+    int32 Count = 0;
+    if (MaxCount > 0)
+        ForEachInRadius(Center, Radius, [&](uint32) { return ++Count < MaxCount; });
+    return Count;
+}
+
+int32 FGaussianSplatSpatialGrid::GetInRadius(const FVector3f &Center, float Radius, int32 Nth) const
+{
+    int32 Found = INDEX_NONE;
+    if (Nth >= 0)
+    {
+        int32 Seen = 0;
+        ForEachInRadius(Center, Radius,
+                        [&](uint32 Slot)
+                        {
+                            if (Seen++ < Nth)
+                                return true;
+                            Found = SortedIndices[Slot];
+                            return false;
+                        });
+    }
+    return Found;
+}
+
+int32 FGaussianSplatSpatialGrid::FindInRadius(const FVector3f &Center, float Radius, int32 MaxCount,
+                                              TArray<int32> &OutIndices) const
+{
+    int32 Count = 0;
+    if (MaxCount > 0)
+    {
+        ForEachInRadius(Center, Radius,
+                        [&](uint32 Slot)
+                        {
+                            OutIndices.Add(SortedIndices[Slot]);
+                            return ++Count < MaxCount;
+                        });
+    }
+    return Count;
+}
+
+int32 FGaussianSplatSpatialGrid::FindNearest(const FVector3f &Position, float MaxDistance, float *OutDistance) const
+{
+    int32 Best = INDEX_NONE;
+    float BestDistSq = MaxDistance > 0.0f ? MaxDistance * MaxDistance : UE_MAX_FLT;
+    if (!IsEmpty())
+    {
+        // Grow shells of cells around the query's cell until the next shell cannot hold anything closer. Every
+        // cell of shell Ring is at least Ring - 1 cells away.
+        const FIntVector Center = GetCell(Position);
+        int32 MaxRing = 0;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+            MaxRing = FMath::Max(MaxRing, FMath::Max(Center[Axis], Dims[Axis] - 1 - Center[Axis]));
+        if (MaxDistance > 0.0f)
+            MaxRing = FMath::Min(MaxRing, FMath::CeilToInt32(FMath::Min(MaxDistance * InvCellSize, 1.0e6f)) + 1);
+
+        for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+        {
+            const float MinDist = float(FMath::Max(Ring - 1, 0)) * CellSize;
+            if (MinDist * MinDist > BestDistSq)
+                break;
+            for (int32 DZ = -Ring; DZ <= Ring; ++DZ)
+            {
+                const int32 Z = Center.Z + DZ;
+                if (Z < 0 || Z >= Dims.Z)
+                    continue;
+                for (int32 DY = -Ring; DY <= Ring; ++DY)
+                {
+                    const int32 Y = Center.Y + DY;
+                    if (Y < 0 || Y >= Dims.Y)
+                        continue;
+                    // Inside the shell's Y/Z faces only its two X caps belong to it
+                    const bool bFace = FMath::Abs(DZ) == Ring || FMath::Abs(DY) == Ring;
+                    const int32 Step = bFace ? 1 : 2 * Ring;
+                    for (int32 DX = -Ring; DX <= Ring; DX += Step)
+                    {
+                        const int32 X = Center.X + DX;
+                        if (X < 0 || X >= Dims.X)
+                            continue;
+                        const int32 Cell = GetCellIndex(FIntVector(X, Y, Z));
+                        for (uint32 Slot = CellStarts[Cell]; Slot < CellStarts[Cell + 1]; ++Slot)
+                        {
+                            const float DistSq = FVector3f::DistSquared(SortedPositions[Slot], Position);
+                            const int32 Index = SortedIndices[Slot];
+                            if (DistSq < BestDistSq || (DistSq == BestDistSq && (Best == INDEX_NONE || Index < Best)))
+                            {
+                                BestDistSq = DistSq;
+                                Best = Index;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if (OutDistance)
+        *OutDistance = Best != INDEX_NONE ? FMath::Sqrt(BestDistSq) : 0.0f;
+    return Best;
+}
+
+void FGaussianSplatSpatialGrid::PackSplats(TArray<FVector4f> &OutPacked) const
+{
+    OutPacked.SetNumUninitialized(Num());
+    for (int32 Slot = 0; Slot < Num(); ++Slot)
+    {
+        float IndexBits;
+        FMemory::Memcpy(&IndexBits, &SortedIndices[Slot], sizeof(float));
+        OutPacked[Slot] = FVector4f(SortedPositions[Slot], IndexBits);
+    }
+}
+
+SIZE_T FGaussianSplatSpatialGrid::GetAllocatedSize() const
+{
+    return CellStarts.GetAllocatedSize() + SortedIndices.GetAllocatedSize() + SortedPositions.GetAllocatedSize();
+}
@@ -0,0 +1,105 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+/**
+ * Uniform grid over splat centres for radius and nearest-neighbour queries, in the space the splats are stored in.
+ * Splats are counting-sorted by cell, so each cell is a contiguous run of SortedIndices/SortedPositions between
+ * CellStarts[Cell] and CellStarts[Cell + 1]. Cells are cubes sized for about TargetSplatsPerCell splats each.
+ *
+ * Queries visit cells in Z, Y, X order and each cell's splats in ascending index order, which is also the order
+ * the HLSL in UGaussianSplatNiagaraDataInterface walks the uploaded copy, so both return the same splats.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatSpatialGrid
+{
+public:
+    // Per axis, so a flat or thin cloud cannot blow up the cell count
+    static constexpr int32 MaxDimsPerAxis = 256;
+
+    void Build(TConstArrayView<FGaussianSplatData> Splats, int32 TargetSplatsPerCell = 8);
+    void Reset();
+
+    bool IsEmpty() const
+    {
+        return SortedIndices.Num() == 0;
+    }
+
+    int32 Num() const
+    {
+        return SortedIndices.Num();
+    }
+
+    // Splats within Radius of Center, stopping at MaxCount
+    int32 CountInRadius(const FVector3f &Center, float Radius, int32 MaxCount) const;
+
+    // The Nth splat CountInRadius counts, INDEX_NONE past the end
+    int32 GetInRadius(const FVector3f &Center, float Radius, int32 Nth) const;
+
+    // Appends up to MaxCount splat indices to OutIndices; returns how many were added
+    int32 FindInRadius(const FVector3f &Center, float Radius, int32 MaxCount, TArray<int32> &OutIndices) const;
+
+    // Closest splat to Position no further than MaxDistance (unbounded when <= 0), INDEX_NONE if none. Ties go to
+    // the lower index.
+    int32 FindNearest(const FVector3f &Position, float MaxDistance, float *OutDistance = nullptr) const;
+
+    // float4 per sorted splat for the GPU: centre in XYZ, splat index bits in W
+    void PackSplats(TArray<FVector4f> &OutPacked) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+    FVector3f Origin = FVector3f::ZeroVector;
+    float CellSize = 1.0f;
+    float InvCellSize = 1.0f;
+    FIntVector Dims = FIntVector::ZeroValue;
+    // NumCells + 1 entries
+    TArray<uint32> CellStarts;
+    TArray<int32> SortedIndices;
+    TArray<FVector3f> SortedPositions;
+
+private:
+    // Calls Visit(SortedSlot) for every splat within Radius until it returns false
+    template <typename VisitorType> void ForEachInRadius(const FVector3f &Center, float Radius, VisitorType Visit) const
+    {
+        if (IsEmpty() || !(Radius >= 0.0f))
+            return;
+        const FIntVector First = GetCell(Center - FVector3f(Radius));
+        const FIntVector Last = GetCell(Center + FVector3f(Radius));
+        if (Last.X < 0 || Last.Y < 0 || Last.Z < 0 || First.X >= Dims.X || First.Y >= Dims.Y || First.Z >= Dims.Z)
+            return;
+        const FIntVector Min = ClampCell(First);
+        const FIntVector Max = ClampCell(Last);
+        const float RadiusSq = Radius * Radius;
+        for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+            for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+                for (int32 X = Min.X; X <= Max.X; ++X)
+                {
+                    const int32 Cell = GetCellIndex(FIntVector(X, Y, Z));
+                    for (uint32 Slot = CellStarts[Cell]; Slot < CellStarts[Cell + 1]; ++Slot)
+                    {
+                        if (FVector3f::DistSquared(SortedPositions[Slot], Center) <= RadiusSq && !Visit(Slot))
+                            return;
+                    }
+                }
+    }
+
+    // Positions outside the grid land one cell past its edge, so far-away queries cannot overflow
+    FIntVector GetCell(const FVector3f &Position) const
+    {
+        const FVector3f Local = (Position - Origin) * InvCellSize;
+        return FIntVector(FMath::FloorToInt32(FMath::Clamp(Local.X, -1.0f, float(Dims.X))),
+                          FMath::FloorToInt32(FMath::Clamp(Local.Y, -1.0f, float(Dims.Y))),
+                          FMath::FloorToInt32(FMath::Clamp(Local.Z, -1.0f, float(Dims.Z))));
+    }
+
+    FIntVector ClampCell(const FIntVector &Cell) const
+    {
+        return FIntVector(FMath::Clamp(Cell.X, 0, Dims.X - 1), FMath::Clamp(Cell.Y, 0, Dims.Y - 1),
+                          FMath::Clamp(Cell.Z, 0, Dims.Z - 1));
+    }
+
+    int32 GetCellIndex(const FIntVector &Cell) const
+    {
+        return (Cell.Z * Dims.Y + Cell.Y) * Dims.X + Cell.X;
+    }
+};
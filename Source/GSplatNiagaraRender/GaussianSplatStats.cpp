@@ -0,0 +1,24 @@
+﻿#include "GaussianSplatStats.h"
+
+DEFINE_STAT(STAT_GaussianSplat_FileRead);
+DEFINE_STAT(STAT_GaussianSplat_HeaderParse);
+DEFINE_STAT(STAT_GaussianSplat_Decode);
+DEFINE_STAT(STAT_GaussianSplat_Convert);
+DEFINE_STAT(STAT_GaussianSplat_Cleanup);
+DEFINE_STAT(STAT_GaussianSplat_Pack);
+DEFINE_STAT(STAT_GaussianSplat_BuildCPUData);
+DEFINE_STAT(STAT_GaussianSplat_BuildSpatialGrid);
+DEFINE_STAT(STAT_GaussianSplat_Upload);
+DEFINE_STAT(STAT_GaussianSplat_InitPerInstance);
+DEFINE_STAT(STAT_GaussianSplat_Cull);
+DEFINE_STAT(STAT_GaussianSplat_Raster);
+
+DEFINE_STAT(STAT_GaussianSplat_LoadedSplats);
+DEFINE_STAT(STAT_GaussianSplat_CPUMemory);
+DEFINE_STAT(STAT_GaussianSplat_GPUMemory);
+
+DEFINE_STAT(STAT_GaussianSplat_UploadedBytes);
+DEFINE_STAT(STAT_GaussianSplat_PendingUploadSplats);
+DEFINE_STAT(STAT_GaussianSplat_TimeToResidency);
+
+LLM_DEFINE_TAG(GaussianSplat);
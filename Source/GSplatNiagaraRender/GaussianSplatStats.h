@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("GaussianSplat"), STATGROUP_GaussianSplat, STATCAT_Advanced);
+
+// Load path, in the order a cloud goes through it
+DECLARE_CYCLE_STAT_EXTERN(TEXT("File Read"), STAT_GaussianSplat_FileRead, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Header Parse"), STAT_GaussianSplat_HeaderParse, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decode"), STAT_GaussianSplat_Decode, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Convert"), STAT_GaussianSplat_Convert, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cleanup"), STAT_GaussianSplat_Cleanup, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pack"), STAT_GaussianSplat_Pack, STATGROUP_GaussianSplat, GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build CPU Data"), STAT_GaussianSplat_BuildCPUData, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Spatial Grid"), STAT_GaussianSplat_BuildSpatialGrid, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Upload"), STAT_GaussianSplat_Upload, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Init Per Instance"), STAT_GaussianSplat_InitPerInstance, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+// Per frame: the CPU fallback of view culling
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cull"), STAT_GaussianSplat_Cull, STATGROUP_GaussianSplat, GSPLATNIAGARARENDER_API);
+// One FGaussianSplatRasterizer::Render; the GPU rasterizer shows up under the GaussianSplatRaster draw event
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Raster (CPU)"), STAT_GaussianSplat_Raster, STATGROUP_GaussianSplat,
+                          GSPLATNIAGARARENDER_API);
+
+// Sums over every live NDI; each one adds and removes its own share as its data changes
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Loaded Splats"), STAT_GaussianSplat_LoadedSplats,
+                                      STATGROUP_GaussianSplat, GSPLATNIAGARARENDER_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("CPU Memory"), STAT_GaussianSplat_CPUMemory, STATGROUP_GaussianSplat,
+                           GSPLATNIAGARARENDER_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("GPU Memory"), STAT_GaussianSplat_GPUMemory, STATGROUP_GaussianSplat,
+                           GSPLATNIAGARARENDER_API);
+
+// Per frame: splat bytes written into GPU buffers, time sliced initial uploads and edits alike
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Uploaded Bytes"), STAT_GaussianSplat_UploadedBytes, STATGROUP_GaussianSplat,
+                                  GSPLATNIAGARARENDER_API);
+// Splats of time sliced uploads still waiting for their slice, and how long the last one took to become resident
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Upload Splats"), STAT_GaussianSplat_PendingUploadSplats,
+                                      STATGROUP_GaussianSplat, GSPLATNIAGARARENDER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Time To Full Residency (s)"), STAT_GaussianSplat_TimeToResidency,
+                                      STATGROUP_GaussianSplat, GSPLATNIAGARARENDER_API);
+
+LLM_DECLARE_TAG_API(GaussianSplat, GSPLATNIAGARARENDER_API);
+
+// Cycle counter for `stat GaussianSplat` plus an Insights scope of the same name, which is recorded even when
+// stats are compiled out
+#define GSPLAT_SCOPE(Name)                                                                                             \
+    SCOPE_CYCLE_COUNTER(STAT_GaussianSplat_##Name);                                                                    \
+    TRACE_CPUPROFILER_EVENT_SCOPE(GaussianSplat_##Name)
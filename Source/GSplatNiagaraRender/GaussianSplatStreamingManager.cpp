@@ -0,0 +1,236 @@
+﻿#include "GaussianSplatStreamingManager.h"
+#include "Async/AsyncFileHandle.h"
+#include "GaussianSplatStats.h"
+#include "HAL/PlatformFileManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatStreaming, Log, All);
+
+FGaussianSplatStreamingManager::FGaussianSplatStreamingManager() {}
+
+FGaussianSplatStreamingManager::~FGaussianSplatStreamingManager()
+{
+    Close();
+}
+
+bool FGaussianSplatStreamingManager::Open(const FString &FilePath, const FGaussianSplatStreamingSettings &InSettings,
+                                          FString &OutError)
+{
+    Close();
+
+    if (!FGaussianSplatTiledFile::ReadTable(FilePath, Header, Tiles, OutError))
+        return false;
+
+    FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*FilePath));
+    if (!FileHandle)
+    {
+        OutError = FString::Printf(TEXT("Failed to open for async read: %s"), *FilePath);
+        return false;
+    }
+
+    Settings = InSettings;
+    Settings.MaxInFlightReads = FMath::Max(Settings.MaxInFlightReads, 1);
+
+    const int64 SlotBytes = int64(Header.TileCapacity) * sizeof(FGaussianSplatPackedRecord);
+    const int32 NumSlots =
+        int32(FMath::Clamp<int64>(Settings.ResidencyBudgetBytes / SlotBytes, 1, FMath::Max(Header.NumTiles, 1)));
+    Slots.SetNum(NumSlots);
+    TileToSlot.Init(INDEX_NONE, Tiles.Num());
+    Stats = FGaussianSplatStreamingStats();
+    FrameNumber = 0;
+
+    UE_LOG(LogGaussianSplatStreaming, Log, TEXT("Opened %s | Tiles=%d | Splats=%lld | Slots=%d (%lld MB pool)"),
+           *FilePath, Tiles.Num(), Header.TotalSplats, NumSlots, (SlotBytes * NumSlots) >> 20);
+    return true;
+}
+
+void FGaussianSplatStreamingManager::Close()
+{
+    for (FPendingRead &Read : PendingReads)
+    {
+        Read.Request->Cancel();
+        Read.Request->WaitCompletion();
+        if (uint8 *Data = Read.Request->GetReadResults())
+            FMemory::Free(Data);
+        delete Read.Request;
+        ++Stats.TotalCancelledReads;
+    }
+    PendingReads.Empty();
+    CompletedUploads.Empty();
+    FileHandle.Reset();
+    Tiles.Empty();
+    TileToSlot.Empty();
+    Slots.Empty();
+}
+
+bool FGaussianSplatStreamingManager::CompleteReads(bool bWait)
+{
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    bool bChanged = false;
+    for (int32 i = PendingReads.Num() - 1; i >= 0; --i)
+    {
+        FPendingRead &Read = PendingReads[i];
+        if (bWait)
+            Read.Request->WaitCompletion();
+        else if (!Read.Request->PollCompletion())
+            continue;
+
+        uint8 *Data = Read.Request->GetReadResults();
+        FSlot &Slot = Slots[Read.Slot];
+        const FGaussianSplatTileInfo &Tile = Tiles[Read.Tile];
+
+        if (Data && Slot.Tile == Read.Tile)
+        {
+            FGaussianSplatTileUpload &Upload = CompletedUploads.AddDefaulted_GetRef();
+            Upload.Slot = Read.Slot;
+            Upload.Records.SetNumUninitialized(Tile.SplatCount);
+            FMemory::Memcpy(Upload.Records.GetData(), Data, Tile.GetDataSize());
+
+            Slot.bLoading = false;
+            ++Stats.TotalTileLoads;
+            Stats.TotalBytesRead += Tile.GetDataSize();
+            bChanged = true;
+        }
+        else if (Slot.Tile == Read.Tile)
+        {
+            UE_LOG(LogGaussianSplatStreaming, Warning, TEXT("Read failed for tile %d, releasing slot %d"), Read.Tile,
+                   Read.Slot);
+            TileToSlot[Read.Tile] = INDEX_NONE;
+            Slot = FSlot();
+        }
+
+        if (Data)
+            FMemory::Free(Data);
+        delete Read.Request;
+        PendingReads.RemoveAtSwap(i);
+    }
+    return bChanged;
+}
+
+int32 FGaussianSplatStreamingManager::AcquireSlot(const TBitArray<> &WantedTiles, bool &bOutEvicted)
+{
+    bOutEvicted = false;
+    int32 Victim = INDEX_NONE;
+    for (int32 SlotIdx = 0; SlotIdx < Slots.Num(); ++SlotIdx)
+    {
+        const FSlot &Slot = Slots[SlotIdx];
+        if (Slot.Tile == INDEX_NONE)
+            return SlotIdx;
+
+        // Never steal from a tile that is still wanted or whose read is still in flight
+        if (Slot.bLoading || WantedTiles[Slot.Tile])
+            continue;
+        if (Victim == INDEX_NONE || Slot.LastUsedFrame < Slots[Victim].LastUsedFrame)
+            Victim = SlotIdx;
+    }
+
+    if (Victim != INDEX_NONE)
+    {
+        TileToSlot[Slots[Victim].Tile] = INDEX_NONE;
+        Slots[Victim] = FSlot();
+        ++Stats.TotalEvictions;
+        bOutEvicted = true;
+    }
+    return Victim;
+}
+
+void FGaussianSplatStreamingManager::IssueRead(int32 Tile, int32 SlotIdx)
+{
+    const FGaussianSplatTileInfo &Info = Tiles[Tile];
+    FSlot &Slot = Slots[SlotIdx];
+    Slot.Tile = Tile;
+    Slot.bLoading = true;
+    Slot.LastUsedFrame = FrameNumber;
+    TileToSlot[Tile] = SlotIdx;
+
+    FPendingRead &Read = PendingReads.AddDefaulted_GetRef();
+    Read.Tile = Tile;
+    Read.Slot = SlotIdx;
+    Read.Request = FileHandle->ReadRequest(Info.DataOffset, Info.GetDataSize(), AIOP_Normal);
+}
+
+bool FGaussianSplatStreamingManager::Update(const FVector3f &ViewOrigin)
+{
+    if (!IsOpen())
+        return false;
+
+    ++FrameNumber;
+    bool bChanged = CompleteReads(false);
+
+    // Rank tiles by distance and keep as many as there are slots
+    TArray<TPair<float, int32>> Ranked;
+    Ranked.Reserve(Tiles.Num());
+    const float MaxDistSq =
+        Settings.MaxStreamingDistance > 0.0f ? FMath::Square(Settings.MaxStreamingDistance) : MAX_flt;
+    for (int32 TileIdx = 0; TileIdx < Tiles.Num(); ++TileIdx)
+    {
+        const float DistSq = Tiles[TileIdx].DistanceSquaredTo(ViewOrigin);
+        if (DistSq <= MaxDistSq)
+            Ranked.Emplace(DistSq, TileIdx);
+    }
+    Ranked.Sort([](const TPair<float, int32> &A, const TPair<float, int32> &B) { return A.Key < B.Key; });
+    Ranked.SetNum(FMath::Min(Ranked.Num(), Slots.Num()), EAllowShrinking::No);
+
+    TBitArray<> WantedTiles(false, Tiles.Num());
+    for (const TPair<float, int32> &Entry : Ranked)
+    {
+        WantedTiles[Entry.Value] = true;
+        if (TileToSlot[Entry.Value] != INDEX_NONE)
+            Slots[TileToSlot[Entry.Value]].LastUsedFrame = FrameNumber;
+    }
+
+    // Closest missing tiles first, bounded by the in-flight limit
+    for (const TPair<float, int32> &Entry : Ranked)
+    {
+        if (PendingReads.Num() >= Settings.MaxInFlightReads)
+            break;
+        if (TileToSlot[Entry.Value] != INDEX_NONE)
+            continue;
+
+        bool bEvicted = false;
+        const int32 SlotIdx = AcquireSlot(WantedTiles, bEvicted);
+        if (SlotIdx == INDEX_NONE)
+            break;
+        bChanged |= bEvicted;
+        IssueRead(Entry.Value, SlotIdx);
+    }
+
+    Stats.ResidentTiles = 0;
+    Stats.ResidentSplats = 0;
+    for (const FSlot &Slot : Slots)
+    {
+        if (Slot.Tile != INDEX_NONE && !Slot.bLoading)
+        {
+            ++Stats.ResidentTiles;
+            Stats.ResidentSplats += Tiles[Slot.Tile].SplatCount;
+        }
+    }
+    Stats.ResidentBytes = Stats.ResidentSplats * sizeof(FGaussianSplatPackedRecord);
+    Stats.PendingReads = PendingReads.Num();
+    return bChanged;
+}
+
+void FGaussianSplatStreamingManager::Flush()
+{
+    CompleteReads(true);
+    Stats.PendingReads = 0;
+}
+
+TArray<FGaussianSplatTileUpload> FGaussianSplatStreamingManager::ConsumeUploads()
+{
+    return MoveTemp(CompletedUploads);
+}
+
+void FGaussianSplatStreamingManager::BuildIndirection(TArray<uint32> &OutIndirection) const
+{
+    OutIndirection.Reset();
+    for (int32 SlotIdx = 0; SlotIdx < Slots.Num(); ++SlotIdx)
+    {
+        const FSlot &Slot = Slots[SlotIdx];
+        if (Slot.Tile == INDEX_NONE || Slot.bLoading)
+            continue;
+
+        const uint32 Base = uint32(SlotIdx) * uint32(Header.TileCapacity);
+        for (int32 i = 0; i < Tiles[Slot.Tile].SplatCount; ++i)
+            OutIndirection.Add(Base + i);
+    }
+}
@@ -0,0 +1,131 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+#include "GaussianSplatTiledFile.h"
+
+class IAsyncReadFileHandle;
+class IAsyncReadRequest;
+
+struct FGaussianSplatStreamingSettings
+{
+    // Bytes of packed splat records allowed to be resident at once; decides the pool slot count
+    int64 ResidencyBudgetBytes = 512ll * 1024 * 1024;
+
+    int32 MaxInFlightReads = 8;
+
+    // Tiles farther than this from the view are never requested (0 = unlimited)
+    float MaxStreamingDistance = 0.0f;
+};
+
+struct FGaussianSplatStreamingStats
+{
+    int32 ResidentTiles = 0;
+    int64 ResidentSplats = 0;
+    int64 ResidentBytes = 0;
+    int32 PendingReads = 0;
+
+    // Cumulative since Open
+    int64 TotalBytesRead = 0;
+    int32 TotalTileLoads = 0;
+    int32 TotalEvictions = 0;
+    // Reads still in flight when the manager was closed
+    int32 TotalCancelledReads = 0;
+};
+
+// A tile that finished loading and must be written into the GPU pool at Slot * TileCapacity
+struct FGaussianSplatTileUpload
+{
+    int32 Slot = INDEX_NONE;
+    TArray<FGaussianSplatPackedRecord> Records;
+};
+
+/**
+ * Pages tiles of a FGaussianSplatTiledFile into a fixed number of pool slots.
+ *
+ * Tiles are prioritised by distance to the view origin, read with async file I/O and evicted least-recently-used
+ * when a closer tile needs a slot. The manager owns no GPU resources: completed tiles are handed out through
+ * ConsumeUploads and the dense resident view through BuildIndirection, so it can be driven headless.
+ * Game thread only.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatStreamingManager
+{
+public:
+    FGaussianSplatStreamingManager();
+    ~FGaussianSplatStreamingManager();
+
+    bool Open(const FString &FilePath, const FGaussianSplatStreamingSettings &InSettings, FString &OutError);
+    void Close();
+
+    bool IsOpen() const
+    {
+        return FileHandle.IsValid();
+    }
+
+    // Completes finished reads, re-prioritises tiles and issues new reads.
+    // Returns true when the resident set changed and the indirection must be rebuilt.
+    bool Update(const FVector3f &ViewOrigin);
+
+    // Blocks until every in-flight read has landed
+    void Flush();
+
+    TArray<FGaussianSplatTileUpload> ConsumeUploads();
+
+    // Dense index -> pool element index for every resident splat, in slot order
+    void BuildIndirection(TArray<uint32> &OutIndirection) const;
+
+    int32 GetNumSlots() const
+    {
+        return Slots.Num();
+    }
+
+    int32 GetTileCapacity() const
+    {
+        return Header.TileCapacity;
+    }
+
+    int64 GetPoolElementCount() const
+    {
+        return int64(Slots.Num()) * Header.TileCapacity;
+    }
+
+    const FGaussianSplatTiledFileHeader &GetHeader() const
+    {
+        return Header;
+    }
+
+    const FGaussianSplatStreamingStats &GetStats() const
+    {
+        return Stats;
+    }
+
+private:
+    struct FSlot
+    {
+        int32 Tile = INDEX_NONE;
+        uint64 LastUsedFrame = 0;
+        bool bLoading = false;
+    };
+
+    struct FPendingRead
+    {
+        int32 Tile = INDEX_NONE;
+        int32 Slot = INDEX_NONE;
+        IAsyncReadRequest *Request = nullptr;
+    };
+
+    bool CompleteReads(bool bWait);
+    int32 AcquireSlot(const TBitArray<> &WantedTiles, bool &bOutEvicted);
+    void IssueRead(int32 Tile, int32 Slot);
+
+    FGaussianSplatStreamingSettings Settings;
+    FGaussianSplatTiledFileHeader Header;
+    TArray<FGaussianSplatTileInfo> Tiles;
+    TArray<int32> TileToSlot;
+    TArray<FSlot> Slots;
+    TArray<FPendingRead> PendingReads;
+    TArray<FGaussianSplatTileUpload> CompletedUploads;
+    TUniquePtr<IAsyncReadFileHandle> FileHandle;
+    FGaussianSplatStreamingStats Stats;
+    uint64 FrameNumber = 0;
+};
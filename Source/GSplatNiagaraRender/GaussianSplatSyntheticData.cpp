@@ -0,0 +1,176 @@
+﻿#include "GaussianSplatSyntheticData.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/ByteSwap.h"
+#include "Serialization/Archive.h"
+
+namespace GaussianSplatSyntheticData
+{
+int32 GetNumRestCoeffs(int32 SHDegree)
+{
+    const int32 Degree = FMath::Clamp(SHDegree, 0, 3);
+    return 3 * ((Degree + 1) * (Degree + 1) - 1);
+}
+
+int32 GetNumProperties(int32 SHDegree)
+{
+    // xyz, normal, f_dc, f_rest, opacity, scale, rot
+    return 3 + 3 + 3 + GetNumRestCoeffs(SHDegree) + 1 + 3 + 4;
+}
+
+void GenerateRow(FRandomStream &Random, int32 NumRest, float Extent, float *Out)
+{
+    for (int32 i = 0; i < 3; ++i)
+        *Out++ = Random.FRandRange(-Extent, Extent);
+    for (int32 i = 0; i < 3; ++i)
+        *Out++ = 0.0f;
+    for (int32 i = 0; i < 3; ++i)
+        *Out++ = Random.FRandRange(-2.0f, 2.0f);
+    for (int32 i = 0; i < NumRest; ++i)
+        *Out++ = Random.FRandRange(-0.5f, 0.5f);
+    *Out++ = Random.FRandRange(-4.0f, 4.0f);
+    for (int32 i = 0; i < 3; ++i)
+        *Out++ = Random.FRandRange(-6.0f, -2.0f);
+    for (int32 i = 0; i < 4; ++i)
+        *Out++ = Random.FRandRange(-1.0f, 1.0f);
+}
+
+const TCHAR *GetFormatName(EPLYFormat Format)
+{
+    switch (Format)
+    {
+    case EPLYFormat::ASCII:
+        return TEXT("ascii");
+    case EPLYFormat::BinaryBigEndian:
+        return TEXT("binary_big_endian");
+    default:
+        return TEXT("binary_little_endian");
+    }
+}
+} // namespace GaussianSplatSyntheticData
+
+void FGaussianSplatSyntheticData::GetPropertyNames(int32 SHDegree, TArray<FString> &OutNames)
+{
+    OutNames = {TEXT("x"), TEXT("y"), TEXT("z"), TEXT("nx"), TEXT("ny"), TEXT("nz"),
+                TEXT("f_dc_0"), TEXT("f_dc_1"), TEXT("f_dc_2")};
+    const int32 NumRest = GaussianSplatSyntheticData::GetNumRestCoeffs(SHDegree);
+    for (int32 i = 0; i < NumRest; ++i)
+        OutNames.Add(FString::Printf(TEXT("f_rest_%d"), i));
+    OutNames.Append({TEXT("opacity"), TEXT("scale_0"), TEXT("scale_1"), TEXT("scale_2"), TEXT("rot_0"),
+                     TEXT("rot_1"), TEXT("rot_2"), TEXT("rot_3")});
+}
+
+bool FGaussianSplatSyntheticData::WritePLY(const FString &FilePath, const FGaussianSplatSyntheticSettings &Settings,
+                                           FString &OutError)
+{
+    using namespace GaussianSplatSyntheticData;
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        OutError = FString::Printf(TEXT("Failed to open for writing: %s"), *FilePath);
+        return false;
+    }
+
+    TArray<FString> Names;
+    GetPropertyNames(Settings.SHDegree, Names);
+    FString Header = FString::Printf(TEXT("ply\nformat %s 1.0\nelement vertex %lld\n"), GetFormatName(Settings.Format),
+                                     Settings.NumSplats);
+    for (const FString &Name : Names)
+        Header += FString::Printf(TEXT("property float %s\n"), *Name);
+    Header += TEXT("end_header\n");
+    FTCHARToUTF8 HeaderUtf8(*Header);
+    Writer->Serialize(const_cast<ANSICHAR *>(HeaderUtf8.Get()), HeaderUtf8.Length());
+
+    const int32 NumProperties = Names.Num();
+    const int32 NumRest = GetNumRestCoeffs(Settings.SHDegree);
+    FRandomStream Random(Settings.Seed);
+
+    constexpr int64 BatchSize = 65536;
+    TArray<float> Rows;
+    Rows.SetNumUninitialized(BatchSize * NumProperties);
+    FString Text;
+    for (int64 Start = 0; Start < Settings.NumSplats; Start += BatchSize)
+    {
+        const int64 Count = FMath::Min(BatchSize, Settings.NumSplats - Start);
+        for (int64 i = 0; i < Count; ++i)
+            GenerateRow(Random, NumRest, Settings.Extent, Rows.GetData() + i * NumProperties);
+
+        const int64 NumValues = Count * NumProperties;
+        if (Settings.Format == EPLYFormat::ASCII)
+        {
+            Text.Reset();
+            for (int64 i = 0; i < NumValues; ++i)
+            {
+                Text += FString::Printf(TEXT("%.7g"), Rows[i]);
+                Text += (i + 1) % NumProperties == 0 ? TEXT("\n") : TEXT(" ");
+            }
+            FTCHARToUTF8 TextUtf8(*Text);
+            Writer->Serialize(const_cast<ANSICHAR *>(TextUtf8.Get()), TextUtf8.Length());
+            continue;
+        }
+
+        if (Settings.Format == EPLYFormat::BinaryBigEndian)
+        {
+            uint32 *Words = reinterpret_cast<uint32 *>(Rows.GetData());
+            for (int64 i = 0; i < NumValues; ++i)
+                Words[i] = ByteSwap(Words[i]);
+        }
+        Writer->Serialize(Rows.GetData(), NumValues * sizeof(float));
+    }
+
+    if (!Writer->Close())
+    {
+        OutError = FString::Printf(TEXT("Failed to write: %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
+
+void FGaussianSplatSyntheticData::MakeRawProperties(const FGaussianSplatSyntheticSettings &Settings,
+                                                    TArray64<float> &OutValues)
+{
+    using namespace GaussianSplatSyntheticData;
+
+    const int32 NumProperties = GetNumProperties(Settings.SHDegree);
+    const int32 NumRest = GetNumRestCoeffs(Settings.SHDegree);
+    FRandomStream Random(Settings.Seed);
+    OutValues.SetNumUninitialized(Settings.NumSplats * NumProperties);
+    for (int64 i = 0; i < Settings.NumSplats; ++i)
+        GenerateRow(Random, NumRest, Settings.Extent, OutValues.GetData() + i * NumProperties);
+}
+
+void FGaussianSplatSyntheticData::ConvertRawProperties(TConstArrayView64<float> Values, int32 SHDegree,
+                                                       TArray<FGaussianSplatData> &OutSplats)
+{
+    using namespace GaussianSplatSyntheticData;
+
+    const int32 NumProperties = GetNumProperties(SHDegree);
+    const int32 NumRest = GetNumRestCoeffs(SHDegree);
+    const int32 NumSplats = int32(Values.Num() / NumProperties);
+    OutSplats.SetNum(NumSplats);
+    for (int32 i = 0; i < NumSplats; ++i)
+    {
+        const float *Row = Values.GetData() + int64(i) * NumProperties;
+        FGaussianSplatData &Splat = OutSplats[i];
+        Splat.Position = FGaussianSplatData::ConvertPositionToUnreal(Row[0], Row[1], Row[2]);
+        Splat.Normal = FVector3f(Row[3], Row[4], Row[5]);
+        Splat.ZeroOrderHarmonicsCoefficients = FVector3f(Row[6], Row[7], Row[8]);
+        const float *Rest = Row + 9;
+        Splat.HighOrderHarmonicsCoefficients.Reset(NumRest / 3);
+        for (int32 c = 0; c + 2 < NumRest; c += 3)
+            Splat.HighOrderHarmonicsCoefficients.Add(FVector3f(Rest[c], Rest[c + 1], Rest[c + 2]));
+        const float *Tail = Rest + NumRest;
+        Splat.Opacity = FGaussianSplatData::ConvertOpacityToUnreal(Tail[0]);
+        Splat.Scale = FGaussianSplatData::ConvertScaleToUnreal(Tail[1], Tail[2], Tail[3]);
+        Splat.Orientation = FGaussianSplatData::ConvertOrientationToUnreal(Tail[4], Tail[5], Tail[6], Tail[7]);
+    }
+}
+
+void FGaussianSplatSyntheticData::MakeSplats(const FGaussianSplatSyntheticSettings &Settings,
+                                             TArray<FGaussianSplatData> &OutSplats)
+{
+    TArray64<float> Values;
+    MakeRawProperties(Settings, Values);
+    ConvertRawProperties(Values, Settings.SHDegree, OutSplats);
+}
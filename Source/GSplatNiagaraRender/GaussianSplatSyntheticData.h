@@ -0,0 +1,41 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+#include "PLYParser.h"
+
+struct FGaussianSplatSyntheticSettings
+{
+    int64 NumSplats = 100000;
+    // 0..3; degree D writes 3 * ((D + 1)^2 - 1) f_rest properties like the reference 3DGS exporter
+    int32 SHDegree = 0;
+    EPLYFormat Format = EPLYFormat::BinaryLittleEndian;
+    int32 Seed = 0x5EED;
+    // Half-extent of the cube positions are drawn from, in PLY units (metres)
+    float Extent = 10.0f;
+};
+
+/**
+ * Deterministic random splat clouds for benchmarks and round-trip checks. Values are drawn in the raw 3DGS
+ * encoding (log-ish scale, logit opacity, unnormalised wxyz rotation), so parsing them exercises the same
+ * conversions as a trained capture.
+ */
+class GSPLATNIAGARARENDER_API FGaussianSplatSyntheticData
+{
+public:
+    // Property names in file order for the given SH degree
+    static void GetPropertyNames(int32 SHDegree, TArray<FString> &OutNames);
+
+    // Streams the file out in batches, so clouds far larger than memory can be produced
+    static bool WritePLY(const FString &FilePath, const FGaussianSplatSyntheticSettings &Settings, FString &OutError);
+
+    // Raw property rows (GetPropertyNames order) for the first NumSplats splats of the same stream WritePLY emits
+    static void MakeRawProperties(const FGaussianSplatSyntheticSettings &Settings, TArray64<float> &OutValues);
+
+    // The per-splat conversion FPLYParser applies after reading a row, over rows from MakeRawProperties
+    static void ConvertRawProperties(TConstArrayView64<float> Values, int32 SHDegree,
+                                     TArray<FGaussianSplatData> &OutSplats);
+
+    // Already converted splats, for benchmarking stages after the parser
+    static void MakeSplats(const FGaussianSplatSyntheticSettings &Settings, TArray<FGaussianSplatData> &OutSplats);
+};
@@ -0,0 +1,244 @@
+﻿#include "GaussianSplatTiledFile.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGaussianSplatTiles, Log, All);
+
+namespace GaussianSplatTiledFile
+{
+void SerializeHeader(FArchive &Ar, FGaussianSplatTiledFileHeader &Header)
+{
+    Ar << Header.Magic;
+    Ar << Header.Version;
+    Ar << Header.TileCapacity;
+    Ar << Header.NumTiles;
+    Ar << Header.TotalSplats;
+    Ar << Header.BoundsMin;
+    Ar << Header.BoundsMax;
+}
+
+void SerializeTile(FArchive &Ar, FGaussianSplatTileInfo &Tile)
+{
+    Ar << Tile.BoundsMin;
+    Ar << Tile.BoundsMax;
+    Ar << Tile.DataOffset;
+    Ar << Tile.SplatCount;
+    Ar << Tile.Depth;
+}
+
+// Size of the header and one table entry as written by the serializers above
+constexpr int64 HeaderByteSize = 4 + 4 + 4 + 4 + 8 + 12 + 12;
+constexpr int64 TileByteSize = 12 + 12 + 8 + 4 + 4;
+
+struct FOctreeBuilder
+{
+    const TArray<FGaussianSplatData> &Splats;
+    const int32 TileCapacity;
+    TArray<int32> Scratch;
+    TArray<int32> OrderedIndices;
+    TArray<FGaussianSplatTileInfo> Tiles;
+
+    FOctreeBuilder(const TArray<FGaussianSplatData> &InSplats, int32 InTileCapacity)
+        : Splats(InSplats), TileCapacity(InTileCapacity)
+    {
+    }
+
+    void EmitLeaf(const int32 *Indices, int32 Count, int32 Depth)
+    {
+        // A leaf that still overflows (max depth or coincident points) is chunked sequentially
+        for (int32 Start = 0; Start < Count; Start += TileCapacity)
+        {
+            const int32 ChunkCount = FMath::Min(TileCapacity, Count - Start);
+            FGaussianSplatTileInfo &Tile = Tiles.AddDefaulted_GetRef();
+            Tile.SplatCount = ChunkCount;
+            Tile.Depth = Depth;
+            Tile.BoundsMin = FVector3f(MAX_flt);
+            Tile.BoundsMax = FVector3f(-MAX_flt);
+            for (int32 i = 0; i < ChunkCount; ++i)
+            {
+                const int32 SplatIdx = Indices[Start + i];
+                Tile.BoundsMin = Tile.BoundsMin.ComponentMin(Splats[SplatIdx].Position);
+                Tile.BoundsMax = Tile.BoundsMax.ComponentMax(Splats[SplatIdx].Position);
+                OrderedIndices.Add(SplatIdx);
+            }
+        }
+    }
+
+    void Build(int32 *Indices, int32 Count, const FVector3f &Min, const FVector3f &Max, int32 Depth)
+    {
+        if (Count <= 0)
+            return;
+
+        if (Count <= TileCapacity || Depth >= FGaussianSplatTiledFile::MaxOctreeDepth)
+        {
+            EmitLeaf(Indices, Count, Depth);
+            return;
+        }
+
+        const FVector3f Center = (Min + Max) * 0.5f;
+        auto GetChild = [&Center](const FVector3f &P)
+        { return (P.X >= Center.X ? 1 : 0) | (P.Y >= Center.Y ? 2 : 0) | (P.Z >= Center.Z ? 4 : 0); };
+
+        // Counting sort of this node's indices into its eight children
+        int32 ChildCounts[8] = {};
+        for (int32 i = 0; i < Count; ++i)
+            ++ChildCounts[GetChild(Splats[Indices[i]].Position)];
+
+        int32 ChildStarts[8];
+        int32 Running = 0;
+        for (int32 c = 0; c < 8; ++c)
+        {
+            ChildStarts[c] = Running;
+            Running += ChildCounts[c];
+        }
+
+        int32 *Temp = Scratch.GetData();
+        int32 Cursor[8];
+        FMemory::Memcpy(Cursor, ChildStarts, sizeof(Cursor));
+        for (int32 i = 0; i < Count; ++i)
+            Temp[Cursor[GetChild(Splats[Indices[i]].Position)]++] = Indices[i];
+        FMemory::Memcpy(Indices, Temp, Count * sizeof(int32));
+
+        for (int32 c = 0; c < 8; ++c)
+        {
+            const FVector3f ChildMin((c & 1) ? Center.X : Min.X, (c & 2) ? Center.Y : Min.Y,
+                                     (c & 4) ? Center.Z : Min.Z);
+            const FVector3f ChildMax((c & 1) ? Max.X : Center.X, (c & 2) ? Max.Y : Center.Y,
+                                     (c & 4) ? Max.Z : Center.Z);
+            Build(Indices + ChildStarts[c], ChildCounts[c], ChildMin, ChildMax, Depth + 1);
+        }
+    }
+};
+} // namespace GaussianSplatTiledFile
+
+bool FGaussianSplatTiledFile::Write(const FString &FilePath, const TArray<FGaussianSplatData> &Splats,
+                                    int32 TileCapacity, FString &OutError)
+{
+    using namespace GaussianSplatTiledFile;
+
+    if (Splats.Num() == 0)
+    {
+        OutError = TEXT("No splats to write");
+        return false;
+    }
+    TileCapacity = FMath::Max(TileCapacity, 1);
+
+    FGaussianSplatTiledFileHeader Header;
+    Header.TileCapacity = TileCapacity;
+    Header.TotalSplats = Splats.Num();
+    Header.BoundsMin = FVector3f(MAX_flt);
+    Header.BoundsMax = FVector3f(-MAX_flt);
+    for (const FGaussianSplatData &S : Splats)
+    {
+        Header.BoundsMin = Header.BoundsMin.ComponentMin(S.Position);
+        Header.BoundsMax = Header.BoundsMax.ComponentMax(S.Position);
+    }
+
+    FOctreeBuilder Builder(Splats, TileCapacity);
+    TArray<int32> Indices;
+    Indices.SetNumUninitialized(Splats.Num());
+    for (int32 i = 0; i < Splats.Num(); ++i)
+        Indices[i] = i;
+    Builder.Scratch.SetNumUninitialized(Splats.Num());
+    Builder.OrderedIndices.Reserve(Splats.Num());
+    Builder.Build(Indices.GetData(), Indices.Num(), Header.BoundsMin, Header.BoundsMax, 0);
+
+    Header.NumTiles = Builder.Tiles.Num();
+    int64 Offset = HeaderByteSize + int64(Header.NumTiles) * TileByteSize;
+    for (FGaussianSplatTileInfo &Tile : Builder.Tiles)
+    {
+        Tile.DataOffset = Offset;
+        Offset += Tile.GetDataSize();
+    }
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        OutError = FString::Printf(TEXT("Failed to open for writing: %s"), *FilePath);
+        return false;
+    }
+
+    SerializeHeader(*Writer, Header);
+    for (FGaussianSplatTileInfo &Tile : Builder.Tiles)
+        SerializeTile(*Writer, Tile);
+
+    // Records are written in tile order in batches to keep the staging buffer small
+    constexpr int32 BatchSize = 65536;
+    TArray<FGaussianSplatPackedRecord> Batch;
+    Batch.Reserve(BatchSize);
+    for (int32 i = 0; i < Builder.OrderedIndices.Num(); ++i)
+    {
+        Batch.Add(FGaussianSplatPackedRecord::FromSplat(Splats[Builder.OrderedIndices[i]]));
+        if (Batch.Num() == BatchSize || i == Builder.OrderedIndices.Num() - 1)
+        {
+            Writer->Serialize(Batch.GetData(), Batch.Num() * sizeof(FGaussianSplatPackedRecord));
+            Batch.Reset();
+        }
+    }
+
+    const bool bOk = Writer->Close();
+    if (!bOk)
+    {
+        OutError = FString::Printf(TEXT("Failed to write: %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogGaussianSplatTiles, Log, TEXT("Wrote %lld splats in %d tiles (capacity %d) to %s"), Header.TotalSplats,
+           Header.NumTiles, TileCapacity, *FilePath);
+    return true;
+}
+
+bool FGaussianSplatTiledFile::ReadTable(const FString &FilePath, FGaussianSplatTiledFileHeader &OutHeader,
+                                        TArray<FGaussianSplatTileInfo> &OutTiles, FString &OutError)
+{
+    using namespace GaussianSplatTiledFile;
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        OutError = FString::Printf(TEXT("File not found: %s"), *FilePath);
+        return false;
+    }
+
+    SerializeHeader(*Reader, OutHeader);
+    if (Reader->IsError() || OutHeader.Magic != FGaussianSplatTiledFileHeader::MagicValue)
+    {
+        OutError = TEXT("Invalid tiled splat file: bad magic");
+        return false;
+    }
+    if (OutHeader.Version != FGaussianSplatTiledFileHeader::CurrentVersion)
+    {
+        OutError = FString::Printf(TEXT("Unsupported tiled splat file version %u"), OutHeader.Version);
+        return false;
+    }
+    const int64 FileSize = Reader->TotalSize();
+    // Checked before sizing the table so a corrupt count cannot trigger a huge allocation
+    const int64 HeaderEnd = HeaderByteSize + int64(OutHeader.NumTiles) * TileByteSize;
+    if (OutHeader.NumTiles < 0 || OutHeader.TileCapacity <= 0 || HeaderEnd > FileSize)
+    {
+        OutError = TEXT("Invalid tiled splat file: corrupt header");
+        return false;
+    }
+
+    OutTiles.SetNum(OutHeader.NumTiles);
+    for (FGaussianSplatTileInfo &Tile : OutTiles)
+        SerializeTile(*Reader, Tile);
+
+    if (Reader->IsError())
+    {
+        OutError = TEXT("Invalid tiled splat file: truncated tile table");
+        return false;
+    }
+
+    for (const FGaussianSplatTileInfo &Tile : OutTiles)
+    {
+        // Compared as DataOffset <= FileSize - size so a huge offset cannot overflow the sum
+        if (Tile.SplatCount < 0 || Tile.SplatCount > OutHeader.TileCapacity || Tile.DataOffset < HeaderEnd ||
+            Tile.DataOffset > FileSize - Tile.GetDataSize())
+        {
+            OutError = TEXT("Invalid tiled splat file: tile out of range");
+            return false;
+        }
+    }
+    return true;
+}
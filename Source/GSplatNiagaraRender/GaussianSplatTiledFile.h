@@ -0,0 +1,65 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatData.h"
+
+/**
+ * On-disk octree layout for splat clouds too large to load in one piece.
+ *
+ * File layout:
+ *   FGaussianSplatTiledFileHeader
+ *   FGaussianSplatTileInfo[NumTiles]
+ *   FGaussianSplatPackedRecord[TotalSplats]  (grouped per tile, each tile contiguous)
+ *
+ * Every tile holds at most TileCapacity splats so a streaming pool can use fixed-size slots.
+ */
+struct FGaussianSplatTiledFileHeader
+{
+    static constexpr uint32 MagicValue = 0x4C545347; // 'GSTL'
+    static constexpr uint32 CurrentVersion = 1;
+
+    uint32 Magic = MagicValue;
+    uint32 Version = CurrentVersion;
+    int32 TileCapacity = 0;
+    int32 NumTiles = 0;
+    int64 TotalSplats = 0;
+    FVector3f BoundsMin = FVector3f::ZeroVector;
+    FVector3f BoundsMax = FVector3f::ZeroVector;
+};
+
+struct FGaussianSplatTileInfo
+{
+    FVector3f BoundsMin = FVector3f::ZeroVector;
+    FVector3f BoundsMax = FVector3f::ZeroVector;
+    int64 DataOffset = 0; // absolute byte offset of the first record
+    int32 SplatCount = 0;
+    int32 Depth = 0; // octree depth of the leaf this tile came from
+
+    int64 GetDataSize() const
+    {
+        return int64(SplatCount) * sizeof(FGaussianSplatPackedRecord);
+    }
+
+    float DistanceSquaredTo(const FVector3f &Point) const
+    {
+        const FVector3f Closest(FMath::Clamp(Point.X, BoundsMin.X, BoundsMax.X),
+                                FMath::Clamp(Point.Y, BoundsMin.Y, BoundsMax.Y),
+                                FMath::Clamp(Point.Z, BoundsMin.Z, BoundsMax.Z));
+        return FVector3f::DistSquared(Point, Closest);
+    }
+};
+
+class GSPLATNIAGARARENDER_API FGaussianSplatTiledFile
+{
+public:
+    static constexpr int32 DefaultTileCapacity = 16384;
+    static constexpr int32 MaxOctreeDepth = 16;
+
+    // Builds the octree and writes the tiled file. Splats are already in Unreal space and must all be in memory.
+    static bool Write(const FString &FilePath, const TArray<FGaussianSplatData> &Splats, int32 TileCapacity,
+                      FString &OutError);
+
+    // Reads the header and tile table only; payload is left on disk for streaming.
+    static bool ReadTable(const FString &FilePath, FGaussianSplatTiledFileHeader &OutHeader,
+                          TArray<FGaussianSplatTileInfo> &OutTiles, FString &OutError);
+};
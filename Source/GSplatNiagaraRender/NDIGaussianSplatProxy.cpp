@@ -1,105 +1,1079 @@
 ﻿#include "NDIGaussianSplatProxy.h"
 #include "GaussianSplatData.h"
+#include "GaussianSplatShaders.h"
+#include "GaussianSplatStats.h"
+#include "GPUSort.h"
+#include "GlobalShader.h"
+#include "HAL/IConsoleManager.h"
 #include "RHICommandList.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
 #include "RenderingThread.h"
+#include "TextureResource.h"
 
-FNDIGaussianSplatProxy::FNDIGaussianSplatProxy() {}
+static int32 GGaussianSplatUploadFrameBudgetMB = 0;
+static FAutoConsoleVariableRef CVarGaussianSplatUploadFrameBudgetMB(
+    TEXT("gsplat.Upload.FrameBudgetMB"), GGaussianSplatUploadFrameBudgetMB,
+    TEXT("Splat data uploaded per frame across all clouds, in MB (0 = unlimited). Larger clouds are uploaded over "
+         "several frames and fill in as their slices land; GPU GetSplatCount grows with them."),
+    ECVF_Scalability);
+
+namespace GaussianSplatProxy
+{
+// Upper bound on the rasterizer's key buffers: four buffers of this many uints
+constexpr uint32 MaxRasterKeys = 1u << 25;
+
+static uint32 UploadBudgetFrame = MAX_uint32;
+static int64 UploadBudgetUsed = 0;
+
+// How many of Wanted splats still fit in this frame's upload budget, which it then charges. Render thread only.
+static int32 TakeUploadBudget(int32 Wanted)
+{
+    if (GGaussianSplatUploadFrameBudgetMB <= 0)
+        return Wanted;
+    if (UploadBudgetFrame != GFrameNumberRenderThread)
+    {
+        UploadBudgetFrame = GFrameNumberRenderThread;
+        UploadBudgetUsed = 0;
+    }
+    const int64 Budget = int64(GGaussianSplatUploadFrameBudgetMB) * 1024 * 1024;
+    const int64 Remaining = (Budget - UploadBudgetUsed) / FGaussianSplatBufferArena::BytesPerSplat;
+    const int32 Fits = int32(FMath::Clamp(Remaining, int64(0), int64(Wanted)));
+    UploadBudgetUsed += int64(Fits) * FGaussianSplatBufferArena::BytesPerSplat;
+    return Fits;
+}
+
+// Linear dispatches are folded into rows, since large clouds need more groups than one dimension allows.
+// OutWidth is the group count per row, as the shaders' DispatchWidth expects.
+static FIntVector GetLinearGroupCount(uint32 NumThreads, uint32 ThreadGroupSize, uint32 &OutWidth)
+{
+    const uint32 NumGroups = FMath::Max(FMath::DivideAndRoundUp(NumThreads, ThreadGroupSize), 1u);
+    OutWidth = FMath::Min(NumGroups, uint32(GRHIMaxDispatchThreadGroupsPerDimension.X));
+    return FIntVector(OutWidth, FMath::DivideAndRoundUp(NumGroups, OutWidth), 1);
+}
+} // namespace GaussianSplatProxy
+
+FNDIGaussianSplatProxy::FNDIGaussianSplatProxy() : InterleavedArena(EGaussianSplatBufferLayout::Interleaved) {}
 
 FNDIGaussianSplatProxy::~FNDIGaussianSplatProxy()
 {
     FallbackBuffer.Release();
-    for (auto &Pair : SystemInstancesToData_RT)
-        Pair.Value.ReleaseBuffers();
+    FallbackRecordBuffer.Release();
+    FallbackIndirectionBuffer.Release();
+    FallbackUAVBuffer.Release();
+    FallbackCloudTintBuffer.Release();
+    CloudOffsetsBuffer.Release();
+    CloudTintsBuffer.Release();
+    SpatialCellStartsBuffer.Release();
+    SpatialSplatsBuffer.Release();
+    CloudInstancesBuffer.Release();
+    StreamingPool.Release();
+    SequenceBuffers.Release();
+    Arena.Release();
+    InterleavedArena.Release();
     SystemInstancesToData_RT.Empty();
+    UpdateGPUMemoryStat();
 }
 
 void FNDIGaussianSplatProxy::CreateBuffer(FRHICommandListImmediate &RHICmdList, FGaussianSplatBuffer &OutBuffer,
-                                          uint32 NumElements, uint32 BytesPerElement, const TCHAR *DebugName)
+                                          uint32 NumElements, uint32 BytesPerElement, const TCHAR *DebugName,
+                                          EPixelFormat Format, EBufferUsageFlags Usage)
 {
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    const uint64 BufferSize = uint64(NumElements) * BytesPerElement;
+    if (BufferSize > FGaussianSplatBufferArena::MaxBufferBytes)
+    {
+        // Left invalid, which callers already treat as "no buffer"
+        UE_LOG(LogTemp, Error, TEXT("[Proxy::CreateBuffer] %s | %llu bytes exceeds the %llu byte buffer limit"),
+               DebugName, BufferSize, FGaussianSplatBufferArena::MaxBufferBytes);
+        OutBuffer.Release();
+        return;
+    }
     OutBuffer.NumElements = NumElements;
-    const uint32 BufferSize = NumElements * BytesPerElement;
     FRHIResourceCreateInfo CreateInfo(DebugName);
-    OutBuffer.Buffer = RHICmdList.CreateVertexBuffer(BufferSize, BUF_ShaderResource | BUF_Dynamic, CreateInfo);
-    OutBuffer.SRV = RHICmdList.CreateShaderResourceView(OutBuffer.Buffer, BytesPerElement, PF_A32B32G32R32F);
+    OutBuffer.Buffer = RHICmdList.CreateVertexBuffer(uint32(BufferSize), Usage, CreateInfo);
+    OutBuffer.SRV = RHICmdList.CreateShaderResourceView(OutBuffer.Buffer, BytesPerElement, Format);
+    if (EnumHasAnyFlags(Usage, BUF_UnorderedAccess))
+        OutBuffer.UAV = RHICmdList.CreateUnorderedAccessView(OutBuffer.Buffer, Format);
+}
+
+void FNDIGaussianSplatProxy::CreateAndFillBuffer(FRHICommandListImmediate &RHICmdList, FGaussianSplatBuffer &OutBuffer,
+                                                 const void *Data, uint32 NumElements, uint32 BytesPerElement,
+                                                 const TCHAR *DebugName, EPixelFormat Format)
+{
+    CreateBuffer(RHICmdList, OutBuffer, NumElements, BytesPerElement, DebugName, Format);
+    if (!OutBuffer.IsValid())
+        return;
+    void *Mapped = RHICmdList.LockBuffer(OutBuffer.Buffer, 0, NumElements * BytesPerElement, RLM_WriteOnly);
+    if (Mapped)
+    {
+        FMemory::Memcpy(Mapped, Data, NumElements * BytesPerElement);
+        RHICmdList.UnlockBuffer(OutBuffer.Buffer);
+    }
 }
 
 void FNDIGaussianSplatProxy::InitializeAndUpload(FRHICommandListImmediate &RHICmdList,
                                                  FGaussianSplatInstanceData_RT &InstanceData,
-                                                 const TArray<FGaussianSplatData> &SplatsData)
+                                                 TArray<FGaussianSplatPackedRecord> &&Records,
+                                                 EGaussianSplatBufferLayout Layout, bool bWritable)
 {
     check(IsInRenderingThread());
-    const int32 NumSplats = SplatsData.Num();
+    LLM_SCOPE_BYTAG(GaussianSplat);
+    const int32 NumSplats = Records.Num();
 
+    ReleaseInstanceData(RHICmdList, InstanceData);
     if (NumSplats <= 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[Proxy::InitializeAndUpload] NumSplats=0, creating fallback"));
-        CreateFallbackBuffers(RHICmdList, InstanceData);
+        UE_LOG(LogTemp, Verbose, TEXT("[Proxy::InitializeAndUpload] NumSplats=0, instance will bind fallback"));
         return;
     }
 
-    if (InstanceData.AreBuffersValid())
-        InstanceData.ReleaseBuffers();
-
-    const uint32 BytesPerElement = sizeof(FVector4f);
-    CreateBuffer(RHICmdList, InstanceData.PositionsBuffer, NumSplats, BytesPerElement, TEXT("GSplat_Positions"));
-    CreateBuffer(RHICmdList, InstanceData.ScalesBuffer, NumSplats, BytesPerElement, TEXT("GSplat_Scales"));
-    CreateBuffer(RHICmdList, InstanceData.OrientationsBuffer, NumSplats, BytesPerElement, TEXT("GSplat_Orientations"));
-    CreateBuffer(RHICmdList, InstanceData.SHZeroCoeffsAndOpacityBuffer, NumSplats, BytesPerElement,
-                 TEXT("GSplat_SHOpacity"));
+    FGaussianSplatBufferArena &TargetArena = GetArena(Layout);
+    InstanceData.Allocation = TargetArena.Allocate(RHICmdList, NumSplats);
+    if (!InstanceData.HasAllocation())
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Proxy::InitializeAndUpload] No arena space for %d splats, binding fallback"),
+               NumSplats);
+        return;
+    }
+    InstanceData.Layout = Layout;
     InstanceData.SplatsCount = NumSplats;
 
-    // Pack into SoA float4 arrays
-    TArray<FVector4f> Positions, Scales, Orientations, SHOpacity;
-    Positions.SetNum(NumSplats);
-    Scales.SetNum(NumSplats);
-    Orientations.SetNum(NumSplats);
-    SHOpacity.SetNum(NumSplats);
+    // UploadRecords below fills the rest buffers once they exist; the live ones are filled from them by the first
+    // flip pass
+    if (bWritable)
+        CreateDeformBuffers(RHICmdList, InstanceData.Deform, NumSplats);
+
+    const int32 FirstSlice = GaussianSplatProxy::TakeUploadBudget(NumSplats);
+    if (FirstSlice < NumSplats)
+    {
+        InstanceData.PendingRecords = MoveTemp(Records);
+        InstanceData.UploadedCount = 0;
+        InstanceData.UploadStartSeconds = FPlatformTime::Seconds();
+        NumPendingUploads.fetch_add(1, std::memory_order_relaxed);
+        AddPendingUploadBytes(InstanceData.PendingRecords.GetAllocatedSize());
+        INC_DWORD_STAT_BY(STAT_GaussianSplat_PendingUploadSplats, NumSplats);
+        UploadSlice(RHICmdList, InstanceData, FirstSlice);
+    }
+    else
+    {
+        UploadRecords(RHICmdList, InstanceData, 0, Records);
+    }
+    UpdateGPUMemoryStat();
+
+    const FGaussianSplatArenaRange Range = TargetArena.GetRange(InstanceData.Allocation);
+    UE_LOG(LogTemp, Verbose,
+           TEXT("[Proxy::InitializeAndUpload] COMPLETE | %d splats | %d uploaded | Interleaved=%d | ArenaOffset=%u | "
+                "Valid=%d"),
+           NumSplats, InstanceData.GetResidentCount(), Layout == EGaussianSplatBufferLayout::Interleaved, Range.Offset,
+           TargetArena.IsValid());
+}
+
+void FNDIGaussianSplatProxy::UploadPendingSlices(FRHICommandListImmediate &RHICmdList)
+{
+    check(IsInRenderingThread());
+    for (auto &Pair : SystemInstancesToData_RT)
+    {
+        FGaussianSplatInstanceData_RT &InstanceData = Pair.Value;
+        if (InstanceData.IsFullyResident())
+            continue;
+        const int32 Count =
+            GaussianSplatProxy::TakeUploadBudget(InstanceData.SplatsCount - InstanceData.UploadedCount);
+        if (Count == 0)
+            break;
+        UploadSlice(RHICmdList, InstanceData, Count);
+    }
+}
+
+void FNDIGaussianSplatProxy::UploadSlice(FRHICommandListImmediate &RHICmdList,
+                                         FGaussianSplatInstanceData_RT &InstanceData, int32 Count)
+{
+    if (Count <= 0)
+        return;
+    const int32 First = InstanceData.UploadedCount;
+    UploadRecords(RHICmdList, InstanceData, First, MakeArrayView(InstanceData.PendingRecords.GetData() + First, Count));
+    InstanceData.UploadedCount = First + Count;
+    DEC_DWORD_STAT_BY(STAT_GaussianSplat_PendingUploadSplats, Count);
+    if (InstanceData.UploadedCount < InstanceData.SplatsCount)
+        return;
+
+    // One reset once the rest pose is whole refreshes the live copies, rather than a full copy per slice
+    InstanceData.Deform.bResetPending = true;
+
+    const double Seconds = FPlatformTime::Seconds() - InstanceData.UploadStartSeconds;
+    SET_FLOAT_STAT(STAT_GaussianSplat_TimeToResidency, Seconds);
+    UE_LOG(LogTemp, Verbose, TEXT("[Proxy::UploadSlice] %d splats resident after %.2f s"), InstanceData.SplatsCount,
+           Seconds);
+    ClearPendingRecords(InstanceData);
+}
+
+void FNDIGaussianSplatProxy::ClearPendingRecords(FGaussianSplatInstanceData_RT &InstanceData)
+{
+    if (InstanceData.IsFullyResident())
+        return;
+    DEC_DWORD_STAT_BY(STAT_GaussianSplat_PendingUploadSplats, InstanceData.SplatsCount - InstanceData.UploadedCount);
+    AddPendingUploadBytes(-int64(InstanceData.PendingRecords.GetAllocatedSize()));
+    NumPendingUploads.fetch_sub(1, std::memory_order_relaxed);
+    InstanceData.PendingRecords.Empty();
+    InstanceData.UploadedCount = 0;
+}
+
+void FNDIGaussianSplatProxy::PatchPendingRecords(FGaussianSplatInstanceData_RT &InstanceData, uint32 FirstElement,
+                                                 TConstArrayView<FGaussianSplatPackedRecord> Records)
+{
+    if (InstanceData.IsFullyResident() || FirstElement + Records.Num() > uint32(InstanceData.PendingRecords.Num()))
+        return;
+    FMemory::Memcpy(InstanceData.PendingRecords.GetData() + FirstElement, Records.GetData(),
+                    Records.Num() * sizeof(FGaussianSplatPackedRecord));
+}
+
+bool FNDIGaussianSplatProxy::ShareUpload(FRHICommandListImmediate &RHICmdList,
+                                         FGaussianSplatInstanceData_RT &InstanceData, uint32 Revision,
+                                         EGaussianSplatBufferLayout Layout, bool bWritable)
+{
+    check(IsInRenderingThread());
+    ReleaseInstanceData(RHICmdList, InstanceData);
+
+    const FGaussianSplatInstanceData_RT *Source = nullptr;
+    for (const auto &Pair : SystemInstancesToData_RT)
+    {
+        const FGaussianSplatInstanceData_RT &Other = Pair.Value;
+        if (&Other != &InstanceData && Other.HasAllocation() && Other.IsFullyResident() &&
+            Other.Revision == Revision && Other.Layout == Layout && (!bWritable || Other.Deform.IsValid()))
+        {
+            Source = &Other;
+            break;
+        }
+    }
+    if (!Source)
+        return false;
+
+    InstanceData.Allocation = Source->Allocation;
+    InstanceData.Layout = Layout;
+    InstanceData.SplatsCount = Source->SplatsCount;
+    InstanceData.Revision = Revision;
+    if (bWritable)
+    {
+        // The source's live buffers may already be deformed, so the new instance starts from its rest pose
+        const uint32 Bytes = uint32(InstanceData.SplatsCount) * sizeof(FVector4f);
+        CreateDeformBuffers(RHICmdList, InstanceData.Deform, InstanceData.SplatsCount);
+        FRHIBuffer *SourceBuffers[2] = {Source->Deform.RestPositions.Buffer, Source->Deform.RestSHZero.Buffer};
+        FRHIBuffer *DestBuffers[2] = {InstanceData.Deform.RestPositions.Buffer, InstanceData.Deform.RestSHZero.Buffer};
+        for (int32 Stream = 0; Stream < 2; ++Stream)
+        {
+            RHICmdList.Transition({FRHITransitionInfo(SourceBuffers[Stream], ERHIAccess::Unknown, ERHIAccess::CopySrc),
+                                   FRHITransitionInfo(DestBuffers[Stream], ERHIAccess::Unknown, ERHIAccess::CopyDest)});
+            RHICmdList.CopyBufferRegion(DestBuffers[Stream], 0, SourceBuffers[Stream], 0, Bytes);
+            RHICmdList.Transition({FRHITransitionInfo(SourceBuffers[Stream], ERHIAccess::CopySrc, ERHIAccess::SRVMask),
+                                   FRHITransitionInfo(DestBuffers[Stream], ERHIAccess::CopyDest, ERHIAccess::SRVMask)});
+        }
+    }
+    UpdateGPUMemoryStat();
+
+    UE_LOG(LogTemp, Verbose, TEXT("[Proxy::ShareUpload] %d splats | Interleaved=%d | ArenaOffset=%u"),
+           InstanceData.SplatsCount, Layout == EGaussianSplatBufferLayout::Interleaved,
+           GetArena(Layout).GetRange(InstanceData.Allocation).Offset);
+    return true;
+}
+
+void FNDIGaussianSplatProxy::CreateDeformBuffers(FRHICommandListImmediate &RHICmdList,
+                                                 FGaussianSplatDeformBuffers_RT &Deform, uint32 NumSplats)
+{
+    // Range edits and upload slices lock the rest pose in sub-ranges, so it must be static: a partial lock on a
+    // dynamic buffer may rename it and drop everything outside the range
+    const EBufferUsageFlags RestUsage = BUF_Static | BUF_ShaderResource | BUF_SourceCopy;
+    const EBufferUsageFlags LiveUsage = BUF_Static | BUF_ShaderResource | BUF_UnorderedAccess | BUF_SourceCopy;
+    CreateBuffer(RHICmdList, Deform.RestPositions, NumSplats, sizeof(FVector4f), TEXT("GSplat_RestPositions"),
+                 PF_A32B32G32R32F, RestUsage);
+    CreateBuffer(RHICmdList, Deform.RestSHZero, NumSplats, sizeof(FVector4f), TEXT("GSplat_RestSHZero"),
+                 PF_A32B32G32R32F, RestUsage);
+    for (int32 i = 0; i < 2; ++i)
+    {
+        CreateBuffer(RHICmdList, Deform.LivePositions[i], NumSplats, sizeof(FVector4f), TEXT("GSplat_LivePositions"),
+                     PF_A32B32G32R32F, LiveUsage);
+        CreateBuffer(RHICmdList, Deform.LiveSHZero[i], NumSplats, sizeof(FVector4f), TEXT("GSplat_LiveSHZero"),
+                     PF_A32B32G32R32F, LiveUsage);
+    }
+    Deform.bResetPending = true;
+}
+
+bool FNDIGaussianSplatProxy::IsAllocationShared(const FGaussianSplatInstanceData_RT &InstanceData) const
+{
+    for (const auto &Pair : SystemInstancesToData_RT)
+    {
+        const FGaussianSplatInstanceData_RT &Other = Pair.Value;
+        if (&Other != &InstanceData && Other.Layout == InstanceData.Layout &&
+            Other.Allocation == InstanceData.Allocation)
+            return true;
+    }
+    return false;
+}
+
+void FNDIGaussianSplatProxy::UploadRecords(FRHICommandListImmediate &RHICmdList,
+                                           const FGaussianSplatInstanceData_RT &InstanceData, uint32 FirstElement,
+                                           TConstArrayView<FGaussianSplatPackedRecord> Records)
+{
+    check(IsInRenderingThread());
+    if (!InstanceData.HasAllocation() || Records.Num() == 0)
+        return;
+
+    GSPLAT_SCOPE(Upload);
+    INC_DWORD_STAT_BY(STAT_GaussianSplat_UploadedBytes, Records.Num() * FGaussianSplatBufferArena::BytesPerSplat);
+
+    FGaussianSplatBufferArena &TargetArena = GetArena(InstanceData.Layout);
+    const FGaussianSplatBufferArena::FHandle Handle = InstanceData.Allocation;
+    const uint32 Count = Records.Num();
+
+    // The rest pose follows edits; deformed live values stay until the next reset
+    const FGaussianSplatDeformBuffers_RT &Deform = InstanceData.Deform;
+    if (Deform.IsValid())
+    {
+        SplitIntoUploadScratch(Records);
+        auto UploadRest = [&RHICmdList, FirstElement, Count](const FGaussianSplatBuffer &Rest,
+                                                            const TArray<FVector4f> &Values)
+        {
+            const uint32 Size = Count * sizeof(FVector4f);
+            void *Mapped = RHICmdList.LockBuffer(Rest.Buffer, FirstElement * sizeof(FVector4f), Size, RLM_WriteOnly);
+            if (Mapped)
+            {
+                FMemory::Memcpy(Mapped, Values.GetData(), Size);
+                RHICmdList.UnlockBuffer(Rest.Buffer);
+            }
+        };
+        UploadRest(Deform.RestPositions, UploadScratch.Positions);
+        UploadRest(Deform.RestSHZero, UploadScratch.SHZeroCoeffsAndOpacity);
+    }
+
+    if (InstanceData.Layout == EGaussianSplatBufferLayout::Interleaved)
+    {
+        // Records already match the GPU layout
+        TargetArena.UploadRecords(RHICmdList, Handle, FirstElement, Records.GetData(), Count);
+        return;
+    }
+
+    if (!Deform.IsValid())
+        SplitIntoUploadScratch(Records);
+    TargetArena.Upload(RHICmdList, Handle, FGaussianSplatBufferArena::Stream_Positions, FirstElement,
+                       UploadScratch.Positions.GetData(), Count);
+    TargetArena.Upload(RHICmdList, Handle, FGaussianSplatBufferArena::Stream_Scales, FirstElement,
+                       UploadScratch.Scales.GetData(), Count);
+    TargetArena.Upload(RHICmdList, Handle, FGaussianSplatBufferArena::Stream_Orientations, FirstElement,
+                       UploadScratch.Orientations.GetData(), Count);
+    TargetArena.Upload(RHICmdList, Handle, FGaussianSplatBufferArena::Stream_SHZeroCoeffsAndOpacity, FirstElement,
+                       UploadScratch.SHZeroCoeffsAndOpacity.GetData(), Count);
+}
+
+void FNDIGaussianSplatProxy::ReleaseInstanceData(FRHICommandListImmediate &RHICmdList,
+                                                 FGaussianSplatInstanceData_RT &InstanceData)
+{
+    check(IsInRenderingThread());
+    ClearPendingRecords(InstanceData);
+    if (InstanceData.HasAllocation() && !IsAllocationShared(InstanceData))
+        GetArena(InstanceData.Layout).Free(RHICmdList, InstanceData.Allocation);
+    InstanceData.Allocation = INDEX_NONE;
+    InstanceData.SplatsCount = 0;
+    // Sized to the old splat count; the next cull reallocates
+    InstanceData.VisibleCountBuffer.Release();
+    InstanceData.VisibleIndicesBuffer.Release();
+    InstanceData.CullGroupOffsetsBuffer.Release();
+    InstanceData.Raster.Release();
+    InstanceData.Deform.Release();
+    UpdateGPUMemoryStat();
+}
+
+void FNDIGaussianSplatProxy::SplitIntoUploadScratch(TConstArrayView<FGaussianSplatPackedRecord> Records)
+{
+    FGaussianSplatPacking::SplitRecords(Records, UploadScratch);
+    UploadScratchBytes.store(int64(UploadScratch.GetAllocatedSize()), std::memory_order_relaxed);
+}
 
-    for (int32 i = 0; i < NumSplats; ++i)
+FGaussianSplatGPUMemory FNDIGaussianSplatProxy::GetGPUMemory() const
+{
+    // The 1 element fallbacks are shared and too small to matter. Every attribute stream is a float4 per element.
+    constexpr int64 Stride = sizeof(FVector4f);
+    FGaussianSplatGPUMemory Memory;
+    auto AddToStreams = [&Memory](int64 Bytes)
     {
-        const FGaussianSplatData &S = SplatsData[i];
-        Positions[i] = FVector4f(S.Position.X, S.Position.Y, S.Position.Z, 0.f);
-        Scales[i] = FVector4f(S.Scale.X, S.Scale.Y, S.Scale.Z, 0.f);
-        Orientations[i] = FVector4f(S.Orientation.X, S.Orientation.Y, S.Orientation.Z, S.Orientation.W);
-        SHOpacity[i] = FVector4f(S.ZeroOrderHarmonicsCoefficients.X, S.ZeroOrderHarmonicsCoefficients.Y,
-                                 S.ZeroOrderHarmonicsCoefficients.Z, S.Opacity);
+        Memory.Positions += Bytes;
+        Memory.Scales += Bytes;
+        Memory.Orientations += Bytes;
+        Memory.SHZeroCoeffsAndOpacity += Bytes;
+    };
+    AddToStreams(Arena.GetStats().CapacityElements * Stride);
+    Memory.Records += InterleavedArena.GetStats().CapacityElements * FGaussianSplatBufferArena::BytesPerSplat;
+    AddToStreams(int64(StreamingPool.PositionsBuffer.NumElements) * Stride);
+    AddToStreams(int64(SequenceBuffers.Capacity) * 2 * Stride);
+
+    Memory.Tables += int64(StreamingPool.IndirectionBuffer.NumElements) * sizeof(uint32);
+    Memory.Tables += int64(CloudOffsetsBuffer.NumElements + SpatialCellStartsBuffer.NumElements) * sizeof(uint32);
+    Memory.Tables += int64(SpatialSplatsBuffer.NumElements) * Stride;
+    Memory.Tables += int64(CloudTintsBuffer.NumElements + CloudInstancesBuffer.NumElements) * Stride;
+
+    for (const auto &Pair : SystemInstancesToData_RT)
+    {
+        const FGaussianSplatInstanceData_RT &InstanceData = Pair.Value;
+        Memory.Culling +=
+            int64(InstanceData.VisibleCountBuffer.NumElements + InstanceData.VisibleIndicesBuffer.NumElements +
+                  InstanceData.CullGroupOffsetsBuffer.NumElements) *
+            sizeof(uint32);
+        Memory.Raster += InstanceData.Raster.GetBytes();
+        const FGaussianSplatDeformBuffers_RT &Deform = InstanceData.Deform;
+        Memory.Positions += int64(Deform.RestPositions.NumElements + Deform.LivePositions[0].NumElements +
+                                  Deform.LivePositions[1].NumElements) *
+                            Stride;
+        Memory.SHZeroCoeffsAndOpacity += int64(Deform.RestSHZero.NumElements + Deform.LiveSHZero[0].NumElements +
+                                               Deform.LiveSHZero[1].NumElements) *
+                                         Stride;
     }
+    return Memory;
+}
 
-    const uint32 DataSize = NumSplats * BytesPerElement;
-    auto Upload = [&RHICmdList, DataSize](const FGaussianSplatBuffer &Buf, const void *Data, const TCHAR *Name)
+void FNDIGaussianSplatProxy::UpdateGPUMemoryStat()
+{
+    const FGaussianSplatGPUMemory Memory = GetGPUMemory();
     {
-        if (!Buf.IsValid() || !Data)
+        FScopeLock Lock(&AccountedGPUMemoryLock);
+        AccountedGPUMemory = Memory;
+    }
+
+    const int64 Bytes = Memory.GetTotal();
+    const int64 Accounted = AccountedGPUBytes.load(std::memory_order_relaxed);
+    if (Bytes > Accounted)
+        INC_MEMORY_STAT_BY(STAT_GaussianSplat_GPUMemory, Bytes - Accounted);
+    else if (Bytes < Accounted)
+        DEC_MEMORY_STAT_BY(STAT_GaussianSplat_GPUMemory, Accounted - Bytes);
+    AccountedGPUBytes.store(Bytes, std::memory_order_relaxed);
+}
+
+void FNDIGaussianSplatProxy::EnsureFallbackBuffers(FRHICommandListImmediate &RHICmdList)
+{
+    check(IsInRenderingThread());
+    auto CreateZeroed = [this, &RHICmdList](FGaussianSplatBuffer &Buf, uint32 BytesPerElement, const TCHAR *Name,
+                                            EPixelFormat Format)
+    {
+        if (Buf.IsValid())
             return;
-        void *Mapped = RHICmdList.LockBuffer(Buf.Buffer, 0, DataSize, RLM_WriteOnly);
+        CreateBuffer(RHICmdList, Buf, 1, BytesPerElement, Name, Format);
+        void *Mapped = RHICmdList.LockBuffer(Buf.Buffer, 0, BytesPerElement, RLM_WriteOnly);
         if (Mapped)
         {
-            FMemory::Memcpy(Mapped, Data, DataSize);
+            FMemory::Memzero(Mapped, BytesPerElement);
             RHICmdList.UnlockBuffer(Buf.Buffer);
         }
-        UE_LOG(LogTemp, Warning, TEXT("[Proxy::InitializeAndUpload] %s | %d bytes written"), Name, DataSize);
     };
+    // SplatsCount stays 0 for instances bound to these — shader will read nothing
+    CreateZeroed(FallbackBuffer, sizeof(FVector4f), TEXT("GSplat_Fallback"), PF_A32B32G32R32F);
+    CreateZeroed(FallbackIndirectionBuffer, sizeof(uint32), TEXT("GSplat_Fallback_Indirection"), PF_R32_UINT);
+    if (!FallbackUAVBuffer.IsValid())
+        CreateBuffer(RHICmdList, FallbackUAVBuffer, 1, sizeof(FVector4f), TEXT("GSplat_Fallback_UAV"),
+                     PF_A32B32G32R32F, BUF_Static | BUF_ShaderResource | BUF_UnorderedAccess);
+
+    if (!FallbackCloudTintBuffer.IsValid())
+    {
+        CreateBuffer(RHICmdList, FallbackCloudTintBuffer, 1, sizeof(FVector4f), TEXT("GSplat_Fallback_CloudTint"));
+        void *Mapped = RHICmdList.LockBuffer(FallbackCloudTintBuffer.Buffer, 0, sizeof(FVector4f), RLM_WriteOnly);
+        if (Mapped)
+        {
+            *static_cast<FVector4f *>(Mapped) = FVector4f(1.0f, 1.0f, 1.0f, 1.0f);
+            RHICmdList.UnlockBuffer(FallbackCloudTintBuffer.Buffer);
+        }
+    }
 
-    Upload(InstanceData.PositionsBuffer, Positions.GetData(), TEXT("Positions"));
-    Upload(InstanceData.ScalesBuffer, Scales.GetData(), TEXT("Scales"));
-    Upload(InstanceData.OrientationsBuffer, Orientations.GetData(), TEXT("Orientations"));
-    Upload(InstanceData.SHZeroCoeffsAndOpacityBuffer, SHOpacity.GetData(), TEXT("SHOpacity"));
+    // The record fallback is a raw buffer, which CreateBuffer does not make
+    if (!FallbackRecordBuffer.IsValid())
+    {
+        const uint32 Size = sizeof(FGaussianSplatPackedRecord);
+        FRHIResourceCreateInfo CreateInfo(TEXT("GSplat_Fallback_Records"));
+        FallbackRecordBuffer.Buffer = RHICmdList.CreateStructuredBuffer(
+            sizeof(uint32), Size, BUF_ShaderResource | BUF_Static | BUF_ByteAddressBuffer, CreateInfo);
+        FallbackRecordBuffer.SRV = RHICmdList.CreateShaderResourceView(FallbackRecordBuffer.Buffer);
+        FallbackRecordBuffer.NumElements = 1;
+        void *Mapped = RHICmdList.LockBuffer(FallbackRecordBuffer.Buffer, 0, Size, RLM_WriteOnly);
+        if (Mapped)
+        {
+            FMemory::Memzero(Mapped, Size);
+            RHICmdList.UnlockBuffer(FallbackRecordBuffer.Buffer);
+        }
+    }
+}
+
+void FNDIGaussianSplatProxy::InitStreamingPool(FRHICommandListImmediate &RHICmdList, uint32 PoolElements)
+{
+    check(IsInRenderingThread());
+    StreamingPool.Release();
+
+    // Tiles are written into sub-ranges, so the pool must be static: a partial lock on a dynamic buffer may rename it
+    const uint32 BytesPerElement = sizeof(FVector4f);
+    const EPixelFormat Format = PF_A32B32G32R32F;
+    const EBufferUsageFlags Usage = BUF_ShaderResource | BUF_Static;
+    CreateBuffer(RHICmdList, StreamingPool.PositionsBuffer, PoolElements, BytesPerElement, TEXT("GSplat_Pool_Pos"),
+                 Format, Usage);
+    CreateBuffer(RHICmdList, StreamingPool.ScalesBuffer, PoolElements, BytesPerElement, TEXT("GSplat_Pool_Scl"),
+                 Format, Usage);
+    CreateBuffer(RHICmdList, StreamingPool.OrientationsBuffer, PoolElements, BytesPerElement,
+                 TEXT("GSplat_Pool_Ori"), Format, Usage);
+    CreateBuffer(RHICmdList, StreamingPool.SHZeroCoeffsAndOpacityBuffer, PoolElements, BytesPerElement,
+                 TEXT("GSplat_Pool_SH"), Format, Usage);
+    // Indirection is sized to the pool so it never needs reallocating as residency changes
+    CreateBuffer(RHICmdList, StreamingPool.IndirectionBuffer, PoolElements, sizeof(uint32),
+                 TEXT("GSplat_Pool_Indirection"), PF_R32_UINT, Usage);
+    StreamingPool.ResidentSplats = 0;
+    UpdateGPUMemoryStat();
 
-    UE_LOG(LogTemp, Warning, TEXT("[Proxy::InitializeAndUpload] COMPLETE | %d splats | Valid=%d"), NumSplats,
-           InstanceData.AreBuffersValid());
+    UE_LOG(LogTemp, Log, TEXT("[Proxy::InitStreamingPool] %u elements | Valid=%d"), PoolElements,
+           StreamingPool.IsValid());
 }
 
-void FNDIGaussianSplatProxy::CreateFallbackBuffers(FRHICommandListImmediate &RHICmdList,
-                                                   FGaussianSplatInstanceData_RT &InstanceData)
+void FNDIGaussianSplatProxy::UploadStreamingTiles(FRHICommandListImmediate &RHICmdList,
+                                                  const TArray<FGaussianSplatTileUpload> &Uploads,
+                                                  uint32 TileCapacity)
 {
     check(IsInRenderingThread());
-    if (InstanceData.AreBuffersValid())
+    if (!StreamingPool.IsValid())
         return;
 
+    GSPLAT_SCOPE(Upload);
+    for (const FGaussianSplatTileUpload &Upload : Uploads)
+    {
+        const int32 Count = Upload.Records.Num();
+        if (Count == 0)
+            continue;
+
+        const uint64 Offset = uint64(Upload.Slot) * TileCapacity * sizeof(FVector4f);
+        const uint32 Size = Count * sizeof(FVector4f);
+        if (Offset + Size > uint64(StreamingPool.PositionsBuffer.NumElements) * sizeof(FVector4f))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[Proxy::UploadStreamingTiles] slot %d lies outside the pool"), Upload.Slot);
+            continue;
+        }
+
+        // Records are interleaved on disk; split them back into the four streams
+        SplitIntoUploadScratch(Upload.Records);
+        auto UploadStream = [&](const FGaussianSplatBuffer &Buf, const TArray<FVector4f> &Data)
+        {
+            void *Mapped = RHICmdList.LockBuffer(Buf.Buffer, uint32(Offset), Size, RLM_WriteOnly);
+            if (Mapped)
+            {
+                FMemory::Memcpy(Mapped, Data.GetData(), Size);
+                RHICmdList.UnlockBuffer(Buf.Buffer);
+            }
+        };
+        UploadStream(StreamingPool.PositionsBuffer, UploadScratch.Positions);
+        UploadStream(StreamingPool.ScalesBuffer, UploadScratch.Scales);
+        UploadStream(StreamingPool.OrientationsBuffer, UploadScratch.Orientations);
+        UploadStream(StreamingPool.SHZeroCoeffsAndOpacityBuffer, UploadScratch.SHZeroCoeffsAndOpacity);
+    }
+}
+
+void FNDIGaussianSplatProxy::UploadStreamingIndirection(FRHICommandListImmediate &RHICmdList,
+                                                        const TArray<uint32> &Indirection)
+{
+    check(IsInRenderingThread());
+    if (!StreamingPool.IsValid())
+        return;
+
+    const int32 Count = FMath::Min<int32>(Indirection.Num(), StreamingPool.IndirectionBuffer.NumElements);
+    if (Count > 0)
+    {
+        const uint32 Size = Count * sizeof(uint32);
+        void *Mapped = RHICmdList.LockBuffer(StreamingPool.IndirectionBuffer.Buffer, 0, Size, RLM_WriteOnly);
+        if (Mapped)
+        {
+            FMemory::Memcpy(Mapped, Indirection.GetData(), Size);
+            RHICmdList.UnlockBuffer(StreamingPool.IndirectionBuffer.Buffer);
+        }
+    }
+    StreamingPool.ResidentSplats = Count;
+}
+
+void FNDIGaussianSplatProxy::InitSequenceBuffers(FRHICommandListImmediate &RHICmdList, uint32 MaxSplats)
+{
+    check(IsInRenderingThread());
+    if (SequenceBuffers.IsValid() && SequenceBuffers.Capacity >= MaxSplats)
+        return;
+    SequenceBuffers.Release();
+
+    // Frames overwrite only their own prefix of a set, so the buffers are static like the streaming pool
+    const uint32 NumElements = FMath::Max(MaxSplats, 1u);
     const uint32 BytesPerElement = sizeof(FVector4f);
-    CreateBuffer(RHICmdList, InstanceData.PositionsBuffer, 1, BytesPerElement, TEXT("GSplat_Fallback_Pos"));
-    CreateBuffer(RHICmdList, InstanceData.ScalesBuffer, 1, BytesPerElement, TEXT("GSplat_Fallback_Scl"));
-    CreateBuffer(RHICmdList, InstanceData.OrientationsBuffer, 1, BytesPerElement, TEXT("GSplat_Fallback_Ori"));
-    CreateBuffer(RHICmdList, InstanceData.SHZeroCoeffsAndOpacityBuffer, 1, BytesPerElement, TEXT("GSplat_Fallback_SH"));
-    // SplatsCount stays 0 — shader will read nothing
-    UE_LOG(LogTemp, Warning, TEXT("[Proxy::CreateFallbackBuffers] Done | Valid=%d"), InstanceData.AreBuffersValid());
+    const EPixelFormat Format = PF_A32B32G32R32F;
+    const EBufferUsageFlags Usage = BUF_ShaderResource | BUF_Static;
+    for (FGaussianSplatSequenceBuffers_RT::FSet &Set : SequenceBuffers.Sets)
+    {
+        CreateBuffer(RHICmdList, Set.PositionsBuffer, NumElements, BytesPerElement, TEXT("GSplat_Seq_Pos"), Format,
+                     Usage);
+        CreateBuffer(RHICmdList, Set.ScalesBuffer, NumElements, BytesPerElement, TEXT("GSplat_Seq_Scl"), Format,
+                     Usage);
+        CreateBuffer(RHICmdList, Set.OrientationsBuffer, NumElements, BytesPerElement, TEXT("GSplat_Seq_Ori"), Format,
+                     Usage);
+        CreateBuffer(RHICmdList, Set.SHZeroCoeffsAndOpacityBuffer, NumElements, BytesPerElement, TEXT("GSplat_Seq_SH"),
+                     Format, Usage);
+        Set.SplatCount = 0;
+    }
+    SequenceBuffers.Capacity = NumElements;
+    UpdateGPUMemoryStat();
+
+    UE_LOG(LogTemp, Log, TEXT("[Proxy::InitSequenceBuffers] 2 x %u elements | Valid=%d"), NumElements,
+           SequenceBuffers.IsValid());
+}
+
+void FNDIGaussianSplatProxy::UploadSequenceFrame(FRHICommandListImmediate &RHICmdList,
+                                                 const FGaussianSplatSequenceFrame &Frame)
+{
+    check(IsInRenderingThread());
+    if (!SequenceBuffers.IsValid())
+        return;
+
+    GSPLAT_SCOPE(Upload);
+    const int32 Count = FMath::Min(Frame.Records.Num(), int32(SequenceBuffers.Capacity));
+    const int32 Back = 1 - SequenceBuffers.Front;
+    FGaussianSplatSequenceBuffers_RT::FSet &Set = SequenceBuffers.Sets[Back];
+    if (Count > 0)
+    {
+        SplitIntoUploadScratch(MakeArrayView(Frame.Records.GetData(), Count));
+        const uint32 Size = Count * sizeof(FVector4f);
+        auto UploadStream = [&](const FGaussianSplatBuffer &Buf, const TArray<FVector4f> &Data)
+        {
+            void *Mapped = RHICmdList.LockBuffer(Buf.Buffer, 0, Size, RLM_WriteOnly);
+            if (Mapped)
+            {
+                FMemory::Memcpy(Mapped, Data.GetData(), Size);
+                RHICmdList.UnlockBuffer(Buf.Buffer);
+            }
+        };
+        UploadStream(Set.PositionsBuffer, UploadScratch.Positions);
+        UploadStream(Set.ScalesBuffer, UploadScratch.Scales);
+        UploadStream(Set.OrientationsBuffer, UploadScratch.Orientations);
+        UploadStream(Set.SHZeroCoeffsAndOpacityBuffer, UploadScratch.SHZeroCoeffsAndOpacity);
+    }
+    Set.SplatCount = Count;
+    SequenceBuffers.Front = Back;
+    SequenceBuffers.FrameIndex = Frame.FileFrame;
+}
+
+void FNDIGaussianSplatProxy::UploadCloudTable(FRHICommandListImmediate &RHICmdList, const TArray<uint32> &Offsets,
+                                              const TArray<FVector4f> &Tints)
+{
+    check(IsInRenderingThread());
+    CloudOffsetsBuffer.Release();
+    CloudTintsBuffer.Release();
+    NumClouds = Tints.Num();
+    if (NumClouds == 0 || Offsets.Num() != NumClouds + 1)
+    {
+        NumClouds = 0;
+        UpdateGPUMemoryStat();
+        return;
+    }
+    CreateAndFillBuffer(RHICmdList, CloudOffsetsBuffer, Offsets.GetData(), Offsets.Num(), sizeof(uint32),
+                        TEXT("GSplat_CloudOffsets"), PF_R32_UINT);
+    CreateAndFillBuffer(RHICmdList, CloudTintsBuffer, Tints.GetData(), Tints.Num(), sizeof(FVector4f),
+                        TEXT("GSplat_CloudTints"), PF_A32B32G32R32F);
+    UpdateGPUMemoryStat();
+}
+
+void FNDIGaussianSplatProxy::UploadSpatialGrid(FRHICommandListImmediate &RHICmdList, const TArray<uint32> &CellStarts,
+                                               const TArray<FVector4f> &PackedSplats, const FVector3f &Origin,
+                                               float InvCellSize, const FIntVector &Dims)
+{
+    check(IsInRenderingThread());
+    SpatialCellStartsBuffer.Release();
+    SpatialSplatsBuffer.Release();
+    SpatialGridDims = FIntVector::ZeroValue;
+    if (PackedSplats.Num() == 0 || CellStarts.Num() != Dims.X * Dims.Y * Dims.Z + 1)
+    {
+        UpdateGPUMemoryStat();
+        return;
+    }
+
+    CreateAndFillBuffer(RHICmdList, SpatialCellStartsBuffer, CellStarts.GetData(), CellStarts.Num(), sizeof(uint32),
+                        TEXT("GSplat_SpatialCellStarts"), PF_R32_UINT);
+    CreateAndFillBuffer(RHICmdList, SpatialSplatsBuffer, PackedSplats.GetData(), PackedSplats.Num(),
+                        sizeof(FVector4f), TEXT("GSplat_SpatialSplats"), PF_A32B32G32R32F);
+    SpatialGridOrigin = Origin;
+    SpatialGridInvCellSize = InvCellSize;
+    SpatialGridDims = Dims;
+    UpdateGPUMemoryStat();
+}
+
+void FNDIGaussianSplatProxy::UploadCloudInstances(FRHICommandListImmediate &RHICmdList,
+                                                  const TArray<FVector4f> &PackedInstances)
+{
+    check(IsInRenderingThread());
+    constexpr int32 Float4sPerInstance = 3;
+    const int32 NewNumInstances = PackedInstances.Num() / Float4sPerInstance;
+    if (NewNumInstances == 0)
+    {
+        CloudInstancesBuffer.Release();
+        NumCloudInstances = 0;
+        UpdateGPUMemoryStat();
+        return;
+    }
+
+    if (NewNumInstances != NumCloudInstances || !CloudInstancesBuffer.IsValid())
+    {
+        CloudInstancesBuffer.Release();
+        CreateBuffer(RHICmdList, CloudInstancesBuffer, uint32(PackedInstances.Num()), sizeof(FVector4f),
+                     TEXT("GSplat_CloudInstances"));
+        NumCloudInstances = NewNumInstances;
+        UpdateGPUMemoryStat();
+    }
+
+    const uint32 Size = uint32(PackedInstances.Num()) * sizeof(FVector4f);
+    void *Mapped = RHICmdList.LockBuffer(CloudInstancesBuffer.Buffer, 0, Size, RLM_WriteOnly);
+    if (Mapped)
+    {
+        FMemory::Memcpy(Mapped, PackedInstances.GetData(), Size);
+        RHICmdList.UnlockBuffer(CloudInstancesBuffer.Buffer);
+    }
+}
+
+void FNDIGaussianSplatProxy::ConsumePerInstanceDataFromGameThread(void *PerInstanceData,
+                                                                 const FNiagaraSystemInstanceID &Instance)
+{
+    FGaussianSplatCullParams *Params = static_cast<FGaussianSplatCullParams *>(PerInstanceData);
+    if (FGaussianSplatInstanceData_RT *InstanceData = SystemInstancesToData_RT.Find(Instance))
+        InstanceData->Cull = *Params;
+    Params->~FGaussianSplatCullParams();
+}
+
+void FNDIGaussianSplatProxy::ResetDeformation()
+{
+    for (TPair<FNiagaraSystemInstanceID, FGaussianSplatInstanceData_RT> &Pair : SystemInstancesToData_RT)
+        Pair.Value.Deform.bResetPending = true;
+}
+
+void FNDIGaussianSplatProxy::PreStage(const FNDIGpuComputePreStageContext &Context)
+{
+    FGaussianSplatInstanceData_RT *InstanceData = SystemInstancesToData_RT.Find(Context.GetSystemInstanceID());
+    if (!InstanceData || !InstanceData->HasAllocation() || InstanceData->SplatsCount <= 0)
+        return;
+
+    // Every stage of every emitter reading this instance calls in; the first one each frame flips and culls, so the
+    // cull sees last frame's writes
+    FGaussianSplatDeformBuffers_RT &Deform = InstanceData->Deform;
+    if (Deform.IsValid() && Deform.LastFlipFrame != GFrameNumberRenderThread)
+    {
+        Deform.LastFlipFrame = GFrameNumberRenderThread;
+        AddDeformFlipPass(Context.GetGraphBuilder(), *InstanceData);
+    }
+
+    if (!InstanceData->Cull.bEnabled || InstanceData->LastCulledFrame == GFrameNumberRenderThread)
+        return;
+    InstanceData->LastCulledFrame = GFrameNumberRenderThread;
+    AddCullPass(Context.GetGraphBuilder(), Context.GetSystemInstanceID(), *InstanceData);
+}
+
+void FNDIGaussianSplatProxy::AddCullPass(FRDGBuilder &GraphBuilder, const FNiagaraSystemInstanceID &InstanceID,
+                                         FGaussianSplatInstanceData_RT &InstanceData)
+{
+    check(IsInRenderingThread());
+    FRHICommandListImmediate &RHICmdList = GraphBuilder.RHICmdList;
+    const uint32 NumSplats = uint32(InstanceData.GetResidentCount());
+
+    // The previous count is collected before the next copy is queued
+    if (InstanceData.bReadbackPending && InstanceData.VisibleCountReadback->IsReady())
+    {
+        const uint32 *Count = static_cast<const uint32 *>(InstanceData.VisibleCountReadback->Lock(sizeof(uint32)));
+        {
+            FScopeLock Lock(&VisibleCountsLock);
+            VisibleCounts.Add(InstanceID, int32(*Count));
+        }
+        InstanceData.VisibleCountReadback->Unlock();
+        InstanceData.bReadbackPending = false;
+    }
+
+    EnsureFallbackBuffers(RHICmdList);
+    const uint32 NumGroups = FMath::Max(FMath::DivideAndRoundUp(NumSplats, FGaussianSplatCullCS::ThreadGroupSize), 1u);
+    // Sized for the whole cloud, so a time-sliced upload does not reallocate as its resident count grows
+    const uint32 Capacity = uint32(FMath::Max(InstanceData.SplatsCount, 1));
+    if (InstanceData.VisibleIndicesBuffer.NumElements < Capacity)
+    {
+        const EBufferUsageFlags Usage = BUF_Static | BUF_ShaderResource | BUF_UnorderedAccess;
+        InstanceData.VisibleIndicesBuffer.Release();
+        CreateBuffer(RHICmdList, InstanceData.VisibleIndicesBuffer, Capacity, sizeof(uint32),
+                     TEXT("GSplat_VisibleIndices"), PF_R32_UINT, Usage);
+        InstanceData.CullGroupOffsetsBuffer.Release();
+        CreateBuffer(RHICmdList, InstanceData.CullGroupOffsetsBuffer,
+                     FMath::DivideAndRoundUp(Capacity, FGaussianSplatCullCS::ThreadGroupSize), sizeof(uint32),
+                     TEXT("GSplat_CullGroupOffsets"), PF_R32_UINT, Usage);
+        if (!InstanceData.VisibleCountBuffer.IsValid())
+            CreateBuffer(RHICmdList, InstanceData.VisibleCountBuffer, 1, sizeof(uint32), TEXT("GSplat_VisibleCount"),
+                         PF_R32_UINT, Usage | BUF_SourceCopy);
+        UpdateGPUMemoryStat();
+    }
+    if (!InstanceData.VisibleCountReadback)
+        InstanceData.VisibleCountReadback = MakeUnique<FRHIGPUBufferReadback>(TEXT("GSplat_VisibleCountReadback"));
+
+    // Writable instances are culled where their splats are now, not where they were uploaded
+    const FGaussianSplatBufferArena &TargetArena = GetArena(InstanceData.Layout);
+    const FGaussianSplatDeformBuffers_RT &Deform = InstanceData.Deform;
+    const bool bDeformed = Deform.IsValid();
+    const bool bInterleaved = !bDeformed && InstanceData.Layout == EGaussianSplatBufferLayout::Interleaved;
+    const FGaussianSplatCullParams &Cull = InstanceData.Cull;
+
+    static_assert(FGaussianSplatCullParams::MaxPlanes == FGaussianSplatCullCS::MaxPlanes, "Plane counts must match");
+    FGaussianSplatCullCS::FParameters Parameters;
+    Parameters.NumSplats = NumSplats;
+    Parameters.BaseOffset = bDeformed ? 0 : TargetArena.GetRange(InstanceData.Allocation).Offset;
+    Parameters.NumPlanes = uint32(Cull.NumPlanes);
+    Parameters.RadiusScale = Cull.RadiusScale;
+    for (int32 i = 0; i < FGaussianSplatCullParams::MaxPlanes; ++i)
+        Parameters.Planes[i] = Cull.Planes[i];
+    Parameters.DepthPlane = Cull.DepthPlane;
+    Parameters.PixelScale = Cull.PixelScale;
+    Parameters.MinPixelRadius = Cull.GetSubPixelRadius();
+    if (bDeformed)
+        Parameters.Positions = Deform.LivePositions[Deform.Front].SRV;
+    else
+        Parameters.Positions = bInterleaved ? FallbackBuffer.SRV.GetReference()
+                                            : TargetArena.GetSRV(FGaussianSplatBufferArena::Stream_Positions);
+    Parameters.SplatRecords = bInterleaved ? TargetArena.GetRecordsSRV() : FallbackRecordBuffer.SRV.GetReference();
+    Parameters.NumGroups = NumGroups;
+    Parameters.GroupOffsets = InstanceData.CullGroupOffsetsBuffer.UAV;
+    Parameters.VisibleIndices = InstanceData.VisibleIndicesBuffer.UAV;
+
+    const FIntVector GroupCount = GaussianSplatProxy::GetLinearGroupCount(
+        NumSplats, FGaussianSplatCullCS::ThreadGroupSize, Parameters.DispatchWidth);
+
+    FGaussianSplatCullScanCS::FParameters ScanParameters;
+    ScanParameters.NumGroups = Parameters.NumGroups;
+    ScanParameters.GroupOffsets = InstanceData.CullGroupOffsetsBuffer.UAV;
+    ScanParameters.VisibleCount = InstanceData.VisibleCountBuffer.UAV;
+
+    FGlobalShaderMap *ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+    FGaussianSplatCullCS::FPermutationDomain Permutation;
+    Permutation.Set<FGaussianSplatCullCS::FInterleavedDim>(bInterleaved);
+    TShaderMapRef<FGaussianSplatCullCS> CountShader(ShaderMap, Permutation);
+    Permutation.Set<FGaussianSplatCullCS::FWriteDim>(true);
+    TShaderMapRef<FGaussianSplatCullCS> WriteShader(ShaderMap, Permutation);
+    TShaderMapRef<FGaussianSplatCullScanCS> ScanShader(ShaderMap);
+
+    FRHIUnorderedAccessView *CountUAV = InstanceData.VisibleCountBuffer.UAV;
+    FRHIUnorderedAccessView *OffsetsUAV = InstanceData.CullGroupOffsetsBuffer.UAV;
+    FRHIUnorderedAccessView *IndicesUAV = InstanceData.VisibleIndicesBuffer.UAV;
+    FRHIBuffer *CountBuffer = InstanceData.VisibleCountBuffer.Buffer;
+    FRHIGPUBufferReadback *Readback = InstanceData.bReadbackPending ? nullptr : InstanceData.VisibleCountReadback.Get();
+    InstanceData.bReadbackPending = true;
+
+    // The splat buffers are plain RHI resources bound outside the graph, so the pass transitions them itself and
+    // leaves the results readable by the simulation that follows
+    GraphBuilder.AddPass(
+        RDG_EVENT_NAME("GaussianSplatCull (%u splats)", NumSplats), ERDGPassFlags::None,
+        [CountShader, WriteShader, ScanShader, Parameters, ScanParameters, GroupCount, CountUAV, OffsetsUAV,
+         IndicesUAV, CountBuffer, Readback](FRHICommandListImmediate &RHICmdList)
+        {
+            // Count per group, scan the counts into offsets, then write each group's survivors at its offset
+            RHICmdList.Transition({FRHITransitionInfo(CountUAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute),
+                                   FRHITransitionInfo(OffsetsUAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute),
+                                   FRHITransitionInfo(IndicesUAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute)});
+            FComputeShaderUtils::Dispatch(RHICmdList, CountShader, Parameters, GroupCount);
+            RHICmdList.Transition(FRHITransitionInfo(OffsetsUAV, ERHIAccess::UAVCompute, ERHIAccess::UAVCompute));
+            FComputeShaderUtils::Dispatch(RHICmdList, ScanShader, ScanParameters, FIntVector(1, 1, 1));
+            RHICmdList.Transition(FRHITransitionInfo(OffsetsUAV, ERHIAccess::UAVCompute, ERHIAccess::UAVCompute));
+            FComputeShaderUtils::Dispatch(RHICmdList, WriteShader, Parameters, GroupCount);
+
+            ERHIAccess CountAccess = ERHIAccess::UAVCompute;
+            if (Readback)
+            {
+                RHICmdList.Transition(FRHITransitionInfo(CountUAV, CountAccess, ERHIAccess::CopySrc));
+                Readback->EnqueueCopy(RHICmdList, CountBuffer, sizeof(uint32));
+                CountAccess = ERHIAccess::CopySrc;
+            }
+            RHICmdList.Transition({FRHITransitionInfo(CountUAV, CountAccess, ERHIAccess::SRVMask),
+                                   FRHITransitionInfo(IndicesUAV, ERHIAccess::UAVCompute, ERHIAccess::SRVMask)});
+        });
+}
+
+void FNDIGaussianSplatProxy::AddDeformFlipPass(FRDGBuilder &GraphBuilder, FGaussianSplatInstanceData_RT &InstanceData)
+{
+    FGaussianSplatDeformBuffers_RT &Deform = InstanceData.Deform;
+    const bool bReset = Deform.bResetPending;
+    if (!bReset)
+        Deform.Front ^= 1;
+    Deform.bResetPending = false;
+    const int32 Front = Deform.Front;
+    const int32 Back = Front ^ 1;
+    const uint32 NumBytes = Deform.RestPositions.NumElements * sizeof(FVector4f);
+
+    // Positions then SH zero/opacity. The back starts as a copy of the front so splats nobody writes this frame
+    // keep their value after the next flip.
+    FRHIBuffer *RestBuffers[2] = {Deform.RestPositions.Buffer, Deform.RestSHZero.Buffer};
+    FRHIBuffer *FrontBuffers[2] = {Deform.LivePositions[Front].Buffer, Deform.LiveSHZero[Front].Buffer};
+    FRHIBuffer *BackBuffers[2] = {Deform.LivePositions[Back].Buffer, Deform.LiveSHZero[Back].Buffer};
+
+    GraphBuilder.AddPass(
+        RDG_EVENT_NAME("GaussianSplatDeformFlip%s", bReset ? TEXT(" (reset)") : TEXT("")), ERDGPassFlags::None,
+        [RestBuffers, FrontBuffers, BackBuffers, NumBytes, bReset](FRHICommandListImmediate &RHICmdList)
+        {
+            for (int32 Stream = 0; Stream < 2; ++Stream)
+            {
+                FRHIBuffer *Rest = RestBuffers[Stream];
+                FRHIBuffer *FrontBuffer = FrontBuffers[Stream];
+                FRHIBuffer *BackBuffer = BackBuffers[Stream];
+                if (bReset)
+                {
+                    RHICmdList.Transition({FRHITransitionInfo(Rest, ERHIAccess::Unknown, ERHIAccess::CopySrc),
+                                           FRHITransitionInfo(FrontBuffer, ERHIAccess::Unknown, ERHIAccess::CopyDest)});
+                    RHICmdList.CopyBufferRegion(FrontBuffer, 0, Rest, 0, NumBytes);
+                }
+                RHICmdList.Transition(
+                    {FRHITransitionInfo(FrontBuffer, ERHIAccess::Unknown, ERHIAccess::CopySrc),
+                     FRHITransitionInfo(BackBuffer, ERHIAccess::Unknown, ERHIAccess::CopyDest)});
+                RHICmdList.CopyBufferRegion(BackBuffer, 0, FrontBuffer, 0, NumBytes);
+
+                // Stages read the front and the rest pose and write the back
+                RHICmdList.Transition({FRHITransitionInfo(Rest, ERHIAccess::Unknown, ERHIAccess::SRVMask),
+                                       FRHITransitionInfo(FrontBuffer, ERHIAccess::CopySrc, ERHIAccess::SRVMask),
+                                       FRHITransitionInfo(BackBuffer, ERHIAccess::CopyDest, ERHIAccess::UAVCompute)});
+            }
+        });
+}
+
+void FNDIGaussianSplatProxy::Rasterize(FRHICommandListImmediate &RHICmdList, const FNiagaraSystemInstanceID &InstanceID,
+                                       const FGaussianSplatRasterView &View, FTextureRenderTargetResource *Target,
+                                       float KeysPerSplat)
+{
+    using namespace GaussianSplatProxy;
+    check(IsInRenderingThread());
+    FGaussianSplatInstanceData_RT *InstanceData = SystemInstancesToData_RT.Find(InstanceID);
+    FRHITexture *TargetTexture = Target ? Target->GetRenderTargetTexture() : nullptr;
+    if (!InstanceData || !InstanceData->HasAllocation() || InstanceData->SplatsCount <= 0 || !TargetTexture ||
+        !View.IsValid())
+        return;
+    SCOPED_DRAW_EVENT(RHICmdList, GaussianSplatRaster);
+
+    const uint32 NumSplats = uint32(InstanceData->GetResidentCount());
+    const uint32 MaxKeys = uint32(FMath::Clamp(double(NumSplats) * KeysPerSplat, 1.0, double(MaxRasterKeys)));
+    const uint32 NumTiles = uint32(View.GetNumTiles());
+
+    EnsureFallbackBuffers(RHICmdList);
+    FGaussianSplatRasterBuffers_RT &Raster = InstanceData->Raster;
+    bool bResized = false;
+    auto EnsureBuffer = [&](FGaussianSplatBuffer &Buffer, uint32 NumElements, uint32 BytesPerElement,
+                            const TCHAR *DebugName, EPixelFormat Format)
+    {
+        if (Buffer.NumElements >= NumElements)
+            return;
+        Buffer.Release();
+        CreateBuffer(RHICmdList, Buffer, NumElements, BytesPerElement, DebugName, Format,
+                     BUF_Static | BUF_ShaderResource | BUF_UnorderedAccess);
+        bResized = true;
+    };
+    EnsureBuffer(Raster.Projected, NumSplats * FGaussianSplatRasterProjectCS::ProjectedStride, sizeof(FVector4f),
+                 TEXT("GSplat_RasterProjected"), PF_A32B32G32R32F);
+    EnsureBuffer(Raster.KeyCounter, 1, sizeof(uint32), TEXT("GSplat_RasterKeyCounter"), PF_R32_UINT);
+    for (int32 i = 0; i < 2; ++i)
+    {
+        EnsureBuffer(Raster.Keys[i], MaxKeys, sizeof(uint32), TEXT("GSplat_RasterKeys"), PF_R32_UINT);
+        EnsureBuffer(Raster.Values[i], MaxKeys, sizeof(uint32), TEXT("GSplat_RasterValues"), PF_R32_UINT);
+    }
+    EnsureBuffer(Raster.TileRanges, NumTiles * 2, sizeof(uint32), TEXT("GSplat_RasterTileRanges"), PF_R32_UINT);
+    if (bResized)
+        UpdateGPUMemoryStat();
+    if (Raster.TargetTexture != TargetTexture)
+    {
+        Raster.TargetTexture = TargetTexture;
+        Raster.TargetUAV = RHICmdList.CreateUnorderedAccessView(TargetTexture, 0);
+    }
+
+    // Unused key slots stay all ones, so they sort after every real tile and the sort can run over MaxKeys without
+    // reading the GPU's key count back
+    RHICmdList.Transition({FRHITransitionInfo(Raster.Projected.UAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute),
+                           FRHITransitionInfo(Raster.KeyCounter.UAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute),
+                           FRHITransitionInfo(Raster.Keys[0].UAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute),
+                           FRHITransitionInfo(Raster.Values[0].UAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute),
+                           FRHITransitionInfo(Raster.TileRanges.UAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute)});
+    RHICmdList.ClearUAVUint(Raster.KeyCounter.UAV, FUintVector4(0));
+    RHICmdList.ClearUAVUint(Raster.Keys[0].UAV, FUintVector4(MAX_uint32));
+    RHICmdList.ClearUAVUint(Raster.TileRanges.UAV, FUintVector4(0));
+    RHICmdList.Transition({FRHITransitionInfo(Raster.KeyCounter.UAV, ERHIAccess::UAVCompute, ERHIAccess::UAVCompute),
+                           FRHITransitionInfo(Raster.Keys[0].UAV, ERHIAccess::UAVCompute, ERHIAccess::UAVCompute)});
+
+    // Project and duplicate into (tile, depth) keys
+    {
+        const FGaussianSplatBufferArena &TargetArena = GetArena(InstanceData->Layout);
+        const bool bInterleaved = InstanceData->Layout == EGaussianSplatBufferLayout::Interleaved;
+        auto StreamSRV = [&](FGaussianSplatBufferArena::EStream Stream) -> FRHIShaderResourceView *
+        { return bInterleaved ? FallbackBuffer.SRV.GetReference() : TargetArena.GetSRV(Stream); };
+
+        FGaussianSplatRasterProjectCS::FParameters Parameters;
+        Parameters.NumSplats = NumSplats;
+        Parameters.BaseOffset = TargetArena.GetRange(InstanceData->Allocation).Offset;
+        Parameters.LocalToView = View.LocalToView;
+        Parameters.Focal = View.Focal;
+        Parameters.Principal = View.Principal;
+        Parameters.ImageSize = View.Size;
+        Parameters.TileCount = View.GetTileCount();
+        Parameters.DepthBits = View.GetDepthBits();
+        Parameters.NearZ = View.NearZ;
+        Parameters.InvLogDepthRange = 1.0f / FMath::Loge(View.FarZ / View.NearZ);
+        Parameters.MaxKeys = MaxKeys;
+        Parameters.Tint = InstanceData->GlobalTint;
+        Parameters.Positions = StreamSRV(FGaussianSplatBufferArena::Stream_Positions);
+        Parameters.Scales = StreamSRV(FGaussianSplatBufferArena::Stream_Scales);
+        Parameters.Orientations = StreamSRV(FGaussianSplatBufferArena::Stream_Orientations);
+        Parameters.SHZeroCoeffsAndOpacity = StreamSRV(FGaussianSplatBufferArena::Stream_SHZeroCoeffsAndOpacity);
+        Parameters.SplatRecords = bInterleaved ? TargetArena.GetRecordsSRV() : FallbackRecordBuffer.SRV.GetReference();
+        Parameters.ProjectedSplats = Raster.Projected.UAV;
+        Parameters.KeyCounter = Raster.KeyCounter.UAV;
+        Parameters.SortKeys = Raster.Keys[0].UAV;
+        Parameters.SortValues = Raster.Values[0].UAV;
+
+        const FIntVector GroupCount = GetLinearGroupCount(NumSplats, FGaussianSplatRasterProjectCS::ThreadGroupSize,
+                                                          Parameters.DispatchWidth);
+        FGaussianSplatRasterProjectCS::FPermutationDomain Permutation;
+        Permutation.Set<FGaussianSplatRasterProjectCS::FInterleavedDim>(bInterleaved);
+        TShaderMapRef<FGaussianSplatRasterProjectCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel),
+                                                                   Permutation);
+        FComputeShaderUtils::Dispatch(RHICmdList, ComputeShader, Parameters, GroupCount);
+    }
+
+    // Sort every slot; returns which of the pairs holds the result
+    RHICmdList.Transition({FRHITransitionInfo(Raster.Projected.UAV, ERHIAccess::UAVCompute, ERHIAccess::SRVCompute),
+                           FRHITransitionInfo(Raster.Keys[0].UAV, ERHIAccess::UAVCompute, ERHIAccess::SRVCompute),
+                           FRHITransitionInfo(Raster.Values[0].UAV, ERHIAccess::UAVCompute, ERHIAccess::SRVCompute),
+                           FRHITransitionInfo(Raster.Keys[1].UAV, ERHIAccess::Unknown, ERHIAccess::SRVCompute),
+                           FRHITransitionInfo(Raster.Values[1].UAV, ERHIAccess::Unknown, ERHIAccess::SRVCompute)});
+    FGPUSortBuffers SortBuffers;
+    for (int32 i = 0; i < 2; ++i)
+    {
+        SortBuffers.RemoteKeySRVs[i] = Raster.Keys[i].SRV;
+        SortBuffers.RemoteKeyUAVs[i] = Raster.Keys[i].UAV;
+        SortBuffers.RemoteValueSRVs[i] = Raster.Values[i].SRV;
+        SortBuffers.RemoteValueUAVs[i] = Raster.Values[i].UAV;
+    }
+    const int32 Sorted = SortGPUBuffers(RHICmdList, SortBuffers, 0, MAX_uint32, int32(MaxKeys), GMaxRHIFeatureLevel);
+    RHICmdList.Transition({FRHITransitionInfo(Raster.Keys[Sorted].UAV, ERHIAccess::Unknown, ERHIAccess::SRVCompute),
+                           FRHITransitionInfo(Raster.Values[Sorted].UAV, ERHIAccess::Unknown, ERHIAccess::SRVCompute)});
+
+    // Per tile [first, last) of the sorted keys
+    {
+        FGaussianSplatTileRangesCS::FParameters Parameters;
+        Parameters.MaxKeys = MaxKeys;
+        Parameters.NumTiles = NumTiles;
+        Parameters.DepthBits = View.GetDepthBits();
+        Parameters.SortedKeys = Raster.Keys[Sorted].SRV;
+        Parameters.RWTileRanges = Raster.TileRanges.UAV;
+        const FIntVector GroupCount =
+            GetLinearGroupCount(MaxKeys, FGaussianSplatTileRangesCS::ThreadGroupSize, Parameters.DispatchWidth);
+        TShaderMapRef<FGaussianSplatTileRangesCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        FComputeShaderUtils::Dispatch(RHICmdList, ComputeShader, Parameters, GroupCount);
+    }
+
+    // Blend each tile front to back
+    RHICmdList.Transition({FRHITransitionInfo(Raster.TileRanges.UAV, ERHIAccess::UAVCompute, ERHIAccess::SRVCompute),
+                           FRHITransitionInfo(TargetTexture, ERHIAccess::Unknown, ERHIAccess::UAVCompute)});
+    {
+        FGaussianSplatRasterizeCS::FParameters Parameters;
+        Parameters.ImageSize = View.Size;
+        Parameters.TileCount = View.GetTileCount();
+        Parameters.SortedValues = Raster.Values[Sorted].SRV;
+        Parameters.TileRanges = Raster.TileRanges.SRV;
+        Parameters.Projected = Raster.Projected.SRV;
+        Parameters.Output = Raster.TargetUAV;
+        TShaderMapRef<FGaussianSplatRasterizeCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        FComputeShaderUtils::Dispatch(RHICmdList, ComputeShader, Parameters,
+                                      FIntVector(Parameters.TileCount.X, Parameters.TileCount.Y, 1));
+    }
+    RHICmdList.Transition(FRHITransitionInfo(TargetTexture, ERHIAccess::UAVCompute, ERHIAccess::SRVMask));
 }
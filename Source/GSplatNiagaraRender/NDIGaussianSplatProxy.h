@@ -1,17 +1,31 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "GaussianSplatBufferArena.h"
+#include "GaussianSplatCulling.h"
 #include "GaussianSplatData.h"
+#include "GaussianSplatPacking.h"
+#include "GaussianSplatRasterizer.h"
+#include "GaussianSplatSequencePlayer.h"
+#include "GaussianSplatStreamingManager.h"
+#include "Misc/ScopeLock.h"
 #include "NiagaraCommon.h"
 #include "NiagaraDataInterfaceRW.h"
 #include "RHI.h"
+#include "RHIGPUReadback.h"
 #include "RHIResources.h"
+#include "RenderGraphFwd.h"
 #include "RenderResource.h"
+#include <atomic>
+
+class FTextureRenderTargetResource;
 
 struct FGaussianSplatBuffer
 {
     FBufferRHIRef Buffer;
     FShaderResourceViewRHIRef SRV;
+    // Only for buffers created with BUF_UnorderedAccess
+    FUnorderedAccessViewRHIRef UAV;
     uint32 NumElements;
 
     FGaussianSplatBuffer() : NumElements(0) {}
@@ -20,6 +34,7 @@ struct FGaussianSplatBuffer
     {
         Buffer.SafeRelease();
         SRV.SafeRelease();
+        UAV.SafeRelease();
         NumElements = 0;
     }
 
@@ -29,28 +44,234 @@ struct FGaussianSplatBuffer
     }
 };
 
+// Scratch of the tile rasterizer for one instance. Grown to the largest cloud and view seen, never shrunk.
+struct FGaussianSplatRasterBuffers_RT
+{
+    // FGaussianSplatRasterProjectCS::ProjectedStride float4 per splat
+    FGaussianSplatBuffer Projected;
+    FGaussianSplatBuffer KeyCounter;
+    // Ping-pong pairs for FGPUSort
+    FGaussianSplatBuffer Keys[2];
+    FGaussianSplatBuffer Values[2];
+    // Two uints per tile
+    FGaussianSplatBuffer TileRanges;
+    // UAV on the render target's texture, recreated when the target is resized or replaced
+    FTextureRHIRef TargetTexture;
+    FUnorderedAccessViewRHIRef TargetUAV;
+
+    int64 GetBytes() const
+    {
+        const int64 Elements = int64(KeyCounter.NumElements) + Keys[0].NumElements + Keys[1].NumElements +
+                               Values[0].NumElements + Values[1].NumElements + TileRanges.NumElements;
+        return Elements * sizeof(uint32) + int64(Projected.NumElements) * sizeof(FVector4f);
+    }
+
+    void Release()
+    {
+        for (FGaussianSplatBuffer *Buffer : {&Projected, &KeyCounter, &Keys[0], &Keys[1], &Values[0], &Values[1],
+                                             &TileRanges})
+            Buffer->Release();
+        TargetTexture.SafeRelease();
+        TargetUAV.SafeRelease();
+    }
+};
+
+// Writable splats: the streams GPU emitters can write, ping-ponged so a frame's stages all read the previous frame's
+// values from Live[Front] while writing Live[1 - Front]. Rest holds the uploaded pose that resets copy back in.
+struct FGaussianSplatDeformBuffers_RT
+{
+    // Position with the bounding radius in W, as Stream_Positions
+    FGaussianSplatBuffer RestPositions;
+    FGaussianSplatBuffer LivePositions[2];
+    // SH0 with opacity in W, as Stream_SHZeroCoeffsAndOpacity
+    FGaussianSplatBuffer RestSHZero;
+    FGaussianSplatBuffer LiveSHZero[2];
+    int32 Front = 0;
+    uint32 LastFlipFrame = MAX_uint32;
+    // Copy the rest pose into the live buffers before the next frame's stages
+    bool bResetPending = true;
+
+    bool IsValid() const
+    {
+        return RestPositions.IsValid() && LivePositions[0].IsValid() && LivePositions[1].IsValid() &&
+               RestSHZero.IsValid() && LiveSHZero[0].IsValid() && LiveSHZero[1].IsValid();
+    }
+
+    int64 GetBytes() const
+    {
+        return int64(RestPositions.NumElements + LivePositions[0].NumElements + LivePositions[1].NumElements +
+                     RestSHZero.NumElements + LiveSHZero[0].NumElements + LiveSHZero[1].NumElements) *
+               sizeof(FVector4f);
+    }
+
+    void Release()
+    {
+        for (FGaussianSplatBuffer *Buffer : {&RestPositions, &LivePositions[0], &LivePositions[1], &RestSHZero,
+                                             &LiveSHZero[0], &LiveSHZero[1]})
+            Buffer->Release();
+        Front = 0;
+        LastFlipFrame = MAX_uint32;
+        bResetPending = true;
+    }
+};
+
 struct FGaussianSplatInstanceData_RT
+{
+    // This instance's range in the proxy's shared arena; INDEX_NONE until data is uploaded. Instances initialised
+    // through ShareUpload point at a sibling's range, which is freed with the last of them.
+    FGaussianSplatBufferArena::FHandle Allocation = INDEX_NONE;
+    // Which of the proxy's arenas Allocation belongs to
+    EGaussianSplatBufferLayout Layout = EGaussianSplatBufferLayout::SeparateStreams;
+    int32 SplatsCount = 0;
+    // The NDI's RenderDataRevision the allocation holds
+    uint32 Revision = 0;
+
+    // Every record of an init cut into slices by gsplat.Upload.FrameBudgetMB, kept until the last slice lands. The
+    // first UploadedCount are on the GPU, and all the shader sees until then.
+    TArray<FGaussianSplatPackedRecord> PendingRecords;
+    int32 UploadedCount = 0;
+    double UploadStartSeconds = 0.0;
+    FVector3f GlobalTint = FVector3f::OneVector;
+
+    // View culling: the frustum from the last game thread tick, and the pass output. The count is one uint; the
+    // indices buffer is sized to SplatsCount on first use, the group offsets the compaction scans to one per group.
+    FGaussianSplatCullParams Cull;
+    FGaussianSplatBuffer VisibleCountBuffer;
+    FGaussianSplatBuffer VisibleIndicesBuffer;
+    FGaussianSplatBuffer CullGroupOffsetsBuffer;
+    uint32 LastCulledFrame = MAX_uint32;
+    // One copy of the count in flight at a time
+    TUniquePtr<FRHIGPUBufferReadback> VisibleCountReadback;
+    bool bReadbackPending = false;
+
+    FGaussianSplatRasterBuffers_RT Raster;
+
+    // Only allocated for NDIs with bWritableSplats
+    FGaussianSplatDeformBuffers_RT Deform;
+
+    bool HasAllocation() const
+    {
+        return Allocation != INDEX_NONE;
+    }
+
+    bool IsFullyResident() const
+    {
+        return PendingRecords.Num() == 0;
+    }
+
+    // Splats readable on the GPU: SplatsCount, less any slices still to upload
+    int32 GetResidentCount() const
+    {
+        return IsFullyResident() ? SplatsCount : UploadedCount;
+    }
+
+    // True when the visible buffers hold this frame's cull of this instance
+    bool HasCullResult() const
+    {
+        return Cull.bEnabled && LastCulledFrame == GFrameNumberRenderThread && VisibleIndicesBuffer.IsValid();
+    }
+};
+
+// Fixed-capacity pool fed by FGaussianSplatStreamingManager; shared by every instance of the NDI
+struct FGaussianSplatStreamingPool_RT
 {
     FGaussianSplatBuffer PositionsBuffer;
     FGaussianSplatBuffer ScalesBuffer;
     FGaussianSplatBuffer OrientationsBuffer;
     FGaussianSplatBuffer SHZeroCoeffsAndOpacityBuffer;
-    int32 SplatsCount = 0;
-    FVector3f GlobalTint = FVector3f::OneVector;
+    // Dense index -> pool element, one entry per resident splat
+    FGaussianSplatBuffer IndirectionBuffer;
+    int32 ResidentSplats = 0;
 
-    bool AreBuffersValid() const
+    bool IsValid() const
     {
         return PositionsBuffer.IsValid() && ScalesBuffer.IsValid() && OrientationsBuffer.IsValid() &&
-               SHZeroCoeffsAndOpacityBuffer.IsValid();
+               SHZeroCoeffsAndOpacityBuffer.IsValid() && IndirectionBuffer.IsValid();
     }
 
-    void ReleaseBuffers()
+    void Release()
     {
         PositionsBuffer.Release();
         ScalesBuffer.Release();
         OrientationsBuffer.Release();
         SHZeroCoeffsAndOpacityBuffer.Release();
-        SplatsCount = 0;
+        IndirectionBuffer.Release();
+        ResidentSplats = 0;
+    }
+};
+
+// Sequence playback: two sets of streams sized for the largest frame. A frame is written into the back set and
+// then flipped to the front, so an upload never locks buffers the GPU may still be reading for the frame on screen.
+struct FGaussianSplatSequenceBuffers_RT
+{
+    struct FSet
+    {
+        FGaussianSplatBuffer PositionsBuffer;
+        FGaussianSplatBuffer ScalesBuffer;
+        FGaussianSplatBuffer OrientationsBuffer;
+        FGaussianSplatBuffer SHZeroCoeffsAndOpacityBuffer;
+        int32 SplatCount = 0;
+
+        bool IsValid() const
+        {
+            return PositionsBuffer.IsValid() && ScalesBuffer.IsValid() && OrientationsBuffer.IsValid() &&
+                   SHZeroCoeffsAndOpacityBuffer.IsValid();
+        }
+
+        void Release()
+        {
+            PositionsBuffer.Release();
+            ScalesBuffer.Release();
+            OrientationsBuffer.Release();
+            SHZeroCoeffsAndOpacityBuffer.Release();
+            SplatCount = 0;
+        }
+    };
+
+    FSet Sets[2];
+    int32 Front = 0;
+    uint32 Capacity = 0;
+    // File frame currently in the front set
+    int32 FrameIndex = INDEX_NONE;
+
+    const FSet &GetFront() const
+    {
+        return Sets[Front];
+    }
+
+    bool IsValid() const
+    {
+        return Sets[0].IsValid() && Sets[1].IsValid();
+    }
+
+    void Release()
+    {
+        Sets[0].Release();
+        Sets[1].Release();
+        Front = 0;
+        Capacity = 0;
+        FrameIndex = INDEX_NONE;
+    }
+};
+
+// GPU bytes of one NDI by what they hold. The attribute streams add up the arena, streaming pool, sequence sets and
+// writable copies; the interleaved arena keeps all four in Records.
+struct FGaussianSplatGPUMemory
+{
+    int64 Positions = 0;
+    int64 Scales = 0;
+    int64 Orientations = 0;
+    int64 SHZeroCoeffsAndOpacity = 0;
+    int64 Records = 0;
+    // Streaming indirection, cloud table, cloud instances and spatial grid
+    int64 Tables = 0;
+    // Per instance visible lists and tile rasterizer buffers
+    int64 Culling = 0;
+    int64 Raster = 0;
+
+    int64 GetTotal() const
+    {
+        return Positions + Scales + Orientations + SHZeroCoeffsAndOpacity + Records + Tables + Culling + Raster;
     }
 };
 
@@ -60,27 +281,202 @@ public:
     FNDIGaussianSplatProxy();
     virtual ~FNDIGaussianSplatProxy();
 
+    // The game thread sends each instance's cull frustum every tick
     virtual int32 PerInstanceDataPassedToRenderThreadSize() const override
     {
-        return 0;
+        return sizeof(FGaussianSplatCullParams);
     }
     virtual void ConsumePerInstanceDataFromGameThread(void *PerInstanceData,
-                                                      const FNiagaraSystemInstanceID &Instance) override
+                                                      const FNiagaraSystemInstanceID &Instance) override;
+    // Flips the writable buffers and runs the cull pass ahead of the first stage that reads an instance each frame
+    virtual void PreStage(const FNDIGpuComputePreStageContext &Context) override;
+
+    // Visible count of the instance's last cull read back from the GPU, a few frames old; INDEX_NONE before the
+    // first. Any thread.
+    int32 GetVisibleCount(const FNiagaraSystemInstanceID &InstanceID) const
     {
+        FScopeLock Lock(&VisibleCountsLock);
+        const int32 *Count = VisibleCounts.Find(InstanceID);
+        return Count ? *Count : INDEX_NONE;
+    }
+    void ForgetVisibleCount(const FNiagaraSystemInstanceID &InstanceID)
+    {
+        FScopeLock Lock(&VisibleCountsLock);
+        VisibleCounts.Remove(InstanceID);
     }
 
-    // Called on the render thread from InitPerInstanceData's enqueued command
+    // Called on the render thread from InitPerInstanceData's enqueued command with the splats already packed.
+    // bWritable also allocates the instance's FGaussianSplatDeformBuffers_RT. Uploads what fits in this frame's
+    // gsplat.Upload.FrameBudgetMB and keeps the rest of Records for UploadPendingSlices.
     void InitializeAndUpload(FRHICommandListImmediate &RHICmdList, FGaussianSplatInstanceData_RT &InstanceData,
-                             const TArray<FGaussianSplatData> &SplatsData);
+                             TArray<FGaussianSplatPackedRecord> &&Records, EGaussianSplatBufferLayout Layout,
+                             bool bWritable = false);
+
+    // Continues time sliced uploads within this frame's budget. The game thread queues it once per frame while
+    // HasPendingUploads.
+    void UploadPendingSlices(FRHICommandListImmediate &RHICmdList);
+    // Any thread
+    bool HasPendingUploads() const
+    {
+        return NumPendingUploads.load(std::memory_order_relaxed) > 0;
+    }
+    // Keeps an edit of splats not uploaded yet from being overwritten by their slice
+    void PatchPendingRecords(FGaussianSplatInstanceData_RT &InstanceData, uint32 FirstElement,
+                             TConstArrayView<FGaussianSplatPackedRecord> Records);
+
+    // Points InstanceData at the allocation of another instance holding Revision in the same layout instead of
+    // uploading, for NDIs that no longer keep their splats on the CPU. A writable instance gets its own deform
+    // buffers with the rest pose copied on the GPU. False, leaving InstanceData empty, when there is no such instance.
+    bool ShareUpload(FRHICommandListImmediate &RHICmdList, FGaussianSplatInstanceData_RT &InstanceData,
+                     uint32 Revision, EGaussianSplatBufferLayout Layout, bool bWritable);
+
+    // Writable instances copy their rest pose back into the live buffers before the next frame's stages
+    void ResetDeformation();
+
+    // Overwrites Records.Num() splats starting at FirstElement in the instance's existing allocation
+    void UploadRecords(FRHICommandListImmediate &RHICmdList, const FGaussianSplatInstanceData_RT &InstanceData,
+                       uint32 FirstElement, TConstArrayView<FGaussianSplatPackedRecord> Records);
 
-    // Creates 1 element zeroed buffers so SRVs are never null when no data is available
-    void CreateFallbackBuffers(FRHICommandListImmediate &RHICmdList, FGaussianSplatInstanceData_RT &InstanceData);
+    // Returns the instance's arena range to the free list, unless another instance shares it
+    void ReleaseInstanceData(FRHICommandListImmediate &RHICmdList, FGaussianSplatInstanceData_RT &InstanceData);
+
+    FGaussianSplatBufferArena &GetArena(EGaussianSplatBufferLayout Layout)
+    {
+        return Layout == EGaussianSplatBufferLayout::Interleaved ? InterleavedArena : Arena;
+    }
+
+    const FGaussianSplatBufferArena &GetArena(EGaussianSplatBufferLayout Layout) const
+    {
+        return Layout == EGaussianSplatBufferLayout::Interleaved ? InterleavedArena : Arena;
+    }
+
+    // Bytes held by this NDI's splat buffers across all its instances
+    FGaussianSplatGPUMemory GetGPUMemory() const;
+    int64 GetGPUMemoryBytes() const
+    {
+        return GetGPUMemory().GetTotal();
+    }
+    // Reconciles the GPU memory stat with GetGPUMemoryBytes; call after creating or releasing buffers
+    void UpdateGPUMemoryStat();
+    // GetGPUMemoryBytes as of the last UpdateGPUMemoryStat. Any thread.
+    int64 GetAccountedGPUBytes() const
+    {
+        return AccountedGPUBytes.load(std::memory_order_relaxed);
+    }
+    // GetGPUMemory as of the last UpdateGPUMemoryStat. Any thread.
+    FGaussianSplatGPUMemory GetAccountedGPUMemory() const
+    {
+        FScopeLock Lock(&AccountedGPUMemoryLock);
+        return AccountedGPUMemory;
+    }
+
+    // Game thread copies queued for the render thread; the game thread adds them when enqueuing and the command
+    // subtracts them once uploaded. Any thread.
+    void AddPendingUploadBytes(int64 Bytes)
+    {
+        PendingUploadBytes.fetch_add(Bytes, std::memory_order_relaxed);
+    }
+    // Those copies plus the render thread's upload scratch. Any thread.
+    int64 GetRenderThreadCPUBytes() const
+    {
+        return PendingUploadBytes.load(std::memory_order_relaxed) + UploadScratchBytes.load(std::memory_order_relaxed);
+    }
+
+    // Creates the shared 1 element zeroed buffers bound whenever an instance has nothing uploaded
+    void EnsureFallbackBuffers(FRHICommandListImmediate &RHICmdList);
+
+    // Streaming: allocate the pool once, then write tiles into slots and replace the indirection as they land
+    void InitStreamingPool(FRHICommandListImmediate &RHICmdList, uint32 PoolElements);
+    void UploadStreamingTiles(FRHICommandListImmediate &RHICmdList, const TArray<FGaussianSplatTileUpload> &Uploads,
+                              uint32 TileCapacity);
+    void UploadStreamingIndirection(FRHICommandListImmediate &RHICmdList, const TArray<uint32> &Indirection);
+
+    // Multi-cloud: per-cloud first splat (NumClouds + 1 entries) and tint, shared by every instance
+    void UploadCloudTable(FRHICommandListImmediate &RHICmdList, const TArray<uint32> &Offsets,
+                          const TArray<FVector4f> &Tints);
+
+    // Spatial queries: FGaussianSplatSpatialGrid's cell table and its packed splats (see PackSplats), shared by
+    // every instance like the cloud table. An empty grid releases both.
+    void UploadSpatialGrid(FRHICommandListImmediate &RHICmdList, const TArray<uint32> &CellStarts,
+                           const TArray<FVector4f> &PackedSplats, const FVector3f &Origin, float InvCellSize,
+                           const FIntVector &Dims);
+
+    // Sequence playback: allocate both sets once for the largest frame, then write each new frame into the back set
+    void InitSequenceBuffers(FRHICommandListImmediate &RHICmdList, uint32 MaxSplats);
+    void UploadSequenceFrame(FRHICommandListImmediate &RHICmdList, const FGaussianSplatSequenceFrame &Frame);
+
+    // Tile rasterizer: renders the instance's splats into Target's texture from View. The key buffers hold
+    // KeysPerSplat (tile, splat) pairs per splat; splats whose keys do not fit lose some of their tiles.
+    void Rasterize(FRHICommandListImmediate &RHICmdList, const FNiagaraSystemInstanceID &InstanceID,
+                   const FGaussianSplatRasterView &View, FTextureRenderTargetResource *Target, float KeysPerSplat);
+
+    // Instanced mode: three float4 per instance, see UGaussianSplatNiagaraDataInterface::TickInstancing. Rewritten
+    // in place while the instance count is unchanged.
+    void UploadCloudInstances(FRHICommandListImmediate &RHICmdList, const TArray<FVector4f> &PackedInstances);
 
     // one entry per live NiagaraComponent
     TMap<FNiagaraSystemInstanceID, FGaussianSplatInstanceData_RT> SystemInstancesToData_RT;
+    // Backing storage for every instance's splats, one arena per layout
+    FGaussianSplatBufferArena Arena;
+    FGaussianSplatBufferArena InterleavedArena;
     FGaussianSplatBuffer FallbackBuffer;
+    FGaussianSplatBuffer FallbackRecordBuffer;
+    FGaussianSplatBuffer FallbackIndirectionBuffer;
+    // float4 with a UAV, bound to the write outputs of instances that are not writable
+    FGaussianSplatBuffer FallbackUAVBuffer;
+    FGaussianSplatStreamingPool_RT StreamingPool;
+    FGaussianSplatSequenceBuffers_RT SequenceBuffers;
+    FGaussianSplatBuffer CloudOffsetsBuffer;
+    FGaussianSplatBuffer CloudTintsBuffer;
+    // White, so a missing table leaves colours untouched
+    FGaussianSplatBuffer FallbackCloudTintBuffer;
+    int32 NumClouds = 0;
+    FGaussianSplatBuffer SpatialCellStartsBuffer;
+    FGaussianSplatBuffer SpatialSplatsBuffer;
+    FVector3f SpatialGridOrigin = FVector3f::ZeroVector;
+    float SpatialGridInvCellSize = 1.0f;
+    // Zero when there is no grid, which makes every query come back empty
+    FIntVector SpatialGridDims = FIntVector::ZeroValue;
+    FGaussianSplatBuffer CloudInstancesBuffer;
+    int32 NumCloudInstances = 0;
 
 private:
+    void AddCullPass(FRDGBuilder &GraphBuilder, const FNiagaraSystemInstanceID &InstanceID,
+                     FGaussianSplatInstanceData_RT &InstanceData);
+    // Makes last frame's writes the front and carries them into the back; or copies in the rest pose after a reset
+    void AddDeformFlipPass(FRDGBuilder &GraphBuilder, FGaussianSplatInstanceData_RT &InstanceData);
+
     void CreateBuffer(FRHICommandListImmediate &RHICmdList, FGaussianSplatBuffer &OutBuffer, uint32 NumElements,
-                      uint32 BytesPerElement, const TCHAR *DebugName);
+                      uint32 BytesPerElement, const TCHAR *DebugName, EPixelFormat Format = PF_A32B32G32R32F,
+                      EBufferUsageFlags Usage = BUF_ShaderResource | BUF_Dynamic);
+    // CreateBuffer, then copies NumElements * BytesPerElement bytes of Data in
+    void CreateAndFillBuffer(FRHICommandListImmediate &RHICmdList, FGaussianSplatBuffer &OutBuffer, const void *Data,
+                             uint32 NumElements, uint32 BytesPerElement, const TCHAR *DebugName, EPixelFormat Format);
+
+    void CreateDeformBuffers(FRHICommandListImmediate &RHICmdList, FGaussianSplatDeformBuffers_RT &Deform,
+                             uint32 NumSplats);
+    // Uploads Count more of InstanceData's PendingRecords and finishes the upload once all are on the GPU
+    void UploadSlice(FRHICommandListImmediate &RHICmdList, FGaussianSplatInstanceData_RT &InstanceData, int32 Count);
+    void ClearPendingRecords(FGaussianSplatInstanceData_RT &InstanceData);
+    // True when an instance other than InstanceData uses its allocation
+    bool IsAllocationShared(const FGaussianSplatInstanceData_RT &InstanceData) const;
+
+    // Splits Records into UploadScratch and records the scratch's size for GetRenderThreadCPUBytes
+    void SplitIntoUploadScratch(TConstArrayView<FGaussianSplatPackedRecord> Records);
+
+    // Scratch for splitting records into streams on the render thread
+    FGaussianSplatStreams UploadScratch;
+
+    // This proxy's share of STAT_GaussianSplat_GPUMemory
+    std::atomic<int64> AccountedGPUBytes = 0;
+    mutable FCriticalSection AccountedGPUMemoryLock;
+    FGaussianSplatGPUMemory AccountedGPUMemory;
+    std::atomic<int64> PendingUploadBytes = 0;
+    std::atomic<int64> UploadScratchBytes = 0;
+    // Instances with PendingRecords
+    std::atomic<int32> NumPendingUploads = 0;
+
+    // Each instance's read back visible count, for the game thread
+    mutable FCriticalSection VisibleCountsLock;
+    TMap<FNiagaraSystemInstanceID, int32> VisibleCounts;
 };
@@ -1,7 +1,13 @@
 ﻿#include "PLYParser.h"
+#include "GaussianSplatStats.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
 
+// Rows are decoded into a block of floats and then converted in one go, so each stage gets its own stat scope
+// without paying for one per splat
+static constexpr int32 PLYRowsPerBlock = 4096;
+
 FPLYParser::FPLYParser()
     : Format(EPLYFormat::Unknown), VertexCount(0), PropIdx_X(-1), PropIdx_Y(-1), PropIdx_Z(-1), PropIdx_NX(-1),
       PropIdx_NY(-1), PropIdx_NZ(-1), PropIdx_FDC0(-1), PropIdx_FDC1(-1), PropIdx_FDC2(-1), PropIdx_Opacity(-1),
@@ -14,6 +20,7 @@ FPLYParser::~FPLYParser() {}
 
 bool FPLYParser::ParseFile(const FString &FilePath, TArray<FGaussianSplatData> &OutSplats)
 {
+    LLM_SCOPE_BYTAG(GaussianSplat);
     OutSplats.Empty();
     ErrorMessage.Empty();
 
@@ -24,36 +31,40 @@ bool FPLYParser::ParseFile(const FString &FilePath, TArray<FGaussianSplatData> &
     }
 
     TArray<uint8> FileData;
-    if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
     {
-        ErrorMessage = FString::Printf(TEXT("Failed to load file: %s"), *FilePath);
-        return false;
+        GSPLAT_SCOPE(FileRead);
+        if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+        {
+            ErrorMessage = FString::Printf(TEXT("Failed to load file: %s"), *FilePath);
+            return false;
+        }
     }
 
     FString FileContent;
-    FFileHelper::BufferToString(FileContent, FileData.GetData(), FileData.Num());
-
     TArray<FString> Lines;
-    FileContent.ParseIntoArrayLines(Lines);
-
-    if (Lines.Num() == 0)
+    int32 HeaderEndLine = 0;
     {
-        ErrorMessage = TEXT("Empty file");
-        return false;
-    }
+        GSPLAT_SCOPE(HeaderParse);
+        FFileHelper::BufferToString(FileContent, FileData.GetData(), FileData.Num());
+        FileContent.ParseIntoArrayLines(Lines);
 
-    // Check PLY magic number
-    if (!Lines[0].TrimStartAndEnd().Equals(TEXT("ply"), ESearchCase::IgnoreCase))
-    {
-        ErrorMessage = TEXT("Invalid PLY file: missing 'ply' header");
-        return false;
-    }
+        if (Lines.Num() == 0)
+        {
+            ErrorMessage = TEXT("Empty file");
+            return false;
+        }
 
-    // Parse header
-    int32 HeaderEndLine = 0;
-    if (!ParseHeader(Lines, HeaderEndLine))
-    {
-        return false;
+        // Check PLY magic number
+        if (!Lines[0].TrimStartAndEnd().Equals(TEXT("ply"), ESearchCase::IgnoreCase))
+        {
+            ErrorMessage = TEXT("Invalid PLY file: missing 'ply' header");
+            return false;
+        }
+
+        if (!ParseHeader(Lines, HeaderEndLine))
+        {
+            return false;
+        }
     }
 
     if (Format == EPLYFormat::ASCII)
@@ -86,6 +97,48 @@ bool FPLYParser::ParseFile(const FString &FilePath, TArray<FGaussianSplatData> &
     return false;
 }
 
+bool FPLYParser::ProbeFile(const FString &FilePath)
+{
+    ErrorMessage.Empty();
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        ErrorMessage = FString::Printf(TEXT("File not found: %s"), *FilePath);
+        return false;
+    }
+
+    // Capture headers are a few hundred bytes; this leaves room for any number of comments
+    constexpr int64 MaxHeaderBytes = 64 * 1024;
+    TArray<uint8> Prefix;
+    Prefix.SetNumUninitialized(int32(FMath::Min(Reader->TotalSize(), MaxHeaderBytes)));
+    Reader->Serialize(Prefix.GetData(), Prefix.Num());
+    if (Reader->IsError())
+    {
+        ErrorMessage = FString::Printf(TEXT("Failed to read header: %s"), *FilePath);
+        return false;
+    }
+
+    FString Header;
+    FFileHelper::BufferToString(Header, Prefix.GetData(), Prefix.Num());
+    const int32 EndHeader = Header.Find(TEXT("end_header"), ESearchCase::IgnoreCase);
+    if (EndHeader == INDEX_NONE)
+    {
+        ErrorMessage = TEXT("Missing end_header");
+        return false;
+    }
+    TArray<FString> Lines;
+    Header.LeftInline(EndHeader + FCString::Strlen(TEXT("end_header")));
+    Header.ParseIntoArrayLines(Lines);
+    if (Lines.Num() == 0 || !Lines[0].TrimStartAndEnd().Equals(TEXT("ply"), ESearchCase::IgnoreCase))
+    {
+        ErrorMessage = TEXT("Invalid PLY file: missing 'ply' header");
+        return false;
+    }
+
+    int32 HeaderEndLine = 0;
+    return ParseHeader(Lines, HeaderEndLine);
+}
+
 bool FPLYParser::ParseHeader(const TArray<FString> &Lines, int32 &OutHeaderEndLine)
 {
     Properties.Empty();
@@ -205,35 +258,44 @@ bool FPLYParser::ParseASCIIData(const TArray<FString> &Lines, int32 StartLine, T
     OutSplats.Reserve(VertexCount);
 
     int32 NumProperties = Properties.Num();
-    TArray<float> PropertyValues;
-    PropertyValues.SetNum(NumProperties);
+    TArray<float> Block;
+    Block.SetNumZeroed(PLYRowsPerBlock * NumProperties);
 
-    for (int32 i = 0; i < VertexCount; ++i)
+    for (int32 BlockStart = 0; BlockStart < VertexCount; BlockStart += PLYRowsPerBlock)
     {
-        int32 LineIdx = StartLine + i;
-        if (LineIdx >= Lines.Num())
+        const int32 NumRows = FMath::Min(PLYRowsPerBlock, VertexCount - BlockStart);
         {
-            ErrorMessage = FString::Printf(TEXT("Unexpected end of file at vertex %d"), i);
-            return false;
-        }
+            GSPLAT_SCOPE(Decode);
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                const int32 i = BlockStart + Row;
+                int32 LineIdx = StartLine + i;
+                if (LineIdx >= Lines.Num())
+                {
+                    ErrorMessage = FString::Printf(TEXT("Unexpected end of file at vertex %d"), i);
+                    return false;
+                }
 
-        FString Line = Lines[LineIdx].TrimStartAndEnd();
-        TArray<FString> Tokens;
-        Line.ParseIntoArray(Tokens, TEXT(" "), true);
+                FString Line = Lines[LineIdx].TrimStartAndEnd();
+                TArray<FString> Tokens;
+                Line.ParseIntoArray(Tokens, TEXT(" "), true);
 
-        if (Tokens.Num() < NumProperties)
-        {
-            ErrorMessage = FString::Printf(TEXT("Not enough values at vertex %d (expected %d, got %d)"), i,
-                                           NumProperties, Tokens.Num());
-            return false;
-        }
+                if (Tokens.Num() < NumProperties)
+                {
+                    ErrorMessage = FString::Printf(TEXT("Not enough values at vertex %d (expected %d, got %d)"), i,
+                                                   NumProperties, Tokens.Num());
+                    return false;
+                }
 
-        for (int32 j = 0; j < NumProperties; ++j)
-        {
-            PropertyValues[j] = FCString::Atof(*Tokens[j]);
+                float *PropertyValues = Block.GetData() + Row * NumProperties;
+                for (int32 j = 0; j < NumProperties; ++j)
+                {
+                    PropertyValues[j] = FCString::Atof(*Tokens[j]);
+                }
+            }
         }
 
-        OutSplats.Add(ExtractSplatData(PropertyValues));
+        ConvertRows(Block.GetData(), NumRows, OutSplats);
     }
 
     UE_LOG(LogTemp, Log, TEXT("PLYParser: Loaded %d splats from ASCII PLY file"), OutSplats.Num());
@@ -249,45 +311,53 @@ bool FPLYParser::ParseBinaryData(const TArray<uint8> &FileData, int32 HeaderByte
     int32 VertexByteSize = CalculateVertexByteSize();
     int32 NumProperties = Properties.Num();
 
-    TArray<float> PropertyValues;
-    PropertyValues.SetNum(NumProperties);
+    TArray<float> Block;
+    Block.SetNumZeroed(PLYRowsPerBlock * NumProperties);
 
     int32 Offset = HeaderByteOffset;
 
-    for (int32 i = 0; i < VertexCount; ++i)
+    for (int32 BlockStart = 0; BlockStart < VertexCount; BlockStart += PLYRowsPerBlock)
     {
-        if (Offset + VertexByteSize > FileData.Num())
+        const int32 NumRows = FMath::Min(PLYRowsPerBlock, VertexCount - BlockStart);
         {
-            ErrorMessage = FString::Printf(TEXT("Unexpected end of file at vertex %d"), i);
-            return false;
-        }
+            GSPLAT_SCOPE(Decode);
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                if (Offset + VertexByteSize > FileData.Num())
+                {
+                    ErrorMessage = FString::Printf(TEXT("Unexpected end of file at vertex %d"), BlockStart + Row);
+                    return false;
+                }
 
-        // Read each property
-        for (int32 j = 0; j < NumProperties; ++j)
-        {
-            const FPLYProperty &Prop = Properties[j];
+                // Read each property
+                float *PropertyValues = Block.GetData() + Row * NumProperties;
+                for (int32 j = 0; j < NumProperties; ++j)
+                {
+                    const FPLYProperty &Prop = Properties[j];
 
-            if (Prop.bIsList)
-            {
-                continue;
-            }
+                    if (Prop.bIsList)
+                    {
+                        continue;
+                    }
 
-            if (Prop.Type == TEXT("float") || Prop.Type == TEXT("float32"))
-            {
-                PropertyValues[j] = ReadFloat(FileData.GetData(), Offset, bBigEndian);
-            }
-            else if (Prop.Type == TEXT("double") || Prop.Type == TEXT("float64"))
-            {
-                PropertyValues[j] = static_cast<float>(ReadDouble(FileData.GetData(), Offset, bBigEndian));
-            }
-            else
-            {
-                Offset += Prop.ByteSize;
-                PropertyValues[j] = 0.0f;
+                    if (Prop.Type == TEXT("float") || Prop.Type == TEXT("float32"))
+                    {
+                        PropertyValues[j] = ReadFloat(FileData.GetData(), Offset, bBigEndian);
+                    }
+                    else if (Prop.Type == TEXT("double") || Prop.Type == TEXT("float64"))
+                    {
+                        PropertyValues[j] = static_cast<float>(ReadDouble(FileData.GetData(), Offset, bBigEndian));
+                    }
+                    else
+                    {
+                        Offset += Prop.ByteSize;
+                        PropertyValues[j] = 0.0f;
+                    }
+                }
             }
         }
 
-        OutSplats.Add(ExtractSplatData(PropertyValues));
+        ConvertRows(Block.GetData(), NumRows, OutSplats);
     }
 
     UE_LOG(LogTemp, Log, TEXT("PLYParser: Loaded %d splats from binary PLY file"), OutSplats.Num());
@@ -355,7 +425,15 @@ int32 FPLYParser::CalculateVertexByteSize() const
     return Size;
 }
 
-FGaussianSplatData FPLYParser::ExtractSplatData(const TArray<float> &PropertyValues)
+void FPLYParser::ConvertRows(const float *Rows, int32 NumRows, TArray<FGaussianSplatData> &OutSplats)
+{
+    GSPLAT_SCOPE(Convert);
+    const int32 NumProperties = Properties.Num();
+    for (int32 Row = 0; Row < NumRows; ++Row)
+        OutSplats.Add(ExtractSplatData(Rows + Row * NumProperties));
+}
+
+FGaussianSplatData FPLYParser::ExtractSplatData(const float *PropertyValues)
 {
     FGaussianSplatData Splat;
 
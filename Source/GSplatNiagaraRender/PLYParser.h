@@ -52,6 +52,9 @@ public:
 
     bool ParseFile(const FString &FilePath, TArray<FGaussianSplatData> &OutSplats);
 
+    // Reads only the header, for the format, vertex count and properties without touching the vertex data
+    bool ProbeFile(const FString &FilePath);
+
     int32 GetVertexCount() const
     {
         return VertexCount;
@@ -62,6 +65,12 @@ public:
         return Format;
     }
 
+    // High order SH coefficients each splat will carry
+    int32 GetNumSHCoeffs() const
+    {
+        return PropIdx_FRest.Num() / 3;
+    }
+
     FString GetErrorMessage() const
     {
         return ErrorMessage;
@@ -82,7 +91,10 @@ private:
 
     int32 CalculateVertexByteSize() const;
 
-    FGaussianSplatData ExtractSplatData(const TArray<float> &PropertyValues);
+    // Appends NumRows splats converted from consecutive rows of Properties.Num() values
+    void ConvertRows(const float *Rows, int32 NumRows, TArray<FGaussianSplatData> &OutSplats);
+
+    FGaussianSplatData ExtractSplatData(const float *PropertyValues);
 
 private:
     EPLYFormat Format;
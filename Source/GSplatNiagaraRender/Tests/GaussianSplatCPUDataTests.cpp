@@ -0,0 +1,163 @@
+﻿#include "CoreMinimal.h"
+#include "GaussianSplatCPUData.h"
+#include "GaussianSplatCulling.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+// Odd count so the last group of 4 is partial and its spare lanes read the sentinel, as in the VM gathers
+constexpr int32 NumTestSplats = 4 * 64 + 3;
+
+void MakeRandomCPUData(FRandomStream &Random, TArray<FGaussianSplatData> &OutSplats, FGaussianSplatCPUData &OutData)
+{
+    OutSplats.SetNum(NumTestSplats);
+    for (FGaussianSplatData &S : OutSplats)
+    {
+        S.Position = FVector3f(Random.FRandRange(-500.0f, 500.0f), Random.FRandRange(-500.0f, 500.0f),
+                               Random.FRandRange(-500.0f, 500.0f));
+        // Negative scales are not produced by the parser but the radius must still take the magnitude
+        S.Scale = FVector3f(Random.FRandRange(-20.0f, 20.0f), Random.FRandRange(-20.0f, 20.0f),
+                            Random.FRandRange(-20.0f, 20.0f));
+        // Wide enough to hit both clamps
+        S.ZeroOrderHarmonicsCoefficients =
+            FVector3f(Random.FRandRange(-3.0f, 3.0f), Random.FRandRange(-3.0f, 3.0f), Random.FRandRange(-3.0f, 3.0f));
+        S.Opacity = Random.FRand();
+    }
+    OutData.Build(OutSplats);
+}
+
+// Lane indices for group Base, with lanes past the end sent to the sentinel
+void GetLaneIndices(const FGaussianSplatCPUData &Data, int32 Base, int32 OutIndices[4])
+{
+    for (int32 Lane = 0; Lane < 4; ++Lane)
+        OutIndices[Lane] = Data.ClampIndex(Base + Lane);
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatCPUDataBoundingRadiiTest, "GaussianSplat.CPUData.BoundingRadii",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatCPUDataBoundingRadiiTest::RunTest(const FString &Parameters)
+{
+    FRandomStream Random(0x5A1D);
+    TArray<FGaussianSplatData> Splats;
+    FGaussianSplatCPUData Data;
+    MakeRandomCPUData(Random, Splats, Data);
+
+    // Build runs ComputeBoundingRadii over Num + 1 elements, so the scalar tail and the sentinel are covered
+    for (int32 i = 0; i < Splats.Num(); ++i)
+    {
+        if (Data.BoundingRadius[i] != Splats[i].GetBoundingRadius())
+        {
+            AddError(FString::Printf(TEXT("Splat %d: radius %.9g, scalar %.9g"), i, Data.BoundingRadius[i],
+                                     Splats[i].GetBoundingRadius()));
+            return false;
+        }
+    }
+    TestEqual(TEXT("Sentinel radius is BoundingSigma for its unit scale"), Data.BoundingRadius[Data.Num()],
+              FGaussianSplatData::BoundingSigma);
+
+    // Every start offset and length, so both the 4-wide body and the remainder loop run from unaligned bases
+    for (int32 Start = 0; Start < 4; ++Start)
+    {
+        for (int32 Count = 0; Count <= 9; ++Count)
+        {
+            TArray<float> Radii;
+            Radii.Init(-1.0f, Count);
+            FGaussianSplatCPUData::ComputeBoundingRadii(Data.ScaleX.GetData() + Start, Data.ScaleY.GetData() + Start,
+                                                        Data.ScaleZ.GetData() + Start, Radii.GetData(), Count);
+            for (int32 i = 0; i < Count; ++i)
+                TestEqual(FString::Printf(TEXT("Start %d count %d lane %d"), Start, Count, i), Radii[i],
+                          Splats[Start + i].GetBoundingRadius());
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatCPUDataSHToColorTest, "GaussianSplat.CPUData.SHToColor4",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatCPUDataSHToColorTest::RunTest(const FString &Parameters)
+{
+    FRandomStream Random(0xC010);
+    TArray<FGaussianSplatData> Splats;
+    FGaussianSplatCPUData Data;
+    MakeRandomCPUData(Random, Splats, Data);
+
+    const FLinearColor Tint(0.75f, 1.5f, 0.25f, 1.0f);
+    alignas(16) float SHR[4], SHG[4], SHB[4], R[4], G[4], B[4];
+    for (int32 Base = 0; Base < Data.Num(); Base += 4)
+    {
+        int32 Indices[4];
+        GetLaneIndices(Data, Base, Indices);
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            SHR[Lane] = Data.SHZeroR[Indices[Lane]];
+            SHG[Lane] = Data.SHZeroG[Indices[Lane]];
+            SHB[Lane] = Data.SHZeroB[Indices[Lane]];
+        }
+        FGaussianSplatCPUData::SHToColor4(SHR, SHG, SHB, Tint, R, G, B);
+
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            const bool bSentinel = Indices[Lane] == Data.Num();
+            const FLinearColor Expected =
+                bSentinel ? FLinearColor::Black
+                          : FGaussianSplatData::SHToColor(Splats[Indices[Lane]].ZeroOrderHarmonicsCoefficients) * Tint;
+            // The SIMD path may fuse the multiply-add, so allow a few ulps
+            const FString What =
+                FString::Printf(TEXT("Splat %d%s"), Indices[Lane], bSentinel ? TEXT(" (sentinel)") : TEXT(""));
+            TestEqual(What + TEXT(" R"), R[Lane], Expected.R, 1.0e-6f);
+            TestEqual(What + TEXT(" G"), G[Lane], Expected.G, 1.0e-6f);
+            TestEqual(What + TEXT(" B"), B[Lane], Expected.B, 1.0e-6f);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatCPUDataPixelRadiusTest, "GaussianSplat.CPUData.PixelRadius4",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatCPUDataPixelRadiusTest::RunTest(const FString &Parameters)
+{
+    FRandomStream Random(0x9123);
+    TArray<FGaussianSplatData> Splats;
+    FGaussianSplatCPUData Data;
+    MakeRandomCPUData(Random, Splats, Data);
+
+    // Camera in the middle of the cloud looking down a skewed axis, so lanes land in front, behind and on the plane
+    FGaussianSplatCullParams View;
+    const FVector3f Forward = FVector3f(1.0f, 0.3f, -0.2f).GetSafeNormal();
+    const FVector3f Eye(20.0f, -10.0f, 5.0f);
+    View.DepthPlane = FVector4f(Forward, -FVector3f::DotProduct(Forward, Eye));
+    View.PixelScale = 960.0f;
+
+    alignas(16) float PX[4], PY[4], PZ[4], Radius[4], Pixels[4];
+    for (int32 Base = 0; Base < Data.Num(); Base += 4)
+    {
+        int32 Indices[4];
+        GetLaneIndices(Data, Base, Indices);
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            PX[Lane] = Data.PositionX[Indices[Lane]];
+            PY[Lane] = Data.PositionY[Indices[Lane]];
+            PZ[Lane] = Data.PositionZ[Indices[Lane]];
+            Radius[Lane] = Data.BoundingRadius[Indices[Lane]];
+        }
+        FGaussianSplatCPUData::PixelRadius4(PX, PY, PZ, Radius, View.DepthPlane, View.PixelScale, Pixels);
+
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            const FVector3f Position(PX[Lane], PY[Lane], PZ[Lane]);
+            const float Expected = FGaussianSplatCulling::GetPixelRadius(View, Position, Radius[Lane]);
+            TestEqual(FString::Printf(TEXT("Splat %d"), Indices[Lane]), Pixels[Lane], Expected,
+                      FMath::Max(FMath::Abs(Expected) * 1.0e-5f, 1.0e-6f));
+        }
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,158 @@
+﻿#include "CoreMinimal.h"
+#include "GaussianSplatCompactFile.h"
+#include "GaussianSplatSyntheticData.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+// Worst-case error each format's quantization allows, in Unreal units
+struct FCompactTolerances
+{
+    float Position = 0.0f; // cm
+    float ScaleRelative = 0.0f;
+    float Color = 0.0f; // clamped linear SH0 colour
+    float Opacity = 0.0f;
+    float RotationRadians = 0.0f;
+    // Per f_rest coefficient by index; negative when the format drops higher-order SH
+    float HighOrderSH[15] = {};
+};
+
+void MakeCompactTestSplats(TArray<FGaussianSplatData> &OutSplats)
+{
+    FGaussianSplatSyntheticSettings Synthetic;
+    Synthetic.NumSplats = 5000;
+    Synthetic.SHDegree = 3;
+    FGaussianSplatSyntheticData::MakeSplats(Synthetic, OutSplats);
+}
+
+bool RoundTripFile(FAutomationTestBase &Test, const TCHAR *Extension, const FGaussianSplatCompactSettings &Settings,
+                   const TArray<FGaussianSplatData> &Splats, TArray<FGaussianSplatData> &OutSplats)
+{
+    const FString FilePath =
+        FPaths::Combine(FPaths::AutomationTransientDir(), FString(TEXT("GaussianSplatCompactTest")) + Extension);
+    FString Error;
+    const bool bWritten = FGaussianSplatCompactFile::Write(FilePath, Splats, Settings, Error);
+    const bool bRead = bWritten && FGaussianSplatCompactFile::Read(FilePath, OutSplats, Error);
+    IFileManager::Get().Delete(*FilePath);
+    return Test.TestTrue(FString::Printf(TEXT("Write and read %s: %s"), Extension, *Error), bRead) &&
+           Test.TestEqual(TEXT("Splat count survives"), OutSplats.Num(), Splats.Num());
+}
+
+void CheckErrors(FAutomationTestBase &Test, const TArray<FGaussianSplatData> &In,
+                 const TArray<FGaussianSplatData> &Out, const FCompactTolerances &Tolerances)
+{
+    float MaxPosition = 0.0f, MaxScale = 0.0f, MaxColor = 0.0f, MaxOpacity = 0.0f, MaxRotation = 0.0f;
+    float MaxSHExcess = 0.0f;
+    const bool bKeepsSH = Tolerances.HighOrderSH[0] >= 0.0f;
+    for (int32 i = 0; i < In.Num(); ++i)
+    {
+        const FGaussianSplatData &A = In[i];
+        const FGaussianSplatData &B = Out[i];
+        MaxPosition = FMath::Max(MaxPosition, (A.Position - B.Position).GetAbsMax());
+        for (int32 c = 0; c < 3; ++c)
+            MaxScale = FMath::Max(MaxScale, FMath::Abs(B.Scale[c] / A.Scale[c] - 1.0f));
+        const FLinearColor ColorA = FGaussianSplatData::SHToColor(A.ZeroOrderHarmonicsCoefficients);
+        const FLinearColor ColorB = FGaussianSplatData::SHToColor(B.ZeroOrderHarmonicsCoefficients);
+        MaxColor = FMath::Max(MaxColor, FMath::Max3(FMath::Abs(ColorA.R - ColorB.R), FMath::Abs(ColorA.G - ColorB.G),
+                                                    FMath::Abs(ColorA.B - ColorB.B)));
+        MaxOpacity = FMath::Max(MaxOpacity, FMath::Abs(A.Opacity - B.Opacity));
+        MaxRotation = FMath::Max(MaxRotation, A.Orientation.GetNormalized().AngularDistance(B.Orientation));
+
+        if (!bKeepsSH)
+        {
+            MaxSHExcess = FMath::Max(MaxSHExcess, float(B.HighOrderHarmonicsCoefficients.Num()));
+            continue;
+        }
+        if (B.HighOrderHarmonicsCoefficients.Num() != A.HighOrderHarmonicsCoefficients.Num())
+        {
+            MaxSHExcess = UE_MAX_FLT;
+            continue;
+        }
+        // Flat f_rest order: channel-major over NumCoeffs coefficients, as FPLYParser groups them
+        const int32 NumCoeffs = A.HighOrderHarmonicsCoefficients.Num();
+        for (int32 Flat = 0; Flat < NumCoeffs * 3; ++Flat)
+        {
+            const float Error = FMath::Abs(A.HighOrderHarmonicsCoefficients[Flat / 3][Flat % 3] -
+                                           B.HighOrderHarmonicsCoefficients[Flat / 3][Flat % 3]);
+            MaxSHExcess = FMath::Max(MaxSHExcess, Error - Tolerances.HighOrderSH[Flat % NumCoeffs]);
+        }
+    }
+
+    Test.TestTrue(FString::Printf(TEXT("Position error %g cm within %g"), MaxPosition, Tolerances.Position),
+                  MaxPosition <= Tolerances.Position);
+    Test.TestTrue(FString::Printf(TEXT("Relative scale error %g within %g"), MaxScale, Tolerances.ScaleRelative),
+                  MaxScale <= Tolerances.ScaleRelative);
+    Test.TestTrue(FString::Printf(TEXT("Colour error %g within %g"), MaxColor, Tolerances.Color),
+                  MaxColor <= Tolerances.Color);
+    Test.TestTrue(FString::Printf(TEXT("Opacity error %g within %g"), MaxOpacity, Tolerances.Opacity),
+                  MaxOpacity <= Tolerances.Opacity);
+    Test.TestTrue(FString::Printf(TEXT("Rotation error %g rad within %g"), MaxRotation, Tolerances.RotationRadians),
+                  MaxRotation <= Tolerances.RotationRadians);
+    Test.TestTrue(bKeepsSH ? FString::Printf(TEXT("Higher-order SH error exceeds its bucket by %g"), MaxSHExcess)
+                           : FString(TEXT("Higher-order SH is dropped")),
+                  MaxSHExcess <= 0.0f);
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatCompactSplatTest, "GaussianSplat.CompactFile.SplatRoundTrip",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatCompactSplatTest::RunTest(const FString &Parameters)
+{
+    TArray<FGaussianSplatData> Splats, Decoded;
+    MakeCompactTestSplats(Splats);
+    if (!RoundTripFile(*this, TEXT(".splat"), FGaussianSplatCompactSettings(), Splats, Decoded))
+        return false;
+
+    // Position and scale are float32 through the PLY-space conversions; colour, opacity and each wxyz component
+    // are 8 bits, with rotation components stepping 1/128 and 1.0 clamping one step short
+    FCompactTolerances Tolerances;
+    Tolerances.Position = 1.0e-3f;
+    Tolerances.ScaleRelative = 1.0e-4f;
+    Tolerances.Color = 0.5f / 255.0f + 1.0e-5f;
+    Tolerances.Opacity = 0.5f / 255.0f + 1.0e-6f;
+    Tolerances.RotationRadians = 0.02f;
+    Tolerances.HighOrderSH[0] = -1.0f;
+    CheckErrors(*this, Splats, Decoded, Tolerances);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatCompactSpzTest, "GaussianSplat.CompactFile.SpzRoundTrip",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatCompactSpzTest::RunTest(const FString &Parameters)
+{
+    TArray<FGaussianSplatData> Splats, Decoded;
+    MakeCompactTestSplats(Splats);
+    FGaussianSplatCompactSettings Settings;
+    if (!RoundTripFile(*this, TEXT(".spz"), Settings, Splats, Decoded))
+        return false;
+
+    // Half a step of each quantizer: 24-bit fixed point metres, log scale in 1/16ths, SH0 in 8 bits over +-0.5/0.15,
+    // 8-bit opacity, and SH buckets of 8 (degree 1) or 16 (above) on a 1/128 grid. Rotation stores xyz in 8 bits and
+    // rebuilds w, so near w = 0 an xyz error E of up to sqrt(3) * 0.5 / 127.5 grows to sqrt(2E) in w.
+    const float RotationComponent = FMath::Sqrt(3.0f) * 0.5f / 127.5f;
+    FCompactTolerances Tolerances;
+    Tolerances.Position = 100.0f * 0.5f / float(1 << Settings.FractionalBits) + 1.0e-3f;
+    Tolerances.ScaleRelative = FMath::Exp(0.5f / 16.0f) - 1.0f + 1.0e-4f;
+    Tolerances.Color = FGaussianSplatData::SHToColor(FVector3f(0.5f / (0.15f * 255.0f))).R - 0.5f + 1.0e-5f;
+    Tolerances.Opacity = 0.5f / 255.0f + 1.0e-6f;
+    Tolerances.RotationRadians = 2.0f * (RotationComponent + FMath::Sqrt(2.0f * RotationComponent));
+    for (int32 Coeff = 0; Coeff < UE_ARRAY_COUNT(Tolerances.HighOrderSH); ++Coeff)
+        Tolerances.HighOrderSH[Coeff] = ((Coeff < 3 ? 8.0f : 16.0f) * 0.5f + 0.5f) / 128.0f + 1.0e-6f;
+    CheckErrors(*this, Splats, Decoded, Tolerances);
+
+    // A lower SH cap keeps only the degree 1 coefficients
+    Settings.MaxSHDegree = 1;
+    if (!RoundTripFile(*this, TEXT(".spz"), Settings, Splats, Decoded))
+        return false;
+    TestEqual(TEXT("MaxSHDegree 1 keeps 3 coefficients per channel"), Decoded[0].HighOrderHarmonicsCoefficients.Num(),
+              3);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,199 @@
+﻿#include "CoreMinimal.h"
+#include "GaussianSplatCulling.h"
+#include "Math/PerspectiveMatrix.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+constexpr float TestViewHeight = 1080.0f;
+
+// Camera at the origin looking down +X with a 90 degree horizontal field of view, as FSceneView builds it
+FMatrix MakeTestLocalToClip()
+{
+    const FMatrix ViewRotation(FPlane(0, 0, 1, 0), FPlane(1, 0, 0, 0), FPlane(0, 1, 0, 0), FPlane(0, 0, 0, 1));
+    const FReversedZPerspectiveMatrix Projection(UE_HALF_PI * 0.5f, 1920.0f, TestViewHeight, 10.0f);
+    return ViewRotation * Projection;
+}
+
+// Splat of a given bounding radius; orientation and colour do not matter to culling
+FGaussianSplatData MakeCullSplat(const FVector3f &Position, float BoundingRadius)
+{
+    FGaussianSplatData S;
+    S.Position = Position;
+    S.Scale = FVector3f(BoundingRadius / FGaussianSplatData::BoundingSigma);
+    S.Opacity = 0.5f;
+    return S;
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatCullFrustumTest, "GaussianSplat.Culling.Frustum",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatCullFrustumTest::RunTest(const FString &Parameters)
+{
+    const FMatrix LocalToClip = MakeTestLocalToClip();
+    FGaussianSplatCullParams Params;
+    FGaussianSplatCulling::BuildParams(LocalToClip, TestViewHeight, 1.0f, 0.0f, Params);
+    Params.bEnabled = true;
+
+    // More than one 16384 chunk, all around the camera, with near-zero radii so clip space decides visibility
+    FRandomStream Random(0xF257);
+    TArray<FGaussianSplatData> Splats;
+    for (int32 i = 0; i < 40000; ++i)
+    {
+        Splats.Add(MakeCullSplat(FVector3f(Random.FRandRange(-2000.0f, 2000.0f), Random.FRandRange(-2000.0f, 2000.0f),
+                                           Random.FRandRange(-2000.0f, 2000.0f)),
+                                 1.0e-3f));
+    }
+
+    TArray<int32> Visible;
+    const int32 NumVisible = FGaussianSplatCulling::Cull(Params, Splats, Visible);
+    TestEqual(TEXT("Returned count matches the list"), NumVisible, Visible.Num());
+    for (int32 i = 1; i < Visible.Num(); ++i)
+    {
+        if (Visible[i] <= Visible[i - 1])
+        {
+            AddError(TEXT("Visible indices are not strictly ascending"));
+            return false;
+        }
+    }
+
+    // Reference: inside the reversed-Z clip volume in front of the near plane. Splats within a hair of a plane are
+    // left out of the comparison, since plane extraction and projection round differently.
+    TBitArray<> IsListed(false, Splats.Num());
+    for (int32 Index : Visible)
+        IsListed[Index] = true;
+    int32 NumChecked = 0, NumInside = 0;
+    for (int32 i = 0; i < Splats.Num(); ++i)
+    {
+        const FVector4 Clip = LocalToClip.TransformFVector4(FVector4(FVector(Splats[i].Position), 1.0));
+        const double Margin = FMath::Min3(Clip.W - FMath::Abs(Clip.X), Clip.W - FMath::Abs(Clip.Y), Clip.W - Clip.Z);
+        if (FMath::Abs(Margin) < 1.0e-3 * FMath::Max(FMath::Abs(Clip.W), 1.0))
+            continue;
+        const bool bInside = Clip.W > 0.0 && Margin > 0.0;
+        ++NumChecked;
+        NumInside += bInside;
+        if (bInside != IsListed[i])
+        {
+            AddError(FString::Printf(TEXT("Splat %d at %s: culled %s, reference %s"), i,
+                                     *Splats[i].Position.ToString(), IsListed[i] ? TEXT("visible") : TEXT("hidden"),
+                                     bInside ? TEXT("visible") : TEXT("hidden")));
+            return false;
+        }
+    }
+    TestTrue(TEXT("Most splats were compared"), NumChecked > Splats.Num() * 9 / 10);
+    TestTrue(TEXT("Some splats are in view and some are not"), NumInside > 0 && NumInside < NumChecked);
+
+    // Bounding spheres that straddle a plane are kept; the radius scale widens the test
+    const FGaussianSplatData Straddling[] = {
+        MakeCullSplat(FVector3f(1000.0f, -1010.0f, 0.0f), 20.0f),  // centre just left of the 45 degree edge
+        MakeCullSplat(FVector3f(1000.0f, -1100.0f, 0.0f), 20.0f),  // well outside
+        MakeCullSplat(FVector3f(5.0f, 0.0f, 0.0f), 10.0f),         // centre in front of the near plane
+        MakeCullSplat(FVector3f(-100.0f, 0.0f, 0.0f), 20.0f),      // behind the camera
+    };
+    FGaussianSplatCulling::Cull(Params, Straddling, Visible);
+    TestTrue(TEXT("Only the straddling and near-plane splats survive"), Visible == TArray<int32>({0, 2}));
+    Params.RadiusScale = 10.0f;
+    FGaussianSplatCulling::Cull(Params, Straddling, Visible);
+    TestTrue(TEXT("A larger radius scale keeps the nearby outside splat"), Visible == TArray<int32>({0, 1, 2}));
+
+    // Disabled culling lists everything, in order
+    Params.bEnabled = false;
+    TestEqual(TEXT("Disabled culling keeps every splat"), FGaussianSplatCulling::Cull(Params, Splats, Visible),
+              Splats.Num());
+    TestTrue(TEXT("Disabled culling lists indices in order"),
+             Visible.Num() == Splats.Num() && Visible[0] == 0 && Visible.Last() == Splats.Num() - 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatCullThinningTest, "GaussianSplat.Culling.DistanceThinning",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Sub-pixel thinning by distance: at each depth the surviving fraction must match the keep probability, and the
+// compensated opacity of the survivors must preserve the transmittance of the whole band
+bool FGaussianSplatCullThinningTest::RunTest(const FString &Parameters)
+{
+    constexpr float MinPixelRadius = 2.0f;
+    constexpr float BoundingRadius = 4.0f;
+    constexpr int32 SplatsPerBand = 20000;
+
+    FGaussianSplatCullParams Params;
+    FGaussianSplatCulling::BuildParams(MakeTestLocalToClip(), TestViewHeight, 1.0f, MinPixelRadius, Params);
+    Params.bEnabled = true;
+
+    // Depth at which the splat projects to exactly MinPixelRadius; keep falls off as 1 / depth^2 beyond it
+    const float FullDepth = BoundingRadius * Params.PixelScale / MinPixelRadius;
+    const float DepthScales[] = {0.5f, 1.5f, 2.0f, 4.0f};
+
+    FRandomStream Random(0x7B1A);
+    TArray<FGaussianSplatData> Splats;
+    for (float DepthScale : DepthScales)
+    {
+        // A small patch on the view axis, so every splat is well inside the frustum and at the same depth
+        for (int32 i = 0; i < SplatsPerBand; ++i)
+        {
+            Splats.Add(MakeCullSplat(FVector3f(FullDepth * DepthScale, Random.FRandRange(-1.0f, 1.0f),
+                                               Random.FRandRange(-1.0f, 1.0f)),
+                                     BoundingRadius));
+        }
+    }
+
+    TArray<int32> Visible;
+    FGaussianSplatCulling::Cull(Params, Splats, Visible);
+
+    for (int32 Band = 0; Band < UE_ARRAY_COUNT(DepthScales); ++Band)
+    {
+        const float Keep = FMath::Min(1.0f / FMath::Square(DepthScales[Band]), 1.0f);
+        const FGaussianSplatData &First = Splats[Band * SplatsPerBand];
+        TestEqual(FString::Printf(TEXT("Band %d keep probability"), Band),
+                  FGaussianSplatCulling::GetKeepProbability(
+                      FGaussianSplatCulling::GetPixelRadius(Params, First.Position, First.GetBoundingRadius()),
+                      MinPixelRadius),
+                  Keep, 1.0e-3f);
+
+        // Survivors, and the log transmittance their compensated opacities leave
+        int32 NumKept = 0;
+        double LogTransmittance = 0.0;
+        for (int32 Index : Visible)
+        {
+            if (Index / SplatsPerBand != Band)
+                continue;
+            ++NumKept;
+            const FGaussianSplatData &S = Splats[Index];
+            const float PixelRadius = FGaussianSplatCulling::GetPixelRadius(Params, S.Position, S.GetBoundingRadius());
+            const float Opacity = FGaussianSplatCulling::CompensateOpacity(
+                S.Opacity, FGaussianSplatCulling::GetKeepProbability(PixelRadius, MinPixelRadius));
+            LogTransmittance += FMath::Loge(1.0 - Opacity);
+        }
+
+        // Binomial: within five standard deviations of the expected count
+        const double Expected = double(SplatsPerBand) * Keep;
+        const double Sigma = FMath::Sqrt(double(SplatsPerBand) * Keep * (1.0 - Keep));
+        TestTrue(FString::Printf(TEXT("Band %d keeps %d of %d, expected %.0f"), Band, NumKept, SplatsPerBand, Expected),
+                 FMath::Abs(NumKept - Expected) <= 5.0 * Sigma + 0.5);
+
+        // The band's full transmittance is (1 - 0.5)^N; survivors must reproduce it up to the same sampling noise
+        const double FullLogTransmittance = SplatsPerBand * FMath::Loge(0.5);
+        TestEqual(FString::Printf(TEXT("Band %d log transmittance"), Band), LogTransmittance, FullLogTransmittance,
+                  FMath::Abs(FullLogTransmittance) * 5.0 * Sigma / FMath::Max(Expected, 1.0) + 1.0e-3);
+    }
+
+    // The compensation itself is exact: Keep survivors of opacity A' leave (1 - A')^Keep = 1 - A per original
+    for (float Opacity : {0.01f, 0.3f, 0.9f})
+    {
+        for (float Keep : {0.05f, 0.25f, 0.8f})
+        {
+            const float Compensated = FGaussianSplatCulling::CompensateOpacity(Opacity, Keep);
+            TestEqual(FString::Printf(TEXT("Compensated %.2f at keep %.2f"), Opacity, Keep),
+                      FMath::Pow(1.0f - Compensated, Keep), 1.0f - Opacity, 1.0e-4f);
+        }
+        TestEqual(TEXT("Full keep leaves opacity alone"), FGaussianSplatCulling::CompensateOpacity(Opacity, 1.0f),
+                  Opacity);
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,94 @@
+﻿#include "CoreMinimal.h"
+#include "GaussianSplatPacking.h"
+#include "GaussianSplatSyntheticData.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatPackingRoundTripTest, "GaussianSplat.Packing.RoundTrip",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// The record stores every field as fp32 (see FGaussianSplatPacking), so the allowed error per field is zero
+bool FGaussianSplatPackingRoundTripTest::RunTest(const FString &Parameters)
+{
+    FGaussianSplatSyntheticSettings Synthetic;
+    Synthetic.NumSplats = 4096;
+    Synthetic.SHDegree = 3;
+    TArray<FGaussianSplatData> Splats;
+    FGaussianSplatSyntheticData::MakeSplats(Synthetic, Splats);
+
+    // Values the synthetic stream does not produce: signed zero, denormal, huge and unnormalised rotations
+    FGaussianSplatData &Edge = Splats.AddDefaulted_GetRef();
+    Edge.Position = FVector3f(-0.0f, 1.0e-40f, 3.0e30f);
+    Edge.Scale = FVector3f(1.0e-30f, 0.0f, 7.0e5f);
+    Edge.Orientation = FQuat4f(0.5f, -2.0f, 0.25f, 8.0f);
+    Edge.ZeroOrderHarmonicsCoefficients = FVector3f(-1.0e4f, 0.0f, 1.0e4f);
+    Edge.Opacity = 1.0f;
+
+    TArray<FGaussianSplatPackedRecord> Records;
+    FGaussianSplatPacking::PackRecords(Splats, Records);
+    TArray<FGaussianSplatData> Unpacked;
+    FGaussianSplatPacking::UnpackRecords(Records, Unpacked);
+    if (!TestEqual(TEXT("Unpacked count"), Unpacked.Num(), Splats.Num()))
+        return false;
+
+    float MaxError[6] = {};
+    auto Track = [&MaxError](int32 Field, float A, float B)
+    {
+        // Any mismatch registers, however small
+        MaxError[Field] = FMath::Max(MaxError[Field], A == B ? 0.0f : FMath::Abs(A - B) + UE_SMALL_NUMBER);
+    };
+    for (int32 i = 0; i < Splats.Num(); ++i)
+    {
+        const FGaussianSplatData &In = Splats[i];
+        const FGaussianSplatData &Out = Unpacked[i];
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            Track(0, In.Position[Axis], Out.Position[Axis]);
+            Track(1, In.Scale[Axis], Out.Scale[Axis]);
+            Track(3, In.ZeroOrderHarmonicsCoefficients[Axis], Out.ZeroOrderHarmonicsCoefficients[Axis]);
+        }
+        Track(2, In.Orientation.X, Out.Orientation.X);
+        Track(2, In.Orientation.Y, Out.Orientation.Y);
+        Track(2, In.Orientation.Z, Out.Orientation.Z);
+        Track(2, In.Orientation.W, Out.Orientation.W);
+        Track(4, In.Opacity, Out.Opacity);
+        Track(5, In.GetBoundingRadius(), Records[i].Position.W);
+
+        if (Out.HighOrderHarmonicsCoefficients.Num() != 0 || !Out.Normal.IsZero())
+        {
+            AddError(FString::Printf(TEXT("Splat %d: normals and higher-order SH must not survive the record"), i));
+            return false;
+        }
+    }
+
+    const TCHAR *FieldNames[] = {TEXT("Position"), TEXT("Scale"), TEXT("Orientation"), TEXT("SH0"), TEXT("Opacity"),
+                                 TEXT("Bounding radius")};
+    for (int32 Field = 0; Field < UE_ARRAY_COUNT(MaxError); ++Field)
+        TestEqual(FString::Printf(TEXT("%s max round-trip error"), FieldNames[Field]), MaxError[Field], 0.0f);
+
+    // The stream split must carry the same four float4s the interleaved HLSL reads at the record offsets
+    FGaussianSplatStreams Streams;
+    FGaussianSplatPacking::SplitRecords(Records, Streams);
+    if (!TestEqual(TEXT("Stream count"), Streams.Num(), Records.Num()))
+        return false;
+    for (int32 i = 0; i < Records.Num(); ++i)
+    {
+        const uint8 *Bytes = reinterpret_cast<const uint8 *>(&Records[i]);
+        const bool bMatch =
+            FMemory::Memcmp(&Streams.Positions[i], Bytes + FGaussianSplatPackedRecord::PositionOffset, 16) == 0 &&
+            FMemory::Memcmp(&Streams.Scales[i], Bytes + FGaussianSplatPackedRecord::ScaleOffset, 16) == 0 &&
+            FMemory::Memcmp(&Streams.Orientations[i], Bytes + FGaussianSplatPackedRecord::OrientationOffset, 16) == 0 &&
+            FMemory::Memcmp(&Streams.SHZeroCoeffsAndOpacity[i],
+                            Bytes + FGaussianSplatPackedRecord::SHZeroCoeffsAndOpacityOffset, 16) == 0 &&
+            FMemory::Memcmp(&Unpacked[i].Opacity, Bytes + FGaussianSplatPackedRecord::OpacityOffset, 4) == 0;
+        if (!bMatch)
+        {
+            AddError(FString::Printf(TEXT("Record %d: streams or HLSL offsets disagree with the record"), i));
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,193 @@
+﻿#include "Algo/StableSort.h"
+#include "CoreMinimal.h"
+#include "GaussianSplatRasterizer.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+// 32x32 pixels (2x2 tiles), identity camera: a splat at (X, Y, Z) lands on pixel (16 + 100 X / Z, 16 + 100 Y / Z)
+FGaussianSplatRasterView MakeTestView()
+{
+    FGaussianSplatRasterView View;
+    View.Size = FIntPoint(32, 32);
+    View.Focal = FVector2f(100.0f, 100.0f);
+    View.Principal = FVector2f(16.0f, 16.0f);
+    View.NearZ = 1.0f;
+    View.FarZ = 1000.0f;
+    return View;
+}
+
+FGaussianSplatData MakeTestSplat(const FVector3f &Position, const FVector3f &Scale, const FVector3f &SH,
+                                 float Opacity)
+{
+    FGaussianSplatData S;
+    S.Position = Position;
+    S.Scale = Scale;
+    S.Orientation = FQuat4f::Identity;
+    S.ZeroOrderHarmonicsCoefficients = SH;
+    S.Opacity = Opacity;
+    return S;
+}
+
+// Alpha of an isotropic splat centred on the view axis whose footprint is Sigma pixels, at a pixel centre. The
+// rasterizer adds 0.3 to the 2D variance as a low-pass.
+float OracleAlpha(float Opacity, float SigmaPixels, int32 X, int32 Y)
+{
+    const float Variance = SigmaPixels * SigmaPixels + 0.3f;
+    const float DX = 16.0f - (X + 0.5f);
+    const float DY = 16.0f - (Y + 0.5f);
+    const float Alpha = FMath::Min(0.99f, Opacity * FMath::Exp(-0.5f * (DX * DX + DY * DY) / Variance));
+    return Alpha < FGaussianSplatRasterizer::MinAlpha ? 0.0f : Alpha;
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatRasterizerOracleTest, "GaussianSplat.Rasterizer.Oracle",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatRasterizerOracleTest::RunTest(const FString &Parameters)
+{
+    const FGaussianSplatRasterView View = MakeTestView();
+
+    // A green splat behind a red one, both 2 pixels across at their depth, listed back to front so the sort has
+    // to reorder them. Then one in front of the near plane and one far off screen, which must both be dropped.
+    const FVector3f Red(10.0f, -10.0f, -10.0f);
+    const FVector3f Green(-10.0f, 10.0f, -10.0f);
+    const TArray<FGaussianSplatData> Splats = {
+        MakeTestSplat(FVector3f(0.0f, 0.0f, 200.0f), FVector3f(4.0f), Green, 0.9f),
+        MakeTestSplat(FVector3f(0.0f, 0.0f, 100.0f), FVector3f(2.0f), Red, 0.6f),
+        MakeTestSplat(FVector3f(0.0f, 0.0f, 0.5f), FVector3f(2.0f), Red, 1.0f),
+        MakeTestSplat(FVector3f(5000.0f, 0.0f, 100.0f), FVector3f(2.0f), Red, 1.0f),
+    };
+
+    TArray<FLinearColor> Pixels;
+    FGaussianSplatRasterStats Stats;
+    FGaussianSplatRasterizer::Render(View, Splats, Pixels, &Stats);
+    if (!TestEqual(TEXT("Pixel count"), Pixels.Num(), View.Size.X * View.Size.Y))
+        return false;
+    TestEqual(TEXT("Only the two visible splats project"), Stats.NumProjected, 2);
+    // Radius ceil(3 sqrt(lambda)) = 7 pixels around pixel 16 reaches all four tiles
+    TestEqual(TEXT("Each visible splat keys all four tiles"), Stats.NumKeys, int64(8));
+
+    for (int32 Y = 0; Y < View.Size.Y; ++Y)
+    {
+        for (int32 X = 0; X < View.Size.X; ++X)
+        {
+            // Front to back: red, then green through what red lets past
+            const float RedAlpha = OracleAlpha(0.6f, 2.0f, X, Y);
+            const float GreenAlpha = OracleAlpha(0.9f, 2.0f, X, Y);
+            const float Transmittance = (1.0f - RedAlpha) * (1.0f - GreenAlpha);
+            const FLinearColor Expected(RedAlpha, GreenAlpha * (1.0f - RedAlpha), 0.0f, 1.0f - Transmittance);
+
+            const FLinearColor &Got = Pixels[Y * View.Size.X + X];
+            if (!Got.Equals(Expected, 1.0e-4f))
+            {
+                AddError(FString::Printf(TEXT("Pixel (%d, %d): got %s, expected %s"), X, Y, *Got.ToString(),
+                                         *Expected.ToString()));
+                return false;
+            }
+        }
+    }
+    TestTrue(TEXT("Centre is mostly red"), Pixels[16 * View.Size.X + 16].R > Pixels[16 * View.Size.X + 16].G);
+    TestEqual(TEXT("Corner is empty"), Pixels[0], FLinearColor(0.0f, 0.0f, 0.0f, 0.0f));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatRasterizerAnisotropyTest, "GaussianSplat.Rasterizer.Anisotropy",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatRasterizerAnisotropyTest::RunTest(const FString &Parameters)
+{
+    const FGaussianSplatRasterView View = MakeTestView();
+
+    // Long along local X, then turned a quarter about the view axis: the footprint must run down the screen
+    FGaussianSplatData Splat =
+        MakeTestSplat(FVector3f(0.0f, 0.0f, 100.0f), FVector3f(5.0f, 1.0f, 1.0f), FVector3f(10.0f), 0.9f);
+    TArray<FLinearColor> Pixels;
+    FGaussianSplatRasterizer::Render(View, MakeArrayView(&Splat, 1), Pixels);
+    const float AlongX = Pixels[15 * View.Size.X + 22].A;
+    const float AlongY = Pixels[22 * View.Size.X + 15].A;
+    TestTrue(TEXT("Unrotated footprint is wide"), AlongX > 4.0f * AlongY);
+
+    Splat.Orientation = FQuat4f(FVector3f(0.0f, 0.0f, 1.0f), UE_HALF_PI);
+    FGaussianSplatRasterizer::Render(View, MakeArrayView(&Splat, 1), Pixels);
+    TestEqual(TEXT("Rotated footprint is tall"), Pixels[22 * View.Size.X + 15].A, AlongX, 1.0e-4f);
+    TestEqual(TEXT("Rotated footprint is narrow"), Pixels[15 * View.Size.X + 22].A, AlongY, 1.0e-4f);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatRasterizerStatsTest, "GaussianSplat.Rasterizer.StatsOnEarlyOut",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatRasterizerStatsTest::RunTest(const FString &Parameters)
+{
+    FGaussianSplatRasterView View = MakeTestView();
+    View.Size = FIntPoint::ZeroValue;
+    const FGaussianSplatData Splat =
+        MakeTestSplat(FVector3f(0.0f, 0.0f, 100.0f), FVector3f(2.0f), FVector3f(0.0f), 1.0f);
+
+    TArray<FLinearColor> Pixels;
+    FGaussianSplatRasterStats Stats;
+    Stats.NumProjected = 123;
+    Stats.NumKeys = 456;
+    Stats.BlendSeconds = 7.0;
+    FGaussianSplatRasterizer::Render(View, MakeArrayView(&Splat, 1), Pixels, &Stats);
+    TestEqual(TEXT("No pixels for an invalid view"), Pixels.Num(), 0);
+    TestEqual(TEXT("NumProjected reset"), Stats.NumProjected, 0);
+    TestEqual(TEXT("NumKeys reset"), Stats.NumKeys, int64(0));
+    TestEqual(TEXT("BlendSeconds reset"), Stats.BlendSeconds, 0.0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatRasterizerSortTest, "GaussianSplat.Rasterizer.SortPairs",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatRasterizerSortTest::RunTest(const FString &Parameters)
+{
+    struct FPair
+    {
+        uint32 Key;
+        uint32 Value;
+    };
+
+    // Each mask leaves different bytes varying, so different passes are skipped. An odd number of executed passes
+    // leaves the result in the scratch arrays, which SortPairs must swap back.
+    const uint32 Masks[] = {0xFFFFFFFFu, 0x000000FFu, 0xFF000000u, 0x00FF00FFu, 0x00FFFF00u, 0x0000000Fu, 0u};
+    const int32 Counts[] = {0, 1, 2, 3, 17, 1000, 20000};
+
+    FRandomStream Random(0x50F7);
+    for (uint32 Mask : Masks)
+    {
+        for (int32 Count : Counts)
+        {
+            TArray<uint32> Keys, Values;
+            TArray<FPair> Expected;
+            for (int32 i = 0; i < Count; ++i)
+            {
+                // The constant bits make skipped digits nonzero; the narrow masks give many equal keys, so
+                // stability is actually exercised
+                const uint32 Key = (uint32(Random.GetUnsignedInt()) & Mask) | 0x40404040u;
+                Keys.Add(Key);
+                Values.Add(uint32(i));
+                Expected.Add(FPair{Key, uint32(i)});
+            }
+            Algo::StableSortBy(Expected, &FPair::Key);
+
+            FGaussianSplatRasterizer::SortPairs(Keys, Values);
+            bool bMatch = Keys.Num() == Count && Values.Num() == Count;
+            for (int32 i = 0; bMatch && i < Count; ++i)
+                bMatch = Keys[i] == Expected[i].Key && Values[i] == Expected[i].Value;
+            if (!bMatch)
+            {
+                AddError(FString::Printf(TEXT("Mask %08x count %d: radix order differs from Algo::StableSort"), Mask,
+                                         Count));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
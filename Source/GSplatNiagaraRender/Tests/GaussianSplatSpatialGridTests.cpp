@@ -0,0 +1,263 @@
+﻿#include "CoreMinimal.h"
+#include "GaussianSplatDirtyRanges.h"
+#include "GaussianSplatSpatialGrid.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+// A dense blob, a flat sheet and some exact duplicates, so cells are uneven, one axis is thin and ties happen
+void MakeGridTestSplats(FRandomStream &Random, TArray<FGaussianSplatData> &OutSplats)
+{
+    for (int32 i = 0; i < 1500; ++i)
+    {
+        FGaussianSplatData &S = OutSplats.AddDefaulted_GetRef();
+        S.Position = FVector3f(Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(-50.0f, 50.0f),
+                               Random.FRandRange(-50.0f, 50.0f));
+    }
+    for (int32 i = 0; i < 1500; ++i)
+    {
+        FGaussianSplatData &S = OutSplats.AddDefaulted_GetRef();
+        S.Position = FVector3f(Random.FRandRange(-400.0f, 400.0f), Random.FRandRange(-400.0f, 400.0f), 120.0f);
+    }
+    for (int32 i = 0; i < 20; ++i)
+    {
+        const FGaussianSplatData Duplicate = OutSplats[Random.RandHelper(OutSplats.Num())];
+        OutSplats.Add(Duplicate);
+    }
+}
+
+// Query points inside, on the edge of and far outside the cloud, plus the splat centres themselves
+FVector3f MakeQueryPoint(FRandomStream &Random, const TArray<FGaussianSplatData> &Splats, int32 Query)
+{
+    switch (Query % 3)
+    {
+    case 0:
+        return Splats[Random.RandHelper(Splats.Num())].Position;
+    case 1:
+        return FVector3f(Random.FRandRange(-450.0f, 450.0f), Random.FRandRange(-450.0f, 450.0f),
+                         Random.FRandRange(-100.0f, 200.0f));
+    default:
+        return FVector3f(Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-5000.0f, 5000.0f),
+                         Random.FRandRange(-5000.0f, 5000.0f));
+    }
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatSpatialGridRadiusTest, "GaussianSplat.SpatialGrid.RadiusQueries",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatSpatialGridRadiusTest::RunTest(const FString &Parameters)
+{
+    FRandomStream Random(0x6121D);
+    TArray<FGaussianSplatData> Splats;
+    MakeGridTestSplats(Random, Splats);
+    FGaussianSplatSpatialGrid Grid;
+    Grid.Build(Splats);
+    TestEqual(TEXT("Every splat is in the grid"), Grid.Num(), Splats.Num());
+
+    const float Radii[] = {0.0f, 1.0f, 7.5f, 40.0f, 600.0f};
+    TArray<int32> Expected, Found;
+    for (int32 Query = 0; Query < 300; ++Query)
+    {
+        const FVector3f Center = MakeQueryPoint(Random, Splats, Query);
+        const float Radius = Radii[Query % UE_ARRAY_COUNT(Radii)];
+
+        // Same inclusive float test as the grid, so boundary splats agree exactly
+        Expected.Reset();
+        for (int32 i = 0; i < Splats.Num(); ++i)
+        {
+            if (FVector3f::DistSquared(Splats[i].Position, Center) <= Radius * Radius)
+                Expected.Add(i);
+        }
+
+        Found.Reset();
+        const int32 NumFound = Grid.FindInRadius(Center, Radius, MAX_int32, Found);
+        TestEqual(TEXT("FindInRadius returns what it appended"), NumFound, Found.Num());
+        TestEqual(TEXT("CountInRadius matches brute force"), Grid.CountInRadius(Center, Radius, MAX_int32),
+                  Expected.Num());
+        for (int32 Nth = 0; Nth < Found.Num(); ++Nth)
+        {
+            if (Grid.GetInRadius(Center, Radius, Nth) != Found[Nth])
+            {
+                AddError(FString::Printf(TEXT("Query %d: GetInRadius(%d) disagrees with FindInRadius"), Query, Nth));
+                break;
+            }
+        }
+        TestEqual(TEXT("GetInRadius past the end"), Grid.GetInRadius(Center, Radius, Found.Num()), INDEX_NONE);
+
+        Found.Sort();
+        if (Found != Expected)
+        {
+            AddError(FString::Printf(TEXT("Query %d at %s radius %g: grid found %d splats, brute force %d"), Query,
+                                     *Center.ToString(), Radius, Found.Num(), Expected.Num()));
+            return false;
+        }
+
+        // MaxCount stops early without going past it
+        const int32 MaxCount = Expected.Num() / 2;
+        TestEqual(TEXT("CountInRadius honours MaxCount"), Grid.CountInRadius(Center, Radius, MaxCount), MaxCount);
+        Found.Reset();
+        TestEqual(TEXT("FindInRadius honours MaxCount"), Grid.FindInRadius(Center, Radius, MaxCount, Found), MaxCount);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatSpatialGridNearestTest, "GaussianSplat.SpatialGrid.Nearest",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatSpatialGridNearestTest::RunTest(const FString &Parameters)
+{
+    FRandomStream Random(0x4EA2);
+    TArray<FGaussianSplatData> Splats;
+    MakeGridTestSplats(Random, Splats);
+    FGaussianSplatSpatialGrid Grid;
+    Grid.Build(Splats);
+
+    const float MaxDistances[] = {0.0f, 2.0f, 25.0f, 300.0f};
+    for (int32 Query = 0; Query < 300; ++Query)
+    {
+        const FVector3f Position = MakeQueryPoint(Random, Splats, Query);
+        const float MaxDistance = MaxDistances[Query % UE_ARRAY_COUNT(MaxDistances)];
+
+        int32 Expected = INDEX_NONE;
+        float ExpectedDistSq = MaxDistance > 0.0f ? MaxDistance * MaxDistance : UE_MAX_FLT;
+        for (int32 i = 0; i < Splats.Num(); ++i)
+        {
+            // Strictly closer only, so the lowest index wins ties
+            const float DistSq = FVector3f::DistSquared(Splats[i].Position, Position);
+            if (DistSq < ExpectedDistSq || (DistSq == ExpectedDistSq && Expected == INDEX_NONE))
+            {
+                ExpectedDistSq = DistSq;
+                Expected = i;
+            }
+        }
+
+        float Distance = -1.0f;
+        const int32 Nearest = Grid.FindNearest(Position, MaxDistance, &Distance);
+        if (Nearest != Expected)
+        {
+            AddError(FString::Printf(TEXT("Query %d at %s max %g: grid found %d, brute force %d"), Query,
+                                     *Position.ToString(), MaxDistance, Nearest, Expected));
+            return false;
+        }
+        if (Expected != INDEX_NONE)
+            TestEqual(TEXT("Nearest distance"), Distance, FMath::Sqrt(ExpectedDistSq));
+    }
+
+    FGaussianSplatSpatialGrid Empty;
+    Empty.Build(TConstArrayView<FGaussianSplatData>());
+    TestEqual(TEXT("Empty grid finds nothing"), Empty.FindNearest(FVector3f::ZeroVector, 0.0f), INDEX_NONE);
+    TestEqual(TEXT("Empty grid counts nothing"), Empty.CountInRadius(FVector3f::ZeroVector, 100.0f, 10), 0);
+    return true;
+}
+
+namespace
+{
+bool RangesEqual(FAutomationTestBase &Test, const TCHAR *What, const FGaussianSplatDirtyRanges &Ranges,
+                 std::initializer_list<FGaussianSplatDirtyRange> Expected)
+{
+    TArray<FString> Got, Want;
+    for (const FGaussianSplatDirtyRange &Range : Ranges.GetRanges())
+        Got.Add(FString::Printf(TEXT("[%d,%d)"), Range.Start, Range.End()));
+    for (const FGaussianSplatDirtyRange &Range : Expected)
+        Want.Add(FString::Printf(TEXT("[%d,%d)"), Range.Start, Range.End()));
+    return Test.TestEqual(What, FString::Join(Got, TEXT(" ")), FString::Join(Want, TEXT(" ")));
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatDirtyRangesTest, "GaussianSplat.DirtyRanges.MergeAndSplit",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGaussianSplatDirtyRangesTest::RunTest(const FString &Parameters)
+{
+    {
+        // Scattered indices split into runs; duplicates and adjacent indices join
+        FGaussianSplatDirtyRanges Ranges;
+        const int32 Indices[] = {9, 3, 4, 4, 5, 20, 11, 10, 0};
+        Ranges.AddIndices(Indices);
+        RangesEqual(*this, TEXT("AddIndices runs"), Ranges, {{0, 1}, {3, 3}, {9, 3}, {20, 1}});
+        TestEqual(TEXT("AddIndices total"), Ranges.GetTotalCount(), int64(8));
+    }
+    {
+        // Out of order, overlapping, contained and touching ranges collapse; the distant one stays separate
+        FGaussianSplatDirtyRanges Ranges;
+        Ranges.Add(50, 10);
+        Ranges.Add(10, 5);
+        Ranges.Add(12, 2);
+        Ranges.Add(15, 5);
+        Ranges.Add(18, 4);
+        Ranges.Add(0, 0);
+        Ranges.Merge(100, 0);
+        RangesEqual(*this, TEXT("Merge without gap"), Ranges, {{10, 12}, {50, 10}});
+    }
+    {
+        // Gaps up to the tolerance are bridged, wider ones are not
+        FGaussianSplatDirtyRanges Ranges;
+        Ranges.Add(0, 4);
+        Ranges.Add(7, 3);
+        Ranges.Add(14, 2);
+        Ranges.Merge(100, 3);
+        RangesEqual(*this, TEXT("Merge with gap tolerance"), Ranges, {{0, 10}, {14, 2}});
+    }
+    {
+        // Clamped to the element count; ranges wholly outside vanish
+        FGaussianSplatDirtyRanges Ranges;
+        Ranges.Add(-5, 8);
+        Ranges.Add(95, 10);
+        Ranges.Add(120, 4);
+        Ranges.Add(-20, 5);
+        Ranges.Merge(100, 0);
+        RangesEqual(*this, TEXT("Merge clamps"), Ranges, {{0, 3}, {95, 5}});
+        TestEqual(TEXT("Clamped total"), Ranges.GetTotalCount(), int64(8));
+    }
+    {
+        FGaussianSplatDirtyRanges Ranges;
+        Ranges.Add(200, 4);
+        Ranges.Merge(100, 16);
+        TestTrue(TEXT("Everything out of range leaves nothing"), Ranges.IsEmpty());
+        Ranges.Merge(100, 16);
+        TestTrue(TEXT("Merging nothing is a no-op"), Ranges.IsEmpty());
+    }
+    {
+        // Random ranges against a per-element mask: merging without a gap must cover exactly the dirty elements
+        // with disjoint, sorted, non-touching ranges
+        FRandomStream Random(0xD127);
+        constexpr int32 NumElements = 500;
+        for (int32 Trial = 0; Trial < 50; ++Trial)
+        {
+            FGaussianSplatDirtyRanges Ranges;
+            TBitArray<> Dirty(false, NumElements);
+            for (int32 i = 0; i < 20; ++i)
+            {
+                const int32 Start = Random.RandRange(-20, NumElements + 20);
+                const int32 Count = Random.RandRange(0, 30);
+                Ranges.Add(Start, Count);
+                for (int32 Element = FMath::Max(Start, 0); Element < FMath::Min(Start + Count, NumElements); ++Element)
+                    Dirty[Element] = true;
+            }
+            Ranges.Merge(NumElements, 0);
+
+            TBitArray<> Covered(false, NumElements);
+            int32 PrevEnd = -1;
+            for (const FGaussianSplatDirtyRange &Range : Ranges.GetRanges())
+            {
+                TestTrue(TEXT("Ranges are sorted and separated"), Range.Start > PrevEnd && Range.Count > 0);
+                PrevEnd = Range.End();
+                for (int32 Element = Range.Start; Element < Range.End(); ++Element)
+                    Covered[Element] = true;
+            }
+            if (Covered != Dirty)
+            {
+                AddError(FString::Printf(TEXT("Trial %d: merged ranges do not cover exactly the dirty elements"),
+                                         Trial));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
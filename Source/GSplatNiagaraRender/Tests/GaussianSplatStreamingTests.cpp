@@ -0,0 +1,172 @@
+﻿#include "CoreMinimal.h"
+#include "GaussianSplatStreamingManager.h"
+#include "GaussianSplatSyntheticData.h"
+#include "GaussianSplatTiledFile.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatStreamingCameraPathTest, "GaussianSplat.Streaming.CameraPathReplay",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Flies the view diagonally through a tiled cloud with a pool far smaller than the file and checks the manager
+// stays inside its budget, keeps the tile under the camera resident and evicts what it flew away from.
+bool FGaussianSplatStreamingCameraPathTest::RunTest(const FString &Parameters)
+{
+    constexpr int32 TileCapacity = 256;
+    constexpr int32 NumSlots = 6;
+    constexpr int32 NumSteps = 24;
+
+    FGaussianSplatSyntheticSettings Synthetic;
+    Synthetic.NumSplats = 20000;
+    TArray<FGaussianSplatData> Splats;
+    FGaussianSplatSyntheticData::MakeSplats(Synthetic, Splats);
+
+    const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("GaussianSplatStreamingTest.gstl"));
+    FString Error;
+    if (!TestTrue(FString::Printf(TEXT("Write tiled file: %s"), *Error),
+                  FGaussianSplatTiledFile::Write(FilePath, Splats, TileCapacity, Error)))
+        return false;
+
+    FGaussianSplatTiledFileHeader Header;
+    TArray<FGaussianSplatTileInfo> Tiles;
+    if (!TestTrue(TEXT("Read tile table"), FGaussianSplatTiledFile::ReadTable(FilePath, Header, Tiles, Error)))
+        return false;
+    TestTrue(TEXT("Cloud spans more tiles than the pool holds"), Tiles.Num() > NumSlots * 2);
+
+    const int64 SlotBytes = int64(TileCapacity) * sizeof(FGaussianSplatPackedRecord);
+    FGaussianSplatStreamingSettings Settings;
+    Settings.ResidencyBudgetBytes = SlotBytes * NumSlots;
+    Settings.MaxInFlightReads = 2;
+
+    FGaussianSplatStreamingManager Manager;
+    if (!TestTrue(TEXT("Open"), Manager.Open(FilePath, Settings, Error)))
+        return false;
+    TestEqual(TEXT("Slot count follows the budget"), Manager.GetNumSlots(), NumSlots);
+
+    // Records currently held by each pool slot, as the GPU pool would see them
+    TArray<TArray<FGaussianSplatPackedRecord>> SlotRecords;
+    SlotRecords.SetNum(Manager.GetNumSlots());
+    int32 UploadCount = 0;
+    TArray<uint32> Indirection;
+
+    for (int32 Step = 0; Step <= NumSteps; ++Step)
+    {
+        const FVector3f ViewOrigin = FMath::Lerp(Header.BoundsMin, Header.BoundsMax, float(Step) / NumSteps);
+
+        // Settle the frame: the first Update issues reads, Flush lands them and the second Update publishes them
+        Manager.Update(ViewOrigin);
+        TestTrue(TEXT("In-flight reads stay within the limit"),
+                 Manager.GetStats().PendingReads <= Settings.MaxInFlightReads);
+        for (int32 Pass = 0; Pass < NumSlots && Manager.GetStats().PendingReads > 0; ++Pass)
+        {
+            Manager.Flush();
+            Manager.Update(ViewOrigin);
+        }
+        Manager.Flush();
+        Manager.Update(ViewOrigin);
+
+        for (FGaussianSplatTileUpload &Upload : Manager.ConsumeUploads())
+        {
+            SlotRecords[Upload.Slot] = MoveTemp(Upload.Records);
+            ++UploadCount;
+        }
+
+        const FGaussianSplatStreamingStats &Stats = Manager.GetStats();
+        TestTrue(TEXT("Resident bytes stay within the budget"), Stats.ResidentBytes <= Settings.ResidencyBudgetBytes);
+        TestEqual(TEXT("Every slot is filled once settled"), Stats.ResidentTiles, Manager.GetNumSlots());
+
+        Manager.BuildIndirection(Indirection);
+        TestEqual(TEXT("Indirection covers the resident splats"), int64(Indirection.Num()), Stats.ResidentSplats);
+
+        // The tile containing (or nearest to) the camera must be in one of the resident slots
+        int32 NearestTile = 0;
+        for (int32 TileIdx = 1; TileIdx < Tiles.Num(); ++TileIdx)
+        {
+            if (Tiles[TileIdx].DistanceSquaredTo(ViewOrigin) < Tiles[NearestTile].DistanceSquaredTo(ViewOrigin))
+                NearestTile = TileIdx;
+        }
+        const FGaussianSplatTileInfo &Nearest = Tiles[NearestTile];
+        const FBox3f NearestBounds(Nearest.BoundsMin, Nearest.BoundsMax);
+
+        TSet<int32> ResidentSlots;
+        for (uint32 Element : Indirection)
+            ResidentSlots.Add(int32(Element / uint32(TileCapacity)));
+
+        bool bNearestResident = false;
+        for (int32 SlotIdx : ResidentSlots)
+        {
+            const TArray<FGaussianSplatPackedRecord> &Records = SlotRecords[SlotIdx];
+            if (Records.Num() != Nearest.SplatCount)
+                continue;
+            bool bInside = true;
+            for (const FGaussianSplatPackedRecord &Record : Records)
+                bInside &= NearestBounds.ExpandBy(1e-3f).IsInside(FVector3f(Record.Position));
+            bNearestResident |= bInside;
+        }
+        TestTrue(FString::Printf(TEXT("Step %d: tile nearest the camera is resident"), Step), bNearestResident);
+    }
+
+    const FGaussianSplatStreamingStats &Stats = Manager.GetStats();
+    TestTrue(TEXT("Flying across the cloud evicts tiles"), Stats.TotalEvictions > 0);
+    TestEqual(TEXT("Every load produced one upload"), UploadCount, Stats.TotalTileLoads);
+    TestEqual(TEXT("Loads beyond the pool size are evictions"), Stats.TotalTileLoads - Manager.GetNumSlots(),
+              Stats.TotalEvictions);
+    TestEqual(TEXT("Nothing left in flight"), Stats.PendingReads, 0);
+
+    Manager.Close();
+    IFileManager::Get().Delete(*FilePath);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGaussianSplatStreamingCorruptTableTest, "GaussianSplat.Streaming.CorruptTileTable",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Patches single fields of the first tile table entry and checks ReadTable rejects each one
+bool FGaussianSplatStreamingCorruptTableTest::RunTest(const FString &Parameters)
+{
+    // Little-endian layout written by FGaussianSplatTiledFile: 48 byte header, then bounds (24), DataOffset (8),
+    // SplatCount (4), Depth (4) per tile
+    constexpr int32 HeaderBytes = 48;
+    constexpr int32 DataOffsetAt = HeaderBytes + 24;
+    constexpr int32 SplatCountAt = DataOffsetAt + 8;
+
+    FGaussianSplatSyntheticSettings Synthetic;
+    Synthetic.NumSplats = 2000;
+    TArray<FGaussianSplatData> Splats;
+    FGaussianSplatSyntheticData::MakeSplats(Synthetic, Splats);
+
+    const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("GaussianSplatCorruptTest.gstl"));
+    FString Error;
+    if (!TestTrue(TEXT("Write tiled file"), FGaussianSplatTiledFile::Write(FilePath, Splats, 256, Error)))
+        return false;
+    TArray<uint8> Original;
+    if (!TestTrue(TEXT("Load tiled file"), FFileHelper::LoadFileToArray(Original, *FilePath)))
+        return false;
+
+    auto ReadPatched = [&](int32 At, const void *Value, int32 Size)
+    {
+        TArray<uint8> Bytes = Original;
+        FMemory::Memcpy(Bytes.GetData() + At, Value, Size);
+        FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+        FGaussianSplatTiledFileHeader Header;
+        TArray<FGaussianSplatTileInfo> Tiles;
+        return FGaussianSplatTiledFile::ReadTable(FilePath, Header, Tiles, Error);
+    };
+
+    const int32 NegativeCount = -1;
+    const int64 InsideHeader = 8;
+    const int64 NearMax = MAX_int64 - 16;
+    TestTrue(TEXT("Unpatched file reads"), ReadPatched(0, Original.GetData(), 0));
+    TestFalse(TEXT("Negative splat count"), ReadPatched(SplatCountAt, &NegativeCount, sizeof(NegativeCount)));
+    TestFalse(TEXT("Data offset inside the tile table"), ReadPatched(DataOffsetAt, &InsideHeader, sizeof(int64)));
+    TestFalse(TEXT("Data offset that overflows"), ReadPatched(DataOffsetAt, &NearMax, sizeof(int64)));
+
+    IFileManager::Get().Delete(*FilePath);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
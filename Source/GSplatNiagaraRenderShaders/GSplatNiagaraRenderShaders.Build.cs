@@ -0,0 +1,19 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Global shaders have to be registered before the engine compiles its shader maps, which is earlier than the game
+// module loads, so they live in this small PostConfigInit module
+public class GSplatNiagaraRenderShaders : ModuleRules
+{
+    public GSplatNiagaraRenderShaders(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new string[] {
+            "Core",
+            "RenderCore",
+            "RHI"
+        });
+    }
+}
@@ -0,0 +1,96 @@
+﻿#include "GaussianSplatShaders.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "ShaderCore.h"
+
+class FGSplatNiagaraRenderShadersModule : public IModuleInterface
+{
+public:
+    virtual void StartupModule() override
+    {
+        const FString ShaderDir = FPaths::Combine(FPaths::ProjectDir(), TEXT("Shaders"));
+        AddShaderSourceDirectoryMapping(TEXT(GSPLAT_SHADER_PATH), ShaderDir);
+    }
+};
+
+IMPLEMENT_MODULE(FGSplatNiagaraRenderShadersModule, GSplatNiagaraRenderShaders);
+
+bool FGaussianSplatCullCS::ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters)
+{
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+}
+
+void FGaussianSplatCullCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                                        FShaderCompilerEnvironment &OutEnvironment)
+{
+    FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+    OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+    OutEnvironment.SetDefine(TEXT("SCAN_GROUP_SIZE"), FGaussianSplatCullScanCS::ThreadGroupSize);
+    OutEnvironment.SetDefine(TEXT("MAX_PLANES"), MaxPlanes);
+}
+
+bool FGaussianSplatCullScanCS::ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters)
+{
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+}
+
+void FGaussianSplatCullScanCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                                            FShaderCompilerEnvironment &OutEnvironment)
+{
+    FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+    // The culling parameters share the file
+    OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), FGaussianSplatCullCS::ThreadGroupSize);
+    OutEnvironment.SetDefine(TEXT("SCAN_GROUP_SIZE"), ThreadGroupSize);
+    OutEnvironment.SetDefine(TEXT("MAX_PLANES"), FGaussianSplatCullCS::MaxPlanes);
+}
+
+IMPLEMENT_GLOBAL_SHADER(FGaussianSplatCullCS, GSPLAT_SHADER_PATH "/Private/GaussianSplatCull.usf", "MainCS",
+                        SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FGaussianSplatCullScanCS, GSPLAT_SHADER_PATH "/Private/GaussianSplatCull.usf", "ScanCS",
+                        SF_Compute);
+
+bool FGaussianSplatRasterProjectCS::ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters)
+{
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+}
+
+void FGaussianSplatRasterProjectCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                                                 FShaderCompilerEnvironment &OutEnvironment)
+{
+    FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+    OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+    OutEnvironment.SetDefine(TEXT("RASTER_TILE_SIZE"), FGaussianSplatRasterizeCS::TileSize);
+}
+
+bool FGaussianSplatTileRangesCS::ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters)
+{
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+}
+
+void FGaussianSplatTileRangesCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                                              FShaderCompilerEnvironment &OutEnvironment)
+{
+    FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+    OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+    OutEnvironment.SetDefine(TEXT("RASTER_TILE_SIZE"), FGaussianSplatRasterizeCS::TileSize);
+}
+
+bool FGaussianSplatRasterizeCS::ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters)
+{
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+}
+
+void FGaussianSplatRasterizeCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                                             FShaderCompilerEnvironment &OutEnvironment)
+{
+    FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+    OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), TileSize * TileSize);
+    OutEnvironment.SetDefine(TEXT("RASTER_TILE_SIZE"), TileSize);
+}
+
+IMPLEMENT_GLOBAL_SHADER(FGaussianSplatRasterProjectCS, GSPLAT_SHADER_PATH "/Private/GaussianSplatRaster.usf",
+                        "ProjectCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FGaussianSplatTileRangesCS, GSPLAT_SHADER_PATH "/Private/GaussianSplatRaster.usf",
+                        "TileRangesCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FGaussianSplatRasterizeCS, GSPLAT_SHADER_PATH "/Private/GaussianSplatRaster.usf",
+                        "RasterizeCS", SF_Compute);
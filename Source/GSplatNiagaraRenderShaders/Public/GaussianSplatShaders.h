@@ -0,0 +1,171 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GlobalShader.h"
+#include "ShaderParameterStruct.h"
+
+// Sources live in <Project>/Shaders, mapped to this virtual path by the module
+#define GSPLAT_SHADER_PATH "/GaussianSplat"
+
+/**
+ * View culling: tests every splat's bounding sphere (the W of its position) against up to six planes and compacts the
+ * survivors into an index list. With MinPixelRadius set, splats projecting smaller than that are thinned out too.
+ * Runs twice around FGaussianSplatCullScanCS: the first pass writes each group's count to GroupOffsets, the
+ * FWriteDim pass writes VisibleIndices in ascending order from the scanned offsets.
+ */
+class GSPLATNIAGARARENDERSHADERS_API FGaussianSplatCullCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FGaussianSplatCullCS);
+    SHADER_USE_PARAMETER_STRUCT(FGaussianSplatCullCS, FGlobalShader);
+
+    static constexpr uint32 ThreadGroupSize = 256;
+    static constexpr int32 MaxPlanes = 6;
+
+    // Reads FGaussianSplatPackedRecord records instead of the position stream
+    class FInterleavedDim : SHADER_PERMUTATION_BOOL("GSPLAT_INTERLEAVED");
+    // Second pass: writes the indices instead of counting them
+    class FWriteDim : SHADER_PERMUTATION_BOOL("GSPLAT_CULL_WRITE");
+    using FPermutationDomain = TShaderPermutationDomain<FInterleavedDim, FWriteDim>;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+    SHADER_PARAMETER(uint32, NumSplats)
+    SHADER_PARAMETER(uint32, BaseOffset)
+    // Thread groups per row; large clouds need more groups than one dispatch dimension allows
+    SHADER_PARAMETER(uint32, DispatchWidth)
+    SHADER_PARAMETER(uint32, NumPlanes)
+    SHADER_PARAMETER(float, RadiusScale)
+    SHADER_PARAMETER_ARRAY(FVector4f, Planes, [MaxPlanes])
+    // Projected radius in pixels is PixelScale * radius / dot(DepthPlane, position); 0 disables sub-pixel culling
+    SHADER_PARAMETER(FVector4f, DepthPlane)
+    SHADER_PARAMETER(float, PixelScale)
+    SHADER_PARAMETER(float, MinPixelRadius)
+    SHADER_PARAMETER_SRV(Buffer<float4>, Positions)
+    SHADER_PARAMETER_SRV(ByteAddressBuffer, SplatRecords)
+    // Thread groups covering NumSplats; one GroupOffsets entry each
+    SHADER_PARAMETER(uint32, NumGroups)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, GroupOffsets)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, VisibleIndices)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters);
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                             FShaderCompilerEnvironment &OutEnvironment);
+};
+
+// View culling, between the two FGaussianSplatCullCS passes: one group turns the per-group counts into exclusive
+// offsets in place and writes their total to VisibleCount[0]
+class GSPLATNIAGARARENDERSHADERS_API FGaussianSplatCullScanCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FGaussianSplatCullScanCS);
+    SHADER_USE_PARAMETER_STRUCT(FGaussianSplatCullScanCS, FGlobalShader);
+
+    static constexpr uint32 ThreadGroupSize = 1024;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+    SHADER_PARAMETER(uint32, NumGroups)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, GroupOffsets)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, VisibleCount)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters);
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                             FShaderCompilerEnvironment &OutEnvironment);
+};
+
+/**
+ * Tile rasterizer, stage 1: projects every splat to a 2D conic and appends one (tile, depth) sort key per tile it
+ * overlaps. Keys past MaxKeys are dropped; unused slots must be cleared to all ones so they sort last.
+ * FGaussianSplatRasterizer is the CPU reference of all three stages.
+ */
+class GSPLATNIAGARARENDERSHADERS_API FGaussianSplatRasterProjectCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FGaussianSplatRasterProjectCS);
+    SHADER_USE_PARAMETER_STRUCT(FGaussianSplatRasterProjectCS, FGlobalShader);
+
+    static constexpr uint32 ThreadGroupSize = 64;
+    // float4s per projected splat: (center, depth, opacity), (conic, -), (color, -)
+    static constexpr uint32 ProjectedStride = 3;
+
+    class FInterleavedDim : SHADER_PERMUTATION_BOOL("GSPLAT_INTERLEAVED");
+    using FPermutationDomain = TShaderPermutationDomain<FInterleavedDim>;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+    SHADER_PARAMETER(uint32, NumSplats)
+    SHADER_PARAMETER(uint32, BaseOffset)
+    SHADER_PARAMETER(uint32, DispatchWidth)
+    SHADER_PARAMETER(FMatrix44f, LocalToView)
+    SHADER_PARAMETER(FVector2f, Focal)
+    SHADER_PARAMETER(FVector2f, Principal)
+    SHADER_PARAMETER(FIntPoint, ImageSize)
+    SHADER_PARAMETER(FIntPoint, TileCount)
+    SHADER_PARAMETER(uint32, DepthBits)
+    SHADER_PARAMETER(float, NearZ)
+    // 1 / ln(FarZ / NearZ)
+    SHADER_PARAMETER(float, InvLogDepthRange)
+    SHADER_PARAMETER(uint32, MaxKeys)
+    SHADER_PARAMETER(FVector3f, Tint)
+    SHADER_PARAMETER_SRV(Buffer<float4>, Positions)
+    SHADER_PARAMETER_SRV(Buffer<float4>, Scales)
+    SHADER_PARAMETER_SRV(Buffer<float4>, Orientations)
+    SHADER_PARAMETER_SRV(Buffer<float4>, SHZeroCoeffsAndOpacity)
+    SHADER_PARAMETER_SRV(ByteAddressBuffer, SplatRecords)
+    SHADER_PARAMETER_UAV(RWBuffer<float4>, ProjectedSplats)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, KeyCounter)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, SortKeys)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, SortValues)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters);
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                             FShaderCompilerEnvironment &OutEnvironment);
+};
+
+// Tile rasterizer, stage 2: finds the [first, last) range of every tile in the sorted keys. Ranges must be cleared.
+class GSPLATNIAGARARENDERSHADERS_API FGaussianSplatTileRangesCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FGaussianSplatTileRangesCS);
+    SHADER_USE_PARAMETER_STRUCT(FGaussianSplatTileRangesCS, FGlobalShader);
+
+    static constexpr uint32 ThreadGroupSize = 64;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+    SHADER_PARAMETER(uint32, MaxKeys)
+    SHADER_PARAMETER(uint32, DispatchWidth)
+    SHADER_PARAMETER(uint32, NumTiles)
+    SHADER_PARAMETER(uint32, DepthBits)
+    SHADER_PARAMETER_SRV(Buffer<uint>, SortedKeys)
+    SHADER_PARAMETER_UAV(RWBuffer<uint>, RWTileRanges)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters);
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                             FShaderCompilerEnvironment &OutEnvironment);
+};
+
+// Tile rasterizer, stage 3: one group per tile blends its splats front to back into Output, premultiplied, with
+// coverage in alpha. Every pixel is written, so Output needs no clear.
+class GSPLATNIAGARARENDERSHADERS_API FGaussianSplatRasterizeCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FGaussianSplatRasterizeCS);
+    SHADER_USE_PARAMETER_STRUCT(FGaussianSplatRasterizeCS, FGlobalShader);
+
+    static constexpr uint32 TileSize = 16;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+    SHADER_PARAMETER(FIntPoint, ImageSize)
+    SHADER_PARAMETER(FIntPoint, TileCount)
+    SHADER_PARAMETER_SRV(Buffer<uint>, SortedValues)
+    SHADER_PARAMETER_SRV(Buffer<uint>, TileRanges)
+    SHADER_PARAMETER_SRV(Buffer<float4>, Projected)
+    SHADER_PARAMETER_UAV(RWTexture2D<float4>, Output)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters &Parameters);
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters &Parameters,
+                                             FShaderCompilerEnvironment &OutEnvironment);
+};